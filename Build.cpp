@@ -34,6 +34,7 @@ using namespace std;
 
 #include "StringDictionary.h"
 #include "iterators/IteratorDictStringPlain.h"
+#include "iterators/IteratorDictStringFile.h"
 #include "utils/LogSequence.h"
 
 
@@ -55,6 +56,71 @@ void checkFile()
 	cerr << endl;
 }
 
+void checkIndexes(const char *indexes)
+{
+	string refused;
+
+	for (const char *c = indexes; *c != '\0'; c++)
+	{
+		if (c != indexes) refused += ", ";
+		refused += string("'")+*c+"'";
+	}
+
+	bool plural = (strlen(indexes) > 1);
+	string line = string(" *** Checks the ")+(plural ? "indexes " : "index ")+refused;
+	line += string(" because the dictionary does not support ")+(plural ? "them" : "it")+" *** ";
+	string stars = " "+string(line.size()-2, '*')+" ";
+
+	cerr << endl;
+	cerr << stars << endl;
+	cerr << line << endl;
+	cerr << stars << endl;
+	cerr << endl;
+}
+
+void checkThreads()
+{
+	cerr << endl;
+	cerr << " ************************************************************************************************ " << endl;
+	cerr << " *** Checks the number of threads because this compression is only built with a single thread *** " << endl;
+	cerr << " ************************************************************************************************ " << endl;
+	cerr << endl;
+}
+
+/* Checks whether the dictionary stored in 'in' can be extended with the
+   given auxiliary index ('s', 'r' or 'f'). The stream is restored to 
+   its beginning. */
+bool supportsIndex(ifstream &in, char index)
+{
+	streampos pos = in.tellg();
+	uint32_t type = loadValue<uint32_t>(in);
+	bool dynamic = (type == DYNAMIC);
+
+	// Dynamic dictionaries forward the substring and rank indexes to 
+	// the base dictionary, stored after their header
+	if (dynamic)
+	{
+		in.seekg(pos + (streamoff)StringDictionaryDynamic::HEADERSIZE, in.beg);
+		type = loadValue<uint32_t>(in);
+	}
+
+	in.seekg(pos, in.beg);
+
+	bool fc = (type == PFC) || (type == RPFC) || (type == HTFC) || (type == HHTFC) || (type == RPHTFC);
+	bool hash = (type == HASHHF) || (type == HASHUFFDAC) || (type == HASHRPF) || (type == MPHFHF) || (type == MPHFRPF) || (type == HASHRPDAC);
+
+	// Loaded XBW dictionaries cannot be saved again (they only keep
+	// the compressed XBW), so they take the filter when they are built
+	switch (index)
+	{
+		case 's': return fc || (type == RPDAC);
+		case 'r': return hash;
+		case 'f': return !dynamic && (type != DXBW);
+	}
+
+	return false;
+}
+
 void useBuild()
 {
 
@@ -70,6 +136,8 @@ void useBuild()
 	cerr << " \t <overhead> : hash table overhead over the number of strings." << endl;
 	cerr << " \t <in> : input file containing the set of '\\0'-delimited strings." << endl;
 	cerr << " \t <out> : output file for storing the dictionary." << endl;
+	cerr << " \t [options] : (optional) 'r' for indexing ranks (prefix and rank operations);" << endl;
+	cerr << " \t              'f' for building the membership filter on locate." << endl;
 	cerr << endl;
 
 	cerr << " type: 2 => Build HASHDAC dictionary" << endl;
@@ -77,6 +145,8 @@ void useBuild()
 	cerr << " \t <overhead> : hash table overhead over the number of strings." << endl;
 	cerr << " \t <in> : input file containing the set of '\\0'-delimited strings." << endl;
 	cerr << " \t <out> : output file for storing the dictionary." << endl;
+	cerr << " \t [options] : (optional) 'r' for indexing ranks (prefix and rank operations);" << endl;
+	cerr << " \t              'f' for building the membership filter on locate." << endl;
 	cerr << endl;
 
 	cerr << " type: 3 => Build PLAIN FRONT CODING dictionary" << endl;
@@ -84,6 +154,8 @@ void useBuild()
 	cerr << " \t <bucketsize> : number of strings per bucket." << endl;
 	cerr << " \t <in> : input file containing the set of '\\0'-delimited strings." << endl;
 	cerr << " \t <out> : output file for storing the dictionary." << endl;
+	cerr << " \t [threads] : (optional) number of threads for 'p' construction ('r' only uses one)." << endl;
+	cerr << " \t [options] : (optional, after [threads]) 'f' for building the membership filter on locate." << endl;
 	cerr << endl;
 
 	cerr << " type: 4 => Build HU-TUCKER FRONT CODING dictionary" << endl;
@@ -92,11 +164,14 @@ void useBuild()
 	cerr << " \t <bucketsize> : number of strings per bucket." << endl;
 	cerr << " \t <in> : input file containing the set of '\\0'-delimited strings." << endl;
 	cerr << " \t <out> : output file for storing the dictionary." << endl;
+	cerr << " \t [threads] : (optional) number of threads for 't' and 'h' construction ('r' only uses one)." << endl;
+	cerr << " \t [options] : (optional, after [threads]) 'f' for building the membership filter on locate." << endl;
 	cerr << endl;
 
 	cerr << " type: 5 => Build RE-PAIR DAC dictionary" << endl;
 	cerr << " \t <in> : input file containing the set of '\\0'-delimited strings." << endl;
 	cerr << " \t <out> : output file for storing the dictionary." << endl;
+	cerr << " \t [f] : (optional) 'f' for building the membership filter on locate." << endl;
 	cerr << endl;
 
 	cerr << " type: 6 => Build FMINDEX dictionary" << endl;
@@ -105,11 +180,39 @@ void useBuild()
 	cerr << " \t <BWT sampling> : sampling step for the BWT (0 for no sampling)" << endl;
 	cerr << " \t <in> : input file containing the set of '\\0'-delimited strings." << endl;
 	cerr << " \t <out> : output file for storing the dictionary." << endl;
+	cerr << " \t [options] : (optional) 'q' for Larsson-Sadakane suffix sorting (SA-IS by default);" << endl;
+	cerr << " \t              'm' for representing the BWT with a wavelet matrix (Huffman-shaped wavelet tree by default);" << endl;
+	cerr << " \t              'f' for building the membership filter on locate." << endl;
 	cerr << endl;
 
 	cerr << " type: 7 => Build XBW dictionary" << endl;
 	cerr << " \t <in> : input file containing the set of '\\0'-delimited strings." << endl;
 	cerr << " \t <out> : output file for storing the dictionary." << endl;
+	cerr << " \t [options] : (optional) 'm' for representing alpha with a wavelet matrix (Huffman-shaped wavelet tree by default);" << endl;
+	cerr << " \t              'f' for building the membership filter on locate." << endl;
+	cerr << endl;
+
+	cerr << " type: 8 => Build MINIMAL PERFECT HASH dictionary" << endl;
+	cerr << " \t <compress> : 'h' for Huffman; 'r' for RePair compression." << endl;
+	cerr << " \t <overhead> : extra bits per level over the number of strings (0 for ~3 bits per string)." << endl;
+	cerr << " \t <in> : input file containing the set of '\\0'-delimited strings." << endl;
+	cerr << " \t <out> : output file for storing the dictionary." << endl;
+	cerr << " \t [options] : (optional) 'r' for indexing ranks (prefix and rank operations);" << endl;
+	cerr << " \t              'f' for building the membership filter on locate." << endl;
+	cerr << endl;
+
+	cerr << " type: 9 => Insert strings in a DYNAMIC dictionary" << endl;
+	cerr << " \t <threshold> : buffered insertions triggering a background merge (0 for default)." << endl;
+	cerr << " \t <dict> : dictionary (of any type) in which the strings are inserted." << endl;
+	cerr << " \t <in> : input file containing the set of '\\0'-delimited strings (in any order)." << endl;
+	cerr << " \t <out> : output file for storing the dictionary." << endl;
+	cerr << endl;
+
+	cerr << " type: 10 => Attach auxiliary INDEXES to a dictionary" << endl;
+	cerr << " \t <indexes> : 's' for substring search (Front-Coding and RPDAC); 'r' for ranks (HASH);" << endl;
+	cerr << " \t              'f' for the membership filter on locate (any static dictionary but XBW)." << endl;
+	cerr << " \t <dict> : dictionary in which the indexes are built." << endl;
+	cerr << " \t <out> : output file for storing the dictionary." << endl;
 	cerr << endl;
 }
 
@@ -125,7 +228,7 @@ main(int argc, char* argv[])
 		{
 			case 1:
 			{
-				if (argc != 6) { useBuild(); break; }
+				if ((argc != 6) && (argc != 7)) { useBuild(); break; }
 
 				ifstream in(argv[4]);
 
@@ -133,7 +236,7 @@ main(int argc, char* argv[])
 				{
 
 					in.seekg(0,ios_base::end);
-					uint lenStr = in.tellg()/sizeof(uchar);
+					size_t lenStr = in.tellg()/sizeof(uchar);
 					in.seekg(0,ios_base::beg);
 
 					uint overhead = atoi(argv[3]);
@@ -159,6 +262,9 @@ main(int argc, char* argv[])
 						filename += string(".hashrpf");
 					}
 
+					if ((argc == 7) && (strchr(argv[6], 'r') != NULL)) dict->indexRanks();
+					if ((argc == 7) && (strchr(argv[6], 'f') != NULL)) dict->indexMembership();
+
 					ofstream out((char*)filename.c_str());
 					dict->save(out);
 					out.close();
@@ -171,14 +277,14 @@ main(int argc, char* argv[])
 
 			case 2:
 			{
-				if (argc != 6) { useBuild(); break; }
+				if ((argc != 6) && (argc != 7)) { useBuild(); break; }
 
 				ifstream in(argv[4]);
 
 				if (in.good())
 				{
 					in.seekg(0,ios_base::end);
-					uint lenStr = in.tellg()/sizeof(uchar);
+					size_t lenStr = in.tellg()/sizeof(uchar);
 					in.seekg(0,ios_base::beg);
 
 					uint overhead = atoi(argv[3]);
@@ -204,6 +310,9 @@ main(int argc, char* argv[])
 						filename += string(".hashrpdac");
 					}
 
+					if ((argc == 7) && (strchr(argv[6], 'r') != NULL)) dict->indexRanks();
+					if ((argc == 7) && (strchr(argv[6], 'f') != NULL)) dict->indexMembership();
+
 					ofstream out((char*)filename.c_str());
 					dict->save(out);
 					out.close();
@@ -216,30 +325,64 @@ main(int argc, char* argv[])
 
 			case 3:
 			{
-				if (argc != 6) { useBuild(); break; }
+				if ((argc < 6) || (argc > 8)) { useBuild(); break; }
+
+				// Only the plain representation is built in parallel
+				uint threads = (argc >= 7) ? atoi(argv[6]) : 1;
+				if ((threads > 1) && (argv[2][0] == 'r')) { checkThreads(); break; }
+				bool filter = (argc == 8) && (strchr(argv[7], 'f') != NULL);
 
 				ifstream in(argv[4]);
 				if (in.good())
 				{
-					in.seekg(0,ios_base::end);
-					uint lenStr = in.tellg()/sizeof(uchar);
-					in.seekg(0,ios_base::beg);
-
 					uint bucketsize = atoi(argv[3]);
+					IteratorDictString *it = NULL;
 
-					uchar *str = loadValue<uchar>(in, lenStr);
-					in.close();
+					if (threads > 1)
+					{
+						// The strings are loaded in memory for the
+						// parallel construction
+						in.seekg(0,ios_base::end);
+						size_t lenStr = in.tellg()/sizeof(uchar);
+						in.seekg(0,ios_base::beg);
 
-					IteratorDictString *it = new IteratorDictStringPlain(str, lenStr);
+						uchar *str = loadValue<uchar>(in, lenStr+1);
+						str[lenStr] = '\0';
+
+						it = new IteratorDictStringPlain(str, lenStr);
+					}
+					// The strings are streamed from disk
+					else it = new IteratorDictStringFile(argv[4]);
+
+					in.close();
 					StringDictionary *dict = NULL;
 					string filename = string(argv[5]);
 
-					if (argv[2][0] == 'p')
+					if ((argv[2][0] == 'p') && (threads > 1))
 					{
-						// Uncompressed internal string
-						dict = new StringDictionaryPFC(it, bucketsize);
+						// Uncompressed internal string (parallel)
+						dict = new StringDictionaryPFC((IteratorDictStringPlain*)it, bucketsize, threads);
 						filename += string(".pfc");
 					}
+					else if (argv[2][0] == 'p')
+					{
+						// Uncompressed internal string: the buckets are
+						// directly written to the output file
+						filename += string(".pfc");
+
+						ofstream out((char*)filename.c_str());
+						size_t elements = StringDictionaryPFC::build(it, bucketsize, out);
+
+						if (filter)
+						{
+							// The filter streams the strings again
+							MembershipFilter membershipFilter(new IteratorDictStringFile(argv[4]), elements);
+							membershipFilter.save(out);
+						}
+
+						out.close();
+						break;
+					}
 					else if (argv[2][0] == 'r')
 					{
 						// RePair compression
@@ -253,6 +396,8 @@ main(int argc, char* argv[])
 						return 0;
 					}
 
+					if (filter) dict->indexMembership();
+
 					ofstream out((char*)filename.c_str());
 					dict->save(out);
 					out.close();
@@ -265,21 +410,36 @@ main(int argc, char* argv[])
 
 			case 4:
 			{
-				if (argc != 6) { useBuild(); break; }
+				if ((argc < 6) || (argc > 8)) { useBuild(); break; }
+
+				// The RePair compression is not built in parallel
+				uint threads = (argc >= 7) ? atoi(argv[6]) : 1;
+				if ((threads > 1) && (argv[2][0] == 'r')) { checkThreads(); break; }
+				bool filter = (argc == 8) && (strchr(argv[7], 'f') != NULL);
 
 				ifstream in(argv[4]);
 				if (in.good())
 				{
-					in.seekg(0,ios_base::end);
-					uint lenStr = in.tellg()/sizeof(uchar);
-					in.seekg(0,ios_base::beg);
-
 					uint bucketsize = atoi(argv[3]);
+					IteratorDictString *it = NULL;
 
-					uchar *str = loadValue<uchar>(in, lenStr);
-					in.close();
+					if (threads > 1)
+					{
+						// The strings are loaded in memory for the
+						// parallel construction
+						in.seekg(0,ios_base::end);
+						size_t lenStr = in.tellg()/sizeof(uchar);
+						in.seekg(0,ios_base::beg);
 
-					IteratorDictString *it = new IteratorDictStringPlain(str, lenStr);
+						uchar *str = loadValue<uchar>(in, lenStr+1);
+						str[lenStr] = '\0';
+
+						it = new IteratorDictStringPlain(str, lenStr);
+					}
+					// The strings are streamed from disk
+					else it = new IteratorDictStringFile(argv[4]);
+
+					in.close();
 					StringDictionary *dict = NULL;
 					string filename = string(argv[5]);
 
@@ -288,7 +448,8 @@ main(int argc, char* argv[])
 						case 't':
 						{
 							// HuTucker compression
-							dict = new StringDictionaryHTFC(it, bucketsize);
+							if (threads > 1) dict = new StringDictionaryHTFC((IteratorDictStringPlain*)it, bucketsize, threads);
+							else dict = new StringDictionaryHTFC(it, bucketsize);
 							filename += string(".htfc");
 							break;
 						}
@@ -296,7 +457,8 @@ main(int argc, char* argv[])
 						case 'h':
 						{
 							// Huffman compression
-							dict = new StringDictionaryHHTFC(it, bucketsize);
+							if (threads > 1) dict = new StringDictionaryHHTFC((IteratorDictStringPlain*)it, bucketsize, threads);
+							else dict = new StringDictionaryHHTFC(it, bucketsize);
 							filename += (".hhtfc");
 							break;
 						}
@@ -317,6 +479,8 @@ main(int argc, char* argv[])
 						}
 					}
 
+					if (filter) dict->indexMembership();
+
 					ofstream out((char*)filename.c_str());
 					dict->save(out);
 					out.close();
@@ -329,13 +493,13 @@ main(int argc, char* argv[])
 
 			case 5:
 			{
-				if (argc != 4) { useBuild(); break; }
+				if ((argc != 4) && (argc != 5)) { useBuild(); break; }
 
 				ifstream in(argv[2]);
 				if (in.good())
 				{
 					in.seekg(0,ios_base::end);
-					uint lenStr = in.tellg()/sizeof(uchar);
+					size_t lenStr = in.tellg()/sizeof(uchar);
 					in.seekg(0,ios_base::beg);
 
 					uchar *str = loadValue<uchar>(in, lenStr);
@@ -345,6 +509,8 @@ main(int argc, char* argv[])
 					StringDictionary *dict = new StringDictionaryRPDAC(it);
 					string filename = string(argv[3])+string(".rpdac");
 
+					if ((argc == 5) && (strchr(argv[4], 'f') != NULL)) dict->indexMembership();
+
 					ofstream out((char*)filename.c_str());
 					dict->save(out);
  					out.close();
@@ -357,13 +523,13 @@ main(int argc, char* argv[])
 
 			case 6:
 			{
-				if (argc != 7) { useBuild(); break; }
+				if ((argc != 7) && (argc != 8)) { useBuild(); break; }
 
 				ifstream in(argv[5]);
 				if (in.good())
 				{
 					in.seekg(0,ios_base::end);
-					uint lenStr = in.tellg()/sizeof(uchar);
+					size_t lenStr = in.tellg()/sizeof(uchar);
 					in.seekg(0,ios_base::beg);
 
 					uchar *str = loadValue<uchar>(in, lenStr);
@@ -374,11 +540,13 @@ main(int argc, char* argv[])
 					string filename;
 
 					uint BWTsampling = atoi(argv[4]);
+					uint sorting = ((argc == 8) && (strchr(argv[7], 'q') != NULL)) ? SAQSUFSORT : SAIS;
+					uint sequence = ((argc == 8) && (strchr(argv[7], 'm') != NULL)) ? WMATRIX : WTREE;
 
 					if (argv[2][0] == 'p')
 					{
 						// Plain bitmaps
-						dict = new StringDictionaryFMINDEX(it, false, atoi(argv[3]), BWTsampling);
+						dict = new StringDictionaryFMINDEX(it, false, atoi(argv[3]), BWTsampling, sorting, sequence);
 						delete it;
 
 						filename = string(argv[6])+string(".")+string(argv[3])+string(".rg.fmi");
@@ -387,7 +555,7 @@ main(int argc, char* argv[])
 					else if (argv[2][0] == 'c')
 					{
 						// Compressed bitmaps
-						dict = new StringDictionaryFMINDEX(it, true, atoi(argv[3]), BWTsampling);
+						dict = new StringDictionaryFMINDEX(it, true, atoi(argv[3]), BWTsampling, sorting, sequence);
 						delete it;
 
 						filename = string(argv[6])+string(".")+string(argv[3])+string(".rrr.fmi");
@@ -398,6 +566,8 @@ main(int argc, char* argv[])
 						break;
 					}
 
+					if ((argc == 8) && (strchr(argv[7], 'f') != NULL)) dict->indexMembership();
+
 					ofstream out((char*)filename.c_str());
 					dict->save(out);
  					out.close();
@@ -410,25 +580,34 @@ main(int argc, char* argv[])
 
 			case 7:
 			{
-				if (argc != 4) { useBuild(); break; }
+				if ((argc != 4) && (argc != 5)) { useBuild(); break; }
 
 				ifstream in(argv[2]);
 				if (in.good())
 				{
 					in.seekg(0,ios_base::end);
-					uint lenStr = in.tellg()/sizeof(uchar);
+					size_t lenStr = in.tellg()/sizeof(uchar);
 					in.seekg(0,ios_base::beg);
 
 					uchar *str = loadValue<uchar>(in, lenStr);
 					IteratorDictString *it = new IteratorDictStringPlain(str, lenStr-1);
 					in.close();
 
-					StringDictionary *dict = new StringDictionaryXBW(it);
+					uint sequence = ((argc == 5) && (strchr(argv[4], 'm') != NULL)) ? WMATRIX : WTREE;
+					StringDictionary *dict = new StringDictionaryXBW(it, sequence);
 					delete it;
 
 					string filename = string(argv[3])+string(".xbw");
 					ofstream out((char*)filename.c_str());
 					dict->save(out);
+
+					if ((argc == 5) && (strchr(argv[4], 'f') != NULL))
+					{
+						// The XBW is only built when it is loaded, so
+						// the filter streams the strings again
+						MembershipFilter membershipFilter(new IteratorDictStringFile(argv[2]), dict->numElements());
+						membershipFilter.save(out);
+					}
 			 		out.close();
 					delete dict;
 				}
@@ -437,6 +616,137 @@ main(int argc, char* argv[])
 				break;
 			}
 
+			case 8:
+			{
+				if ((argc != 6) && (argc != 7)) { useBuild(); break; }
+
+				ifstream in(argv[4]);
+
+				if (in.good())
+				{
+					in.seekg(0,ios_base::end);
+					size_t lenStr = in.tellg()/sizeof(uchar);
+					in.seekg(0,ios_base::beg);
+
+					uint overhead = atoi(argv[3]);
+
+					uchar *str = loadValue<uchar>(in, lenStr+1);
+					str[lenStr] = '\0';
+					in.close();
+
+					IteratorDictString *it = new IteratorDictStringPlain(str, lenStr);
+					StringDictionary *dict = NULL;
+					string filename = string(argv[5]);
+
+					if (argv[2][0] == 'h')
+					{
+						// Huffman compression
+						dict = new StringDictionaryHASHHF(it, lenStr, overhead, HASHMPHF);
+						filename += string(".mphfhf");
+					}
+					else
+					{
+						// RePair compression
+						dict = new StringDictionaryHASHRPF(it, lenStr, overhead, HASHMPHF);
+						filename += string(".mphfrpf");
+					}
+
+					if ((argc == 7) && (strchr(argv[6], 'r') != NULL)) dict->indexRanks();
+					if ((argc == 7) && (strchr(argv[6], 'f') != NULL)) dict->indexMembership();
+
+					ofstream out((char*)filename.c_str());
+					dict->save(out);
+					out.close();
+					delete dict;
+				}
+				else checkFile();
+
+				break;
+			}
+
+			case 9:
+			{
+				if (argc != 6) { useBuild(); break; }
+
+				ifstream in(argv[3]);
+
+				if (in.good())
+				{
+					StringDictionary *loaded = StringDictionary::load(in, HASHRP);
+					in.close();
+
+					if (loaded == NULL) { checkDict(); break; }
+
+					// Static dictionaries are wrapped in a new dynamic one
+					StringDictionaryDynamic *dict = dynamic_cast<StringDictionaryDynamic*>(loaded);
+
+					if (dict == NULL)
+					{
+						size_t threshold = atol(argv[2]);
+						if (threshold == 0) threshold = DYNAMICBUFFER;
+
+						dict = new StringDictionaryDynamic(loaded, threshold);
+					}
+
+					IteratorDictStringFile it(argv[4]);
+
+					while (it.hasNext())
+					{
+						uint strLen;
+						uchar *str = it.next(&strLen);
+						dict->insert(str, strLen);
+					}
+
+					string filename = string(argv[5])+string(".dyn");
+
+					ofstream out((char*)filename.c_str());
+					dict->save(out);
+					out.close();
+					delete dict;
+				}
+				else checkFile();
+
+				break;
+			}
+
+			case 10:
+			{
+				if (argc != 5) { useBuild(); break; }
+
+				ifstream in(argv[3]);
+
+				if (in.good())
+				{
+					bool supported = false;
+
+					for (const char *c = argv[2]; *c != '\0'; c++)
+					{
+						if (supportsIndex(in, *c)) supported = true;
+						else cerr << "[WARNING] The index '" << *c << "' is not supported by the given dictionary." << endl;
+					}
+
+					// Nothing would be attached to the dictionary
+					if (!supported) { in.close(); checkIndexes(argv[2]); break; }
+
+					StringDictionary *dict = StringDictionary::load(in, HASHRP);
+					in.close();
+
+					if (dict == NULL) { checkDict(); break; }
+
+					if (strchr(argv[2], 's') != NULL) dict->indexSubstrings();
+					if (strchr(argv[2], 'r') != NULL) dict->indexRanks();
+					if (strchr(argv[2], 'f') != NULL) dict->indexMembership();
+
+					ofstream out(argv[4]);
+					dict->save(out);
+					out.close();
+					delete dict;
+				}
+				else checkFile();
+
+				break;
+			}
+
 			default:
 			{
 				useBuild();
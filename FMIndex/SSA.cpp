@@ -27,17 +27,23 @@
 #include "SSA.h"
 
 
-	SSA::SSA(uchar *text, uint n, bool free_text, uint samplesuff) {
+	SSA::SSA(uchar *text, size_t n, bool free_text, uint samplesuff, uint sorting) {
 		assert(n>0);
 
+		// The BWT is represented through libcds sequences, whose rank
+		// directories address (at most) 32-bit positions
+		if (n >= UINT_MAX) throw "The FM-Index does not support texts of 4GB or more.";
+
 		// Initial values and default constructors
 		this->n=n;
 		this->_seq = text;
 		this->built = false;
 		this->free_text=free_text;
 		this->samplesuff = samplesuff;
+		this->sorting = sorting;
+		this->mapping = NULL;
 
-		_sbb = new BitSequenceBuilderRG(20);
+		_sbb = rankBitmapBuilder(20);
 		_sbb->use();
 		_ssb = new SequenceBuilderWaveletTreeNoptrs(_sbb,new MapperNone());
 		_ssb->use();
@@ -58,17 +64,17 @@
 		if(_seq!=NULL && free_text)
 			delete [] _seq;
 		if(_bwt!=NULL)
-			delete [] _bwt;
+			free(_bwt);
 		if(_ssb!=NULL)
 			delete _ssb;
 		if(bwt!=NULL)
 			delete (Sequence*)bwt;
 		if(_sa!=NULL)
-			delete [] _sa;
+			free(_sa);
 		if(_sbb!=NULL)
 			delete _sbb;
 		if(suff_sample!=NULL)
-			delete [] suff_sample;
+			MemoryMapping::release(mapping, suff_sample);
 		if(sampled!=NULL)
 			delete sampled;
 		if(alphabet!=NULL)
@@ -92,8 +98,9 @@
 		saveValue(fp, alphabet, 256);
 	}
 
-	SSA * SSA::load(ifstream & fp){
+	SSA * SSA::load(ifstream & fp, MemoryMapping *mapping){
 		SSA *fm = new SSA();
+		fm->mapping = mapping;
 		fm->n = loadValue<uint>(fp);
 		fm->maxV = loadValue<uint>(fp);
 		fm->occ = loadValue<uint>(fp, fm->maxV+1);
@@ -101,7 +108,7 @@
 		fm->samplesuff = loadValue<uint>(fp);
 
 		if(fm->samplesuff > 0){
-			fm->suff_sample = loadValue<uint>(fp, (fm->n+1)/fm->samplesuff+1);	
+			fm->suff_sample = MemoryMapping::loadArray<uint>(mapping, fp, (fm->n+1)/fm->samplesuff+1);
 			fm->sampled = BitSequence::load(fp);
 		}
 		fm->alphabet = loadValue<bool>(fp,256);
@@ -111,7 +118,7 @@
 		return fm;
 	}
 
-	uint SSA::length() {
+	size_t SSA::length() const {
 		return n;
 	}
 
@@ -122,6 +129,7 @@
 		_bwt = NULL;
 		sampled = NULL;
 		suff_sample = NULL;
+		mapping = NULL;
 
 		_seq=NULL;
 		_ssb=NULL;
@@ -129,8 +137,8 @@
 	}
 
 
-	uint SSA::size() {
-		uint size = bwt->getSize();
+	size_t SSA::size() const {
+		size_t size = bwt->getSize();
 		if(samplesuff > 0){
 			size += sizeof(uint)*(1+n/samplesuff);
 			size += sampled->getSize();
@@ -208,7 +216,7 @@
 		for(uint i=1;i<=maxV;i++)
 			occ[i] += occ[i-1];
 
-		delete [] _bwt;
+		free(_bwt);
 		_bwt = NULL;
 		_ssb->unuse();
 		_ssb = NULL;
@@ -223,13 +231,8 @@
 		assert(_seq!=NULL);
 		assert(_sbb!=NULL);
 		if(_bwt!=NULL)
-			delete [] _bwt;
-		_bwt = new uint[n+2];
+			free(_bwt);
 		build_sa();
-		for(uint i=0;i<n+1;i++) {
-			if(_sa[i]==0) _bwt[i]=0;
-			else _bwt[i] = _seq[_sa[i]-1];
-		}
 	
 		if (samplesuff > 0)
 		{
@@ -239,7 +242,7 @@
 			for(uint i=0;i<uint_len(n+1,1);i++) sampled_vector[i] = 0;
 			for(uint i=0;i<n+1;i++) {
 				if(_sa[i]%samplesuff==0) {
-					suff_sample[j++]=(uint)_sa[i];
+					suff_sample[j++]=_sa[i];
 					bitset(sampled_vector,i);
 				}
 			}
@@ -248,37 +251,56 @@
 			delete [] sampled_vector;
 		}
 
-		free (_sa);
+		// The BWT is computed in place over the suffix array
+		for(uint i=0;i<n+1;i++)
+			if(_sa[i]>0) _sa[i] = _seq[_sa[i]-1];
+
+		_bwt = _sa;
 		_sa = NULL;
 	}
 
 
 	void SSA::build_sa() {
-		long *sa_i;
 		assert(_seq!=NULL);
 		if(_sa!=NULL)
-			delete [] _sa;
-		SuffixArray *suffix = new SuffixArray();
-		sa_i = suffix->sort(_seq, n);
-		_sa = (ulong *)sa_i;
-		delete suffix;
+			free(_sa);
+
+		if (sorting == SAQSUFSORT)
+		{
+			SuffixArray *suffix = new SuffixArray();
+			long *sa_i = suffix->sort(_seq, n);
+			delete suffix;
+
+			// Narrowing the suffix array to 32-bit entries (in place)
+			_sa = (uint *)sa_i;
+			for(ulong i=0;i<=n;i++) _sa[i] = (uint)sa_i[i];
+		}
+		else
+		{
+			SuffixArraySAIS *suffix = new SuffixArraySAIS();
+			_sa = suffix->sort(_seq, n);
+			delete suffix;
+		}
+
 		assert(_sa[0]==n);
 		for(ulong i=0;i<n;i++)
-			assert(cmp((uint)_sa[i],(uint)_sa[i+1])<=0);
+			assert(cmp(_sa[i],_sa[i+1])<=0);
 	}
 
-	uint SSA::locate_id(uchar * pattern, uint m) {
+	size_t SSA::locate_id(uchar * pattern, uint m) const {
 		ulong i=m-1;
 		uint c = pattern[i];
-		uint sp = occ[c];
-		uint ep = occ[c+1]-1;
+		size_t sp = occ[c];
+		size_t ep = occ[c+1]-1;
 		while (sp<=ep && i>=1) {
 			c = pattern[--i];
 			if(!alphabet[c]){
 				return 0;
 			}	
-			sp = occ[c]+bwt->rank(c,sp-1);
-			ep = occ[c]+bwt->rank(c,ep)-1;
+			size_t rsp, rep;
+			bwt->rankPair(c,sp-1,ep,rsp,rep);
+			sp = occ[c]+rsp;
+			ep = occ[c]+rep-1;
 		}
 		if (sp<=ep) {
 			return sp;
@@ -287,20 +309,22 @@
 			return 0;
 	}
 
-	uint
-	SSA::locateP(uchar * pattern, uint m, size_t *left, size_t *right, size_t elements)
+	size_t
+	SSA::locateP(uchar * pattern, uint m, size_t *left, size_t *right, size_t elements) const
 	{
 		ulong i=m-1;
 		uint c = pattern[i];
-		uint sp = occ[c];
-		uint ep = occ[c+1]-1;
+		size_t sp = occ[c];
+		size_t ep = occ[c+1]-1;
 		while (sp<=ep && i>=1) {
 			c = pattern[--i];
 			if(!alphabet[c]){
 				return 0;
 			}
-			sp = occ[c]+bwt->rank(c,sp-1);
-			ep = occ[c]+bwt->rank(c,ep)-1;
+			size_t rsp, rep;
+			bwt->rankPair(c,sp-1,ep,rsp,rep);
+			sp = occ[c]+rsp;
+			ep = occ[c]+rep-1;
 		}
 
 		if (sp<=ep)
@@ -313,88 +337,91 @@
 		else return 0;
 	}
 
-	uint SSA::locate(uchar * pattern, uint m, size_t **occs){
-		if(samplesuff == 0){
-			*occs = NULL;
-			return 0;
-		}
+	size_t SSA::count(uchar * pattern, uint m, size_t *sp, size_t *ep) const {
 		ulong i=m-1;
 		uint c = pattern[i];
-		uint sp = occ[c];
-		uint ep = occ[c+1]-1;
-		while (sp<=ep && i>=1) {
+		if(!alphabet[c]) return 0;
+		*sp = occ[c];
+		*ep = occ[c+1]-1;
+		while (*sp<=*ep && i>=1) {
 			c = pattern[--i];
 			if(!alphabet[c]){
 				return 0;
 			}
-			sp = occ[c]+bwt->rank(c,sp-1);
-			ep = occ[c]+bwt->rank(c,ep)-1;
+			size_t rsp, rep;
+			bwt->rankPair(c,*sp-1,*ep,rsp,rep);
+			*sp = occ[c]+rsp;
+			*ep = occ[c]+rep-1;
 		}
 
-		if (sp<=ep) {
-			uint matches = ep-sp+1;
-			*occs = new size_t[matches+1];
-			uint i = sp;
-			uint j,dist;
-			size_t rank_tmp;
+		if (*sp<=*ep) return *ep-*sp+1;
+		else return 0;
+	}
 
-			while(i<=ep)
-			{
-				j = i;
-				dist = 0;
+	size_t SSA::locate_row(size_t i) const {
+		size_t j = i, rank_tmp;
 
-				while(!sampled->access(j))
-				{
-					c = bwt->access(j,rank_tmp);
+		while(!sampled->access(j))
+		{
+			uint c = bwt->access(j,rank_tmp);
 
-					if (c == 1) break;
+			// The beginning of the string is reached: its ID is
+			// given by the rank of its preceding separator
+			if (c == 1) return rank_tmp-1;
+			j = occ[c]+rank_tmp-1;
+		}
 
-					rank_tmp--;
-					j = occ[c]+rank_tmp;
-					dist++;
-				}
+		return suff_sample[sampled->rank1(j)-1];
+	}
 
-				if (c != 1) (*occs)[i-sp] = suff_sample[sampled->rank1(j)-1];
-				else (*occs)[i-sp] = rank_tmp-1;
+	size_t SSA::locate(uchar * pattern, uint m, size_t **occs) const{
+		size_t sp, ep, matches = 0;
+		*occs=NULL;
 
-				i++;
-			}
+		if(samplesuff > 0) matches = count(pattern, m, &sp, &ep);
 
-			return ep-sp+1;
+		if (matches > 0) {
+			*occs = new size_t[matches+1];
+			for(size_t i=sp; i<=ep; i++) (*occs)[i-sp] = locate_row(i);
 		}
-		*occs=NULL;
-		return 0;
+
+		return matches;
 	}
 
 
-	uint SSA::LF(uint i){
+	size_t SSA::LF(size_t i) const{
 		size_t rank_tmp;
 		uint c = bwt->access(i, rank_tmp);
 		return rank_tmp -1 + occ[c];
 	}
 
-	uchar * SSA::extract_id(uint id, uint *strLen, uint max_len){
-		uchar *res = new uchar[max_len+2];
-		uint i = id;
-		uint pos = max_len+1;
-		res[pos] = '\0';
-		pos--;
-		*strLen =0;
+	uchar * SSA::extract_id(size_t id, uint *strLen, uint max_len) const{
+		uchar *res = new uchar[max_len+1];
+		*strLen = extract_id(id, res, max_len);
+		return res;
+	}
+
+	uint SSA::extract_id(size_t id, uchar *res, uint max_len) const{
+		// The string is written backwards from the end of the buffer
+		// and then moved to its beginning
+		size_t i = id;
+		uint pos = max_len;
+		uint strLen = 0;
 		size_t rank_tmp;
 		uint c = bwt->access(id, rank_tmp);
 		
 		while(c!= 1){
 			res[pos] = (uchar)c;
 			pos --;
-			(*strLen)++;
+			strLen++;
 			i = rank_tmp -1 + occ[c];
 			c = bwt->access(i, rank_tmp);
 		}
 		pos++;
-		for(uint j=0; j<(*strLen);j++)
+		for(uint j=0; j<strLen;j++)
 			res[j] = res[pos+j];
-		res[(*strLen)] = '\0';
-		return res;
+		res[strLen] = '\0';
+		return strLen;
 	}
 
 	int SSA::cmp(uint i, uint j) {
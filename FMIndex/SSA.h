@@ -35,13 +35,17 @@
 #include <algorithm>
 
 #include "SuffixArray.h"
+#include "SuffixArraySAIS.h"
+#include "../utils/MemoryMapping.h"
+#include "../utils/RankBitmap.h"
+#include "../utils/Utils.h"
 
 using namespace std;
 using namespace cds_static;
 
 	class SSA{
 		public:
-			SSA(uchar * seq, uint n, bool free_text=false, uint samplesuff=0);
+			SSA(uchar * seq, size_t n, bool free_text=false, uint samplesuff=0, uint sorting=SAIS);
 			SSA();
 			~SSA();
 
@@ -50,17 +54,42 @@ using namespace cds_static;
 
 			bool build_index();
 
-			uint size();
+			size_t size() const;
 			void print_stats();
-			uint length();
-
-			uint LF(uint i);
-			uint locate_id(uchar * pattern, uint m);
-			uint locate(uchar * pattern, uint m, size_t **occs);
-			uint locateP(uchar * pattern, uint m, size_t *left, size_t *right, size_t last);
-
-			uchar * extract_id(uint id, uint *strLen, uint max_len);
-			static SSA * load(ifstream & fp);
+			size_t length() const;
+
+			size_t LF(size_t i) const;
+			size_t locate_id(uchar * pattern, uint m) const;
+			size_t locate(uchar * pattern, uint m, size_t **occs) const;
+
+			/** Backward search of the pattern.
+			    @param pattern: the pattern.
+			    @param m: the pattern length.
+			    @param sp: the first row of the pattern occurrences.
+			    @param ep: the last row of the pattern occurrences.
+			    @returns the number of occurrences (ep-sp+1).
+			*/
+			size_t count(uchar * pattern, uint m, size_t *sp, size_t *ep) const;
+
+			/** Obtains the ID of the string containing the occurrence
+			    at the given row (it requires suffix sampling).
+			    @param i: the row.
+			    @returns the ID.
+			*/
+			size_t locate_row(size_t i) const;
+			size_t locateP(uchar * pattern, uint m, size_t *left, size_t *right, size_t last) const;
+
+			uchar * extract_id(size_t id, uint *strLen, uint max_len) const;
+
+			/** Extracts the string at the given row into a buffer of
+			    max_len+1 bytes.
+			    @param id: the row.
+			    @param res: the buffer.
+			    @param max_len: the maximum string length.
+			    @returns the string length.
+			*/
+			uint extract_id(size_t id, uchar *res, uint max_len) const;
+			static SSA * load(ifstream & fp, MemoryMapping *mapping=NULL);
 			void save(ofstream & fp);
 
 		protected:
@@ -70,6 +99,7 @@ using namespace cds_static;
 			BitSequence * sampled;
 			uint * suff_sample;
 			uint samplesuff;			// Suffix sampling
+			MemoryMapping *mapping;			// Mapping containing suff_sample (if any)
 
 			uint * occ;
 			uint maxV;
@@ -80,7 +110,8 @@ using namespace cds_static;
 			/*use only for construction*/
 			uchar * _seq;
 			uint * _bwt;   
-			ulong * _sa;   
+			uint * _sa;   
+			uint sorting;			// Suffix sorting algorithm (SAIS or SAQSUFSORT)
 			SequenceBuilder * _ssb;
 			BitSequenceBuilder * _sbb;
 			/*******************************/
@@ -0,0 +1,188 @@
+/* SuffixArraySAIS.cpp
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * This class implements the linear time suffix sorting algorithm presented
+ * in "Two Efficient Algorithms for Linear Time Suffix Array Construction" by
+ * Ge Nong, Sen Zhang, and Wai Hong Chan (SA-IS). The suffix array is built
+ * with 32-bit entries and the reduced problems are solved within it, so the
+ * construction requires (about) 4 bytes per symbol, instead of the 16 bytes
+ * used by the Larsson-Sadakane algorithm (SuffixArray).
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+
+#include "SuffixArraySAIS.h"
+
+	static const uint EMPTY = (uint)-1;	// Empty suffix array cell
+
+	/* Text with a virtual terminator: symbols are shifted to 1..256 and
+	   the terminator (position n) is 0. */
+	struct SAISText {
+		const unsigned char *s;
+		uint n;
+		inline uint operator[](uint i) const { return (i < n) ? (uint)s[i]+1 : 0; }
+	};
+
+	/* Reduced text (names of the LMS substrings) */
+	struct SAISNames {
+		const uint *s;
+		inline uint operator[](uint i) const { return s[i]; }
+	};
+
+	#define SAIS_STYPE(t,i) bitget(t,i)
+	#define SAIS_ISLMS(t,i) (((i) > 0) && SAIS_STYPE(t,i) && !SAIS_STYPE(t,(i)-1))
+
+	template <class Text>
+	static void getBuckets(const Text &s, uint *bkt, uint n, uint K, bool end) {
+		for(uint i=0; i<K; i++) bkt[i]=0;
+		for(uint i=0; i<n; i++) bkt[s[i]]++;
+
+		uint sum=0;
+		for(uint i=0; i<K; i++) {
+			sum += bkt[i];
+			bkt[i] = end ? sum : sum-bkt[i];
+		}
+	}
+
+	template <class Text>
+	static void induceL(const uint *t, uint *SA, const Text &s, uint *bkt, uint n, uint K) {
+		getBuckets(s, bkt, n, K, false);
+
+		for(uint i=0; i<n; i++) {
+			if((SA[i] != EMPTY) && (SA[i] > 0)) {
+				uint j = SA[i]-1;
+				if(!SAIS_STYPE(t,j)) SA[bkt[s[j]]++] = j;
+			}
+		}
+	}
+
+	template <class Text>
+	static void induceS(const uint *t, uint *SA, const Text &s, uint *bkt, uint n, uint K) {
+		getBuckets(s, bkt, n, K, true);
+
+		for(uint i=n; i-- > 0;) {
+			if((SA[i] != EMPTY) && (SA[i] > 0)) {
+				uint j = SA[i]-1;
+				if(SAIS_STYPE(t,j)) SA[--bkt[s[j]]] = j;
+			}
+		}
+	}
+
+	/* Sorts the n suffixes of s (whose last symbol is the unique 
+	   minimum) over the alphabet [0, K) */
+	template <class Text>
+	static void sais(const Text &s, uint *SA, uint n, uint K) {
+		// Classifying the suffixes (S-type: 1, L-type: 0)
+		uint *t = new uint[uint_len(n,1)];
+		for(uint i=0; i<uint_len(n,1); i++) t[i]=0;
+
+		bitset(t, n-1);
+		for(uint i=n-1; i-- > 0;) {
+			if((s[i] < s[i+1]) || ((s[i] == s[i+1]) && SAIS_STYPE(t,i+1))) bitset(t, i);
+		}
+
+		// Sorting the LMS substrings
+		uint *bkt = new uint[K];
+		getBuckets(s, bkt, n, K, true);
+
+		for(uint i=0; i<n; i++) SA[i]=EMPTY;
+		for(uint i=1; i<n; i++) if(SAIS_ISLMS(t,i)) SA[--bkt[s[i]]] = i;
+
+		induceL(t, SA, s, bkt, n, K);
+		induceS(t, SA, s, bkt, n, K);
+		delete [] bkt;
+
+		// Compacting the sorted LMS substrings into the first n1 cells
+		uint n1=0;
+		for(uint i=0; i<n; i++) if(SAIS_ISLMS(t,SA[i])) SA[n1++] = SA[i];
+		for(uint i=n1; i<n; i++) SA[i]=EMPTY;
+
+		// Naming the LMS substrings (in text order, in the last n-n1 cells)
+		uint name=0, prev=EMPTY;
+		for(uint i=0; i<n1; i++) {
+			uint pos=SA[i];
+			bool diff=false;
+
+			for(uint d=0; d<n; d++) {
+				if((prev == EMPTY) || (s[pos+d] != s[prev+d]) || (SAIS_STYPE(t,pos+d) != SAIS_STYPE(t,prev+d))) {
+					diff=true;
+					break;
+				}
+				else if((d > 0) && (SAIS_ISLMS(t,pos+d) || SAIS_ISLMS(t,prev+d))) break;
+			}
+
+			if(diff) { name++; prev=pos; }
+			SA[n1+pos/2] = name-1;
+		}
+
+		for(uint i=n, j=n; i-- > n1;) if(SA[i] != EMPTY) SA[--j] = SA[i];
+
+		// Sorting the reduced problem (recursively if the names are not unique)
+		uint *SA1=SA, *s1=SA+n-n1;
+
+		if(name < n1) {
+			SAISNames names = { s1 };
+			sais(names, SA1, n1, name);
+		}
+		else for(uint i=0; i<n1; i++) SA1[s1[i]] = i;
+
+		// Inducing the suffix array from the sorted LMS suffixes
+		bkt = new uint[K];
+		getBuckets(s, bkt, n, K, true);
+
+		for(uint i=1, j=0; i<n; i++) if(SAIS_ISLMS(t,i)) s1[j++] = i;
+		for(uint i=0; i<n1; i++) SA1[i] = s1[SA1[i]];
+		for(uint i=n1; i<n; i++) SA[i]=EMPTY;
+
+		for(uint i=n1; i-- > 0;) {
+			uint j=SA[i];
+			SA[i]=EMPTY;
+			SA[--bkt[s[j]]] = j;
+		}
+
+		induceL(t, SA, s, bkt, n, K);
+		induceS(t, SA, s, bkt, n, K);
+
+		delete [] bkt;
+		delete [] t;
+	}
+
+	SuffixArraySAIS::SuffixArraySAIS(){
+
+	}
+
+	uint* SuffixArraySAIS::sort(unsigned char *text, ulong length){
+		uint *SA = (uint *)malloc((length+1)*sizeof(uint));
+		SA[0] = (uint)length;
+		if(length == 0) return SA;
+
+		SAISText s = { text, (uint)length };
+
+		sais(s, SA, (uint)length+1, 257);
+
+		return SA;
+	}
+
+	SuffixArraySAIS::~SuffixArraySAIS(){
+
+	}
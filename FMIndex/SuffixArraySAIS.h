@@ -0,0 +1,57 @@
+/* SuffixArraySAIS.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * This class implements the linear time suffix sorting algorithm presented
+ * in "Two Efficient Algorithms for Linear Time Suffix Array Construction" by
+ * Ge Nong, Sen Zhang, and Wai Hong Chan (SA-IS). The suffix array is built
+ * with 32-bit entries and the reduced problems are solved within it, so the
+ * construction requires (about) 4 bytes per symbol, instead of the 16 bytes
+ * used by the Larsson-Sadakane algorithm (SuffixArray).
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#ifndef SUFFIXARRAYSAIS_H_
+#define SUFFIXARRAYSAIS_H_
+
+#include <libcdsBasics.h>
+using namespace cds_utils;
+
+	class SuffixArraySAIS{
+		public:
+			SuffixArraySAIS();
+
+			/** Sorts the suffixes of the given text. A virtual
+			    terminator (lower than any symbol) is appended, so
+			    the text can contain any byte.
+			    @param text: the text.
+			    @param length: the text length.
+			    @returns the suffix array (length+1 entries, the first
+			      one is the terminator position: length). It must be
+			      released with free().
+			*/
+			uint* sort(unsigned char *text, ulong length);
+
+			~SuffixArraySAIS();
+	};
+
+#endif /* SUFFIXARRAYSAIS_H_ */
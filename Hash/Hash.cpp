@@ -30,7 +30,7 @@
 	size_t
 	Hash::insert(uchar *w, size_t len, size_t offset)
 	{
-		size_t hval = bitwisehash(w, len, tsize);
+		size_t hval = hash_value(function, w, len, tsize);
 
 		if(hashtable[hval] == (size_t)-1)
 		{
@@ -42,7 +42,7 @@
 		else
 		{
 			 //use double hashing
-			 size_t h2 = step_value(w, len, tsize);
+			 size_t h2 = hash_step(function, w, len, tsize);
 			 for(size_t i=1; i<tsize; i++){
 				 hval = (hval + h2)%tsize;
 				 if(hashtable[hval] == (size_t)-1){
@@ -82,13 +82,19 @@
 			else hash->setField(i, 0);
 		}
 
-		b_ht = new BitSequenceRG(bitmap, tsize, 20);
+		b_ht = buildRankBitmap(bitmap, tsize, 20);
 
 		delete [] bitmap;
 		delete [] hashtable;
 		delete [] enclength;
 	}
 
+	void
+	Hash::searchBatch(uchar **w, const uint *len, size_t n, size_t *pos) const
+	{
+		for(size_t i=0; i<n; i++) pos[i] = search(w[i], len[i]);
+	}
+
 	void
 	Hash::setData(uchar *data)
 	{
@@ -98,32 +104,33 @@
 	void
 	Hash::save(ofstream & fp)
 	{
-		saveValue(fp, tsize);
-		saveValue(fp, n);
+		save_hash_header(fp, function, tsize, n);
 		hash->save(fp);
 		b_ht->save(fp);
 	}
 
 	Hash *
-	Hash::load(ifstream & fp, int r)
+	Hash::load(ifstream & fp, int r, MemoryMapping *mapping)
 	{
 		switch(r) {
 			// HASHUFF and HASHRP must be the same value
 			case (HASHUFF):
-				return Hashdh::load(fp);
+				return Hashdh::load(fp, mapping);
 			// HASBHUFF and HASHVRP must be the same value
 			case (HASHBHUFF): 
 				return HashBdh::load(fp);
 			// HASBBHUFF and HASBBHRP must be the same value
 			case (HASHBBHUFF): 
 				return HashBBdh::load(fp);
+			case (HASHMPHF):
+				return HashMPHF::load(fp, mapping);
 		}
 
 		return NULL;
 	}
 
 	int
-	Hash::scmp(size_t offset, uchar *w, size_t len)
+	Hash::scmp(size_t offset, uchar *w, size_t len) const
 	{
 		size_t ini_pos =  offset;
 		for(size_t i=0; i<len; i++){
@@ -38,6 +38,7 @@ using namespace cds_utils;
 
 #include "HashUtils.h"
 #include "../utils/LogSequence.h"
+#include "../utils/RankBitmap.h"
 #include "../utils/Utils.h"
 
 
@@ -50,7 +51,19 @@ class Hash
 			 * @offset: position of the string in the compressed sequence.
 			 * @returns the position in which the string is inserted in the hash table.
 			 */
-			size_t insert(uchar *w, size_t len, size_t offset=0);
+			virtual size_t insert(uchar *w, size_t len, size_t offset=0);
+
+			/* Places the inserted strings in their final positions. It is
+			 * called once all strings have been inserted; tables which are
+			 * built from the whole set of strings (HashMPHF) are built here.
+			 */
+			virtual void arrange() {};
+
+			/* Obtains the final position of an inserted string.
+			 * @pos: the position returned by insert.
+			 * @returns the position in the hash table (after arrange).
+			 */
+			virtual size_t getPosition(size_t pos) const { return pos; };
 
 			/* Updates the offset position for the string in hash[pos]
 			 * @pos: position in which is stored the string to be updated.
@@ -61,7 +74,7 @@ class Hash
 			/* Post-processes the hash table for storing it.
 			 *  @length: length of the compressed sequence in which the keys are stored.
 			 */
-			void finish(size_t length);
+			virtual void finish(size_t length);
 
 			/* Set a pointer to the compressed sequence.
 			 * @seq: pointer the compressed sequence.
@@ -73,36 +86,46 @@ class Hash
 			 * @len: the key length.
 			 * @returns the position in which the key is stored (or -1 if it does not exist).
 			 */
-			virtual size_t search(uchar *w, size_t len)=0;
+			virtual size_t search(uchar *w, size_t len) const=0;
+
+			/* Searches a batch of keys in the hash table.
+			 * @w: the keys to be searched.
+			 * @len: the key lengths.
+			 * @n: the number of keys.
+			 * @pos: the positions in which the keys are stored (or -1 if they do not exist).
+			 */
+			virtual void searchBatch(uchar **w, const uint *len, size_t n, size_t *pos) const;
 
 			/* Abstract method which retrieves the position in which the i-th key is stored.
 			 * @i: key position in the hash table.
 			 * @returns the position in the compressed sequence.
 			 */
-			virtual size_t getValue(size_t i)=0;
+			virtual size_t getValue(size_t i) const=0;
 
 			/* Abstract method which retrieves the i-th position in the hash table.
 			 * @i: position in the hash table.
 			 * @returns the position in the compressed sequence.
 			 */
-			virtual size_t getValuePos(size_t i)=0;
+			virtual size_t getValuePos(size_t i) const=0;
 
 			/* Abstract method which obtains the hash table size.
 			 * @returns the hash table size.
 			 */
-			virtual size_t getSize()=0;
+			virtual size_t getSize() const=0;
 
 			/** Saves the hash to a file */
-			void save(ofstream & fp);
+			virtual void save(ofstream & fp);
 
-			/** Loads a hash from a file*/
-			static Hash * load(ifstream & fp, int r);
+			/** Loads a hash from a file (the table is referenced within the
+			    mapping, if it is not NULL) */
+			static Hash * load(ifstream & fp, int r, MemoryMapping *mapping=NULL);
 
 			virtual ~Hash() {};
 
 		protected:
 			size_t tsize; 		// size of the hashtable
 			size_t n; 		// number of elements into the hashtable
+			uint32_t function;	// hash function (HASHLEGACY or HASHWORD)
 
 			LogSequence *hash;	// hashtable
 			BitSequence *b_ht;	// bitsequence pointing string beginnings
@@ -113,7 +136,7 @@ class Hash
 			size_t *enclength;	// auxiliar structure storing the lengths of the encoded strings
 
 			/*compare the information in data from offset with w*/
-			virtual int scmp(size_t offset, uchar *w, size_t len);
+			virtual int scmp(size_t offset, uchar *w, size_t len) const;
 
 		friend class StringDictionaryHASHRPF;
 };
@@ -121,6 +144,7 @@ class Hash
 #include "Hashdh.h"
 #include "HashBdh.h"
 #include "HashBBdh.h"
+#include "HashMPHF.h"
 
 #endif  /* _HASHUFF_H */
 
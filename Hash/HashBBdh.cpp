@@ -30,23 +30,25 @@
 
 	HashBBdh::HashBBdh(){
 		tsize=0;
+		function=HASHLEGACY;
 		hashtable=NULL;
 		b_ht = NULL;
 		offsets = NULL;
 	}
 
-	HashBBdh::HashBBdh(uint _tsize){
-		uint i;
+	HashBBdh::HashBBdh(size_t _tsize, uint32_t _function){
+		size_t i;
 		tsize = nearest_prime(_tsize);
+		function = _function;
 		n = 0;
 		hashtable = new size_t[tsize];
 		for(i=0 ; i<tsize ; i++ )
 			hashtable[i] = (size_t)-1;
 	}
 
-	size_t HashBBdh::search(uchar *w, size_t len)
+	size_t HashBBdh::search(uchar *w, size_t len) const
 	{
-		size_t hval = bitwisehash(w, len, tsize);
+		size_t hval = hash_value(function, w, len, tsize);
 		size_t pos, off_pos;
 
 		if(!b_ht->access(hval))
@@ -59,8 +61,8 @@
 			return pos-1;
 
 		//using double hashing
-		size_t h2 = step_value(w, len, tsize);
-		for(uint i=1 ; i<tsize ; i++ ){
+		size_t h2 = hash_step(function, w, len, tsize);
+		for(size_t i=1 ; i<tsize ; i++ ){
 			hval = (hval + h2)%tsize;
 
 			if(!b_ht->access(hval))
@@ -75,20 +77,20 @@
 		return (size_t)-1;
 	}
 
-	size_t HashBBdh::getValue(size_t i)
+	size_t HashBBdh::getValue(size_t i) const
 	{
 		return offsets->select1(i);
 	}
 
 	size_t
-	HashBBdh::getValuePos(size_t i)
+	HashBBdh::getValuePos(size_t i) const
 	{
 		return offsets->select1(b_ht->rank1(i));
 	}
 			
-	size_t HashBBdh::getSize()
+	size_t HashBBdh::getSize() const
 	{
-		uint mem = sizeof(HashBBdh);
+		size_t mem = sizeof(HashBBdh);
 		mem += offsets->getSize();
 		mem += b_ht->getSize();
 		return mem;
@@ -98,20 +100,19 @@
 	{
 		HashBBdh *h_new = new HashBBdh();
 
-		h_new->tsize = loadValue<size_t>(fp);
-		h_new->n = loadValue<size_t>(fp);
+		load_hash_header(fp, &(h_new->function), &(h_new->tsize), &(h_new->n));
 		h_new->hash = new LogSequence(fp);
 		h_new->b_ht = BitSequence::load(fp);
 
-		uint last = (h_new->b_ht)->select1(h_new->n);
+		size_t last = (h_new->b_ht)->select1(h_new->n);
 		BitString *offsets = new BitString(h_new->hash->getField(last)+1);
 
 		uint ones = 0;
 
-		for (uint i=1; i<=h_new->n; i++)
+		for (size_t i=1; i<=h_new->n; i++)
 		{
 
-			uint pos = (h_new->b_ht)->select1(i);
+			size_t pos = (h_new->b_ht)->select1(i);
 			offsets->setBit(h_new->hash->getField(pos), true);
 
 			ones++;
@@ -30,15 +30,17 @@
 	HashBdh::HashBdh()
 	{
 		tsize=0;
+		function=HASHLEGACY;
 		hashtable=NULL;
 		hash = NULL;
 		b_ht = NULL;
 	}
 
-	HashBdh::HashBdh(size_t _tsize)
+	HashBdh::HashBdh(size_t _tsize, uint32_t _function)
 	{
-		uint i;
+		size_t i;
 		tsize = nearest_prime(_tsize);
+		function = _function;
 		n = 0;
 		hashtable = new size_t[tsize];
 
@@ -46,10 +48,10 @@
 			hashtable[i] = (size_t)-1;
 	}
 	
-	size_t HashBdh::search(uchar *w, size_t len)
+	size_t HashBdh::search(uchar *w, size_t len) const
 	{
-		uint hval = bitwisehash(w, len, tsize);
-		uint pos;
+		size_t hval = hash_value(function, w, len, tsize);
+		size_t pos;
 
 		if(!b_ht->access(hval))
 			return (size_t)-1;
@@ -60,7 +62,7 @@
 			return pos;
 
 		//using double hashing
-		size_t h2 = step_value(w,len, tsize);
+		size_t h2 = hash_step(function, w, len, tsize);
 
 		for(size_t i=1 ; i<tsize ; i++ ){
 			hval = (hval + h2)%tsize;
@@ -77,21 +79,21 @@
 	}
 
 	size_t
-	HashBdh::getValue(size_t i)
+	HashBdh::getValue(size_t i) const
 	{
 		return hash->getField(i-1);
 	}
 
 	size_t
-	HashBdh::getValuePos(size_t i)
+	HashBdh::getValuePos(size_t i) const
 	{
 		return hash->getField(b_ht->rank1(i)-1);
 	}
 
 
-	size_t HashBdh::getSize()
+	size_t HashBdh::getSize() const
 	{
-		uint mem = sizeof(HashBdh);
+		size_t mem = sizeof(HashBdh);
 		mem += hash->getSize();
 		mem += b_ht->getSize();
 		return mem;
@@ -101,16 +103,15 @@
 	{
 		HashBdh *h_new = new HashBdh();
 
-		h_new->tsize = loadValue<size_t>(fp);
-		h_new->n = loadValue<size_t>(fp);
+		load_hash_header(fp, &(h_new->function), &(h_new->tsize), &(h_new->n));
 		LogSequence *seq = new LogSequence(fp);
 		h_new->b_ht = BitSequence::load(fp);
 
 		h_new->hash = new LogSequence(seq->getNumbits(), h_new->n);
 
-		for (uint i=1; i<=h_new->n; i++)
+		for (size_t i=1; i<=h_new->n; i++)
 		{
-			uint pos = (h_new->b_ht)->select1(i);
+			size_t pos = (h_new->b_ht)->select1(i);
 			(h_new->hash)->setField(i-1, seq->getField(pos));
 		}
 
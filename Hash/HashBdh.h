@@ -50,32 +50,33 @@ class HashBdh: public Hash{
 
 		/* Creates a hash table of size the given size.
 		 * @tsize: the hash table size.
+		 * @function: the hash function (HASHWORD for new tables).
 		 */
-		HashBdh(size_t tsize);
+		HashBdh(size_t tsize, uint32_t function=HASHWORD);
 
 		/* Searches for a key in the hash table.
 		 * @w: the key to be searched.
 		 * @len: the key length.
 		 * @returns the position in which the key is stored (or -1 if it does not exist).
 		 */
-		size_t search(uchar *w, size_t len);
+		size_t search(uchar *w, size_t len) const;
 
 		/* Retrieves the position in which the i-th key is stored.
 		 * @i: key position in the hash table.
 		 * @returns the position in the compressed sequence.
 		 */
-		size_t getValue(size_t i);
+		size_t getValue(size_t i) const;
 
 		/* Retrieves the i-th position in the hash table.
 		 * @i: position in the hash table.
 		 * @returns the position in the compressed sequence.
 		 */
-		size_t getValuePos(size_t i);
+		size_t getValuePos(size_t i) const;
 
 		/* Obtains the hash table size.
 		 * @returns the hash table size.
 		 */
-		size_t getSize();
+		size_t getSize() const;
 
 		/** Loads a hash from a file*/
 		static HashBdh * load(ifstream & fp);
@@ -30,26 +30,28 @@
 HashDAC::HashDAC()
 {
 	tsize=0;
+	function=HASHLEGACY;
 
 	b_ht = NULL;
 	hashtable=NULL;
 }
 
-HashDAC::HashDAC(size_t tsize)
+HashDAC::HashDAC(size_t tsize, uint32_t function)
 {
 	this->tsize = nearest_prime(tsize);
+	this->function = function;
 	n = 0;
 
 	hashtable = new size_t[this->tsize];
 
-	uint i;
+	size_t i;
 	for(i=0 ; i<this->tsize ; i++) hashtable[i] = (size_t)-1;
 }
 
 size_t
 HashDAC::insert(uchar *w, size_t len, size_t offset)
 {
-	size_t hval = bitwisehash(w, len, tsize);
+	size_t hval = hash_value(function, w, len, tsize);
 
 	if(hashtable[hval] == (size_t)-1)
 	{
@@ -60,7 +62,7 @@ HashDAC::insert(uchar *w, size_t len, size_t offset)
 	else
 	{
 		 //use double hashing
-		 size_t h2 = step_value(w,len, tsize);
+		 size_t h2 = hash_step(function, w, len, tsize);
 		 for(size_t i=1; i<tsize; i++){
 			 hval = (hval + h2)%tsize;
 			 if(hashtable[hval] == (size_t)-1){
@@ -91,7 +93,7 @@ HashDAC::finish(size_t length)
 	for(size_t i=0; i<tsize; i++)
 		if(hashtable[i]!=(size_t)-1) bitset(bitmap, i);
 
-	b_ht = new BitSequenceRG(bitmap, tsize, 20);
+	b_ht = buildRankBitmap(bitmap, tsize, 20);
 
 	delete [] bitmap;
 	delete [] hashtable;
@@ -104,17 +106,41 @@ HashDAC::setData(DAC_BVLS *data)
 }
 
 size_t
-HashDAC::search(uchar *w, size_t len)
+HashDAC::search(uchar *w, size_t len) const
 {
-	uint hval = bitwisehash(w, len, tsize);
+	return search(w, len, hash_value(function, w, len, tsize));
+}
+
+void
+HashDAC::searchBatch(uchar **w, const uint *len, size_t n, size_t *pos) const
+{
+	size_t hvals[BATCHSIZE];
+
+	for(size_t i=0; i<n; i+=BATCHSIZE)
+	{
+		size_t group = min(BATCHSIZE, n-i);
 
+		for(size_t j=0; j<group; j++)
+		{
+			hvals[j] = hash_value(function, w[i+j], len[i+j], tsize);
+			b_ht->prefetch(hvals[j]);
+		}
+
+		for(size_t j=0; j<group; j++)
+			pos[i+j] = search(w[i+j], len[i+j], hvals[j]);
+	}
+}
+
+size_t
+HashDAC::search(uchar *w, size_t len, size_t hval) const
+{
 	if(!b_ht->access(hval)) return (size_t)-1;
-	uint pos = b_ht->rank1(hval)-1;
+	size_t pos = b_ht->rank1(hval)-1;
 
 	if(scmp(pos, w, len) == 0) return pos;
 
 	//using double hashing
-	size_t h2 = step_value(w,len, tsize);
+	size_t h2 = hash_step(function, w, len, tsize);
 
 	for(size_t i=1 ; i<tsize ; i++ ){
 		hval = (hval + h2)%tsize;
@@ -129,9 +155,9 @@ HashDAC::search(uchar *w, size_t len)
 }
 
 size_t
-HashDAC::getSize()
+HashDAC::getSize() const
 {
-	uint mem = sizeof(HashDAC);
+	size_t mem = sizeof(HashDAC);
 	mem += b_ht->getSize();
 	return mem;
 }
@@ -139,8 +165,7 @@ HashDAC::getSize()
 void
 HashDAC::save(ofstream & fp)
 {
-	saveValue(fp, tsize);
-	saveValue(fp, n);
+	save_hash_header(fp, function, tsize, n);
 	b_ht->save(fp);
 }
 
@@ -149,15 +174,14 @@ HashDAC::load(ifstream & fp)
 {
 	HashDAC *h_new = new HashDAC();
 
-	h_new->tsize = loadValue<size_t>(fp);
-	h_new->n = loadValue<size_t>(fp);
+	load_hash_header(fp, &(h_new->function), &(h_new->tsize), &(h_new->n));
 	h_new->b_ht = BitSequence::load(fp);
 
 	return h_new;
 }
 
 int
-HashDAC::scmp(size_t pos, uchar *w, size_t len)
+HashDAC::scmp(size_t pos, uchar *w, size_t len) const
 {
 	uint id = pos+1;
 	uint level = 0;
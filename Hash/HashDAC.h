@@ -46,6 +46,7 @@ using namespace cds_utils;
 #include "HashUtils.h"
 #include "../utils/DAC_BVLS.h"
 #include "../utils/LogSequence.h"
+#include "../utils/RankBitmap.h"
 #include "../utils/Utils.h"
 
 
@@ -57,8 +58,9 @@ class HashDAC
 
 		/* Creates a hash table of size the given size.
 		 * @param tsize: the hash table size.
+		 * @param function: the hash function (HASHWORD for new tables).
 		 */
-		HashDAC(size_t tsize);
+		HashDAC(size_t tsize, uint32_t function=HASHWORD);
 
 		/* Inserts a new string in the hash table.
 		 * @param w: the string to be inserted.
@@ -89,12 +91,22 @@ class HashDAC
 		 * @param len: the key length.
 		 * @returns the position in which the key is stored (or -1 if it does not exist).
 		 */
-		size_t search(uchar *w, size_t len);
+		size_t search(uchar *w, size_t len) const;
+
+		/* Searches a batch of keys in the hash table. The hash values
+		 * are computed in advance, so the bitmap words of the cells are
+		 * prefetched before probing them.
+		 * @param w: the keys to be searched.
+		 * @param len: the key lengths.
+		 * @param n: the number of keys.
+		 * @param pos: the positions in which the keys are stored (or -1 if they do not exist).
+		 */
+		void searchBatch(uchar **w, const uint *len, size_t n, size_t *pos) const;
 
 		/* Obtains the hash table size.
 		 * @returns the hash table size.
 		 */
-		size_t getSize();
+		size_t getSize() const;
 
 		/** Saves the hash to a file */
 		void save(ofstream & fp);
@@ -106,8 +118,17 @@ class HashDAC
 
 
 	protected:
+		/* Searches a key from its (previously computed) hash value.
+		 * @param w: the key to be searched.
+		 * @param len: the key length.
+		 * @param hval: the hash value of the key.
+		 * @returns the position in which the key is stored (or -1 if it does not exist).
+		 */
+		size_t search(uchar *w, size_t len, size_t hval) const;
+
 		size_t tsize; 		// size of the hashtable
 		size_t n; 			// number of elements into the hashtable
+		uint32_t function;	// hash function (HASHLEGACY or HASHWORD)
 
 		BitSequence *b_ht;	// bitsequence pointing string beginnings
 		DAC_BVLS *data; 	// Reference to the DAC-encoded sequence
@@ -116,7 +137,7 @@ class HashDAC
 
 
 		/*compare the information in data from offset with w*/
-		virtual int scmp(size_t pos, uchar *w, size_t len);
+		virtual int scmp(size_t pos, uchar *w, size_t len) const;
 
 	friend class StringDictionaryHASHRPDAC;
 };
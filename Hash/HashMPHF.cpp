@@ -0,0 +1,301 @@
+/* HashMPHF.cpp
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Minimal perfect hash table for compressed string dictionaries.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+
+#include "HashMPHF.h"
+
+	HashMPHF::HashMPHF()
+	{
+		tsize=0;
+		n=0;
+		function=HASHWORD;
+		hashtable=NULL;
+		enclength=NULL;
+		hash=NULL;
+		b_ht=NULL;
+
+		overhead=0;
+		seed=0;
+		levels=0;
+		levelOffset=NULL;
+		levelBits=NULL;
+		ones=0;
+		nfallback=0;
+		fallback=NULL;
+	}
+
+	HashMPHF::HashMPHF(size_t elements, uint32_t _overhead)
+	{
+		tsize = elements;
+		n = 0;
+		function = HASHWORD;
+		hash = NULL;
+		b_ht = NULL;
+		enclength = NULL;
+
+		hashtable = new size_t[tsize];
+		for(size_t i=0; i<tsize; i++) hashtable[i] = (size_t)-1;
+
+		overhead = _overhead;
+		seed = 0;
+		levels = 0;
+		levelOffset = NULL;
+		levelBits = NULL;
+		ones = 0;
+		nfallback = 0;
+		fallback = NULL;
+
+		keyOffsets.push_back(0);
+	}
+
+	size_t
+	HashMPHF::insert(uchar *w, size_t len, size_t offset)
+	{
+		keys.insert(keys.end(), w, w+len);
+		keyOffsets.push_back(keys.size());
+
+		return n++;
+	}
+
+	inline size_t
+	HashMPHF::levelHash(uint64_t h, uint32_t level, size_t size) const
+	{
+		return fast_range(avalanche(h ^ ((uint64_t)(level+1)*0x9e3779b97f4a7c15ULL)), size);
+	}
+
+	void
+	HashMPHF::arrange()
+	{
+		vector<uint64_t> base(n);
+		vector<size_t> placed(n);
+		vector<size_t> pending, next;
+		vector<uint> bitmap, occupied, collided;
+		vector<uint64_t> offsets;
+
+		uchar *buffer = keys.empty() ? NULL : &keys[0];
+
+		for (seed=0; ; seed++)
+		{
+			for (size_t i=0; i<n; i++)
+			{
+				base[i] = wordhash(buffer+keyOffsets[i], keyOffsets[i+1]-keyOffsets[i], seed);
+				placed[i] = (size_t)-1;
+			}
+
+			pending.resize(n);
+			for (size_t i=0; i<n; i++) pending[i] = i;
+
+			bitmap.clear();
+			offsets.assign(1, 0);
+
+			for (levels=0; (levels<MPHFLEVELS) && !pending.empty(); levels++)
+			{
+				// The level size is rounded to complete words
+				size_t size = (size_t)(pending.size()*(1+(overhead*1.0/100.0)));
+				size = ((size+W-1)/W)*W;
+				if (size == 0) size = W;
+
+				occupied.assign(size/W, 0);
+				collided.assign(size/W, 0);
+
+				for (size_t i=0; i<pending.size(); i++)
+				{
+					size_t pos = levelHash(base[pending[i]], levels, size);
+
+					if (bitget(&occupied[0], pos)) bitset(&collided[0], pos);
+					else bitset(&occupied[0], pos);
+				}
+
+				next.clear();
+
+				for (size_t i=0; i<pending.size(); i++)
+				{
+					size_t pos = levelHash(base[pending[i]], levels, size);
+
+					if (bitget(&collided[0], pos)) next.push_back(pending[i]);
+					else placed[pending[i]] = offsets.back()+pos;
+				}
+
+				for (size_t i=0; i<occupied.size(); i++)
+					bitmap.push_back(occupied[i] & ~collided[i]);
+
+				offsets.push_back(offsets.back()+size);
+				pending.swap(next);
+			}
+
+			// The remaining strings are identified by their hash values,
+			// which must be unique (otherwise, a new seed is used)
+			vector<pair<uint64_t, size_t> > remaining(pending.size());
+			for (size_t i=0; i<pending.size(); i++) remaining[i] = make_pair(base[pending[i]], pending[i]);
+			std::sort(remaining.begin(), remaining.end());
+
+			bool unique = true;
+			for (size_t i=1; (i<remaining.size()) && unique; i++)
+				if (remaining[i].first == remaining[i-1].first) unique = false;
+
+			if (!unique) continue;
+
+			if (bitmap.empty()) bitmap.push_back(0);
+			levelBits = buildRankBitmap(&bitmap[0], bitmap.size()*W, MPHFRANK);
+			ones = levelBits->rank1(bitmap.size()*W-1);
+
+			levelOffset = new uint64_t[levels+1];
+			for (uint32_t i=0; i<=levels; i++) levelOffset[i] = offsets[i];
+
+			nfallback = remaining.size();
+			fallback = new uint64_t[nfallback];
+
+			positions.resize(n);
+
+			for (size_t i=0; i<n; i++)
+				if (placed[i] != (size_t)-1) positions[i] = levelBits->rank1(placed[i])-1;
+
+			for (size_t i=0; i<nfallback; i++)
+			{
+				fallback[i] = remaining[i].first;
+				positions[remaining[i].second] = ones+i;
+			}
+
+			break;
+		}
+
+		// The strings are not longer required
+		vector<uchar>().swap(keys);
+		vector<size_t>().swap(keyOffsets);
+	}
+
+	size_t
+	HashMPHF::getPosition(size_t pos) const
+	{
+		return positions[pos];
+	}
+
+	void
+	HashMPHF::finish(size_t length)
+	{
+		hash = new LogSequence(bits(length), tsize);
+
+		for(size_t i=0; i<tsize; i++) hash->setField(i, hashtable[i]);
+
+		delete [] hashtable;
+		hashtable = NULL;
+		vector<size_t>().swap(positions);
+	}
+
+	size_t
+	HashMPHF::lookup(uchar *w, size_t len) const
+	{
+		uint64_t h = wordhash(w, len, seed);
+
+		for (uint32_t l=0; l<levels; l++)
+		{
+			size_t pos = levelOffset[l]+levelHash(h, l, levelOffset[l+1]-levelOffset[l]);
+			if (levelBits->access(pos)) return levelBits->rank1(pos)-1;
+		}
+
+		uint64_t *found = std::lower_bound(fallback, fallback+nfallback, h);
+		if ((found != fallback+nfallback) && (*found == h)) return ones+(found-fallback);
+
+		return (size_t)-1;
+	}
+
+	size_t
+	HashMPHF::search(uchar *w, size_t len) const
+	{
+		size_t pos = lookup(w, len);
+
+		if ((pos == (size_t)-1) || (scmp(hash->getField(pos), w, len) != 0))
+			return (size_t)-1;
+
+		return pos;
+	}
+
+	size_t
+	HashMPHF::getValue(size_t i) const
+	{
+		return hash->getField(i-1);
+	}
+
+	size_t
+	HashMPHF::getValuePos(size_t i) const
+	{
+		return hash->getField(i);
+	}
+
+	size_t
+	HashMPHF::getSize() const
+	{
+		size_t mem = sizeof(HashMPHF);
+		mem += hash->getSize();
+		mem += levelBits->getSize();
+		mem += (levels+1)*sizeof(uint64_t);
+		mem += nfallback*sizeof(uint64_t);
+		return mem;
+	}
+
+	void
+	HashMPHF::save(ofstream & fp)
+	{
+		save_hash_header(fp, function, tsize, n);
+		saveValue<uint64_t>(fp, seed);
+		saveValue<uint32_t>(fp, overhead);
+		saveValue<uint32_t>(fp, levels);
+		saveValue<uint64_t>(fp, levelOffset, levels+1);
+		saveValue<uint64_t>(fp, nfallback);
+		if (nfallback > 0) saveValue<uint64_t>(fp, fallback, nfallback);
+		levelBits->save(fp);
+		hash->save(fp);
+	}
+
+	HashMPHF *
+	HashMPHF::load(ifstream & fp, MemoryMapping *mapping)
+	{
+		HashMPHF *h_new = new HashMPHF();
+
+		load_hash_header(fp, &(h_new->function), &(h_new->tsize), &(h_new->n));
+		h_new->seed = loadValue<uint64_t>(fp);
+		h_new->overhead = loadValue<uint32_t>(fp);
+		h_new->levels = loadValue<uint32_t>(fp);
+		h_new->levelOffset = loadValue<uint64_t>(fp, h_new->levels+1);
+		h_new->nfallback = loadValue<uint64_t>(fp);
+		if (h_new->nfallback > 0) h_new->fallback = loadValue<uint64_t>(fp, h_new->nfallback);
+		h_new->levelBits = BitSequence::load(fp);
+		h_new->hash = new LogSequence(fp, mapping);
+
+		h_new->ones = h_new->levelBits->rank1(h_new->levelBits->getLength()-1);
+
+		return h_new;
+	}
+
+	HashMPHF::~HashMPHF()
+	{
+		delete hash;
+		delete levelBits;
+		delete [] levelOffset;
+		delete [] fallback;
+		delete [] hashtable;
+	}
@@ -0,0 +1,154 @@
+/* HashMPHF.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Minimal perfect hash table for compressed string dictionaries. It is
+ * built level by level, as BBHash ("Fast and scalable minimal perfect
+ * hashing for massive key sets", Limasset et al., SEA 2017): each level is
+ * a bitmap in which the strings which do not collide are placed, and the
+ * remaining ones are moved to the next level. The position of a string is
+ * the rank of its bit over all levels, so the table stores exactly one
+ * entry per string and a lookup performs a single string comparison.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#ifndef HASHMPHF_H
+#define HASHMPHF_H
+
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#include "Hash.h"
+#include <BitSequence.h>
+using namespace cds_static;
+
+/* Maximum number of levels (the remaining strings are stored apart) */
+static const uint32_t MPHFLEVELS = 32;
+/* Sampling factor for rank operations over the levels */
+static const uint32_t MPHFRANK = 8;
+
+	class HashMPHF: public Hash{
+		public:
+			/* Generic constructor. */
+			HashMPHF();
+
+			/* Creates a minimal perfect hash table for the given number
+			 * of strings.
+			 * @elements: the number of strings.
+			 * @overhead: extra bits (percentage over the number of
+			 *   strings) used in each level. 0 uses ~3 bits per string,
+			 *   and greater values reduce the number of levels.
+			 */
+			HashMPHF(size_t elements, uint32_t overhead);
+
+			/* Inserts a new string. Its position is only known after
+			 * arranging the table.
+			 * @w: the string to be inserted.
+			 * @len: the string length.
+			 * @offset: ignored (see setOffset).
+			 * @returns the insertion order of the string.
+			 */
+			size_t insert(uchar *w, size_t len, size_t offset=0);
+
+			/* Builds the minimal perfect hash function over the
+			 * inserted strings. */
+			void arrange();
+
+			/* Obtains the final position of an inserted string.
+			 * @pos: the insertion order returned by insert.
+			 * @returns the position in the hash table.
+			 */
+			size_t getPosition(size_t pos) const;
+
+			/* Post-processes the hash table for storing it.
+			 * @length: length of the compressed sequence in which the keys are stored.
+			 */
+			void finish(size_t length);
+
+			/* Obtains the candidate position for a key. The key must
+			 * be compared with the string stored in this position
+			 * because the function is only defined for the inserted
+			 * strings.
+			 * @w: the key to be searched.
+			 * @len: the key length.
+			 * @returns the candidate position (or -1 if the key is not
+			 *   in the table).
+			 */
+			size_t lookup(uchar *w, size_t len) const;
+
+			/* Searches for a key in the hash table.
+			 * @w: the key to be searched.
+			 * @len: the key length.
+			 * @returns the position in which the key is stored (or -1 if it does not exist).
+			 */
+			size_t search(uchar *w, size_t len) const;
+
+			/* Retrieves the position in which the i-th key is stored.
+			 * @i: key position in the hash table.
+			 * @returns the position in the compressed sequence.
+			 */
+			size_t getValue(size_t i) const;
+
+			/* Retrieves the i-th position in the hash table.
+			 * @i: position in the hash table.
+			 * @returns the position in the compressed sequence.
+			 */
+			size_t getValuePos(size_t i) const;
+
+			/* Obtains the hash table size.
+			 * @returns the hash table size.
+			 */
+			size_t getSize() const;
+
+			/** Saves the hash to a file */
+			void save(ofstream & fp);
+
+			/** Loads a hash from a file*/
+			static HashMPHF * load(ifstream & fp, MemoryMapping *mapping=NULL);
+
+			virtual ~HashMPHF();
+
+		protected:
+			uint32_t overhead;	// extra bits per level (percentage)
+			uint64_t seed;		// seed of the hash function
+			uint32_t levels;	// number of levels
+			uint64_t *levelOffset;	// first bit of each level (and the total length)
+			BitSequence *levelBits;	// bitmaps of all levels
+			size_t ones;		// number of strings placed in the levels
+
+			uint64_t nfallback;	// number of strings which are not placed in the levels
+			uint64_t *fallback;	// (sorted) hash values of these strings
+
+			vector<uchar> keys;		// inserted strings (only for building)
+			vector<size_t> keyOffsets;	// offset of each inserted string (only for building)
+			vector<size_t> positions;	// final position of each inserted string (only for building)
+
+			/* Position of a hash value in the given level.
+			 * @h: the hash value.
+			 * @level: the level.
+			 * @size: the level size (in bits).
+			 */
+			inline size_t levelHash(uint64_t h, uint32_t level, size_t size) const;
+	};
+
+#endif
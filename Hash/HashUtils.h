@@ -29,32 +29,48 @@
 #ifndef _HASHUTILS_H
 #define _HASHUTILS_H
 
+#include <climits>
+
+#include "../utils/Utils.h"
+
 struct SortString {
 	size_t original;	// Original string position in Tdict
 	size_t hash;		// String position in the hash table
 };
 
-/* Bitwise hash function.  Note that tsize does not have to be prime. */
-inline size_t
+/* Bitwise hash function computed on T-bit words.  Note that tsize does
+ * not have to be prime. */
+template <typename T> inline size_t
 bitwisehash(uchar *word, size_t len, size_t htsize)
 {
-	uint h = (uint)(4294967279u);
+	T h = (T)(4294967279u);
 	int c;
 	for(size_t i= 0; i<len; i++){
 		c= word[i];
-		h = (((h << 15) + h)+(uint)c)%htsize; /* h*33+c */
+		h = (((h << 15) + h)+(T)c)%htsize; /* h*33+c */
 	}
 
 	return (size_t)(h%htsize);
 }
 
-/* Function used to do double hashing (proposed by Donald E. Knuth) */
+/* Bitwise hash function.  Tables addressable with 32 bits are hashed on
+ * 32-bit words (as they were always hashed); larger ones use 64-bit words
+ * for reaching all their cells. */
 inline size_t
+bitwisehash(uchar *word, size_t len, size_t htsize)
+{
+	if (htsize <= UINT_MAX) return bitwisehash<uint>(word, len, htsize);
+	else return bitwisehash<uint64_t>(word, len, htsize);
+}
+
+/* Function used to do double hashing (proposed by Donald E. Knuth),
+ * computed on T-bit words */
+template <typename T> inline size_t
 step_value(uchar *word, size_t len, size_t htsize)
 {
-	uint h = (uint)(4294967197u);
+	T h = (T)(4294967197u);
 	for(size_t i = 0; i < len; i++){
-		h = ((h << 5) ^ (h >> 27)) ^ word[i];
+		h = ((h << 5) ^ (h >> (8*sizeof(T)-5))) ^ word[i];
 	}
 	h = h%(htsize-1);
 	if(h==0)
@@ -62,6 +78,123 @@ step_value(uchar *word, size_t len, size_t htsize)
 	return (size_t)h;
 }
 
+/* Function used to do double hashing (proposed by Donald E. Knuth) */
+inline size_t
+step_value(uchar *word, size_t len, size_t htsize)
+{
+	if (htsize <= UINT_MAX) return step_value<uint>(word, len, htsize);
+	else return step_value<uint64_t>(word, len, htsize);
+}
+
+/* Reads 8 bytes as a little-endian 64-bit word, so the hash values do
+ * not depend on the machine endianness. */
+inline uint64_t
+load_word(const uchar *word)
+{
+	uint64_t w = 0;
+	for(int i=7; i>=0; i--) w = (w << 8) | word[i];
+	return w;
+}
+
+/* Final avalanche of a 64-bit hash value (MurmurHash3 finalizer). */
+inline uint64_t
+avalanche(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+/* Maps a 64-bit hash value to [0, range) through the high word of the
+ * product h*range (Lemire's fast range), avoiding the division. */
+inline size_t
+fast_range(uint64_t h, size_t range)
+{
+#ifdef __SIZEOF_INT128__
+	return (size_t)(((unsigned __int128)h * (uint64_t)range) >> 64);
+#else
+	uint64_t r = range;
+	uint64_t lo = (h & 0xffffffffULL)*(r & 0xffffffffULL);
+	uint64_t mid1 = (h >> 32)*(r & 0xffffffffULL);
+	uint64_t mid2 = (h & 0xffffffffULL)*(r >> 32);
+	uint64_t carry = ((lo >> 32) + (mid1 & 0xffffffffULL) + (mid2 & 0xffffffffULL)) >> 32;
+	return (size_t)((h >> 32)*(r >> 32) + (mid1 >> 32) + (mid2 >> 32) + carry);
+#endif
+}
+
+/* Word-wise hash function: the key is consumed in 64-bit words which
+ * are mixed by multiplication, and the value is reduced only once. The
+ * seed allows independent functions to be obtained. */
+inline uint64_t
+wordhash(uchar *word, size_t len, uint64_t seed=0)
+{
+	uint64_t h = (0x9e3779b97f4a7c15ULL ^ seed) ^ (len * 0xbf58476d1ce4e5b9ULL);
+	size_t i = 0;
+
+	for(; i+8 <= len; i+=8){
+		h = (h ^ load_word(word+i)) * 0x94d049bb133111ebULL;
+		h ^= h >> 29;
+	}
+
+	if(i < len){
+		uint64_t w = 0;
+		for(size_t j=len; j>i; j--) w = (w << 8) | word[j-1];
+		h = (h ^ w) * 0x94d049bb133111ebULL;
+	}
+
+	return avalanche(h);
+}
+
+/* Hash value of the key for the given hash function. */
+inline size_t
+hash_value(uint32_t function, uchar *word, size_t len, size_t htsize)
+{
+	if (function == HASHLEGACY) return bitwisehash(word, len, htsize);
+	return fast_range(wordhash(word, len), htsize);
+}
+
+/* Double hashing step of the key for the given hash function. */
+inline size_t
+hash_step(uint32_t function, uchar *word, size_t len, size_t htsize)
+{
+	if (function == HASHLEGACY) return step_value(word, len, htsize);
+	return fast_range(avalanche(wordhash(word, len) ^ 0x2545f4914f6cdd1dULL), htsize-1)+1;
+}
+
+/* Saves the header of a hash table in the versioned format: the format
+ * mark and version, the hash function, the table size and the number of
+ * elements. */
+inline void
+save_hash_header(ofstream & fp, uint32_t function, size_t tsize, size_t n)
+{
+	saveValue<size_t>(fp, HASHVERSIONED);
+	saveValue<uint32_t>(fp, HASHFORMAT);
+	saveValue<uint32_t>(fp, function);
+	saveValue<size_t>(fp, tsize);
+	saveValue<size_t>(fp, n);
+}
+
+/* Loads the header of a hash table. Tables without format version start
+ * with their size, and they use the legacy hash function. */
+inline void
+load_hash_header(ifstream & fp, uint32_t *function, size_t *tsize, size_t *n)
+{
+	*tsize = loadValue<size_t>(fp);
+	*function = HASHLEGACY;
+
+	if (*tsize == HASHVERSIONED)
+	{
+		loadValue<uint32_t>(fp);	// Format version
+		*function = loadValue<uint32_t>(fp);
+		*tsize = loadValue<size_t>(fp);
+	}
+
+	*n = loadValue<size_t>(fp);
+}
+
 /*compute the first prime number higher or equal to n*/
 inline size_t
 nearest_prime(size_t n)
@@ -31,20 +31,22 @@
 	Hashdh::Hashdh()
 	{
 		tsize=0;
+		function=HASHLEGACY;
 		hashtable=NULL;
 		hash = NULL;
 		b_ht = NULL;
 	}
 
-	Hashdh::Hashdh(uint _tsize)
+	Hashdh::Hashdh(size_t _tsize, uint32_t _function)
 	{
 		tsize = nearest_prime(_tsize);
+		function = _function;
 		n = 0;
 
 		hashtable = new size_t[tsize];
 		enclength = new size_t[tsize];
 
-		uint i;
+		size_t i;
 		for(i=0 ; i<tsize ; i++)
 		{
 			hashtable[i] = (size_t)-1;
@@ -53,9 +55,37 @@
 	}
 
 	size_t
-	Hashdh::search(uchar *w, size_t len)
+	Hashdh::search(uchar *w, size_t len) const
+	{
+		return search(w, len, hash_value(function, w, len, tsize));
+	}
+
+	void
+	Hashdh::searchBatch(uchar **w, const uint *len, size_t n, size_t *pos) const
+	{
+		size_t hvals[BATCHSIZE];
+
+		for(size_t i=0; i<n; i+=BATCHSIZE)
+		{
+			size_t group = min(BATCHSIZE, n-i);
+
+			for(size_t j=0; j<group; j++)
+			{
+				hvals[j] = hash_value(function, w[i+j], len[i+j], tsize);
+				hash->prefetch(hvals[j]);
+			}
+
+			for(size_t j=0; j<group; j++)
+				PREFETCH(data+hash->getField(hvals[j]));
+
+			for(size_t j=0; j<group; j++)
+				pos[i+j] = search(w[i+j], len[i+j], hvals[j]);
+		}
+	}
+
+	size_t
+	Hashdh::search(uchar *w, size_t len, size_t hval) const
 	{
-		size_t hval = bitwisehash(w, len, tsize);
 		size_t next;
 
 		if(!b_ht->access(hval))
@@ -65,9 +95,9 @@
 			return b_ht->rank1(hval)-1;
 
 		//using double hashing
-		size_t h2 = step_value(w, len, tsize);
+		size_t h2 = hash_step(function, w, len, tsize);
 
-		for(uint i=1 ; i<tsize ; i++ ){
+		for(size_t i=1 ; i<tsize ; i++ ){
 			next = (hval + i*h2)%tsize;
 
 			if(!b_ht->access(next))
@@ -81,34 +111,33 @@
 	}
 
 	size_t
-	Hashdh::getValue(size_t i)
+	Hashdh::getValue(size_t i) const
 	{
 		return hash->getField(b_ht->select1(i));
 	}
 
 	size_t
-	Hashdh::getValuePos(size_t i)
+	Hashdh::getValuePos(size_t i) const
 	{
 		return hash->getField(i);
 	}
 
 	size_t
-	Hashdh::getSize()
+	Hashdh::getSize() const
 	{
-		uint mem = sizeof(Hashdh);
+		size_t mem = sizeof(Hashdh);
 		mem += hash->getSize();
 		mem += b_ht->getSize();
 		return mem;
 	}
 
 	Hashdh *
-	Hashdh::load(ifstream & fp)
+	Hashdh::load(ifstream & fp, MemoryMapping *mapping)
 	{
 		Hashdh *h_new = new Hashdh();
 
-		h_new->tsize = loadValue<size_t>(fp);
-		h_new->n = loadValue<size_t>(fp);
-		h_new->hash = new LogSequence(fp);
+		load_hash_header(fp, &(h_new->function), &(h_new->tsize), &(h_new->n));
+		h_new->hash = new LogSequence(fp, mapping);
 		h_new->b_ht = BitSequence::load(fp);
 
 		return h_new;
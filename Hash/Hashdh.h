@@ -50,21 +50,32 @@ using namespace cds_static;
 
 			/* Create a hash table of size the given size.
 			 * @tsize: the hash table size.
+			 * @function: the hash function (HASHWORD for new tables).
 			 */
-			Hashdh(uint tsize);
+			Hashdh(size_t tsize, uint32_t function=HASHWORD);
 
 			/* Searches for a key in the hash table.
 			 * @w: the key to be searched.
 			 * @len: the key length.
 			 * @returns the position in which the key is stored (or -1 if it does not exist).
 			 */
-			size_t search(uchar *w, size_t len);
+			size_t search(uchar *w, size_t len) const;
+
+			/* Searches a batch of keys in the hash table. The hash values
+			 * are computed in advance, so the table cells and the keys
+			 * they point to are prefetched before probing them.
+			 * @w: the keys to be searched.
+			 * @len: the key lengths.
+			 * @n: the number of keys.
+			 * @pos: the positions in which the keys are stored (or -1 if they do not exist).
+			 */
+			void searchBatch(uchar **w, const uint *len, size_t n, size_t *pos) const;
 
 			/* Retrieves the position in which the i-th key is stored.
 			 * @i: key position in the hash table.
 			 * @returns the position in the compressed sequence.
 			 */
-			size_t getValue(size_t i);
+			size_t getValue(size_t i) const;
 
 
 			/* Retrieves the i-th position in the hash table. It returns the same value that
@@ -72,19 +83,25 @@ using namespace cds_static;
 			 * @i: position in the hash table.
 			 * @returns the position in the compressed sequence.
 			 */
-			size_t getValuePos(size_t i);
+			size_t getValuePos(size_t i) const;
 
 			/* Obtains the hash table size.
 			 * @returns the hash table size.
 			 */
-			size_t getSize();
+			size_t getSize() const;
 
 			/** Loads a hash from a file*/
-			static Hashdh * load(ifstream & fp);
+			static Hashdh * load(ifstream & fp, MemoryMapping *mapping=NULL);
 
 			virtual ~Hashdh();
 
 		protected:
-
+			/* Searches a key from its (previously computed) hash value.
+			 * @w: the key to be searched.
+			 * @len: the key length.
+			 * @hval: the hash value of the key.
+			 * @returns the position in which the key is stored (or -1 if it does not exist).
+			 */
+			size_t search(uchar *w, size_t len, size_t hval) const;
 	};
 #endif
@@ -30,6 +30,8 @@
 RePair::RePair()
 {
 	this->G = NULL;
+	this->pairs = NULL;
+	this->lengths = NULL;
 	this->Cls = NULL;
 	this->Cdac = NULL;
 	this->maxchar = 0;
@@ -38,6 +40,8 @@ RePair::RePair()
 RePair::RePair(int *sequence, uint length, uchar maxchar)
 {
 	this->G = NULL;
+	this->pairs = NULL;
+	this->lengths = NULL;
 	this->Cls = NULL;
 	this->Cdac = NULL;
 	this->maxchar = maxchar;
@@ -48,7 +52,7 @@ RePair::RePair(int *sequence, uint length, uchar maxchar)
 	compressor.compress(sequence, length, (size_t*)&terminals, (size_t*)&rules, &dicc);
 
 	// Building the array for the dictionary
-	G = new LogSequence(bits(rules+terminals), 2*rules);
+	G = new LogSequence(bits(rules+terminals), 2*rules, true);
 
 	for (uint i=0; i<rules; i++)
 	{
@@ -58,60 +62,152 @@ RePair::RePair(int *sequence, uint length, uchar maxchar)
 	Dictionary::destroyDicc(dicc);
 }
 
-uint
-RePair::expandRule(uint rule, uchar* str)
+void
+RePair::unpack()
 {
-	uint pos = 0;
-	uint left = G->getField(2*rule);
-	uint right = G->getField((2*rule)+1);
+	if (pairs != NULL) return;
+
+	pairs = new uint[2*rules];
+
+	size_t chunk[RPSCRATCH];
+	for (size_t i=0; i<2*rules; i+=RPSCRATCH)
+	{
+		size_t count = (2*rules-i < RPSCRATCH) ? 2*rules-i : RPSCRATCH;
 
-	if (left >= terminals) pos += expandRule(left-terminals, str+pos);
-	else { str[pos] = (char)left; pos++; }
+		G->getRange(i, count, chunk);
+		for (size_t j=0; j<count; j++) pairs[i+j] = chunk[j];
+	}
+
+	// The symbols of a rule are always created before the rule itself
+	lengths = new uint[rules];
 
-	if (right >= terminals) pos += expandRule(right-terminals, str+pos);
-	else { str[pos] = (char)right; pos++; }
+	for (size_t i=0; i<rules; i++)
+	{
+		uint left = pairs[2*i], right = pairs[(2*i)+1];
 
-	return pos;
+		lengths[i] = (left >= terminals) ? lengths[left-terminals] : 1;
+		lengths[i] += (right >= terminals) ? lengths[right-terminals] : 1;
+	}
 }
 
-int
-RePair::expandRuleAndCompareString(uint rule, uchar *str, uint *pos)
+uint
+RePair::expandRule(uint rule, uchar* str) const
 {
-	int cmp = 0;
+	RuleStack stack;
+	uint pos = 0, symbol = rule+terminals, left, right;
 
-	uint left = G->getField(2*rule);
-	if (left >= terminals)
+	while (true)
 	{
-		cmp = expandRuleAndCompareString(left-terminals, str, pos);
-		if (cmp != 0) return cmp;
+		// Descending through the left symbols (the right ones are 
+		// stacked until the left expansion is finished)
+		while (symbol >= terminals)
+		{
+			getRule(symbol-terminals, &left, &right);
+			stack.push(right);
+			symbol = left;
+		}
+
+		str[pos] = (uchar)symbol;
+		pos++;
+
+		if (stack.empty()) return pos;
+		symbol = stack.pop();
 	}
-	else
+}
+
+int
+RePair::compareRule(uint rule, const uchar *str, uint *pos) const
+{
+	uchar expansion[RPSCRATCH];
+	uint len = expandRule(rule, expansion);
+
+	if (memcmp(expansion, str+(*pos), len) == 0)
 	{
-		if ((uchar)left != str[*pos]) return (int)((uchar)left-str[*pos]);
-		(*pos)++;
+		(*pos) += len;
+		return 0;
 	}
 
-	uint right = G->getField((2*rule)+1);
-	if (right >= terminals)
+	uint i = 0;
+	while (expansion[i] == str[(*pos)+i]) i++;
+
+	(*pos) += i;
+	return (int)(expansion[i]-str[*pos]);
+}
+
+int
+RePair::expandRuleAndCompareString(uint rule, uchar *str, uint strLen, uint *pos) const
+{
+	RuleStack stack;
+	uint symbol = rule+terminals, left, right;
+	int cmp;
+
+	while (true)
 	{
-		cmp = expandRuleAndCompareString(right-terminals, str, pos);
-		if (cmp != 0) return cmp;
+		if (symbol < terminals)
+		{
+			if ((uchar)symbol != str[*pos]) return (int)((uchar)symbol-str[*pos]);
+			(*pos)++;
+		}
+		else if (fits(symbol-terminals, *pos, strLen))
+		{
+			cmp = compareRule(symbol-terminals, str, pos);
+			if (cmp != 0) return cmp;
+		}
+		else
+		{
+			getRule(symbol-terminals, &left, &right);
+			stack.push(right);
+			symbol = left;
+			continue;
+		}
+
+		if (stack.empty()) return 0;
+		symbol = stack.pop();
 	}
-	else
+}
+
+int
+RePair::expandRuleAndCompareDelimited(uint rule, const uchar *str, uint strLen, uint *pos) const
+{
+	RuleStack stack;
+	uint symbol = rule+terminals, left, right;
+	int cmp;
+	uchar c;
+
+	while (true)
 	{
-		if ((uchar)right != str[*pos]) return (int)((uchar)right-str[*pos]);
-		(*pos)++;
-	}
+		if (symbol < terminals)
+		{
+			c = (*pos < strLen) ? str[*pos] : maxchar;
+			if ((uchar)symbol != c) return (int)((uchar)symbol-c);
+			(*pos)++;
 
-	return cmp;
+			// The delimiter has been matched
+			if (*pos > strLen) return 0;
+		}
+		else if (fits(symbol-terminals, *pos, strLen))
+		{
+			cmp = compareRule(symbol-terminals, str, pos);
+			if (cmp != 0) return cmp;
+		}
+		else
+		{
+			getRule(symbol-terminals, &left, &right);
+			stack.push(right);
+			symbol = left;
+			continue;
+		}
+
+		if (stack.empty()) return 0;
+		symbol = stack.pop();
+	}
 }
 
 int
-RePair::extractStringAndCompareRP(uint id, uchar* str, uint strLen)
+RePair::extractStringAndCompareRP(uint id, uchar* str, uint strLen) const
 {
-	str[strLen] = maxchar;
-
 	uint l = 0, pos = 0, next;
+	uchar c;
 	int cmp = 0;
 
 	while (pos <= strLen)
@@ -120,36 +216,35 @@ RePair::extractStringAndCompareRP(uint id, uchar* str, uint strLen)
 
 		if  (next >= terminals)
 		{
-			cmp = expandRuleAndCompareString(next-terminals, str, &pos);
+			cmp = expandRuleAndCompareDelimited(next-terminals, str, strLen, &pos);
 			if (cmp != 0) break;
 		}
 		else
 		{
-			if ((uchar)next != str[pos]) return (int)((uchar)next-str[pos]);
+			c = (pos < strLen) ? str[pos] : maxchar;
+			if ((uchar)next != c) return (int)((uchar)next-c);
 			pos++;
 		}
 
 		l++;
 	}
 
-	str[strLen] = 0;
-
 	return cmp;
 }
 
 int
-RePair::extractStringAndCompareDAC(uint id, uchar* str, uint strLen)
+RePair::extractStringAndCompareDAC(size_t id, uchar* str, uint strLen) const
 {
 	uint l = 0, pos = 0, next;
 	int cmp = 0;
 
-	while(id != (uint)-1)
+	while(id != (size_t)-1)
 	{
 		next = Cdac->access_next(l, &id);
 
 		if (next >= terminals)
 		{
-			cmp = expandRuleAndCompareString(next-terminals, str, &pos);
+			cmp = expandRuleAndCompareString(next-terminals, str, strLen, &pos);
 			if (cmp != 0) return cmp;
 		}
 		else
@@ -166,52 +261,53 @@ RePair::extractStringAndCompareDAC(uint id, uchar* str, uint strLen)
 }
 
 int
-RePair::expandRuleAndComparePrefixDAC(uint rule, uchar *str, uint *pos)
+RePair::expandRuleAndComparePrefixDAC(uint rule, uchar *str, uint strLen, uint *pos) const
 {
-	int cmp = 0;
+	RuleStack stack;
+	uint symbol = rule+terminals, left, right;
+	int cmp;
 
-	uint left = G->getField(2*rule);
-	if (left >= terminals)
+	while (true)
 	{
-		cmp = expandRuleAndComparePrefixDAC(left-terminals, str, pos);
-		if (cmp != 0) return cmp;
-	}
-	else
-	{
-		if ((uchar)left != str[*pos]) return (int)((uchar)left-str[*pos]);
-		(*pos)++;
-	}
+		if (symbol < terminals)
+		{
+			if ((uchar)symbol != str[*pos]) return (int)((uchar)symbol-str[*pos]);
+			(*pos)++;
+		}
+		else if (fits(symbol-terminals, *pos, strLen))
+		{
+			cmp = compareRule(symbol-terminals, str, pos);
+			if (cmp != 0) return cmp;
+		}
+		else
+		{
+			getRule(symbol-terminals, &left, &right);
+			stack.push(right);
+			symbol = left;
+			continue;
+		}
 
-	if (str[*pos] == '\0') return cmp;
+		// The whole prefix has been matched
+		if (str[*pos] == '\0') return 0;
 
-	uint right = G->getField((2*rule)+1);
-	if (right >= terminals)
-	{
-		cmp = expandRuleAndComparePrefixDAC(right-terminals, str, pos);
-		if (cmp != 0) return cmp;
-	}
-	else
-	{
-		if ((uchar)right != str[*pos]) return (int)((uchar)right-str[*pos]);
-		(*pos)++;
+		if (stack.empty()) return 0;
+		symbol = stack.pop();
 	}
-
-	return cmp;
 }
 
 int
-RePair::extractPrefixAndCompareDAC(uint id, uchar* prefix, uint prefixLen)
+RePair::extractPrefixAndCompareDAC(size_t id, uchar* prefix, uint prefixLen) const
 {
 	uint l = 0, pos = 0, next;
 	int cmp = 0;
 
-	while(id != (uint)-1)
+	while(id != (size_t)-1)
 	{
 		next = Cdac->access_next(l, &id);
 
 		if (next >= terminals)
 		{
-			cmp = expandRuleAndComparePrefixDAC(next-terminals, prefix, &pos);
+			cmp = expandRuleAndComparePrefixDAC(next-terminals, prefix, prefixLen, &pos);
 			if (cmp != 0) return cmp;
 		}
 		else
@@ -253,48 +349,54 @@ RePair::save(ofstream &out)
 }
 
 RePair*
-RePair::load(ifstream &in)
+RePair::load(ifstream &in, MemoryMapping *mapping)
 {
 	RePair *dict = new RePair();
 
 	dict->maxchar = loadValue<uchar>(in);
 	dict->terminals = loadValue<uint64_t>(in);
 	dict->rules = loadValue<uint64_t>(in);
-	dict->G = new LogSequence(in);
+	dict->G = new LogSequence(in, mapping);
 
 	uint encoding = loadValue<uint32_t>(in);
 
-	if ((encoding == HASHRPDAC) || (encoding == RPDAC)) dict->Cdac = DAC_VLS::load(in);
-	else dict->Cls = new LogSequence(in);
+	if ((encoding == HASHRPDAC) || (encoding == RPDAC)) dict->Cdac = DAC_VLS::load(in, mapping);
+	else dict->Cls = new LogSequence(in, mapping);
 
 	return dict;
 }
 
 RePair*
-RePair::loadNoSeq(ifstream &in)
+RePair::loadNoSeq(ifstream &in, MemoryMapping *mapping)
 {
 	RePair *dict = new RePair();
 
 	dict->maxchar = loadValue<uchar>(in);
 	dict->terminals = loadValue<uint64_t>(in);
 	dict->rules = loadValue<uint64_t>(in);
-	dict->G = new LogSequence(in);
+	dict->G = new LogSequence(in, mapping);
 
 	return dict;
 }
 
 
 size_t
-RePair::getSize()
+RePair::getSize() const
 {
-	if (Cdac != NULL) return G->getSize()+Cdac->getSize()+sizeof(RePair);
-	if (Cls != NULL) return G->getSize()+Cls->getSize()+sizeof(RePair);
-	return G->getSize()+sizeof(RePair);
+	size_t size = G->getSize()+sizeof(RePair);
+
+	if (Cdac != NULL) size += Cdac->getSize();
+	if (Cls != NULL) size += Cls->getSize();
+	if (pairs != NULL) size += 3*rules*sizeof(uint);
+
+	return size;
 }
 
 RePair::~RePair()
 {
 	delete G;
+	if (pairs != NULL) delete [] pairs;
+	if (lengths != NULL) delete [] lengths;
 	if (Cls != NULL) delete Cls;
 	if (Cdac != NULL) delete Cdac;
 }
@@ -30,6 +30,8 @@
 
 using namespace std;
 
+#include <string.h>
+
 #include <libcdsBasics.h>
 using namespace cds_utils;
 
@@ -39,6 +41,43 @@ using namespace cds_utils;
 #include "../utils/Utils.h"
 
 
+/** Explicit stack of the symbols pending to be expanded. It lives in the
+    frame of the expander and only allocates memory for grammars deeper
+    than RPSTACK. */
+class RuleStack
+{
+	public:
+		RuleStack() { data = local; top = 0; capacity = RPSTACK; }
+
+		inline void push(uint symbol)
+		{
+			if (top == capacity) grow();
+			data[top++] = symbol;
+		}
+
+		inline uint pop() { return data[--top]; }
+
+		inline bool empty() const { return top == 0; }
+
+		~RuleStack() { if (data != local) delete [] data; }
+
+	protected:
+		uint local[RPSTACK];	//! Local storage
+		uint *data;		//! Current storage (local or heap)
+		size_t top;		//! Number of stacked symbols
+		size_t capacity;	//! Capacity of the current storage
+
+		void grow()
+		{
+			uint *ndata = new uint[2*capacity];
+			memcpy(ndata, data, capacity*sizeof(uint));
+			if (data != local) delete [] data;
+
+			data = ndata;
+			capacity *= 2;
+		}
+};
+
 class RePair
 {
 	public:
@@ -57,10 +96,18 @@ class RePair
 		/** Returns the RePair representation size.
 		 * @returns representation size.
 		 */
-		size_t getSize();
+		size_t getSize() const;
 
 		/** Returns the number of bits required for encoding purposes */
-		uint getBits() { return bits(rules+terminals); };
+		uint getBits() const { return bits(rules+terminals); };
+
+		/** Unpacks the grammar into word-aligned pairs (8 bytes per 
+		    rule) and computes the expansion length of each rule (4 
+		    more bytes per rule). Expansions then avoid the bit 
+		    unpacking of the rules, and comparisons check whole rules
+		    at once. The unpacked grammar is not serialized.
+		*/
+		void unpack();
 
 		/** Stores the dictionary into an ofstream.
 		    @param out: the oftstream.
@@ -75,15 +122,17 @@ class RePair
 
 		/** Loads a RePair encoding from an ifstream.
 		    @param in: the ifstream.
+		    @param mapping: the memory mapping of the file (if any).
 		    @returns the loaded dictionary.
 		*/
-		static RePair *load(ifstream &in);
+		static RePair *load(ifstream &in, MemoryMapping *mapping=NULL);
 
 		/** Loads a RePair encoding (without sequence) from an ifstream.
 		    @param in: the ifstream.
+		    @param mapping: the memory mapping of the file (if any).
 		    @returns the loaded dictionary.
 		*/
-		static RePair* loadNoSeq(ifstream &in);
+		static RePair* loadNoSeq(ifstream &in, MemoryMapping *mapping=NULL);
 
 		// Generic destructor
 		~RePair();
@@ -96,13 +145,26 @@ class RePair
 		uint64_t terminals;		//! Number of terminals in the grammar G
 		uint64_t rules;			//! Number of rules in the grammar G
 		LogSequence *G;			//! RePair grammar (using 2*log(terminals+rules) bits per rule.
+		uint *pairs;			//! Unpacked grammar: word-aligned pairs (if unpacked)
+		uint *lengths;			//! Expansion length of each rule (if unpacked)
+
+		/** Obtains the symbols of the given rule.
+		    @param rule: the rule.
+		    @param left: the left symbol.
+		    @param right: the right symbol.
+		*/
+		inline void getRule(uint rule, uint *left, uint *right) const
+		{
+			if (pairs != NULL) { *left = pairs[2*rule]; *right = pairs[(2*rule)+1]; }
+			else { *left = G->getField(2*rule); *right = G->getField((2*rule)+1); }
+		}
 
 		/** Expands the required rule into str.
 		    @param rule: the rule to be extracted.
 		    @param str: the expanded string.
 		    @returns the string length.
 		*/
-		uint expandRule(uint rule, uchar *str);
+		uint expandRule(uint rule, uchar *str) const;
 
 		/** Expands the required rule and compares it with respect to
 		    the given string 'str'. Returns an integer value containing
@@ -110,11 +172,25 @@ class RePair
 		    required string.
 		    @param rule: the rule to be expanded and compared.
 		    @param str: the string to be compared.
+		    @param strLen: the string length.
+		    @param pos: pointer to the current position in the
+		      comparison.
+		    @returns the comparison result.
+		*/
+		int expandRuleAndCompareString(uint rule, uchar *str, uint strLen, uint *pos) const;
+
+		/** Similar than "expandRuleAndCompareString", but the string is
+		    compared as if it was ended by 'maxchar' (the delimiter used
+		    in the RePair sequence). The string is not modified, so
+		    concurrent comparisons can share it.
+		    @param rule: the rule to be expanded and compared.
+		    @param str: the string to be compared.
+		    @param strLen: the string length.
 		    @param pos: pointer to the current position in the
 		      comparison.
 		    @returns the comparison result.
 		*/
-		int expandRuleAndCompareString(uint rule, uchar *str, uint *pos);
+		int expandRuleAndCompareDelimited(uint rule, const uchar *str, uint strLen, uint *pos) const;
 
 		/** Extracts the id-th string comparing it with respect to the
 		    required str. Returns an integer value containing the
@@ -125,12 +201,12 @@ class RePair
 		    @param strLen: the string length.
 		    @returns the comparison result.
 		*/
-		int extractStringAndCompareRP(uint id, uchar* str, uint strLen);
+		int extractStringAndCompareRP(uint id, uchar* str, uint strLen) const;
 
 		/** Similar than "extractStringAndCompareRP", extracts the string from
 		 *  a DAC encoding.
 		 */
-		int extractStringAndCompareDAC(uint id, uchar* str, uint strLen);
+		int extractStringAndCompareDAC(size_t id, uchar* str, uint strLen) const;
 
 		/** Expands the required rule and compares it with respect to
 		    the given prefix 'prefix'. Returns an integer value containing
@@ -138,11 +214,35 @@ class RePair
 		    required string.
 		    @param rule: the rule to be expanded and compared.
 		    @param str: the prefix to be compared.
+		    @param strLen: the prefix length.
 		    @param pos: pointer to the current position in the
 		      comparison.
 		    @returns the comparison result.
 		*/
-		int expandRuleAndComparePrefixDAC(uint rule, uchar *str, uint *pos);
+		int expandRuleAndComparePrefixDAC(uint rule, uchar *str, uint strLen, uint *pos) const;
+
+		/** Compares the whole expansion of a rule (which must lie
+		    within the compared string) through its expansion length.
+		    It is only used when the grammar is unpacked.
+		    @param rule: the rule to be compared.
+		    @param str: the string to be compared.
+		    @param pos: pointer to the current position in the
+		      comparison (advanced to the first mismatch).
+		    @returns the comparison result.
+		*/
+		int compareRule(uint rule, const uchar *str, uint *pos) const;
+
+		/** Checks if a rule can be compared at once: the grammar is
+		    unpacked and the whole expansion lies within the string.
+		    @param rule: the rule.
+		    @param pos: the current position in the comparison.
+		    @param strLen: the string length.
+		    @returns if compareRule can be used.
+		*/
+		inline bool fits(uint rule, uint pos, uint strLen) const
+		{
+			return (lengths != NULL) && (lengths[rule] <= RPSCRATCH) && (pos+lengths[rule] <= strLen);
+		}
 
 
 		/** Extracts the id-th string comparing it with respect to the
@@ -154,7 +254,7 @@ class RePair
 		    @param strLen: prefix length.
 		    @returns the comparison result.
 		*/
-		int extractPrefixAndCompareDAC(uint id, uchar* prefix, uint prefixLen);
+		int extractPrefixAndCompareDAC(size_t id, uchar* prefix, uint prefixLen) const;
 
 		friend class StringDictionaryHASHRPF;
 		friend class StringDictionaryHASHRPDAC;
@@ -162,6 +262,7 @@ class RePair
 		friend class StringDictionaryRPFC;
 		friend class StringDictionaryRPHTFC;
 
+		friend class IteratorDictStringRPDAC;
 		friend class IteratorDictStringRPFC;
 		friend class IteratorDictStringRPHTFC;
 };
@@ -27,43 +27,301 @@
 
 #include "StringDictionary.h"
 
+StringDictionary::StringDictionary()
+{
+	memoryMapping = NULL;
+	headerIndex = NULL;
+	rankIndex = NULL;
+	substringIndex = NULL;
+	membershipFilter = NULL;
+}
+
 StringDictionary*
 StringDictionary::load(ifstream & fp, uint opt)
 {
+	return load(fp, opt, NULL);
+}
+
+StringDictionary*
+StringDictionary::loadMapped(const char *filename, uint opt)
+{
+	ifstream in(filename);
+	if (!in.good()) return NULL;
+
+	MemoryMapping *mapping = new MemoryMapping(filename);
+
+	if (!mapping->isMapped())
+	{
+		// Falls back to the regular (copying) loading
+		delete mapping;
+		mapping = NULL;
+	}
+
+	StringDictionary *dict = load(in, opt, mapping);
+	in.close();
+
+	if ((dict == NULL) && (mapping != NULL)) delete mapping;
+	return dict;
+}
+
+StringDictionary*
+StringDictionary::load(ifstream & fp, uint opt, MemoryMapping *mapping)
+{
+	// The dictionary can be nested within another one
+	streampos pos = fp.tellg();
 	size_t r = loadValue<uint32_t>(fp);
-	fp.seekg(0, fp.beg);
+	fp.seekg(pos, fp.beg);
 
 	switch(r)
 	{
-		case HASHHF:		return StringDictionaryHASHHF::load(fp, opt);
-		case HASHUFFDAC:	return StringDictionaryHASHUFFDAC::load(fp);
-		case HASHRPF:		return StringDictionaryHASHRPF::load(fp, opt);
-		case HASHRPDAC:		return StringDictionaryHASHRPDAC::load(fp);
+		case HASHHF:		return StringDictionaryHASHHF::load(fp, opt, mapping);
+		case HASHUFFDAC:	return StringDictionaryHASHUFFDAC::load(fp, mapping);
+		case HASHRPF:		return StringDictionaryHASHRPF::load(fp, opt, mapping);
+		case MPHFHF:		return StringDictionaryHASHHF::load(fp, HASHMPHF, mapping);
+		case MPHFRPF:		return StringDictionaryHASHRPF::load(fp, HASHMPHF, mapping);
+		case HASHRPDAC:		return StringDictionaryHASHRPDAC::load(fp, HASHUFF, mapping);
 
-		case PFC:		return StringDictionaryPFC::load(fp);
-		case RPFC:		return StringDictionaryRPFC::load(fp);
+		case PFC:		return StringDictionaryPFC::load(fp, mapping);
+		case RPFC:		return StringDictionaryRPFC::load(fp, mapping);
 
-		case HTFC:		return StringDictionaryHTFC::load(fp);
-		case HHTFC:		return StringDictionaryHHTFC::load(fp);
-		case RPHTFC:		return StringDictionaryRPHTFC::load(fp);
+		case HTFC:		return StringDictionaryHTFC::load(fp, mapping);
+		case HHTFC:		return StringDictionaryHHTFC::load(fp, mapping);
+		case RPHTFC:		return StringDictionaryRPHTFC::load(fp, mapping);
 
-		case RPDAC:		return StringDictionaryRPDAC::load(fp);
-		case FMINDEX:		return StringDictionaryFMINDEX::load(fp);
-		case DXBW:		return StringDictionaryXBW::load(fp);
+		case RPDAC:		return StringDictionaryRPDAC::load(fp, mapping);
+		case FMINDEX:		return StringDictionaryFMINDEX::load(fp, mapping);
+		case DXBW:		return StringDictionaryXBW::load(fp, mapping);
+
+		case DYNAMIC:		return StringDictionaryDynamic::load(fp, opt, mapping);
 	}
 
 	return NULL;
 }
 
+void
+StringDictionary::locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const
+{
+	for (size_t i=0; i<n; i++) out[i] = locate((uchar*)strs[i], lens[i]);
+}
+
+uint
+StringDictionary::extractInto(size_t id, uchar *buf, uint cap) const
+{
+	uint strLen = 0;
+	uchar *str = extract(id, &strLen);
+
+	if (cap > 0)
+	{
+		uint copied = (strLen < cap) ? strLen : cap-1;
+
+		if (str != NULL) memcpy(buf, str, copied);
+		buf[copied] = '\0';
+	}
+
+	if (str != NULL) delete [] str;
+	return strLen;
+}
+
+uint
+StringDictionary::extractCapacity() const
+{
+	return maxlength+1;
+}
+
+void
+StringDictionary::extractBatch(const size_t *ids, size_t n, ByteArena &arena, size_t *offsets, uint *lengths) const
+{
+	for (size_t i=0; i<n; i++)
+	{
+		uchar *buf = arena.reserve(extractCapacity());
+
+		offsets[i] = arena.getLength();
+		lengths[i] = extractInto(ids[i], buf, extractCapacity());
+		arena.advance(lengths[i]+1);
+	}
+}
+
+IteratorDictString*
+StringDictionary::extractRange(size_t left, size_t right) const
+{
+	vector<uchar*> strings;
+
+	for (size_t id=left; id<=right; id++)
+	{
+		uint strLen;
+		strings.push_back(extract(id, &strLen));
+	}
+
+	return new IteratorDictStringVector(&strings, strings.size());
+}
+
+size_t
+StringDictionary::countSubstr(uchar *str, uint strLen, bool exact) const
+{
+	IteratorDictID *it = locateSubstr(str, strLen);
+	if (it == NULL) return 0;
+
+	size_t count = 0;
+	while (it->hasNext()) { it->next(); count++; }
+	delete it;
+
+	return count;
+}
+
+IteratorDictID*
+StringDictionary::locateSubstrLimit(uchar *str, uint strLen, size_t k) const
+{
+	IteratorDictID *it = locateSubstr(str, strLen);
+	if (it == NULL) return NULL;
+
+	vector<size_t> ids;
+	while (it->hasNext() && (ids.size() < k)) ids.push_back(it->next());
+	delete it;
+
+	size_t *result = new size_t[ids.size()+1];
+	for (size_t i=0; i<ids.size(); i++) result[i] = ids[i];
+
+	return new IteratorDictIDNoContiguous(result, ids.size());
+}
+
+PrefixCursor*
+StringDictionary::locatePrefixCursor(uchar *str, uint strLen) const
+{
+	IteratorDictID *it = locatePrefix(str, strLen);
+	if (it == NULL) return NULL;
+
+	PrefixCursor *cursor = NULL;
+
+	// The sorted dictionaries report IDs (which are also ranks) in a
+	// contiguous range, and the rank index reports a range of ranks
+	IteratorDictIDContiguous *contiguous = dynamic_cast<IteratorDictIDContiguous*>(it);
+	IteratorDictIDRank *ranked = dynamic_cast<IteratorDictIDRank*>(it);
+
+	if (contiguous != NULL)
+	{
+		if (contiguous->getLeftLimit() == NORESULT) cursor = new PrefixCursor(NORESULT, NORESULT, true, type, elements);
+		else cursor = new PrefixCursor(contiguous->getLeftLimit(), contiguous->getRightLimit()+1, true, type, elements);
+	}
+	else if (ranked != NULL) cursor = new PrefixCursor(ranked->getLeftLimit(), ranked->getRightLimit(), false, type, elements);
+	else cerr << "This dictionary does not provide paginated prefix location" << endl;
+
+	delete it;
+	return cursor;
+}
+
+IteratorDictID*
+StringDictionary::locatePrefixPage(PrefixCursor *cursor, size_t limit) const
+{
+	if (!cursor->matches(type, elements))
+	{
+		cerr << "The cursor was not obtained from this dictionary" << endl;
+		return NULL;
+	}
+
+	size_t first, n = cursor->advance(limit, &first);
+
+	if (n == 0) return new IteratorDictIDContiguous(NORESULT, NORESULT);
+	if (cursor->isSorted()) return new IteratorDictIDContiguous(first, first+n-1);
+
+	size_t *ids = new size_t[n];
+	for (size_t i=0; i<n; i++) ids[i] = locateRank(first+i);
+
+	return new IteratorDictIDNoContiguous(ids, n);
+}
+
+IteratorDictID*
+StringDictionary::locatePrefixPage(uchar *str, uint strLen, size_t offset, size_t limit) const
+{
+	PrefixCursor *cursor = locatePrefixCursor(str, strLen);
+	if (cursor == NULL) return NULL;
+
+	cursor->seek(offset);
+	IteratorDictID *it = locatePrefixPage(cursor, limit);
+	delete cursor;
+
+	return it;
+}
+
+IteratorDictString*
+StringDictionary::extractPrefixPage(PrefixCursor *cursor, size_t limit) const
+{
+	if (!cursor->matches(type, elements))
+	{
+		cerr << "The cursor was not obtained from this dictionary" << endl;
+		return NULL;
+	}
+
+	size_t first, n = cursor->advance(limit, &first);
+
+	vector<uchar*> strings;
+
+	if (n > 0)
+	{
+		if (cursor->isSorted()) return extractRange(first, first+n-1);
+
+		for (size_t i=0; i<n; i++)
+		{
+			uint strLen;
+			strings.push_back(extractRank(first+i, &strLen));
+		}
+	}
+
+	return new IteratorDictStringVector(&strings, strings.size());
+}
+
+void
+StringDictionary::sortRequests(const size_t *ids, size_t n, vector<pair<size_t, size_t> > *requests)
+{
+	requests->resize(n);
+	for (size_t i=0; i<n; i++) (*requests)[i] = make_pair(ids[i], i);
+
+	sort(requests->begin(), requests->end());
+}
+
 uint
-StringDictionary::maxLength()
+StringDictionary::maxLength() const
 {
 	return maxlength;
 }
 
 size_t
-StringDictionary::numElements()
+StringDictionary::numElements() const
 {
 	return elements;
 }
 
+void
+StringDictionary::indexHeaders()
+{
+}
+
+void
+StringDictionary::indexGrammar()
+{
+}
+
+void
+StringDictionary::indexRanks()
+{
+}
+
+void
+StringDictionary::indexSubstrings()
+{
+}
+
+void
+StringDictionary::indexMembership()
+{
+}
+
+StringDictionary::~StringDictionary()
+{
+	// Derived destructors have already released their own structures
+	if (headerIndex != NULL) delete headerIndex;
+	if (rankIndex != NULL) delete rankIndex;
+	if (substringIndex != NULL) delete substringIndex;
+	if (membershipFilter != NULL) delete membershipFilter;
+	if (memoryMapping != NULL) delete memoryMapping;
+}
+
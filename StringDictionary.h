@@ -4,6 +4,10 @@
  *
  * Abstract class for implementing Compressed String Dictionaries.
  *
+ * All query operations are const and keep their working state in local
+ * buffers, so a single loaded dictionary can be shared by concurrent
+ * readers. Query strings are never modified by the dictionary.
+ *
  * This library is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
  * License as published by the Free Software Foundation; either
@@ -28,6 +32,8 @@
 #ifndef _STRINGDICTIONARY_H
 #define _STRINGDICTIONARY_H
 
+#include <vector>
+#include <algorithm>
 using namespace std;
 
 #include <libcdsBasics.h>
@@ -35,18 +41,39 @@ using namespace cds_utils;
 
 #include "iterators/IteratorDictID.h"
 #include "iterators/IteratorDictString.h"
+#include "utils/ByteArena.h"
+#include "utils/MemoryMapping.h"
+#include "utils/PrefixCursor.h"
+#include "utils/HeaderIndex.h"
+#include "utils/MembershipFilter.h"
+#include "utils/RankIndex.h"
+#include "utils/SubstringIndex.h"
 #include "utils/Utils.h"
 
 
 class StringDictionary 
 {
 	public:		
+		/** Generic constructor. */
+		StringDictionary();
+
 		/** Retrieves the ID corresponding to the given string.
 		    @param str: the string to be located.
 		    @param strLen: the string length.
 		    @returns the ID (or NORESULT if it is not in the dictionary).
 		*/
-		virtual uint locate(uchar *str, uint strLen)=0;
+		virtual size_t locate(uchar *str, uint strLen) const=0;
+
+		/** Retrieves the IDs corresponding to a batch of strings. The
+		    searches are interleaved, so the memory latency of each one
+		    overlaps with the work performed for the others.
+		    @param strs: the strings to be located.
+		    @param lens: the string lengths.
+		    @param n: the number of strings.
+		    @param out: the resulting IDs (NORESULT for those strings
+		      which are not in the dictionary).
+		*/
+		virtual void locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const;
 		
 		/** Obtains the string associated with the given ID.
 		    @param id: the ID to be extracted.
@@ -54,7 +81,38 @@ class StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		*/
-		virtual uchar* extract(size_t id, uint *strLen)=0;
+		virtual uchar* extract(size_t id, uint *strLen) const=0;
+
+		/** Obtains the string associated with the given ID into a
+		    buffer owned by the caller. As snprintf does, at most cap
+		    bytes (including the '\0' terminator) are written.
+		    @param id: the ID to be extracted.
+		    @param buf: the buffer.
+		    @param cap: the buffer capacity. Dictionaries avoid any
+		      internal allocation if it is not lower than
+		      extractCapacity().
+		    @returns the string length (0 if the ID is not in the
+		      dictionary); the string was truncated if it is not lower
+		      than cap.
+		*/
+		virtual uint extractInto(size_t id, uchar *buf, uint cap) const;
+
+		/** Obtains the buffer capacity with which extractInto decodes
+		    the strings directly on the caller buffer. It is
+		    maxLength()+1 unless the decoder needs some slack space.
+		*/
+		virtual uint extractCapacity() const;
+
+		/** Obtains the strings associated with a batch of IDs. They
+		    are appended ('\0'-terminated) to the given arena.
+		    @param ids: the IDs to be extracted.
+		    @param n: the number of IDs.
+		    @param arena: the arena in which the strings are written.
+		    @param offsets: the offset (within the arena) of each string.
+		    @param lengths: the length of each string (0 if the ID is
+		      not in the dictionary).
+		*/
+		virtual void extractBatch(const size_t *ids, size_t n, ByteArena &arena, size_t *offsets, uint *lengths) const;
 		
 		/** Locates all IDs of those elements prefixed by the given 
 		    string.
@@ -62,7 +120,7 @@ class StringDictionary
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		virtual IteratorDictID* locatePrefix(uchar *str, uint strLen)=0;
+		virtual IteratorDictID* locatePrefix(uchar *str, uint strLen) const=0;
 		
 		/** Locates all IDs of those elements containing the given 
 		    substring.
@@ -70,27 +128,49 @@ class StringDictionary
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		virtual IteratorDictID* locateSubstr(uchar *str, uint strLen)=0;
+		virtual IteratorDictID* locateSubstr(uchar *str, uint strLen) const=0;
+
+		/** Counts the elements containing the given substring. The
+		    generic implementation scans locateSubstr, but the FM-Index
+		    obtains an upper bound (the number of occurrences) without
+		    locating them.
+		    @param str: the substring to be searched.
+		    @param strLen: the substring length.
+		    @param exact: true for counting distinct elements; false 
+		      if an upper bound is enough.
+		    @returns the number of elements (or its upper bound).
+		*/
+		virtual size_t countSubstr(uchar *str, uint strLen, bool exact=true) const;
+
+		/** Locates (at most) k IDs of those elements containing the 
+		    given substring, and stops as soon as they are found. 
+		    These are not necessarily the k lowest IDs.
+		    @param str: the substring to be searched.
+		    @param strLen: the substring length.
+		    @param k: the maximum number of IDs.
+		    @returns an iterator for direct scanning of the IDs.
+		*/
+		virtual IteratorDictID* locateSubstrLimit(uchar *str, uint strLen, size_t k) const;
 		
 		/** Retrieves the ID with rank k according to its alphabetical order. 
 		    @param rank: the alphabetical ranking.
 		    @returns the ID.
 		*/
-		virtual uint locateRank(uint rank)=0;
+		virtual size_t locateRank(size_t rank) const=0;
 		
 		/** Extracts all elements prefixed by the given string.
 		    @param str: the prefix to be searched.
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		virtual IteratorDictString* extractPrefix(uchar *str, uint strLen)=0;
+		virtual IteratorDictString* extractPrefix(uchar *str, uint strLen) const=0;
 		
 		/** Extracts all elements containing by the given substring.
 		    @param str: the substring to be searched.
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		virtual IteratorDictString* extractSubstr(uchar *str, uint strLen)=0;
+		virtual IteratorDictString* extractSubstr(uchar *str, uint strLen) const=0;
 		
 		/** Obtains the string  with rank k according to its 
 		    alphabetical order.
@@ -99,29 +179,129 @@ class StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		*/
-		virtual uchar* extractRank(uint rank, uint *strLen)=0;
+		virtual uchar* extractRank(size_t rank, uint *strLen) const=0;
 		
 		/** Extracts all strings in the dictionary sorted in 
 		    alphabetical order. 
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		virtual IteratorDictString* extractTable()=0;
+		virtual IteratorDictString* extractTable() const=0;
+
+		/** Extracts the strings whose IDs are in the given range (in
+		    ID order). The generic implementation extracts them one by
+		    one, but dictionaries with contiguous representations scan
+		    them directly.
+		    @param left: the first ID.
+		    @param right: the last ID.
+		    @returns an iterator for direct scanning of the strings.
+		*/
+		virtual IteratorDictString* extractRange(size_t left, size_t right) const;
+
+		/** Searches the range of elements prefixed by the given string
+		    and returns a cursor on its first element, so the results
+		    can be retrieved by pages (locatePrefixPage and 
+		    extractPrefixPage) without searching the prefix again. It
+		    is available for the dictionaries reporting prefix results
+		    as a range of ranks: the sorted ones and the hash-based
+		    ones with a rank index.
+		    @param str: the prefix to be searched.
+		    @param strLen: the prefix length.
+		    @returns the cursor (or NULL if the dictionary does not 
+		      provide paginated prefix operations).
+		*/
+		virtual PrefixCursor* locatePrefixCursor(uchar *str, uint strLen) const;
+
+		/** Locates the IDs of the next page of elements in the cursor
+		    range (in alphabetical order) and advances the cursor.
+		    @param cursor: the cursor.
+		    @param limit: maximum number of IDs in the page.
+		    @returns an iterator for direct scanning of the IDs (or
+		      NULL if the cursor was not obtained from a dictionary
+		      with the same type and number of elements).
+		*/
+		IteratorDictID* locatePrefixPage(PrefixCursor *cursor, size_t limit) const;
+
+		/** Locates a page of IDs of those elements prefixed by the 
+		    given string (in alphabetical order).
+		    @param str: the prefix to be searched.
+		    @param strLen: the prefix length.
+		    @param offset: number of elements skipped.
+		    @param limit: maximum number of IDs in the page.
+		    @returns an iterator for direct scanning of the IDs (or 
+		      NULL if the dictionary does not provide paginated prefix
+		      operations).
+		*/
+		IteratorDictID* locatePrefixPage(uchar *str, uint strLen, size_t offset, size_t limit) const;
+
+		/** Extracts the next page of elements in the cursor range (in
+		    alphabetical order) and advances the cursor. The sorted 
+		    dictionaries decode the page with extractRange.
+		    @param cursor: the cursor.
+		    @param limit: maximum number of strings in the page.
+		    @returns an iterator for direct scanning of the strings (or
+		      NULL if the cursor was not obtained from a dictionary
+		      with the same type and number of elements).
+		*/
+		IteratorDictString* extractPrefixPage(PrefixCursor *cursor, size_t limit) const;
 		
 		/** Computes the size of the structure in bytes. 
 		    @returns the dictionary size in bytes.
 		*/
-		virtual size_t getSize()=0;
+		virtual size_t getSize() const=0;
 		
 		/** Retrieves the length of the largest string in the 
 		    dictionary.
 		    @returns the length.
 		*/
-		uint maxLength();
+		uint maxLength() const;
 
 		/** Retrieves the number of elements in the dictionary. 
 		    @returns the number of elements.
 		*/
-		size_t numElements();
+		size_t numElements() const;
+
+		/** Builds a cache-resident index over the bucket headers,
+		    so the search of the candidate bucket only compares a few
+		    headers within the strings representation. It is only 
+		    available for the Front-Coding based dictionaries (the 
+		    remaining ones ignore it) and it is not serialized.
+		*/
+		virtual void indexHeaders();
+
+		/** Unpacks the RePair grammar into word-aligned pairs and 
+		    computes the expansion length of each rule, so rules are
+		    expanded without bit unpacking and compared at once. It 
+		    takes 12 bytes per rule, it is only available for the 
+		    RePair based dictionaries (the remaining ones ignore it) 
+		    and it is not serialized.
+		*/
+		virtual void indexGrammar();
+
+		/** Builds the alphabetical permutation of the IDs, so rank 
+		    and prefix operations are also supported by dictionaries 
+		    which do not keep the strings sorted. It is only available
+		    for the hash-based dictionaries (the remaining ones ignore
+		    it) and it is serialized after the dictionary.
+		*/
+		virtual void indexRanks();
+
+		/** Builds a q-gram index over blocks of consecutive IDs, so
+		    substring operations are also supported by dictionaries 
+		    which do not provide them natively. It is only available
+		    for the Front-Coding based and the RPDAC dictionaries (the
+		    remaining ones ignore it) and it is serialized after the
+		    dictionary.
+		*/
+		virtual void indexSubstrings();
+
+		/** Builds an approximate membership filter (blocked Bloom 
+		    filter, FILTERBITS bits per string), so locate returns 
+		    NORESULT for most of the strings not in the dictionary
+		    without accessing the compressed strings. It is available
+		    for all static dictionaries (the dynamic one ignores it)
+		    and it is serialized after the dictionary.
+		*/
+		virtual void indexMembership();
 
 		/** Stores the dictionary into an ofstream.
 		    @param out: the oftstream.
@@ -135,14 +315,50 @@ class StringDictionary
 		*/
 		static StringDictionary *load(ifstream &in, uint opt);
 
+		/** Loads a dictionary from a file which is memory mapped in
+		    read-only mode. The large payload sections (string buffers,
+		    packed arrays) are referenced in place instead of being
+		    copied, and their pages are shared among processes. The
+		    format has no alignment padding: word arrays are only
+		    referenced when they happen to be aligned, and the libcds
+		    bitsequences and sequences, the XBW and the nested 
+		    dictionaries of DYNAMIC are always copied. The file must
+		    not be modified while the dictionary is in use.
+		    @param filename: the dictionary file.
+		    @param opt: some dicionaries have some different options for loading
+		    @returns the loaded dictionary.
+		*/
+		static StringDictionary *loadMapped(const char *filename, uint opt);
+
 		/** Generic destructor. */
-		virtual ~StringDictionary() {};
+		virtual ~StringDictionary();
 		
 
 	protected:
 		uint32_t type;      //! Dictionary type.
 		uint64_t elements;  //! Number of strings in the dictionary.
 		uint32_t maxlength; //! Length of the largest string in the dictionary.
+
+		MemoryMapping *memoryMapping; //! Mapping of the file the dictionary has been loaded from (if any).
+		HeaderIndex *headerIndex; //! Index over the bucket headers (if built).
+		RankIndex *rankIndex; //! Alphabetical permutation of the IDs (if built).
+		SubstringIndex *substringIndex; //! Q-gram index for substring search (if built).
+		MembershipFilter *membershipFilter; //! Approximate membership filter for locate (if built).
+
+		/** Loads a dictionary from an ifstream.
+		    @param in: the ifstream.
+		    @param opt: some dicionaries have some different options for loading
+		    @param mapping: the memory mapping of the file (or NULL).
+		    @returns the loaded dictionary.
+		*/
+		static StringDictionary *load(ifstream &in, uint opt, MemoryMapping *mapping);
+
+		/** Sorts a batch of IDs, keeping their original positions.
+		    @param ids: the IDs.
+		    @param n: the number of IDs.
+		    @param requests: the sorted (ID, position) pairs.
+		*/
+		static void sortRequests(const size_t *ids, size_t n, vector<pair<size_t, size_t> > *requests);
 };
 
 #include "StringDictionaryHASHHF.h"
@@ -160,5 +376,7 @@ class StringDictionary
 #include "StringDictionaryFMINDEX.h"
 #include "StringDictionaryXBW.h"
 
+#include "StringDictionaryDynamic.h"
+
 #endif  
 
@@ -0,0 +1,769 @@
+/* StringDictionaryDynamic.cpp
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * This class extends any (static) Compressed String Dictionary with a delta
+ * layer supporting insertions, in the spirit of Log-Structured Merge trees:
+ * 
+ *   ==========================================================================
+ *     "The Log-Structured Merge-Tree (LSM-Tree)"
+ *     Patrick O'Neil, Edward Cheng, Dieter Gawlick, and Elizabeth O'Neil.
+ *     Acta Informatica 33(4):351-385, 1996.
+ *   ==========================================================================
+ *
+ * The base dictionary is never modified. New strings are assigned the IDs
+ * following numElements() and are kept in a sorted in-memory buffer. When
+ * the buffer reaches a given size, it is frozen and a background thread 
+ * compresses it into a new (PFC) segment. Consecutive segments are merged 
+ * when they have similar sizes, so the number of segments is logarithmic in
+ * the number of insertions. Each segment maps its local (sorted) IDs to the
+ * global ones, so IDs never change once they are assigned.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#include "StringDictionaryDynamic.h"
+
+StringDictionaryDynamic::StringDictionaryDynamic()
+{
+	this->type = DYNAMIC;
+	this->elements = 0;
+	this->maxlength = 0;
+
+	this->base = NULL;
+	this->baseElements = 0;
+	this->threshold = DYNAMICBUFFER;
+	this->bucketsize = DYNAMICBUCKET;
+
+	initDelta();
+}
+
+StringDictionaryDynamic::StringDictionaryDynamic(StringDictionary *base, size_t threshold, uint bucketsize)
+{
+	this->type = DYNAMIC;
+	this->elements = base->numElements();
+	this->maxlength = base->maxLength();
+
+	this->base = base;
+	this->baseElements = base->numElements();
+	this->threshold = (threshold > 0) ? threshold : 1;
+
+	if (bucketsize < 2)
+	{
+		cerr << "[WARNING] The bucketsize value must be greater than 1. ";
+		cerr << "The segments are built using buckets of size 2" << endl;
+		this->bucketsize = 2;
+	}
+	else this->bucketsize = bucketsize;
+
+	initDelta();
+}
+
+size_t
+StringDictionaryDynamic::insert(uchar *str, uint strLen)
+{
+	// Strings in the base dictionary keep their IDs
+	size_t id = base->locate(str, strLen);
+	if (id != NORESULT) return id;
+
+	bool sequential = false;
+	pthread_rwlock_wrlock(&lock);
+
+	id = locateDelta(str, strLen);
+
+	if (id == NORESULT)
+	{
+		// The string is assigned the next available ID
+		id = ++elements;
+		if (strLen >= maxlength) maxlength = strLen+1;
+
+		map<string, size_t>::iterator it = active->strings.insert(make_pair(string((char*)str, strLen), id)).first;
+		active->ids.push_back(&(it->first));
+
+		if ((active->ids.size() >= threshold) && !merging) sequential = !startMerge();
+	}
+
+	pthread_rwlock_unlock(&lock);
+
+	if (sequential)
+	{
+		// The merge is performed by the current thread
+		mergeFrozen();
+
+		pthread_rwlock_wrlock(&lock);
+		merging = false;
+		pthread_rwlock_unlock(&lock);
+	}
+
+	return id;
+}
+
+void
+StringDictionaryDynamic::sync()
+{
+	// Concurrent calls are serialized, so the worker is joined once
+	pthread_mutex_lock(&syncLock);
+
+	pthread_rwlock_rdlock(&lock);
+	size_t last = elements;
+	pthread_rwlock_unlock(&lock);
+
+	while (true)
+	{
+		pthread_rwlock_wrlock(&lock);
+
+		if (started)
+		{
+			// The worker is joined out of the lock, because it takes
+			// it for publishing the segments
+			pthread_t running = worker;
+			started = false;
+			pthread_rwlock_unlock(&lock);
+
+			pthread_join(running, NULL);
+		}
+		else if (merging)
+		{
+			// An insertion is merging the frozen buffer by itself
+			pthread_rwlock_unlock(&lock);
+			sched_yield();
+		}
+		else if ((active->ids.size() > 0) && (active->first <= last))
+		{
+			// The merge is claimed, so insertions do not start another
+			// one until it is published
+			freezeActive();
+			merging = true;
+			pthread_rwlock_unlock(&lock);
+
+			mergeFrozen();
+
+			pthread_rwlock_wrlock(&lock);
+			merging = false;
+			pthread_rwlock_unlock(&lock);
+		}
+		else
+		{
+			// Strings inserted after the call are left buffered
+			pthread_rwlock_unlock(&lock);
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&syncLock);
+}
+
+size_t
+StringDictionaryDynamic::numSegments() const
+{
+	pthread_rwlock_rdlock(&lock);
+	size_t n = segments.size();
+	pthread_rwlock_unlock(&lock);
+
+	return n;
+}
+
+size_t
+StringDictionaryDynamic::locate(uchar *str, uint strLen) const
+{
+	size_t id = base->locate(str, strLen);
+
+	if (id == NORESULT)
+	{
+		pthread_rwlock_rdlock(&lock);
+		id = locateDelta(str, strLen);
+		pthread_rwlock_unlock(&lock);
+	}
+
+	return id;
+}
+
+uchar *
+StringDictionaryDynamic::extract(size_t id, uint *strLen) const
+{
+	if (id <= baseElements) return base->extract(id, strLen);
+
+	pthread_rwlock_rdlock(&lock);
+	uchar *str = extractDelta(id, strLen);
+	pthread_rwlock_unlock(&lock);
+
+	return str;
+}
+
+IteratorDictID*
+StringDictionaryDynamic::locatePrefix(uchar *str, uint strLen) const
+{
+	IteratorDictID *it = base->locatePrefix(str, strLen);
+	if (it == NULL) return NULL;
+
+	vector<size_t> ids;
+	pthread_rwlock_rdlock(&lock);
+
+	for (size_t i=0; i<segments.size(); i++)
+	{
+		IteratorDictID *local = segments[i]->dict->locatePrefix(str, strLen);
+		while (local->hasNext()) ids.push_back(segments[i]->globals->getField(local->next()-1));
+		delete local;
+	}
+
+	string prefix((char*)str, strLen);
+	DeltaBuffer *buffers[2] = {frozen, active};
+
+	for (uint i=0; i<2; i++)
+	{
+		if (buffers[i] == NULL) continue;
+
+		map<string, size_t>::const_iterator s = buffers[i]->strings.lower_bound(prefix);
+
+		for (; (s != buffers[i]->strings.end()) && (s->first.compare(0, strLen, prefix) == 0); s++)
+			ids.push_back(s->second);
+	}
+
+	pthread_rwlock_unlock(&lock);
+
+	// The base results are directly returned if no inserted string is
+	// prefixed by the given one
+	if (ids.size() == 0) return it;
+
+	while (it->hasNext()) ids.push_back(it->next());
+	delete it;
+
+	sort(ids.begin(), ids.end());
+	size_t *results = new size_t[ids.size()];
+	for (size_t i=0; i<ids.size(); i++) results[i] = ids[i];
+
+	return new IteratorDictIDNoContiguous(results, ids.size());
+}
+
+IteratorDictID*
+StringDictionaryDynamic::locateSubstr(uchar *str, uint strLen) const
+{
+	IteratorDictID *it = base->locateSubstr(str, strLen);
+	if (it == NULL) return NULL;
+
+	vector<size_t> ids;
+	while (it->hasNext()) ids.push_back(it->next());
+	delete it;
+
+	pthread_rwlock_rdlock(&lock);
+
+	// The inserted strings are sequentially scanned
+	for (size_t id=baseElements+1; id<=elements; id++)
+	{
+		uint len;
+		uchar *s = extractDelta(id, &len);
+
+		if (s != NULL)
+		{
+			if (memmem(s, len, str, strLen) != NULL) ids.push_back(id);
+			delete [] s;
+		}
+	}
+
+	pthread_rwlock_unlock(&lock);
+
+	size_t *results = new size_t[ids.size()];
+	for (size_t i=0; i<ids.size(); i++) results[i] = ids[i];
+
+	return new IteratorDictIDNoContiguous(results, ids.size());
+}
+
+size_t
+StringDictionaryDynamic::locateRank(size_t rank) const
+{
+	// Only the base strings are ranked
+	if ((rank == 0) || (rank > baseElements)) return NORESULT;
+
+	return base->locateRank(rank);
+}
+
+IteratorDictString*
+StringDictionaryDynamic::extractPrefix(uchar *str, uint strLen) const
+{
+	IteratorDictID *it = locatePrefix(str, strLen);
+	if (it == NULL) return NULL;
+
+	vector<uchar*> strings;
+
+	while (it->hasNext())
+	{
+		uint len;
+		uchar *s = extract(it->next(), &len);
+		if (s != NULL) strings.push_back(s);
+	}
+
+	delete it;
+	return new IteratorDictStringVector(&strings, strings.size());
+}
+
+IteratorDictString*
+StringDictionaryDynamic::extractSubstr(uchar *str, uint strLen) const
+{
+	IteratorDictID *it = locateSubstr(str, strLen);
+	if (it == NULL) return NULL;
+
+	vector<uchar*> strings;
+
+	while (it->hasNext())
+	{
+		uint len;
+		uchar *s = extract(it->next(), &len);
+		if (s != NULL) strings.push_back(s);
+	}
+
+	delete it;
+	return new IteratorDictStringVector(&strings, strings.size());
+}
+
+uchar *
+StringDictionaryDynamic::extractRank(size_t rank, uint *strLen) const
+{
+	// Only the base strings are ranked
+	if ((rank == 0) || (rank > baseElements)) { *strLen = 0; return NULL; }
+
+	return base->extractRank(rank, strLen);
+}
+
+IteratorDictString*
+StringDictionaryDynamic::extractTable() const
+{
+	vector<uchar*> table;
+	IteratorDictString *it = base->extractTable();
+
+	if (it != NULL)
+	{
+		uint len;
+		while (it->hasNext()) table.push_back(it->next(&len));
+		delete it;
+	}
+
+	pthread_rwlock_rdlock(&lock);
+
+	for (size_t id=baseElements+1; id<=elements; id++)
+	{
+		uint len;
+		uchar *s = extractDelta(id, &len);
+		if (s != NULL) table.push_back(s);
+	}
+
+	pthread_rwlock_unlock(&lock);
+
+	return new IteratorDictStringVector(&table, table.size());
+}
+
+void
+StringDictionaryDynamic::indexHeaders()
+{
+	base->indexHeaders();
+}
+
+void
+StringDictionaryDynamic::indexGrammar()
+{
+	base->indexGrammar();
+}
+
+void
+StringDictionaryDynamic::indexRanks()
+{
+	base->indexRanks();
+}
+
+void
+StringDictionaryDynamic::indexSubstrings()
+{
+	base->indexSubstrings();
+}
+
+size_t 
+StringDictionaryDynamic::getSize() const
+{
+	size_t size = base->getSize()+sizeof(StringDictionaryDynamic);
+
+	pthread_rwlock_rdlock(&lock);
+
+	for (size_t i=0; i<segments.size(); i++)
+		size += sizeof(DeltaSegment)+segments[i]->dict->getSize()+segments[i]->globals->getSize()+segments[i]->locals->getSize();
+
+	DeltaBuffer *buffers[2] = {frozen, active};
+
+	for (uint i=0; i<2; i++)
+	{
+		if (buffers[i] == NULL) continue;
+
+		size += sizeof(DeltaBuffer)+buffers[i]->ids.size()*(sizeof(pair<string, size_t>)+sizeof(const string*));
+		for (size_t j=0; j<buffers[i]->ids.size(); j++) size += buffers[i]->ids[j]->size()+1;
+	}
+
+	pthread_rwlock_unlock(&lock);
+
+	return size;
+}
+
+void 
+StringDictionaryDynamic::save(ofstream &out)
+{
+	// The buffered insertions are compressed before saving
+	sync();
+
+	// Header (HEADERSIZE bytes)
+	saveValue<uint32_t>(out, type);
+	saveValue<uint64_t>(out, elements);
+	saveValue<uint32_t>(out, maxlength);
+	saveValue<uint64_t>(out, threshold);
+	saveValue<uint32_t>(out, bucketsize);
+
+	base->save(out);
+
+	saveValue<uint64_t>(out, segments.size());
+
+	for (size_t i=0; i<segments.size(); i++)
+	{
+		saveValue<uint64_t>(out, segments[i]->first);
+		segments[i]->dict->save(out);
+		segments[i]->globals->save(out);
+	}
+}
+
+StringDictionary*
+StringDictionaryDynamic::load(ifstream &in, uint opt, MemoryMapping *mapping)
+{
+	size_t type = loadValue<uint32_t>(in);
+	if(type != DYNAMIC) return NULL;
+
+	StringDictionaryDynamic *dict = new StringDictionaryDynamic();
+	dict->memoryMapping = mapping;
+
+	dict->elements = loadValue<uint64_t>(in);
+	dict->maxlength = loadValue<uint32_t>(in);
+	dict->threshold = loadValue<uint64_t>(in);
+	dict->bucketsize = loadValue<uint32_t>(in);
+
+	// The nested dictionaries cannot share the mapping (each one 
+	// releases its own), so they are copied into memory
+	dict->base = StringDictionary::load(in, opt, NULL);
+	if (dict->base == NULL) { delete dict; return NULL; }
+	dict->baseElements = dict->base->numElements();
+
+	size_t nsegments = loadValue<uint64_t>(in);
+
+	for (size_t i=0; i<nsegments; i++)
+	{
+		DeltaSegment *seg = new DeltaSegment;
+
+		seg->first = loadValue<uint64_t>(in);
+		seg->dict = StringDictionaryPFC::load(in, NULL);
+		seg->count = seg->dict->numElements();
+		seg->globals = new LogSequence(in);
+
+		// The local IDs are recomputed from the global ones
+		vector<size_t> globals(seg->count), locals(seg->count);
+		if (seg->count > 0) seg->globals->getRange(0, seg->count, &globals[0]);
+		for (size_t j=0; j<seg->count; j++) locals[globals[j]-seg->first] = j+1;
+		seg->locals = new LogSequence(&locals, bits(seg->count));
+
+		dict->segments.push_back(seg);
+	}
+
+	dict->active->first = dict->elements+1;
+
+	return dict;
+}
+
+StringDictionaryDynamic::~StringDictionaryDynamic()
+{
+	if (started) pthread_join(worker, NULL);
+
+	if (base != NULL) delete base;
+	for (size_t i=0; i<segments.size(); i++) deleteSegment(segments[i]);
+
+	delete active;
+	if (frozen != NULL) delete frozen;
+
+	pthread_rwlock_destroy(&lock);
+	pthread_mutex_destroy(&syncLock);
+}
+
+void
+StringDictionaryDynamic::initDelta()
+{
+	active = new DeltaBuffer;
+	active->first = elements+1;
+	frozen = NULL;
+
+	merging = false;
+	started = false;
+	pthread_rwlock_init(&lock, NULL);
+	pthread_mutex_init(&syncLock, NULL);
+}
+
+size_t
+StringDictionaryDynamic::locateDelta(uchar *str, uint strLen) const
+{
+	for (size_t i=0; i<segments.size(); i++)
+	{
+		size_t local = segments[i]->dict->locate(str, strLen);
+		if (local != NORESULT) return segments[i]->globals->getField(local-1);
+	}
+
+	string key((char*)str, strLen);
+	DeltaBuffer *buffers[2] = {frozen, active};
+
+	for (uint i=0; i<2; i++)
+	{
+		if (buffers[i] == NULL) continue;
+
+		map<string, size_t>::const_iterator s = buffers[i]->strings.find(key);
+		if (s != buffers[i]->strings.end()) return s->second;
+	}
+
+	return NORESULT;
+}
+
+uchar *
+StringDictionaryDynamic::extractDelta(size_t id, uint *strLen) const
+{
+	DeltaSegment *seg = findSegment(id);
+	if (seg != NULL) return seg->dict->extract(seg->locals->getField(id-seg->first), strLen);
+
+	DeltaBuffer *buffers[2] = {frozen, active};
+
+	for (uint i=0; i<2; i++)
+	{
+		if ((buffers[i] == NULL) || (id < buffers[i]->first)) continue;
+
+		if ((id-buffers[i]->first) < buffers[i]->ids.size())
+		{
+			const string *s = buffers[i]->ids[id-buffers[i]->first];
+
+			*strLen = s->size();
+			uchar *str = new uchar[*strLen+1];
+			memcpy(str, s->c_str(), *strLen+1);
+
+			return str;
+		}
+	}
+
+	*strLen = 0;
+	return NULL;
+}
+
+void
+StringDictionaryDynamic::freezeActive()
+{
+	frozen = active;
+
+	active = new DeltaBuffer;
+	active->first = elements+1;
+}
+
+bool
+StringDictionaryDynamic::startMerge()
+{
+	// The previous worker has already finished
+	if (started) { pthread_join(worker, NULL); started = false; }
+
+	freezeActive();
+	merging = true;
+
+	if (pthread_create(&worker, NULL, mergeWorker, this) != 0) return false;
+
+	started = true;
+	return true;
+}
+
+void
+StringDictionaryDynamic::mergeFrozen()
+{
+	// The frozen buffer (and the segments) are only modified by the
+	// merging thread, so they are read without locking
+	vector<const uchar*> strs;
+	vector<size_t> ids;
+
+	for (map<string, size_t>::const_iterator s = frozen->strings.begin(); s != frozen->strings.end(); s++)
+	{
+		strs.push_back((const uchar*)s->first.c_str());
+		ids.push_back(s->second);
+	}
+
+	vector<DeltaSegment*> merged(segments);
+	merged.push_back(buildSegment(strs, ids));
+
+	// Merging the newest segments while they have similar sizes (so
+	// there are O(log n) segments) or there are too many segments
+	vector<DeltaSegment*> retired;
+
+	while (merged.size() >= 2)
+	{
+		DeltaSegment *older = merged[merged.size()-2];
+		DeltaSegment *newer = merged[merged.size()-1];
+
+		if ((older->count > DYNAMICFACTOR*newer->count) && (merged.size() <= DYNAMICSEGMENTS)) break;
+
+		merged.pop_back(); merged.pop_back();
+		merged.push_back(mergeSegments(older, newer));
+
+		// Published segments are released after the new ones are
+		DeltaSegment *parts[2] = {older, newer};
+
+		for (uint i=0; i<2; i++)
+		{
+			if (find(segments.begin(), segments.end(), parts[i]) != segments.end()) retired.push_back(parts[i]);
+			else deleteSegment(parts[i]);
+		}
+	}
+
+	// Publishing the new generation
+	pthread_rwlock_wrlock(&lock);
+
+	DeltaBuffer *released = frozen;
+	segments = merged;
+	frozen = NULL;
+
+	pthread_rwlock_unlock(&lock);
+
+	delete released;
+	for (size_t i=0; i<retired.size(); i++) deleteSegment(retired[i]);
+}
+
+DeltaSegment *
+StringDictionaryDynamic::buildSegment(vector<const uchar*> &strs, vector<size_t> &ids)
+{
+	DeltaSegment *seg = new DeltaSegment;
+	seg->count = strs.size();
+	seg->first = *min_element(ids.begin(), ids.end());
+
+	size_t bytes = 0;
+	for (size_t i=0; i<strs.size(); i++) bytes += strlen((char*)strs[i])+1;
+
+	uchar *text = new uchar[bytes+1];
+	bytes = 0;
+
+	for (size_t i=0; i<strs.size(); i++)
+	{
+		size_t len = strlen((char*)strs[i])+1;
+		memcpy(text+bytes, strs[i], len);
+		bytes += len;
+	}
+
+	text[bytes] = '\0';
+
+	// The iterator (and the text) are released by the constructor
+	seg->dict = new StringDictionaryPFC(new IteratorDictStringPlain(text, bytes), bucketsize);
+
+	vector<size_t> locals(seg->count);
+	for (size_t i=0; i<seg->count; i++) locals[ids[i]-seg->first] = i+1;
+
+	seg->globals = new LogSequence(&ids, bits(seg->first+seg->count-1));
+	seg->locals = new LogSequence(&locals, bits(seg->count));
+
+	return seg;
+}
+
+DeltaSegment *
+StringDictionaryDynamic::mergeSegments(DeltaSegment *older, DeltaSegment *newer)
+{
+	IteratorDictString *itO = older->dict->extractTable();
+	IteratorDictString *itN = newer->dict->extractTable();
+
+	vector<const uchar*> strs;
+	vector<size_t> ids;
+
+	size_t localO = 0, localN = 0;
+	uint len;
+
+	uchar *strO = itO->hasNext() ? itO->next(&len) : NULL;
+	uchar *strN = itN->hasNext() ? itN->next(&len) : NULL;
+
+	// Both segments are sorted and disjoint
+	while ((strO != NULL) || (strN != NULL))
+	{
+		if ((strN == NULL) || ((strO != NULL) && (strcmp((char*)strO, (char*)strN) < 0)))
+		{
+			strs.push_back(strO);
+			ids.push_back(older->globals->getField(localO++));
+			strO = itO->hasNext() ? itO->next(&len) : NULL;
+		}
+		else
+		{
+			strs.push_back(strN);
+			ids.push_back(newer->globals->getField(localN++));
+			strN = itN->hasNext() ? itN->next(&len) : NULL;
+		}
+	}
+
+	delete itO; delete itN;
+
+	DeltaSegment *seg = buildSegment(strs, ids);
+	for (size_t i=0; i<strs.size(); i++) delete [] strs[i];
+
+	return seg;
+}
+
+DeltaSegment *
+StringDictionaryDynamic::findSegment(size_t id) const
+{
+	for (size_t i=0; i<segments.size(); i++)
+	{
+		if ((id >= segments[i]->first) && ((id-segments[i]->first) < segments[i]->count))
+			return segments[i];
+	}
+
+	return NULL;
+}
+
+void
+StringDictionaryDynamic::deleteSegment(DeltaSegment *seg)
+{
+	delete seg->dict;
+	delete seg->globals;
+	delete seg->locals;
+	delete seg;
+}
+
+void *
+StringDictionaryDynamic::mergeWorker(void *arg)
+{
+	StringDictionaryDynamic *dict = (StringDictionaryDynamic*)arg;
+
+	while (true)
+	{
+		dict->mergeFrozen();
+
+		pthread_rwlock_wrlock(&dict->lock);
+
+		if (dict->active->ids.size() >= dict->threshold)
+		{
+			// The buffer has been filled again meanwhile
+			dict->freezeActive();
+			pthread_rwlock_unlock(&dict->lock);
+		}
+		else
+		{
+			dict->merging = false;
+			pthread_rwlock_unlock(&dict->lock);
+			break;
+		}
+	}
+
+	return NULL;
+}
+
@@ -0,0 +1,318 @@
+/* StringDictionaryDynamic.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * This class extends any (static) Compressed String Dictionary with a delta
+ * layer supporting insertions, in the spirit of Log-Structured Merge trees:
+ * 
+ *   ==========================================================================
+ *     "The Log-Structured Merge-Tree (LSM-Tree)"
+ *     Patrick O'Neil, Edward Cheng, Dieter Gawlick, and Elizabeth O'Neil.
+ *     Acta Informatica 33(4):351-385, 1996.
+ *   ==========================================================================
+ *
+ * The base dictionary is never modified. New strings are assigned the IDs
+ * following numElements() and are kept in a sorted in-memory buffer. When
+ * the buffer reaches a given size, it is frozen and a background thread 
+ * compresses it into a new (PFC) segment. Consecutive segments are merged 
+ * when they have similar sizes, so the number of segments is logarithmic in
+ * the number of insertions. Each segment maps its local (sorted) IDs to the
+ * global ones, so IDs never change once they are assigned.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#ifndef _STRINGDICTIONARY_DYNAMIC_H
+#define _STRINGDICTIONARY_DYNAMIC_H
+
+#include <iostream>
+#include <map>
+#include <string>
+using namespace std;
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "StringDictionary.h"
+#include "utils/LogSequence.h"
+
+/** Buffer of inserted strings which have not been compressed yet. */
+struct DeltaBuffer
+{
+	size_t first;			//! ID of the first buffered string
+	map<string, size_t> strings;	//! Buffered strings (sorted) and their IDs
+	vector<const string*> ids;	//! Buffered strings by ID
+};
+
+/** Compressed segment of inserted strings, covering a contiguous range of
+    IDs. */
+struct DeltaSegment
+{
+	size_t first;			//! ID of the first string in the segment
+	size_t count;			//! Number of strings in the segment
+	StringDictionary *dict;		//! PFC representation of the strings
+	LogSequence *globals;		//! ID of each local (sorted) ID
+	LogSequence *locals;		//! Local ID of each ID (from first)
+};
+
+class StringDictionaryDynamic : public StringDictionary 
+{
+	public:
+		/** Bytes of the header (type, elements, maxlength, threshold
+		    and bucketsize) written before the base dictionary. */
+		static const uint32_t HEADERSIZE = 28;
+
+		/** Generic Constructor. */
+		StringDictionaryDynamic();
+
+		/** Class Constructor.
+		    @param base: the static dictionary (which is owned, and 
+		      released, by the dynamic one).
+		    @param threshold: number of buffered insertions triggering
+		      a background merge.
+		    @param bucketsize: bucket size of the (PFC) delta segments.
+		*/
+		StringDictionaryDynamic(StringDictionary *base, size_t threshold=DYNAMICBUFFER, uint bucketsize=DYNAMICBUCKET);
+
+		/** Inserts a string in the dictionary. It can be concurrently
+		    called with any query.
+		    @param str: the string to be inserted.
+		    @param strLen: the string length.
+		    @returns the ID of the string (the existing one if it was
+		      already in the dictionary).
+		*/
+		size_t insert(uchar *str, uint strLen);
+
+		/** Waits for the background merge (if any) and compresses the
+		    strings inserted before the call. It can be concurrently
+		    called with insert (and with itself).
+		*/
+		void sync();
+
+		/** Retrieves the number of compressed delta segments (at 
+		    most DYNAMICSEGMENTS).
+		    @returns the number of segments.
+		*/
+		size_t numSegments() const;
+
+		/** Retrieves the ID corresponding to the given string.
+		    @param str: the string to be searched.
+		    @param strLen: the string length.
+		    @returns the ID (or NORESULT if it is not in the bucket).
+		*/
+		size_t locate(uchar *str, uint strLen) const;
+		
+		/** Obtains the string associated with the given ID.
+		    @param id: the ID to be extracted.
+		    @param strLen: pointer to the extracted string length.
+		    @returns the requested string (or NULL if it is not in the
+		      dictionary).
+		 */
+		uchar* extract(size_t id, uint *strLen) const;
+
+		/** Locates all IDs of those elements prefixed by the given 
+		    string. It requires prefix location in the base dictionary.
+		    @param str: the prefix to be searched.
+		    @param strLen: the prefix length.
+		    @returns an iterator for direct scanning of all the IDs.
+		*/
+		IteratorDictID* locatePrefix(uchar *str, uint strLen) const;
+
+		/** Locates all IDs of those elements containing the given 
+		    substring. It requires substring location in the base 
+		    dictionary (the delta strings are sequentially scanned).
+		    @param str: the substring to be searched.
+		    @param strLen: the substring length.
+		    @returns an iterator for direct scanning of all the IDs.
+		*/
+		IteratorDictID* locateSubstr(uchar *str, uint strLen) const;
+
+		/** Retrieves the ID with the rank k according to its 
+		    alphabetical ordering in the base dictionary. Inserted 
+		    strings are never merged into the base (its IDs are the
+		    alphabetical ranks, so they would change) and they are not
+		    ranked.
+		    @param rank: the alphabetical ranking.
+		    @returns the ID (or NORESULT if the rank is not in the 
+		      base dictionary).
+		*/
+		size_t locateRank(size_t rank) const;
+
+		/** Extracts all elements prefixed by the given string.
+		    @param str: the prefix to be searched.
+		    @param strLen: the prefix length.
+		    @returns an iterator for direct scanning of all the strings.
+		*/
+		IteratorDictString* extractPrefix(uchar *str, uint strLen) const;
+
+		/** Extracts all elements containing by the given substring.
+		    @param str: the substring to be searched.
+		    @param strLen: the substring length.
+		    @returns an iterator for direct scanning of all the strings.
+		*/
+		IteratorDictString* extractSubstr(uchar *str, uint strLen) const;
+
+		/** Obtains the string with the rank k according to its 
+		    alphabetical ordering in the base dictionary (inserted 
+		    strings are not ranked, as in locateRank).
+		    @param id: the ID to be extracted.
+		    @param strLen: pointer to the extracted string length.
+		    @returns the requested string (or NULL if the rank is not
+		      in the base dictionary).
+		 */
+		uchar* extractRank(size_t rank, uint *strLen) const;
+
+		/** Extracts all strings in the dictionary: those in the base
+		    dictionary followed by the inserted ones (by ID).
+		    @returns an iterator for direct scanning of all the strings.
+		*/
+		IteratorDictString* extractTable() const;
+
+		/** Builds the bucket header index of the base dictionary (if
+		    it is supported).
+		*/
+		void indexHeaders();
+
+		/** Unpacks the grammar of the base dictionary (if it is 
+		    supported).
+		*/
+		void indexGrammar();
+
+		/** Builds the rank index of the base dictionary (if it is 
+		    supported).
+		*/
+		void indexRanks();
+
+		/** Builds the substring index of the base dictionary (if it is
+		    supported).
+		*/
+		void indexSubstrings();
+
+		/** Computes the size of the structure in bytes. 
+		    @returns the dictionary size in bytes.
+		*/
+		size_t getSize() const;
+
+		/** Stores the dictionary into an ofstream. The buffered 
+		    insertions are previously compressed, so it must not be
+		    called concurrently with insert.
+		    @param out: the oftstream.
+		*/
+		void save(ofstream &out);
+
+		/** Loads a dictionary from an ifstream. The nested dictionaries
+		    are always copied into memory.
+		    @param in: the ifstream.
+		    @param opt: loading option for the base dictionary.
+		    @param mapping: the memory mapping of the file (or NULL).
+		    @returns the loaded dictionary.
+		*/
+		static StringDictionary *load(ifstream &in, uint opt, MemoryMapping *mapping);
+
+		/** Generic destructor. */
+		~StringDictionaryDynamic();
+
+	protected:
+		StringDictionary *base;		//! Static (base) dictionary
+		size_t baseElements;		//! Number of strings in the base dictionary
+		uint64_t threshold;		//! Number of buffered insertions triggering a merge
+		uint32_t bucketsize;		//! Bucket size of the delta segments
+
+		vector<DeltaSegment*> segments;	//! Compressed delta segments (by ID)
+		DeltaBuffer *active;		//! Buffer receiving the insertions
+		DeltaBuffer *frozen;		//! Buffer being merged (or NULL)
+
+		mutable pthread_rwlock_t lock;	//! Lock protecting the delta layer
+		pthread_mutex_t syncLock;	//! Lock serializing the calls to sync
+		pthread_t worker;		//! Background merging thread
+		bool merging;			//! A background merge is running
+		bool started;			//! The worker has to be joined
+
+		/** Initializes the (empty) delta layer. */
+		void initDelta();
+
+		/** Retrieves the ID of the given string in the delta layer. 
+		    The lock must be held by the caller.
+		    @param str: the string to be searched.
+		    @param strLen: the string length.
+		    @returns the ID (or NORESULT).
+		*/
+		size_t locateDelta(uchar *str, uint strLen) const;
+
+		/** Freezes the active buffer, which is replaced by an empty 
+		    one. The write lock must be held by the caller.
+		*/
+		void freezeActive();
+
+		/** Freezes the active buffer and launches the background 
+		    merge. The write lock must be held by the caller.
+		    @returns false if the thread cannot be created (the 
+		      frozen buffer must be merged by the caller).
+		*/
+		bool startMerge();
+
+		/** Compresses the frozen buffer into a new segment, merges
+		    the segments with similar sizes, and publishes the result.
+		*/
+		void mergeFrozen();
+
+		/** Builds a segment from a sorted set of strings.
+		    @param strs: the strings (sorted).
+		    @param ids: the ID of each string.
+		    @returns the segment.
+		*/
+		DeltaSegment *buildSegment(vector<const uchar*> &strs, vector<size_t> &ids);
+
+		/** Merges two consecutive segments.
+		    @param older: the segment with the lower IDs.
+		    @param newer: the segment with the higher IDs.
+		    @returns the merged segment.
+		*/
+		DeltaSegment *mergeSegments(DeltaSegment *older, DeltaSegment *newer);
+
+		/** Obtains the string associated with the given ID in the 
+		    delta layer. The lock must be held by the caller.
+		    @param id: the ID to be extracted.
+		    @param strLen: pointer to the extracted string length.
+		    @returns the requested string (or NULL).
+		*/
+		uchar* extractDelta(size_t id, uint *strLen) const;
+
+		/** Finds the segment containing the given ID. The lock must
+		    be held by the caller.
+		    @param id: the ID.
+		    @returns the segment (or NULL).
+		*/
+		DeltaSegment *findSegment(size_t id) const;
+
+		/** Releases a segment.
+		    @param seg: the segment.
+		*/
+		static void deleteSegment(DeltaSegment *seg);
+
+		/** Entry point of the background merging thread.
+		    @param arg: the dynamic dictionary.
+		*/
+		static void *mergeWorker(void *arg);
+};
+
+#endif  /* _STRINGDICTIONARY_DYNAMIC_H */
+
@@ -39,7 +39,7 @@ StringDictionaryFMINDEX::StringDictionaryFMINDEX()
 }
 
 StringDictionaryFMINDEX::StringDictionaryFMINDEX(
-		IteratorDictString *it, bool sparse_bitsequence, int bparam, size_t BWTsampling)
+		IteratorDictString *it, bool sparse_bitsequence, int bparam, size_t BWTsampling, uint sorting, uint sequence)
 {
 	this->type = FMINDEX;
 	this->elements = 0;
@@ -53,7 +53,7 @@ StringDictionaryFMINDEX::StringDictionaryFMINDEX(
 	if(BWTsampling > 0)
 	{
 		bitmap = new uint[(len+1+W)/W];
-		for(uint i=0; i<(len+1+W)/W; i++)
+		for(size_t i=0; i<(len+1+W)/W; i++)
 			bitmap[i]=0;
 		bitset(bitmap, 0);
 	}
@@ -100,16 +100,18 @@ StringDictionaryFMINDEX::StringDictionaryFMINDEX(
 	}
 	else separators = NULL;
 
-	build_ssa((uchar *)text, len, sparse_bitsequence, bparam);
+	build_ssa((uchar *)text, len, sparse_bitsequence, bparam, sorting, sequence);
 
 	delete [] text;
 }
 
-uint
-StringDictionaryFMINDEX::locate(uchar *str, uint strLen)
+size_t
+StringDictionaryFMINDEX::locate(uchar *str, uint strLen) const
 {
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
+
 	uchar *n_s = new uchar[strLen+2];
-	uint o;
+	size_t o;
 	n_s[0] = '\1';
 	for(size_t i=1; i<=strLen; i++) n_s[i] = str[i-1];
 	n_s[strLen+1] = '\1';
@@ -122,7 +124,7 @@ StringDictionaryFMINDEX::locate(uchar *str, uint strLen)
 }
 
 uchar*
-StringDictionaryFMINDEX::extract(size_t id, uint *strLen)
+StringDictionaryFMINDEX::extract(size_t id, uint *strLen) const
 {
 	if ((id > 0) && (id <= elements))
 	{
@@ -140,15 +142,37 @@ StringDictionaryFMINDEX::extract(size_t id, uint *strLen)
 	}
 }
 
+uint
+StringDictionaryFMINDEX::extractInto(size_t id, uchar *buf, uint cap) const
+{
+	// The BWT is traversed directly on the buffer
+	if (cap <= maxlength) return StringDictionary::extractInto(id, buf, cap);
+
+	if ((id > 0) && (id <= elements))
+	{
+		size_t i;
+
+		if (id == elements) i=2;
+		else i=id+3;
+
+		return fm_index->extract_id(i, buf, maxlength);
+	}
+	else
+	{
+		buf[0] = (uchar)'\0';
+		return 0;
+	}
+}
+
 IteratorDictID*
-StringDictionaryFMINDEX::locatePrefix(uchar *str, uint strLen)
+StringDictionaryFMINDEX::locatePrefix(uchar *str, uint strLen) const
 {
 	uchar *prefix = new uchar[strLen+2];
 	prefix[0] = '\1';
 	strncpy((char*)&(prefix[1]), (char*)str, strLen+1);
 
 	size_t left, right;
-	uint num_occ = fm_index->locateP(prefix, (uint)(strLen+1), &left, &right, elements);
+	size_t num_occ = fm_index->locateP(prefix, (uint)(strLen+1), &left, &right, elements);
 	delete [] prefix;
 
 	if (num_occ > 0) return new IteratorDictIDContiguous(left, right);
@@ -156,14 +180,14 @@ StringDictionaryFMINDEX::locatePrefix(uchar *str, uint strLen)
 }
 
 IteratorDictID*
-StringDictionaryFMINDEX::locateSubstr(uchar *str, uint strLen)
+StringDictionaryFMINDEX::locateSubstr(uchar *str, uint strLen) const
 {
 	if(BWTsampling == 0){
 		cout << "This dictionary configuration does not provide substring location" << endl;
 		return NULL;
 	}
 
-	size_t* occs; uint num_occ;
+	size_t* occs, num_occ;
 	num_occ = fm_index->locate(str, (uint)strLen, &occs);
 
 	if (num_occ > 0)
@@ -176,21 +200,80 @@ StringDictionaryFMINDEX::locateSubstr(uchar *str, uint strLen)
 	else return new IteratorDictIDContiguous(NORESULT, NORESULT);
 }
 
-uint
-StringDictionaryFMINDEX::locateRank(uint rank)
+size_t
+StringDictionaryFMINDEX::countSubstr(uchar *str, uint strLen, bool exact) const
+{
+	size_t sp, ep;
+	size_t num_occ = fm_index->count(str, (uint)strLen, &sp, &ep);
+
+	if (!exact || (num_occ == 0)) return num_occ;
+
+	if(BWTsampling == 0){
+		cout << "This dictionary configuration does not provide exact substring counting" << endl;
+		return 0;
+	}
+
+	uint *marked = new uint[uint_len(elements+1, 1)];
+	for (size_t i=0; i<uint_len(elements+1, 1); i++) marked[i] = 0;
+
+	size_t count = 0;
+
+	for (size_t i=sp; i<=ep; i++)
+	{
+		size_t id = fm_index->locate_row(i);
+
+		if (!bitget(marked, id))
+		{
+			bitset(marked, id);
+			count++;
+		}
+	}
+
+	delete [] marked;
+	return count;
+}
+
+IteratorDictID*
+StringDictionaryFMINDEX::locateSubstrLimit(uchar *str, uint strLen, size_t k) const
+{
+	if(BWTsampling == 0){
+		cout << "This dictionary configuration does not provide substring location" << endl;
+		return NULL;
+	}
+
+	size_t sp, ep;
+	size_t num_occ = fm_index->count(str, (uint)strLen, &sp, &ep);
+
+	set<size_t> found;
+	if (num_occ > 0)
+		for (size_t i=sp; (i<=ep) && (found.size() < k); i++) found.insert(fm_index->locate_row(i));
+
+	if (found.size() > 0)
+	{
+		size_t *ids = new size_t[found.size()+1], num = 0;
+		for (set<size_t>::iterator it=found.begin(); it!=found.end(); it++) ids[num++] = *it;
+		ids[num] = 0;
+
+		return new IteratorDictIDNoContiguous(ids, num);
+	}
+	else return new IteratorDictIDContiguous(NORESULT, NORESULT);
+}
+
+size_t
+StringDictionaryFMINDEX::locateRank(size_t rank) const
 {
 	return rank;
 }
 
 IteratorDictString*
-StringDictionaryFMINDEX::extractPrefix(uchar *str, uint strLen)
+StringDictionaryFMINDEX::extractPrefix(uchar *str, uint strLen) const
 {
 	uchar *prefix = new uchar[strLen+2];
 	prefix[0] = '\1';
 	strncpy((char*)&(prefix[1]), (char*)str, strLen+1);
 
 	size_t left, right;
-	uint num_occ = fm_index->locateP(prefix, (uint)(strLen+1), &left, &right, elements);
+	size_t num_occ = fm_index->locateP(prefix, (uint)(strLen+1), &left, &right, elements);
 	delete [] prefix;
 
 	if (num_occ > 0) return new IteratorDictStringFMINDEX(fm_index, left, right-left+1, elements, maxlength);
@@ -198,7 +281,7 @@ StringDictionaryFMINDEX::extractPrefix(uchar *str, uint strLen)
 }
 
 IteratorDictString*
-StringDictionaryFMINDEX::extractSubstr(uchar *str, uint strLen)
+StringDictionaryFMINDEX::extractSubstr(uchar *str, uint strLen) const
 {
 	if(BWTsampling == 0)
 	{
@@ -206,7 +289,7 @@ StringDictionaryFMINDEX::extractSubstr(uchar *str, uint strLen)
 		return NULL;
 	}
 
-	size_t* occs; uint num_occ;
+	size_t* occs, num_occ;
 	num_occ = fm_index->locate(str, (uint)strLen, &occs);
 
 	if (num_occ > 0)
@@ -220,21 +303,28 @@ StringDictionaryFMINDEX::extractSubstr(uchar *str, uint strLen)
 }
 
 uchar*
-StringDictionaryFMINDEX::extractRank(uint rank, uint *strLen)
+StringDictionaryFMINDEX::extractRank(size_t rank, uint *strLen) const
 {
 	return extract(rank, strLen);
 }
 
 IteratorDictString*
-StringDictionaryFMINDEX::extractTable()
+StringDictionaryFMINDEX::extractTable() const
 {
 	return new IteratorDictStringFMINDEX(fm_index, 1, elements+1, elements, maxlength);
 }
 
+void
+StringDictionaryFMINDEX::indexMembership()
+{
+	if (membershipFilter == NULL) membershipFilter = new MembershipFilter(this);
+}
+
 size_t
-StringDictionaryFMINDEX::getSize()
+StringDictionaryFMINDEX::getSize() const
 {
 	size_t size = fm_index->size()+sizeof(StringDictionaryFMINDEX);
+	if (membershipFilter != NULL) size += membershipFilter->getSize();
 	return size;
 }
 
@@ -245,38 +335,44 @@ StringDictionaryFMINDEX::save(ofstream &out)
 	saveValue<uint64_t>(out, elements);
 	saveValue<uint32_t>(out, maxlength);
 	fm_index->save(out);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 StringDictionary *
-StringDictionaryFMINDEX::load(ifstream &in)
+StringDictionaryFMINDEX::load(ifstream &in, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 	if(type != FMINDEX) return NULL;
 
 	StringDictionaryFMINDEX *dict = new StringDictionaryFMINDEX();
+	dict->memoryMapping = mapping;
 
 	dict->type = FMINDEX;
 	dict->elements = loadValue<uint64_t>(in);
 	dict->maxlength = loadValue<uint32_t>(in);
-	dict->fm_index = SSA::load(in);
+	dict->fm_index = SSA::load(in, mapping);
 	dict->BWTsampling = dict->fm_index->samplesuff;
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
 
 	return dict;
 }
 
 void
-StringDictionaryFMINDEX::build_ssa(uchar *text, size_t len, bool sparse_bitsequence, int bparam)
+StringDictionaryFMINDEX::build_ssa(uchar *text, size_t len, bool sparse_bitsequence, int bparam, uint sorting, uint sequence)
 {
-	fm_index = new SSA((uchar *)text,len, false, BWTsampling);
+	fm_index = new SSA((uchar *)text,len, false, BWTsampling, sorting);
 	Mapper * am = new MapperNone();
-	wt_coder * wc = new wt_coder_huff((uchar *)text,len,am);
 
 	BitSequenceBuilder * sbb;
 	if(sparse_bitsequence) sbb = new BitSequenceBuilderRRR(bparam);
-	else sbb = new BitSequenceBuilderRG(bparam);
+	else sbb = rankBitmapBuilder(bparam);
 	fm_index->set_static_bitsequence_builder(sbb);
 
-	SequenceBuilder * ssb = new SequenceBuilderWaveletTree(sbb, am, wc);
+	SequenceBuilder * ssb;
+	if (sequence == WMATRIX) ssb = new SequenceBuilderWaveletMatrix(sbb, am);
+	else ssb = new SequenceBuilderWaveletTree(sbb, am, new wt_coder_huff((uchar *)text,len,am));
 	fm_index->set_static_sequence_builder(ssb);
 	fm_index->build_index();
 
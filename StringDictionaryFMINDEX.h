@@ -40,6 +40,7 @@
 #define _STRINGDICTIONARYFMINDEX_H_
 
 #include <iostream>
+#include <set>
 using namespace std;
 
 #include <libcdsBasics.h>
@@ -63,19 +64,22 @@ class StringDictionaryFMINDEX : public StringDictionary
 		/** Class Constructor.
 	    	@param it: iterator scanning the original set of strings.
 	    	@sparse_bitsequence: tell which rank/select implementation will be
-	    	 use into the FMIndex (false->BitSequenceRG and true->BitSequenceRRR)
+	    	 use into the FMIndex (false->BitSequenceRG, or BitSequenceCL when
+	    	 compiled with CACHELINE_RANK, and true->BitSequenceRRR)
 	    	@bparam: bparam can be (2,3,4,20,40) is BitSequenceRG is chosen.
 	    	 Otherwise it is the sample rate of BitSequenceRRR.
 	    	@bwt_sample: sample range that will used for the bwt (0 for no sampling)
+	    	@sorting: suffix sorting algorithm (SAIS or SAQSUFSORT)
+	    	@sequence: representation of the BWT (WTREE or WMATRIX)
 		 */
-		StringDictionaryFMINDEX(IteratorDictString *it, bool sparse_bitsequence, int bparam, size_t bwt_sample);
+		StringDictionaryFMINDEX(IteratorDictString *it, bool sparse_bitsequence, int bparam, size_t bwt_sample, uint sorting=SAIS, uint sequence=WTREE);
 
 		/** Retrieves the ID corresponding to the given string.
 	    	@param str: the string to be searched.
 	    	@param strLen: the string length.
 	    	@returns the ID (or NORESULT if it is not in the bucket).
 		 */
-		uint locate(uchar *str, uint strLen);
+		size_t locate(uchar *str, uint strLen) const;
 
 		/** Obtains the string associated with the given ID.
 	    	@param id: the ID to be extracted.
@@ -83,7 +87,18 @@ class StringDictionaryFMINDEX : public StringDictionary
 	   	 	@returns the requested string (or NULL if it is not in the
 	      	 dictionary).
 		 */
-		uchar* extract(size_t id, uint *strLen);
+		uchar* extract(size_t id, uint *strLen) const;
+
+		/** Obtains the string associated with the given ID into a
+		    buffer owned by the caller. The string is directly decoded
+		    on the buffer if its capacity is greater than maxLength().
+		    @param id: the ID to be extracted.
+		    @param buf: the buffer.
+		    @param cap: the buffer capacity.
+		    @returns the string length (0 if the ID is not in the
+		      dictionary).
+		*/
+		uint extractInto(size_t id, uchar *buf, uint cap) const;
 
 		/** Locates all IDs of those elements prefixed by the given
 	    	string.
@@ -91,7 +106,7 @@ class StringDictionaryFMINDEX : public StringDictionary
 	    	@param strLen: the prefix length.
 	    	@returns an iterator for direct scanning of all the IDs.
 		 */
-		IteratorDictID* locatePrefix(uchar *str, uint strLen);
+		IteratorDictID* locatePrefix(uchar *str, uint strLen) const;
 
 		/** Locates all IDs of those elements containing the given
 	    	substring.
@@ -99,27 +114,50 @@ class StringDictionaryFMINDEX : public StringDictionary
 	    	@param strLen: the substring length.
 	    	@returns an iterator for direct scanning of all the IDs.
 		 */
-		IteratorDictID* locateSubstr(uchar *str, uint strLen);
+		IteratorDictID* locateSubstr(uchar *str, uint strLen) const;
+
+		/** Counts the elements containing the given substring. The 
+		    upper bound is the size of the backward search range (so
+		    it does not require BWT sampling), whereas the exact count
+		    locates the occurrences one by one and marks their IDs 
+		    in a bitmap.
+		    @param str: the substring to be searched.
+		    @param strLen: the substring length.
+		    @param exact: true for counting distinct elements; false 
+		      if an upper bound is enough.
+		    @returns the number of elements (or its upper bound).
+		*/
+		size_t countSubstr(uchar *str, uint strLen, bool exact=true) const;
+
+		/** Locates (at most) k IDs of those elements containing the 
+		    given substring. The occurrences are located one by one
+		    until k distinct IDs are found.
+		    @param str: the substring to be searched.
+		    @param strLen: the substring length.
+		    @param k: the maximum number of IDs.
+		    @returns an iterator for direct scanning of the IDs.
+		*/
+		IteratorDictID* locateSubstrLimit(uchar *str, uint strLen, size_t k) const;
 
 		/** Retrieves the ID with rank k according to its alphabetical order.
 	    	@param rank: the alphabetical ranking.
 	    	@returns the ID.
 		 */
-		uint locateRank(uint rank);
+		size_t locateRank(size_t rank) const;
 
 		/** Extracts all elements prefixed by the given string.
 	    	@param str: the prefix to be searched.
 	    	@param strLen: the prefix length.
 	    	@returns an iterator for direct scanning of all the strings.
 		 */
-		IteratorDictString* extractPrefix(uchar *str, uint strLen);
+		IteratorDictString* extractPrefix(uchar *str, uint strLen) const;
 
 		/** Extracts all elements containing by the given substring.
 	    	@param str: the substring to be searched.
 	    	@param strLen: the substring length.
 	    	@returns an iterator for direct scanning of all the strings.
 		 */
-		IteratorDictString* extractSubstr(uchar *str, uint strLen);
+		IteratorDictString* extractSubstr(uchar *str, uint strLen) const;
 
 		/** Obtains the string  with rank k according to its
 	    	alphabetical order.
@@ -128,18 +166,23 @@ class StringDictionaryFMINDEX : public StringDictionary
 	    	@returns the requested string (or NULL if it is not in the
 	      	  dictionary).
 		*/
-		uchar* extractRank(uint rank, uint *strLen);
+		uchar* extractRank(size_t rank, uint *strLen) const;
 
 		/** Extracts all strings in the dictionary sorted in
 	    	alphabetical order.
 	    	@returns an iterator for direct scanning of all the strings.
 		 */
-		IteratorDictString* extractTable();
+		IteratorDictString* extractTable() const;
+
+		/** Builds the approximate membership filter, so locate
+		    discards most of the strings not in the dictionary.
+		*/
+		void indexMembership();
 
 		/** Computes the size of the structure in bytes.
 	    	@returns the dictionary size in bytes.
 		 */
-		size_t getSize();
+		size_t getSize() const;
 
 		/** Stores the dictionary into an ofstream.
 	    	@param out: the oftstream.
@@ -148,9 +191,11 @@ class StringDictionaryFMINDEX : public StringDictionary
 
 		/** Loads a dictionary from an ifstream.
 	    	@param in: the ifstream.
+	    	@param mapping: the memory mapping of the file (if any). The
+	    	  dictionary takes its ownership.
 	    	@returns the loaded dictionary.
 		*/
-		static StringDictionary *load(ifstream &in);
+		static StringDictionary *load(ifstream &in, MemoryMapping *mapping=NULL);
 
 		/** Generic destructor. */
 		~StringDictionaryFMINDEX();
@@ -161,7 +206,7 @@ class StringDictionaryFMINDEX : public StringDictionary
 		BitSequence *separators;
 		uint BWTsampling;			//! BWT sampling (0 if no sampling)
 
-		void build_ssa(uchar *text, size_t len, bool sparse_bitsequence, int bparam);
+		void build_ssa(uchar *text, size_t len, bool sparse_bitsequence, int bparam, uint sorting, uint sequence);
 };
 
 #endif /* STRINGDICTIONARYFMINDEX_H_ */
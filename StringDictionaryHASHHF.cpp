@@ -35,9 +35,9 @@ StringDictionaryHASHHF::StringDictionaryHASHHF()
 	this->maxcomplength = 0;
 }
 
-StringDictionaryHASHHF::StringDictionaryHASHHF(IteratorDictString *it, uint len, int overhead)
+StringDictionaryHASHHF::StringDictionaryHASHHF(IteratorDictString *it, size_t len, int overhead, uint technique, uint tablebits)
 {
-	this->type = HASHHF;
+	this->type = (technique == HASHMPHF) ? MPHFHF : HASHHF;
 	this->elements = 0;
 	this->maxlength = 0;
 	this->maxcomplength = 0;
@@ -59,17 +59,23 @@ StringDictionaryHASHHF::StringDictionaryHASHHF(IteratorDictString *it, uint len,
 	Huffman	*huff = new Huffman(text, len);
 
 	// Initializing the hash table
-	uint hash_size = (uint)(elements*(1+(overhead*1.0/100.0)));
-	hash = new Hashdh(hash_size);
+	if (technique == HASHMPHF) hash = new HashMPHF(elements, overhead);
+	else
+	{
+		size_t hash_size = (size_t)(elements*(1+(overhead*1.0/100.0)));
+		hash = new Hashdh(hash_size);
+	}
 
 	// Initializing the builder for the decoding table and the coder for
 	// Huffman compression
-	DecodingTableBuilder *builder = new DecodingTableBuilder();
+	DecodingTableBuilder *builder = new DecodingTableBuilder(255, tablebits);
 	builder->initializeFromHuffman(huff);
 	delete huff;
 	codewords = builder->getCodewords();
 	coder = new StatCoder(codewords);
 
+	uint k = builder->getK();
+
 	// Auxiliar variables
 	size_t ptr = 0; uint offset = 0, bytes = 0;
 	uchar *tmp = new uchar[6*maxlength];
@@ -80,7 +86,7 @@ StringDictionaryHASHHF::StringDictionaryHASHHF(IteratorDictString *it, uint len,
 	// Simulating the hash representation
 	vector<SortString> sorting(elements);
 
-	for (uint current=1; current<=elements; current++)
+	for (size_t current=1; current<=elements; current++)
 	{
 		// Resetting variables for the next string
 		bytes = 0; tmp[bytes] = 0; offset = 0;
@@ -108,6 +114,10 @@ StringDictionaryHASHHF::StringDictionaryHASHHF(IteratorDictString *it, uint len,
 		}
 	}
 
+	// Placing the strings in their final positions
+	hash->arrange();
+	for (size_t i=0; i<elements; i++) sorting[i].hash = hash->getPosition(sorting[i].hash);
+
 	// Sorting Tdict into Tdict*
 	std::sort(sorting.begin(), sorting.end(), sortTdict);
 
@@ -116,7 +126,7 @@ StringDictionaryHASHHF::StringDictionaryHASHHF(IteratorDictString *it, uint len,
 	textStrings = new uchar[reservedStrings];
 	bytesStrings = 0; textStrings[bytesStrings] = 0;
 
-	for (uint current=1; current<=elements; current++)
+	for (size_t current=1; current<=elements; current++)
 	{
 		// Checking the available space in textStrings and
 		// realloc if required
@@ -168,31 +178,31 @@ StringDictionaryHASHHF::StringDictionaryHASHHF(IteratorDictString *it, uint len,
 				ptrSubstr += (8-offset); offset = 0;
 			}
 
-			if (ptrSubstr > TABLEBITSO)
+			if (ptrSubstr > k)
 			{
-				codeSubstr = codeSubstr >> (ptrSubstr - TABLEBITSO);
-				ptrSubstr = TABLEBITSO;
+				codeSubstr = codeSubstr >> (ptrSubstr - k);
+				ptrSubstr = k;
 			}
 			else
 			{
 				if (current == elements)
 				{
 					// The last element is directly padded
-					codeSubstr = (codeSubstr << (TABLEBITSO-ptrSubstr));
-					ptrSubstr = TABLEBITSO;
+					codeSubstr = (codeSubstr << (k-ptrSubstr));
+					ptrSubstr = k;
 					break;
 				}
 
 				uint read = 0;
 				ptr = sorting[current].original;
 
-				while (TABLEBITSO > ptrSubstr)
+				while (k > ptrSubstr)
 				{
 					uint symbol = text[ptr+read]; read++;
 					uint bits = codewords[(int)symbol].bits; 
 					uint codeword = codewords[(int)symbol].codeword;
 
-					if ((bits+ptrSubstr) <= TABLEBITSO)
+					if ((bits+ptrSubstr) <= k)
 					{
 						codeSubstr = (codeSubstr << bits) | codeword;
 						ptrSubstr += bits;
@@ -202,7 +212,7 @@ StringDictionaryHASHHF::StringDictionaryHASHHF(IteratorDictString *it, uint len,
 						// The next string has fully read!
 						if (symbol == 0)
 						{
-							if (((ptrSubstr+(8-offset)) <= TABLEBITSO))
+							if (((ptrSubstr+(8-offset)) <= k))
 							{
 								// The next string must be parsed...
 								codeSubstr = (codeSubstr << (8-offset));
@@ -215,17 +225,17 @@ StringDictionaryHASHHF::StringDictionaryHASHHF(IteratorDictString *it, uint len,
 								offset = offset % 8;
 
 								// The padding bits are enough...
-								codeSubstr = (codeSubstr << (TABLEBITSO-ptrSubstr));
-								ptrSubstr = TABLEBITSO;
+								codeSubstr = (codeSubstr << (k-ptrSubstr));
+								ptrSubstr = k;
 							}
 						}
 					}
 					else
 					{
-						uint remaining = TABLEBITSO-ptrSubstr;
+						uint remaining = k-ptrSubstr;
 
 						codeSubstr = (codeSubstr << remaining) | (codeword >> (bits-remaining));
-						ptrSubstr = TABLEBITSO;
+						ptrSubstr = k;
 					}
 				}
 			}
@@ -251,10 +261,13 @@ StringDictionaryHASHHF::StringDictionaryHASHHF(IteratorDictString *it, uint len,
 	delete builder;
 }
 
-uint
-StringDictionaryHASHHF::locate(uchar *str, uint strLen)
+size_t
+StringDictionaryHASHHF::locate(uchar *str, uint strLen) const
 {
-	uint id = NORESULT;
+	// Strings discarded by the membership filter are not in the dictionary
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
+
+	size_t id = NORESULT;
 
 	// Encoding the string
 	uint encLen, offset;
@@ -266,22 +279,49 @@ StringDictionaryHASHHF::locate(uchar *str, uint strLen)
 	return id;
 }
 
-uchar *
-StringDictionaryHASHHF::extract(size_t id, uint *strLen)
+void
+StringDictionaryHASHHF::locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const
 {
-	if ((id > 0) && (id <= elements))
+	uchar *encoded[BATCHSIZE];
+	uint encLen[BATCHSIZE];
+	size_t pos[BATCHSIZE], slot[BATCHSIZE];
+	uint offset;
+
+	for (size_t i=0; i<n; i+=BATCHSIZE)
 	{
-		uchar *tmp = new uchar[4*maxlength+table->getK()];
-		uint remain = maxcomplength+4;
-		uint pos = hash->getValue(id);
+		size_t group = min(BATCHSIZE, n-i), searched = 0;
 
-		ChunkScan chunk = {0, 0, textStrings+pos, remain, tmp, 0, 0, 1};
-		while (!(table->processChunk(&chunk)));
+		// Encoding the strings (those discarded by the membership
+		// filter are not searched)
+		for (size_t j=0; j<group; j++)
+		{
+			if ((membershipFilter != NULL) && !membershipFilter->contains(strs[i+j], lens[i+j]))
+			{
+				out[i+j] = NORESULT;
+				continue;
+			}
 
+			encoded[searched] = coder->encodeString((uchar*)strs[i+j], lens[i+j]+1, &encLen[searched], &offset);
+			slot[searched++] = i+j;
+		}
 
-		tmp[chunk.strLen] = '\0';
+		hash->searchBatch(encoded, encLen, searched, pos);
 
-		*strLen = chunk.strLen-1;
+		for (size_t j=0; j<searched; j++)
+		{
+			out[slot[j]] = pos[j]+1;
+			delete [] encoded[j];
+		}
+	}
+}
+
+uchar *
+StringDictionaryHASHHF::extract(size_t id, uint *strLen) const
+{
+	if ((id > 0) && (id <= elements))
+	{
+		uchar *tmp = new uchar[extractCapacity()];
+		*strLen = extractInto(id, tmp, extractCapacity());
 
 		return tmp;
 	}
@@ -292,58 +332,94 @@ StringDictionaryHASHHF::extract(size_t id, uint *strLen)
 	}
 }
 
+uint
+StringDictionaryHASHHF::extractInto(size_t id, uchar *buf, uint cap) const
+{
+	// The chunks are decoded on the buffer if it has enough slack
+	if (cap < extractCapacity()) return StringDictionary::extractInto(id, buf, cap);
+
+	if ((id == 0) || (id > elements))
+	{
+		buf[0] = (uchar)'\0';
+		return 0;
+	}
+
+	size_t pos = hash->getValue(id);
+	uint remain = min((size_t)maxcomplength+4, (size_t)(bytesStrings-pos));
+
+	ChunkScan chunk = {0, 0, textStrings+pos, remain, buf, 0, 0, 1};
+	while (!(table->processChunk(&chunk)));
+
+	buf[chunk.strLen] = '\0';
+	return chunk.strLen-1;
+}
+
+uint
+StringDictionaryHASHHF::extractCapacity() const
+{
+	return 4*maxlength+table->getK();
+}
+
 IteratorDictID*
-StringDictionaryHASHHF::locatePrefix(uchar *str, uint strLen)
+StringDictionaryHASHHF::locatePrefix(uchar *str, uint strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->locatePrefix(str, strLen);
+
 	cout << "This dictionary does not provide prefix location" << endl;
 	return NULL;
 }
 
 IteratorDictID*
-StringDictionaryHASHHF::locateSubstr(uchar *str, uint strLen)
+StringDictionaryHASHHF::locateSubstr(uchar *str, uint strLen) const
 {
 	cout << "This dictionary does not provide substring location" << endl;
 	return NULL;
 }
 
-uint
-StringDictionaryHASHHF::locateRank(uint rank)
+size_t
+StringDictionaryHASHHF::locateRank(size_t rank) const
 {
+	if (rankIndex != NULL) return rankIndex->locateRank(rank);
+
 	cout << "This dictionary does not provide rank location" << endl;
 	return 0;
 }
 
 IteratorDictString*
-StringDictionaryHASHHF::extractPrefix(uchar *str, uint strLen)
+StringDictionaryHASHHF::extractPrefix(uchar *str, uint strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->extractPrefix(str, strLen);
+
 	cout << "This dictionary does not provide prefix extraction" << endl;
 	return NULL;
 }
 
 IteratorDictString*
-StringDictionaryHASHHF::extractSubstr(uchar *str, uint strLen)
+StringDictionaryHASHHF::extractSubstr(uchar *str, uint strLen) const
 {
 	cout << "This dictionary does not provide substring extraction" << endl;
 	return NULL;
 }
 
 uchar *
-StringDictionaryHASHHF::extractRank(uint rank, uint *strLen)
+StringDictionaryHASHHF::extractRank(size_t rank, uint *strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->extractRank(rank, strLen);
+
 	cout << "This dictionary does not provide rank extraction" << endl;
 	return NULL;
 }
 
 IteratorDictString*
-StringDictionaryHASHHF::extractTable()
+StringDictionaryHASHHF::extractTable() const
 {
 	vector<uchar*> tabledec(elements);
 	uchar *tmp = new uchar[4*maxlength+table->getK()];
 
-	for (uint i=1; i<=elements; i++)
+	for (size_t i=1; i<=elements; i++)
 	{
-		uint remain = maxlength;
-		uint pos = hash->getValue(i);
+		size_t pos = hash->getValue(i);
+		uint remain = min((size_t)maxlength, (size_t)(bytesStrings-pos));
 		ChunkScan chunk = {0, 0, textStrings+pos, remain, tmp, 0, 0, 1};
 
 		while (!(table->processChunk(&chunk)));
@@ -358,10 +434,22 @@ StringDictionaryHASHHF::extractTable()
 	return new IteratorDictStringVector(&tabledec, elements);
 }
 
+void
+StringDictionaryHASHHF::indexRanks()
+{
+	if (rankIndex == NULL) rankIndex = new RankIndex(this);
+}
+
+void
+StringDictionaryHASHHF::indexMembership()
+{
+	if (membershipFilter == NULL) membershipFilter = new MembershipFilter(this);
+}
+
 size_t
-StringDictionaryHASHHF::getSize()
+StringDictionaryHASHHF::getSize() const
 {
-	return bytesStrings*sizeof(uchar)+hash->getSize()+256*sizeof(Codeword)+table->getSize()+sizeof(StringDictionaryHASHHF)+256*sizeof(bool);
+	return bytesStrings*sizeof(uchar)+hash->getSize()+256*sizeof(Codeword)+table->getSize()+sizeof(StringDictionaryHASHHF)+256*sizeof(bool)+((rankIndex != NULL) ? rankIndex->getSize() : 0)+((membershipFilter != NULL) ? membershipFilter->getSize() : 0);
 }
 
 void
@@ -380,39 +468,50 @@ StringDictionaryHASHHF::save(ofstream &out)
 	// Decoding Table
 	saveValue<Codeword>(out, codewords, 256);
 	table->save(out);
+
+	// Optional alphabetical permutation
+	if (rankIndex != NULL) rankIndex->save(out);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 StringDictionary*
-StringDictionaryHASHHF::load(ifstream &in, uint technique)
+StringDictionaryHASHHF::load(ifstream &in, uint technique, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 
-	if (type != HASHHF) return NULL;
-	if ((technique != HASHUFF) && (technique != HASHBHUFF) && (technique != HASHBBHUFF)) return NULL;
+	if (type == MPHFHF) technique = HASHMPHF;
+	else if (type != HASHHF) return NULL;
+	else if ((technique != HASHUFF) && (technique != HASHBHUFF) && (technique != HASHBBHUFF)) return NULL;
 
 
 	StringDictionaryHASHHF *dict = new StringDictionaryHASHHF();
-	dict->type = technique;
+	dict->memoryMapping = mapping;
+	dict->type = type;
 	dict->elements = loadValue<uint64_t>(in);
 	dict->maxlength = loadValue<uint32_t>(in);
 	dict->maxcomplength = loadValue<uint32_t>(in);
 
-	dict->hash = Hash::load(in, dict->type);
+	dict->hash = Hash::load(in, technique, mapping);
 	dict->bytesStrings = loadValue<uint64_t>(in);
-	dict->textStrings = loadValue<uchar>(in, dict->bytesStrings);
+	dict->textStrings = MemoryMapping::loadArray<uchar>(mapping, in, dict->bytesStrings);
 	dict->hash->setData(dict->textStrings);
 
 	dict->codewords = loadValue<Codeword>(in, 256);
 	dict->table = DecodingTable::load(in);
 	dict->coder = new StatCoder(dict->table, dict->codewords);
 
+	dict->rankIndex = RankIndex::load(in, dict, mapping);
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
+
 	return dict;
 }
 
 StringDictionaryHASHHF::~StringDictionaryHASHHF()
 {
 	delete hash;
-	delete [] textStrings;
+	MemoryMapping::release(memoryMapping, textStrings);
 	delete [] codewords;
 	delete table; delete coder;
 }
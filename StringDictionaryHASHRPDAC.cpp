@@ -34,7 +34,7 @@ StringDictionaryHASHRPDAC::StringDictionaryHASHRPDAC()
 	this->maxlength = 0;
 }
 
-StringDictionaryHASHRPDAC::StringDictionaryHASHRPDAC(IteratorDictString *it, uint len, int overhead)
+StringDictionaryHASHRPDAC::StringDictionaryHASHRPDAC(IteratorDictString *it, size_t len, int overhead)
 {
 	this->type = HASHRPDAC;
 	this->elements = 0;
@@ -65,7 +65,7 @@ StringDictionaryHASHRPDAC::StringDictionaryHASHRPDAC(IteratorDictString *it, uin
 
 	{
 		// Initializing the hash table
-		uint hash_size = (uint)(elements*(1+(overhead*1.0/100.0)));
+		size_t hash_size = (size_t)(elements*(1+(overhead*1.0/100.0)));
 		hash = new HashDAC(hash_size);
 	}
 
@@ -76,7 +76,7 @@ StringDictionaryHASHRPDAC::StringDictionaryHASHRPDAC(IteratorDictString *it, uin
 	uint lenCurrent=0;
 	uint processed=0;
 
-	for (uint current=0; current<elements; current++)
+	for (size_t current=0; current<elements; current++)
 	{
 		strCurrent= it->next(&lenCurrent);
 
@@ -96,7 +96,7 @@ StringDictionaryHASHRPDAC::StringDictionaryHASHRPDAC(IteratorDictString *it, uin
 	int *dict = new int[it->size()+elements];
 	processed=0;
 
-	for (uint current=0; current<elements; current++)
+	for (size_t current=0; current<elements; current++)
 	{
 		uint ptr = sorting[current].original;
 
@@ -157,30 +157,66 @@ StringDictionaryHASHRPDAC::StringDictionaryHASHRPDAC(IteratorDictString *it, uin
 		hash->finish(ic);
 
 		// Building the array for the sequence
-		rp->Cdac = new DAC_VLS(cdict, ic-2, bits(rp->rules+rp->terminals), maxseq);
+		rp->Cdac = new DAC_VLS(cdict, ic-1, bits(rp->rules+rp->terminals), maxseq);
 
 		delete [] cdict;
 	}
 }
 
-uint
-StringDictionaryHASHRPDAC::locate(uchar *str, uint strLen)
+size_t
+StringDictionaryHASHRPDAC::locate(uchar *str, uint strLen) const
 {
-	uint id = NORESULT;
+	// Strings discarded by the membership filter are not in the dictionary
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
+
+	return locate(str, strLen, hash_value(hash->function, str, strLen, hash->tsize));
+}
+
+void
+StringDictionaryHASHRPDAC::locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const
+{
+	size_t hvals[BATCHSIZE], slot[BATCHSIZE];
+
+	for (size_t i=0; i<n; i+=BATCHSIZE)
+	{
+		size_t group = min(BATCHSIZE, n-i), searched = 0;
 
-	size_t hval = bitwisehash(str, strLen, hash->tsize);
+		// Hashing the strings (those discarded by the membership 
+		// filter are not searched)
+		for (size_t j=0; j<group; j++)
+		{
+			if ((membershipFilter != NULL) && !membershipFilter->contains(strs[i+j], lens[i+j]))
+			{
+				out[i+j] = NORESULT;
+				continue;
+			}
+
+			hvals[searched] = hash_value(hash->function, (uchar*)strs[i+j], lens[i+j], hash->tsize);
+			hash->b_ht->prefetch(hvals[searched]);
+			slot[searched++] = i+j;
+		}
+
+		for (size_t j=0; j<searched; j++)
+			out[slot[j]] = locate((uchar*)strs[slot[j]], lens[slot[j]], hvals[j]);
+	}
+}
+
+size_t
+StringDictionaryHASHRPDAC::locate(uchar *str, uint strLen, size_t hval) const
+{
+	size_t id = NORESULT;
 	size_t next;
 
 	if(!hash->b_ht->access(hval))
 		return id;
 
-	uint pos = hash->b_ht->rank1(hval);
+	size_t pos = hash->b_ht->rank1(hval);
 
 	if (rp->extractStringAndCompareDAC(pos, str, strLen) == 0)
 		return pos;
 
 	// using double hashing
-	size_t h2 = step_value(str, strLen, hash->tsize);
+	size_t h2 = hash_step(hash->function, str, strLen, hash->tsize);
 
 	for(uint i=1; i<hash->tsize ; i++ )
 	{
@@ -199,95 +235,130 @@ StringDictionaryHASHRPDAC::locate(uchar *str, uint strLen)
 }
 
 uchar *
-StringDictionaryHASHRPDAC::extract(size_t id, uint *strLen)
+StringDictionaryHASHRPDAC::extract(size_t id, uint *strLen) const
 {
 	if ((id > 0) && (id <= elements))
 	{
-		uint *rules;
-		uint len = rp->Cdac->access(id, &rules);
 		uchar *s = new uchar[maxlength+1];
+		*strLen = extractInto(id, s, maxlength+1);
 
+		return s;
+	}
+	else
+	{
 		*strLen = 0;
+		return NULL;
+	}
+}
+
+uint
+StringDictionaryHASHRPDAC::extractInto(size_t id, uchar *buf, uint cap) const
+{
+	// The rules of any string can be expanded on the buffer
+	if (cap <= maxlength) return StringDictionary::extractInto(id, buf, cap);
+
+	uint strLen = 0;
+
+	if ((id > 0) && (id <= elements))
+	{
+		uint *rules;
+		uint len = rp->Cdac->access(id, &rules);
 
 		for (uint i=0; i<len; i++)
 		{
-			if (rules[i] >= rp->terminals) (*strLen) += rp->expandRule(rules[i]-rp->terminals, (s+(*strLen)));
+			if (rules[i] >= rp->terminals) strLen += rp->expandRule(rules[i]-rp->terminals, buf+strLen);
 			else
 			{
-				s[*strLen] = (uchar)rules[i];
-				(*strLen)++;
+				buf[strLen] = (uchar)rules[i];
+				strLen++;
 			}
 		}
 
-		s[*strLen] = (uchar)'\0';
 		delete [] rules;
-
-		return s;
-	}
-	else
-	{
-		*strLen = 0;
-		return NULL;
 	}
+
+	buf[strLen] = (uchar)'\0';
+	return strLen;
 }
 
 IteratorDictID*
-StringDictionaryHASHRPDAC::locatePrefix(uchar *str, uint strLen)
+StringDictionaryHASHRPDAC::locatePrefix(uchar *str, uint strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->locatePrefix(str, strLen);
+
 	cout << "This dictionary does not provide prefix location" << endl;
 	return NULL;
 }
 
 IteratorDictID*
-StringDictionaryHASHRPDAC::locateSubstr(uchar *str, uint strLen)
+StringDictionaryHASHRPDAC::locateSubstr(uchar *str, uint strLen) const
 {
 	cout << "This dictionary does not provide substring location" << endl;
 	return NULL;
 }
 
-uint
-StringDictionaryHASHRPDAC::locateRank(uint rank)
+size_t
+StringDictionaryHASHRPDAC::locateRank(size_t rank) const
 {
+	if (rankIndex != NULL) return rankIndex->locateRank(rank);
+
 	cout << "This dictionary does not provide rank location" << endl;
 	return 0;
 }
 
 IteratorDictString*
-StringDictionaryHASHRPDAC::extractPrefix(uchar *str, uint strLen)
+StringDictionaryHASHRPDAC::extractPrefix(uchar *str, uint strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->extractPrefix(str, strLen);
+
 	cout << "This dictionary does not provide prefix extraction" << endl;
 	return NULL;
 }
 
 IteratorDictString*
-StringDictionaryHASHRPDAC::extractSubstr(uchar *str, uint strLen)
+StringDictionaryHASHRPDAC::extractSubstr(uchar *str, uint strLen) const
 {
 	cout << "This dictionary does not provide substring extraction" << endl;
 	return NULL;
 }
 
 uchar *
-StringDictionaryHASHRPDAC::extractRank(uint rank, uint *strLen)
+StringDictionaryHASHRPDAC::extractRank(size_t rank, uint *strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->extractRank(rank, strLen);
+
 	cout << "This dictionary does not provide rank extraction" << endl;
 	return NULL;
 }
 
 IteratorDictString*
-StringDictionaryHASHRPDAC::extractTable()
+StringDictionaryHASHRPDAC::extractTable() const
+{
+	return new IteratorDictStringRPDAC(rp, 0, elements, maxlength);
+}
+
+void
+StringDictionaryHASHRPDAC::indexRanks()
 {
-	vector<uchar*> tabledec(elements);
-	uint strLen;
+	if (rankIndex == NULL) rankIndex = new RankIndex(this);
+}
 
-	for (uint i=1; i<=elements; i++) tabledec[i-1] = extract(i, &strLen);
+void
+StringDictionaryHASHRPDAC::indexMembership()
+{
+	if (membershipFilter == NULL) membershipFilter = new MembershipFilter(this);
+}
 
-	return new IteratorDictStringVector(&tabledec, elements);
+void
+StringDictionaryHASHRPDAC::indexGrammar()
+{
+	rp->unpack();
 }
 
 size_t
-StringDictionaryHASHRPDAC::getSize()
+StringDictionaryHASHRPDAC::getSize() const
 {
-	return hash->getSize()+rp->getSize()+sizeof(StringDictionaryHASHRPDAC);
+	return hash->getSize()+rp->getSize()+sizeof(StringDictionaryHASHRPDAC)+((rankIndex != NULL) ? rankIndex->getSize() : 0)+((membershipFilter != NULL) ? membershipFilter->getSize() : 0);
 }
 
 void
@@ -299,22 +370,32 @@ StringDictionaryHASHRPDAC::save(ofstream &out)
 
 	rp->save(out, type);
 	hash->save(out);
+
+	// Optional alphabetical permutation
+	if (rankIndex != NULL) rankIndex->save(out);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 StringDictionary*
-StringDictionaryHASHRPDAC::load(ifstream &in, uint technique)
+StringDictionaryHASHRPDAC::load(ifstream &in, uint technique, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 	if (type != HASHRPDAC) return NULL;
 
 	StringDictionaryHASHRPDAC *dict = new StringDictionaryHASHRPDAC();
-	dict->type = technique;
+	dict->memoryMapping = mapping;
+	dict->type = HASHRPDAC;
 	dict->elements = loadValue<uint64_t>(in);
 	dict->maxlength = loadValue<uint32_t>(in);
 
-	dict->rp = RePair::load(in);
+	dict->rp = RePair::load(in, mapping);
 	dict->hash = HashDAC::load(in);
 
+	dict->rankIndex = RankIndex::load(in, dict, mapping);
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
+
 	return dict;
 }
 
@@ -61,14 +61,25 @@ class StringDictionaryHASHRPDAC : public StringDictionary
 		      the size of the dictionary
 		    @param order: dictionary order (hash-based order by default)
 		*/
-		StringDictionaryHASHRPDAC(IteratorDictString *it, uint len, int overhead);
+		StringDictionaryHASHRPDAC(IteratorDictString *it, size_t len, int overhead);
 
 		/** Retrieves the ID corresponding to the given string.
 		    @param str: the string to be searched.
 		    @param strLen: the string length.
 		    @returns the ID (or NORESULT if it is not in the bucket).
 		*/
-		uint locate(uchar *str, uint str_length);
+		size_t locate(uchar *str, uint str_length) const;
+
+		/** Retrieves the IDs corresponding to a batch of strings. The 
+		    hash values are computed in advance, so the bitmap words of
+		    the table cells are prefetched before probing them.
+		    @param strs: the strings to be searched.
+		    @param lens: the string lengths.
+		    @param n: the number of strings.
+		    @param out: the resulting IDs (NORESULT for those strings
+		      which are not in the dictionary).
+		*/
+		void locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const;
 
 		/** Obtains the string associated with the given ID.
 		    @param id: the ID to be extracted.
@@ -76,7 +87,18 @@ class StringDictionaryHASHRPDAC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		 */
-		uchar* extract(size_t id, uint *strLen);
+		uchar* extract(size_t id, uint *strLen) const;
+
+		/** Obtains the string associated with the given ID into a
+		    buffer owned by the caller. The rules are directly expanded
+		    on the buffer if its capacity is greater than maxLength().
+		    @param id: the ID to be extracted.
+		    @param buf: the buffer.
+		    @param cap: the buffer capacity.
+		    @returns the string length (0 if the ID is not in the
+		      dictionary).
+		*/
+		uint extractInto(size_t id, uchar *buf, uint cap) const;
 
 		/** Locates all IDs of those elements prefixed by the given
 		    string.
@@ -84,7 +106,7 @@ class StringDictionaryHASHRPDAC : public StringDictionary
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locatePrefix(uchar *str, uint strLen);
+		IteratorDictID* locatePrefix(uchar *str, uint strLen) const;
 
 		/** Locates all IDs of those elements containing the given
 		    substring.
@@ -92,27 +114,27 @@ class StringDictionaryHASHRPDAC : public StringDictionary
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locateSubstr(uchar *str, uint strLen);
+		IteratorDictID* locateSubstr(uchar *str, uint strLen) const;
 
 		/** Retrieves the ID with rank k according to its alphabetical order.
 		    @param rank: the alphabetical ranking.
 		    @returns the ID.
 		*/
-		uint locateRank(uint rank);
+		size_t locateRank(size_t rank) const;
 
 		/** Extracts all elements prefixed by the given string.
 		    @param str: the prefix to be searched.
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractPrefix(uchar *str, uint strLen);
+		IteratorDictString* extractPrefix(uchar *str, uint strLen) const;
 
 		/** Extracts all elements containing by the given substring.
 		    @param str: the substring to be searched.
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractSubstr(uchar *str, uint strLen);
+		IteratorDictString* extractSubstr(uchar *str, uint strLen) const;
 
 		/** Obtains the string  with rank k according to its
 		    alphabetical order.
@@ -121,18 +143,33 @@ class StringDictionaryHASHRPDAC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		*/
-		uchar* extractRank(uint rank, uint *strLen);
+		uchar* extractRank(size_t rank, uint *strLen) const;
 
 		/** Extracts all strings in the dictionary sorted in
 		    alphabetical order.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractTable();
+		IteratorDictString* extractTable() const;
+
+		/** Builds the alphabetical permutation of the IDs, which
+		    enables prefix and rank operations.
+		*/
+		void indexRanks();
+
+		/** Builds the approximate membership filter, so locate 
+		    discards most of the strings not in the dictionary.
+		*/
+		void indexMembership();
+
+		/** Unpacks the RePair grammar (expansions and comparisons
+		    avoid bit unpacking).
+		*/
+		void indexGrammar();
 
 		/** Computes the size of the structure in bytes.
 		    @returns the dictionary size in bytes.
 		*/
-		size_t getSize();
+		size_t getSize() const;
 
 		/** Stores the dictionary into an ofstream.
 		    @param out: the oftstream.
@@ -141,14 +178,26 @@ class StringDictionaryHASHRPDAC : public StringDictionary
 
 		/** Loads a dictionary from an ifstream.
 		    @param in: the ifstream.
+		    @param technique: the hash technique.
+		    @param mapping: the memory mapping of the file (if any). The
+		      dictionary takes its ownership.
 		    @returns the loaded dictionary.
 		*/
-		static StringDictionary *load(ifstream &in, uint technique=HASHUFF);
+		static StringDictionary *load(ifstream &in, uint technique=HASHUFF, MemoryMapping *mapping=NULL);
 
 		/** Generic destructor. */
 		~StringDictionaryHASHRPDAC();
 
 	protected:
+		/** Retrieves the ID corresponding to the given string from its
+		    (previously computed) hash value.
+		    @param str: the string to be searched.
+		    @param strLen: the string length.
+		    @param hval: the hash value of the string.
+		    @returns the ID (or NORESULT if it is not in the dictionary).
+		*/
+		size_t locate(uchar *str, uint strLen, size_t hval) const;
+
 		HashDAC *hash;		//! Hash table
 		RePair *rp;		//! RePair representation
 
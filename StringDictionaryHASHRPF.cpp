@@ -34,9 +34,9 @@ StringDictionaryHASHRPF::StringDictionaryHASHRPF()
 	this->maxlength = 0;
 }
 
-StringDictionaryHASHRPF::StringDictionaryHASHRPF(IteratorDictString *it, uint len, int overhead)
+StringDictionaryHASHRPF::StringDictionaryHASHRPF(IteratorDictString *it, size_t len, int overhead, uint technique)
 {
-	this->type = HASHRPF;
+	this->type = (technique == HASHMPHF) ? MPHFRPF : HASHRPF;
 	this->elements = 0;
 	this->maxlength = 0;
 
@@ -65,8 +65,12 @@ StringDictionaryHASHRPF::StringDictionaryHASHRPF(IteratorDictString *it, uint le
 
 	{
 		// Initializing the hash table
-		uint hash_size = (uint)(elements*(1+(overhead*1.0/100.0)));
-		hash = new Hashdh(hash_size);
+		if (technique == HASHMPHF) hash = new HashMPHF(elements, overhead);
+		else
+		{
+			size_t hash_size = (size_t)(elements*(1+(overhead*1.0/100.0)));
+			hash = new Hashdh(hash_size);
+		}
 	}
 
 	// Performing Tdict reorganization
@@ -76,7 +80,7 @@ StringDictionaryHASHRPF::StringDictionaryHASHRPF(IteratorDictString *it, uint le
 	uint lenCurrent=0;
 	uint processed=0;
 
-	for (uint current=0; current<elements; current++)
+	for (size_t current=0; current<elements; current++)
 	{
 		strCurrent= it->next(&lenCurrent);
 
@@ -88,6 +92,10 @@ StringDictionaryHASHRPF::StringDictionaryHASHRPF(IteratorDictString *it, uint le
 		processed += lenCurrent+1;
 	}
 
+	// Placing the strings in their final positions
+	hash->arrange();
+	for (size_t i=0; i<elements; i++) sorting[i].hash = hash->getPosition(sorting[i].hash);
+
 	// String sorting for Tdict*
 	std::sort(sorting.begin(), sorting.end(), sortTdict);
 
@@ -96,7 +104,7 @@ StringDictionaryHASHRPF::StringDictionaryHASHRPF(IteratorDictString *it, uint le
 	int *dict = new int[it->size()+elements];
 	processed=0;
 
-	for (uint current=0; current<elements; current++)
+	for (size_t current=0; current<elements; current++)
 	{
 		uint ptr = sorting[current].original;
 
@@ -150,16 +158,72 @@ StringDictionaryHASHRPF::StringDictionaryHASHRPF(IteratorDictString *it, uint le
 		hash->finish(bytesStrings);
 
 		// Building the array for the sequence
-		rp->Cls = new LogSequence(&textStrings, bits(rp->rules+rp->terminals));
+		rp->Cls = new LogSequence(&textStrings, bits(rp->rules+rp->terminals), true);
 	}
 }
 
-uint
-StringDictionaryHASHRPF::locate(uchar *str, uint strLen)
+size_t
+StringDictionaryHASHRPF::locate(uchar *str, uint strLen) const
 {
-	uint id = NORESULT;
+	// Strings discarded by the membership filter are not in the dictionary
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
+
+	size_t id = NORESULT;
+
+	if (type == MPHFRPF)
+	{
+		// A single candidate is compared
+		size_t pos = ((HashMPHF*)hash)->lookup(str, strLen);
+
+		if ((pos != (size_t)-1) && (rp->extractStringAndCompareRP(hash->getValuePos(pos), str, strLen) == 0))
+			id = pos+1;
+
+		return id;
+	}
+
+	return locate(str, strLen, hash_value(hash->function, str, strLen, hash->tsize));
+}
+
+void
+StringDictionaryHASHRPF::locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const
+{
+	// A single candidate is compared for each string
+	if (type == MPHFRPF) { StringDictionary::locateBatch(strs, lens, n, out); return; }
+
+	size_t hvals[BATCHSIZE], slot[BATCHSIZE];
 
-	size_t hval = bitwisehash(str, strLen, hash->tsize);
+	for (size_t i=0; i<n; i+=BATCHSIZE)
+	{
+		size_t group = min(BATCHSIZE, n-i), searched = 0;
+
+		// Hashing the strings (those discarded by the membership 
+		// filter are not searched)
+		for (size_t j=0; j<group; j++)
+		{
+			if ((membershipFilter != NULL) && !membershipFilter->contains(strs[i+j], lens[i+j]))
+			{
+				out[i+j] = NORESULT;
+				continue;
+			}
+
+			hvals[searched] = hash_value(hash->function, (uchar*)strs[i+j], lens[i+j], hash->tsize);
+			hash->b_ht->prefetch(hvals[searched]);
+			slot[searched++] = i+j;
+		}
+
+		// Prefetching the grammar sequences of the first candidates
+		for (size_t j=0; j<searched; j++)
+			if (hash->b_ht->access(hvals[j])) rp->Cls->prefetch(hash->getValuePos(hvals[j]));
+
+		for (size_t j=0; j<searched; j++)
+			out[slot[j]] = locate((uchar*)strs[slot[j]], lens[slot[j]], hvals[j]);
+	}
+}
+
+size_t
+StringDictionaryHASHRPF::locate(uchar *str, uint strLen, size_t hval) const
+{
+	size_t id = NORESULT;
 	size_t next;
 
 	if(!hash->b_ht->access(hval))
@@ -169,7 +233,7 @@ StringDictionaryHASHRPF::locate(uchar *str, uint strLen)
 		return hash->b_ht->rank1(hval);
 
 	// using double hashing
-	size_t h2 = step_value(str, strLen, hash->tsize);
+	size_t h2 = hash_step(hash->function, str, strLen, hash->tsize);
 
 	for(uint i=1; i<hash->tsize ; i++ )
 	{
@@ -186,14 +250,33 @@ StringDictionaryHASHRPF::locate(uchar *str, uint strLen)
 }
 
 uchar *
-StringDictionaryHASHRPF::extract(size_t id, uint *strLen)
+StringDictionaryHASHRPF::extract(size_t id, uint *strLen) const
 {
 	if ((id > 0) && (id <= elements))
 	{
 		uchar *s = new uchar[maxlength+1];
+		*strLen = extractInto(id, s, maxlength+1);
+
+		return s;
+	}
+	else
+	{
 		*strLen = 0;
+		return NULL;
+	}
+}
+
+uint
+StringDictionaryHASHRPF::extractInto(size_t id, uchar *buf, uint cap) const
+{
+	// The rules of any string can be expanded on the buffer
+	if (cap <= maxlength) return StringDictionary::extractInto(id, buf, cap);
 
-		uint position = hash->getValue(id);
+	uint strLen = 0;
+
+	if ((id > 0) && (id <= elements))
+	{
+		size_t position = hash->getValue(id);
 
 		uint rule;
 		uint ptr = 0;
@@ -202,85 +285,106 @@ StringDictionaryHASHRPF::extract(size_t id, uint *strLen)
 		{
 			rule = rp->Cls->getField(position+ptr); ptr++;
 
-			if (rule >= rp->terminals) (*strLen) += rp->expandRule(rule-rp->terminals, (s+(*strLen)));
+			if (rule >= rp->terminals) strLen += rp->expandRule(rule-rp->terminals, buf+strLen);
 			else
 			{
-				s[*strLen] = (uchar)rule;
-				(*strLen)++;
+				buf[strLen] = (uchar)rule;
+				strLen++;
 			}
 
-			if (s[*strLen-1] == rp->maxchar) break;
+			if (buf[strLen-1] == rp->maxchar) break;
 		}
 
-		(*strLen)--;
-		s[*strLen] = (uchar)'\0';
-
-		return s;
-	}
-	else
-	{
-		*strLen = 0;
-		return NULL;
+		strLen--;
 	}
+
+	buf[strLen] = (uchar)'\0';
+	return strLen;
 }
 
 IteratorDictID*
-StringDictionaryHASHRPF::locatePrefix(uchar *str, uint strLen)
+StringDictionaryHASHRPF::locatePrefix(uchar *str, uint strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->locatePrefix(str, strLen);
+
 	cout << "This dictionary does not provide prefix location" << endl;
 	return NULL;
 }
 
 IteratorDictID*
-StringDictionaryHASHRPF::locateSubstr(uchar *str, uint strLen)
+StringDictionaryHASHRPF::locateSubstr(uchar *str, uint strLen) const
 {
 	cout << "This dictionary does not provide substring location" << endl;
 	return NULL;
 }
 
-uint
-StringDictionaryHASHRPF::locateRank(uint rank)
+size_t
+StringDictionaryHASHRPF::locateRank(size_t rank) const
 {
+	if (rankIndex != NULL) return rankIndex->locateRank(rank);
+
 	cout << "This dictionary does not provide rank location" << endl;
 	return 0;
 }
 
 IteratorDictString*
-StringDictionaryHASHRPF::extractPrefix(uchar *str, uint strLen)
+StringDictionaryHASHRPF::extractPrefix(uchar *str, uint strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->extractPrefix(str, strLen);
+
 	cout << "This dictionary does not provide prefix extraction" << endl;
 	return NULL;
 }
 
 IteratorDictString*
-StringDictionaryHASHRPF::extractSubstr(uchar *str, uint strLen)
+StringDictionaryHASHRPF::extractSubstr(uchar *str, uint strLen) const
 {
 	cout << "This dictionary does not provide substring extraction" << endl;
 	return NULL;
 }
 
 uchar *
-StringDictionaryHASHRPF::extractRank(uint rank, uint *strLen)
+StringDictionaryHASHRPF::extractRank(size_t rank, uint *strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->extractRank(rank, strLen);
+
 	cout << "This dictionary does not provide rank extraction" << endl;
 	return NULL;
 }
 
 IteratorDictString*
-StringDictionaryHASHRPF::extractTable()
+StringDictionaryHASHRPF::extractTable() const
 {
 	vector<uchar*> tabledec(elements);
 	uint strLen;
 
-	for (uint i=1; i<=elements; i++) tabledec[i-1] = extract(i, &strLen);
+	for (size_t i=1; i<=elements; i++) tabledec[i-1] = extract(i, &strLen);
 
 	return new IteratorDictStringVector(&tabledec, elements);
 }
 
+void
+StringDictionaryHASHRPF::indexRanks()
+{
+	if (rankIndex == NULL) rankIndex = new RankIndex(this);
+}
+
+void
+StringDictionaryHASHRPF::indexMembership()
+{
+	if (membershipFilter == NULL) membershipFilter = new MembershipFilter(this);
+}
+
+void
+StringDictionaryHASHRPF::indexGrammar()
+{
+	rp->unpack();
+}
+
 size_t
-StringDictionaryHASHRPF::getSize()
+StringDictionaryHASHRPF::getSize() const
 {
-	return hash->getSize()+rp->getSize()+sizeof(StringDictionaryHASHRPF);
+	return hash->getSize()+rp->getSize()+sizeof(StringDictionaryHASHRPF)+((rankIndex != NULL) ? rankIndex->getSize() : 0)+((membershipFilter != NULL) ? membershipFilter->getSize() : 0);
 }
 
 void
@@ -292,23 +396,34 @@ StringDictionaryHASHRPF::save(ofstream &out)
 
 	rp->save(out, HASHRPF);
 	hash->save(out);
+
+	// Optional alphabetical permutation
+	if (rankIndex != NULL) rankIndex->save(out);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 StringDictionary*
-StringDictionaryHASHRPF::load(ifstream &in, uint technique)
+StringDictionaryHASHRPF::load(ifstream &in, uint technique, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 
-	if (type != HASHRPF) return NULL;
-	if ((technique != HASHRP) && (technique != HASHBRP) && (technique != HASHBBRP)) return NULL;
+	if (type == MPHFRPF) technique = HASHMPHF;
+	else if (type != HASHRPF) return NULL;
+	else if ((technique != HASHRP) && (technique != HASHBRP) && (technique != HASHBBRP)) return NULL;
 
 	StringDictionaryHASHRPF *dict = new StringDictionaryHASHRPF();
-	dict->type = technique;
+	dict->memoryMapping = mapping;
+	dict->type = type;
 	dict->elements = loadValue<uint64_t>(in);
 	dict->maxlength = loadValue<uint32_t>(in);
 
-	dict->rp = RePair::load(in);
-	dict->hash = Hash::load(in, technique);
+	dict->rp = RePair::load(in, mapping);
+	dict->hash = Hash::load(in, technique, mapping);
+
+	dict->rankIndex = RankIndex::load(in, dict, mapping);
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
 
 	return dict;
 }
@@ -14,6 +14,9 @@
  *
  * The strings are encoded using the grammar-based compressor RePair. 
  *
+ * The hash table can also be a minimal perfect hash (MPHFRPF dictionaries),
+ * in which each lookup compares a single string.
+ *
  * This library is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
  * License as published by the Free Software Foundation; either
@@ -58,17 +61,32 @@ class StringDictionaryHASHRPF : public StringDictionary
 		    @param text: the array of strings.
 		    @param len: stream size (in bytes).
 		    @param overhead: overhead that the hash table will use over
-		      the size of the dictionary
-		    @param order: dictionary order (hash-based order by default)
+		      the size of the dictionary (over the strings remaining in
+		      each level for minimal perfect hashing)
+		    @param technique: HASHUFF for double hashing or HASHMPHF for
+		      minimal perfect hashing (one comparison per lookup).
 		*/
-		StringDictionaryHASHRPF(IteratorDictString *it, uint len, int overhead);
+		StringDictionaryHASHRPF(IteratorDictString *it, size_t len, int overhead, uint technique=HASHUFF);
 
 		/** Retrieves the ID corresponding to the given string.
 		    @param str: the string to be searched.
 		    @param strLen: the string length.
 		    @returns the ID (or NORESULT if it is not in the bucket).
 		*/
-		uint locate(uchar *str, uint str_length);
+		size_t locate(uchar *str, uint str_length) const;
+
+		/** Retrieves the IDs corresponding to a batch of strings. The 
+		    hash values are computed in advance, so the bitmap words of
+		    the table cells and the grammar sequences they point to are
+		    prefetched before probing them (MPHFRPF locates them one at
+		    a time).
+		    @param strs: the strings to be searched.
+		    @param lens: the string lengths.
+		    @param n: the number of strings.
+		    @param out: the resulting IDs (NORESULT for those strings
+		      which are not in the dictionary).
+		*/
+		void locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const;
 
 		/** Obtains the string associated with the given ID.
 		    @param id: the ID to be extracted.
@@ -76,7 +94,18 @@ class StringDictionaryHASHRPF : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		 */
-		uchar* extract(size_t id, uint *strLen);
+		uchar* extract(size_t id, uint *strLen) const;
+
+		/** Obtains the string associated with the given ID into a
+		    buffer owned by the caller. The string is directly decoded
+		    on the buffer if its capacity is greater than maxLength().
+		    @param id: the ID to be extracted.
+		    @param buf: the buffer.
+		    @param cap: the buffer capacity.
+		    @returns the string length (0 if the ID is not in the
+		      dictionary).
+		*/
+		uint extractInto(size_t id, uchar *buf, uint cap) const;
 
 		/** Locates all IDs of those elements prefixed by the given
 		    string.
@@ -84,7 +113,7 @@ class StringDictionaryHASHRPF : public StringDictionary
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locatePrefix(uchar *str, uint strLen);
+		IteratorDictID* locatePrefix(uchar *str, uint strLen) const;
 
 		/** Locates all IDs of those elements containing the given
 		    substring.
@@ -92,27 +121,27 @@ class StringDictionaryHASHRPF : public StringDictionary
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locateSubstr(uchar *str, uint strLen);
+		IteratorDictID* locateSubstr(uchar *str, uint strLen) const;
 
 		/** Retrieves the ID with rank k according to its alphabetical order.
 		    @param rank: the alphabetical ranking.
 		    @returns the ID.
 		*/
-		uint locateRank(uint rank);
+		size_t locateRank(size_t rank) const;
 
 		/** Extracts all elements prefixed by the given string.
 		    @param str: the prefix to be searched.
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractPrefix(uchar *str, uint strLen);
+		IteratorDictString* extractPrefix(uchar *str, uint strLen) const;
 
 		/** Extracts all elements containing by the given substring.
 		    @param str: the substring to be searched.
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractSubstr(uchar *str, uint strLen);
+		IteratorDictString* extractSubstr(uchar *str, uint strLen) const;
 
 		/** Obtains the string  with rank k according to its
 		    alphabetical order.
@@ -121,18 +150,33 @@ class StringDictionaryHASHRPF : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		*/
-		uchar* extractRank(uint rank, uint *strLen);
+		uchar* extractRank(size_t rank, uint *strLen) const;
 
 		/** Extracts all strings in the dictionary sorted in
 		    alphabetical order.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractTable();
+		IteratorDictString* extractTable() const;
+
+		/** Builds the alphabetical permutation of the IDs, which
+		    enables prefix and rank operations.
+		*/
+		void indexRanks();
+
+		/** Builds the approximate membership filter, so locate 
+		    discards most of the strings not in the dictionary.
+		*/
+		void indexMembership();
+
+		/** Unpacks the RePair grammar (expansions and comparisons
+		    avoid bit unpacking).
+		*/
+		void indexGrammar();
 
 		/** Computes the size of the structure in bytes.
 		    @returns the dictionary size in bytes.
 		*/
-		size_t getSize();
+		size_t getSize() const;
 
 		/** Stores the dictionary into an ofstream.
 		    @param out: the oftstream.
@@ -141,14 +185,26 @@ class StringDictionaryHASHRPF : public StringDictionary
 
 		/** Loads a dictionary from an ifstream.
 		    @param in: the ifstream.
+		    @param technique: the hash technique.
+		    @param mapping: the memory mapping of the file (if any). The
+		      dictionary takes its ownership.
 		    @returns the loaded dictionary.
 		*/
-		static StringDictionary *load(ifstream &in, uint technique=HASHUFF);
+		static StringDictionary *load(ifstream &in, uint technique=HASHUFF, MemoryMapping *mapping=NULL);
 
 		/** Generic destructor. */
 		~StringDictionaryHASHRPF();
 
 	protected:
+		/** Retrieves the ID corresponding to the given string from its
+		    (previously computed) hash value.
+		    @param str: the string to be searched.
+		    @param strLen: the string length.
+		    @param hval: the hash value of the string.
+		    @returns the ID (or NORESULT if it is not in the dictionary).
+		*/
+		size_t locate(uchar *str, uint strLen, size_t hval) const;
+
 		Hash *hash;	//! Hash table
 		RePair *rp;	//! The RePair representation
 
@@ -34,7 +34,7 @@ StringDictionaryHASHUFFDAC::StringDictionaryHASHUFFDAC()
 	this->maxlength = 0;
 }
 
-StringDictionaryHASHUFFDAC::StringDictionaryHASHUFFDAC(IteratorDictString *it, uint len, int overhead)
+StringDictionaryHASHUFFDAC::StringDictionaryHASHUFFDAC(IteratorDictString *it, size_t len, int overhead, uint tablebits)
 {
 	this->type = HASHUFFDAC;
 	this->elements = 0;
@@ -57,17 +57,19 @@ StringDictionaryHASHUFFDAC::StringDictionaryHASHUFFDAC(IteratorDictString *it, u
 	Huffman	*huff = new Huffman(text, len);
 
 	// Initializing the hash table
-	uint hash_size = (uint)(elements*(1+(overhead*1.0/100.0)));
+	size_t hash_size = (size_t)(elements*(1+(overhead*1.0/100.0)));
 	hash = new HashDAC(hash_size);
 
 	// Initializing the builder for the decoding table and the coder for
 	// Huffman compression
-	DecodingTableBuilder *builder = new DecodingTableBuilder();
+	DecodingTableBuilder *builder = new DecodingTableBuilder(255, tablebits);
 	builder->initializeFromHuffman(huff);
 	delete huff;
 	codewords = builder->getCodewords();
 	coder = new StatCoder(codewords);
 
+	uint k = builder->getK();
+
 	// Auxiliar variables
 	size_t ptr = 0; uint offset = 0, bytes = 0;
 	uchar *tmp = new uchar[4*maxlength];
@@ -84,7 +86,7 @@ StringDictionaryHASHUFFDAC::StringDictionaryHASHUFFDAC(IteratorDictString *it, u
 	// Simulating the hash representation
 	vector<SortString> sorting(elements);
 
-	for (uint current=1; current<=elements; current++)
+	for (size_t current=1; current<=elements; current++)
 	{
 		// Resetting variables for the next string
 		bytes = 0; tmp[bytes] = 0; offset = 0;
@@ -140,7 +142,7 @@ StringDictionaryHASHUFFDAC::StringDictionaryHASHUFFDAC(IteratorDictString *it, u
 	dacseq = new uchar[tamCode];
 	uint64_t bytesStrings = 0;
 
-	for (uint current=1; current<=elements; current++)
+	for (size_t current=1; current<=elements; current++)
 	{
 		// Resetting variables for the next string
 		{
@@ -189,8 +191,8 @@ StringDictionaryHASHUFFDAC::StringDictionaryHASHUFFDAC(IteratorDictString *it, u
 		if (textSubstr.size() > 0)
 		{
 			// It is necessary padding the substring
-			codeSubstr = (codeSubstr << (TABLEBITSO-ptrSubstr));
-			ptrSubstr = TABLEBITSO;
+			codeSubstr = (codeSubstr << (k-ptrSubstr));
+			ptrSubstr = k;
 
 			builder->insertEndingSubstr(&codeSubstr, &ptrSubstr, &textSubstr, &lenSubstr);
 		}
@@ -209,10 +211,13 @@ StringDictionaryHASHUFFDAC::StringDictionaryHASHUFFDAC(IteratorDictString *it, u
 	delete builder;
 }
 
-uint
-StringDictionaryHASHUFFDAC::locate(uchar *str, uint strLen)
+size_t
+StringDictionaryHASHUFFDAC::locate(uchar *str, uint strLen) const
 {
-	uint id = NORESULT;
+	// Strings discarded by the membership filter are not in the dictionary
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
+
+	size_t id = NORESULT;
 
 	// Encoding the string
 	uint encLen, offset;
@@ -223,73 +228,145 @@ StringDictionaryHASHUFFDAC::locate(uchar *str, uint strLen)
 	return id;
 }
 
+void
+StringDictionaryHASHUFFDAC::locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const
+{
+	uchar *encoded[BATCHSIZE];
+	uint encLen[BATCHSIZE];
+	size_t pos[BATCHSIZE], slot[BATCHSIZE];
+	uint offset;
+
+	for (size_t i=0; i<n; i+=BATCHSIZE)
+	{
+		size_t group = min(BATCHSIZE, n-i), searched = 0;
+
+		// Encoding the strings (those discarded by the membership
+		// filter are not searched)
+		for (size_t j=0; j<group; j++)
+		{
+			if ((membershipFilter != NULL) && !membershipFilter->contains(strs[i+j], lens[i+j]))
+			{
+				out[i+j] = NORESULT;
+				continue;
+			}
+
+			encoded[searched] = coder->encodeString((uchar*)strs[i+j], lens[i+j]+1, &encLen[searched], &offset);
+			slot[searched++] = i+j;
+		}
+
+		hash->searchBatch(encoded, encLen, searched, pos);
+
+		for (size_t j=0; j<searched; j++)
+		{
+			out[slot[j]] = pos[j]+1;
+			delete [] encoded[j];
+		}
+	}
+}
+
 uchar *
-StringDictionaryHASHUFFDAC::extract(size_t id, uint *strLen)
+StringDictionaryHASHUFFDAC::extract(size_t id, uint *strLen) const
 {
-	if ((id > 0) && (id <= elements)) return extractString(id, strLen);
+	if ((id > 0) && (id <= elements))
+	{
+		uchar *dec = new uchar[4*maxlength];
+		uchar *tmp = new uchar[4*maxlength+table->getK()];
+
+		*strLen = extractString(id, dec, tmp);
+		delete [] dec;
+
+		return tmp;
+	}
 	else { *strLen = 0; return NULL; }
 }
 
+uint
+StringDictionaryHASHUFFDAC::extractInto(size_t id, uchar *buf, uint cap) const
+{
+	// The chunks are decoded on the buffer if it has enough slack
+	if (cap < extractCapacity()) return StringDictionary::extractInto(id, buf, cap);
+
+	if ((id == 0) || (id > elements))
+	{
+		buf[0] = (uchar)'\0';
+		return 0;
+	}
+
+	// The DAC bytes are placed behind the decoding room
+	return extractString(id, buf+4*maxlength+table->getK(), buf);
+}
+
+uint
+StringDictionaryHASHUFFDAC::extractCapacity() const
+{
+	return 8*maxlength+table->getK();
+}
+
 IteratorDictID*
-StringDictionaryHASHUFFDAC::locatePrefix(uchar *str, uint strLen)
+StringDictionaryHASHUFFDAC::locatePrefix(uchar *str, uint strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->locatePrefix(str, strLen);
+
 	cout << "This dictionary does not provide prefix location" << endl;
 	return NULL;
 }
 
 IteratorDictID*
-StringDictionaryHASHUFFDAC::locateSubstr(uchar *str, uint strLen)
+StringDictionaryHASHUFFDAC::locateSubstr(uchar *str, uint strLen) const
 {
 	cout << "This dictionary does not provide substring location" << endl;
 	return NULL;
 }
 
-uint
-StringDictionaryHASHUFFDAC::locateRank(uint rank)
+size_t
+StringDictionaryHASHUFFDAC::locateRank(size_t rank) const
 {
+	if (rankIndex != NULL) return rankIndex->locateRank(rank);
+
 	cout << "This dictionary does not provide rank location" << endl;
 	return 0;
 }
 
 IteratorDictString*
-StringDictionaryHASHUFFDAC::extractPrefix(uchar *str, uint strLen)
+StringDictionaryHASHUFFDAC::extractPrefix(uchar *str, uint strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->extractPrefix(str, strLen);
+
 	cout << "This dictionary does not provide prefix extraction" << endl;
 	return NULL;
 }
 
 IteratorDictString*
-StringDictionaryHASHUFFDAC::extractSubstr(uchar *str, uint strLen)
+StringDictionaryHASHUFFDAC::extractSubstr(uchar *str, uint strLen) const
 {
 	cout << "This dictionary does not provide substring extraction" << endl;
 	return NULL;
 }
 
 uchar *
-StringDictionaryHASHUFFDAC::extractRank(uint rank, uint *strLen)
+StringDictionaryHASHUFFDAC::extractRank(size_t rank, uint *strLen) const
 {
+	if (rankIndex != NULL) return rankIndex->extractRank(rank, strLen);
+
 	cout << "This dictionary does not provide rank extraction" << endl;
 	return NULL;
 }
 
 IteratorDictString*
-StringDictionaryHASHUFFDAC::extractTable()
+StringDictionaryHASHUFFDAC::extractTable() const
 {
 	vector<uchar*> tabledec(elements);
 	uint strLen;
 
-	for (uint i=1; i<=elements; i++)
-		tabledec[i-1] = extractString(i, &strLen);
+	for (size_t i=1; i<=elements; i++)
+		tabledec[i-1] = extract(i, &strLen);
 
 	return new IteratorDictStringVector(&tabledec, elements);
 }
 
-uchar*
-StringDictionaryHASHUFFDAC::extractString(size_t id, uint *strLen)
+uint
+StringDictionaryHASHUFFDAC::extractString(size_t id, uchar *dec, uchar *tmp) const
 {
-	uchar *dec = new uchar[4*maxlength];
-	uchar *tmp = new uchar[4*maxlength];
-
 	uint cid = id;
 	uint level = 0;
 
@@ -312,33 +389,41 @@ StringDictionaryHASHUFFDAC::extractString(size_t id, uint *strLen)
 		}
 	}
 
-	delete [] dec;
-
 	if (chunk.c_valid != 0)
 	{
 		do
 		{
-			if (chunk.c_valid < TABLEBITSO)
+			if (chunk.c_valid < table->getK())
 			{
 				// Padding the substring
-				chunk.c_chunk = chunk.c_chunk << (TABLEBITSO-chunk.c_valid);
-				chunk.c_valid=TABLEBITSO;
+				chunk.c_chunk = chunk.c_chunk << (table->getK()-chunk.c_valid);
+				chunk.c_valid=table->getK();
 			}
 		}
 		while (!table->getSubstring(&chunk));
 	}
 
 	tmp[chunk.strLen] = '\0';
-	*strLen = chunk.strLen-1;
+	return chunk.strLen-1;
+}
+
 
-	return tmp;
+void
+StringDictionaryHASHUFFDAC::indexRanks()
+{
+	if (rankIndex == NULL) rankIndex = new RankIndex(this);
 }
 
+void
+StringDictionaryHASHUFFDAC::indexMembership()
+{
+	if (membershipFilter == NULL) membershipFilter = new MembershipFilter(this);
+}
 
 size_t
-StringDictionaryHASHUFFDAC::getSize()
+StringDictionaryHASHUFFDAC::getSize() const
 {
-	return dac->getSize()+hash->getSize()+256*sizeof(Codeword)+table->getSize()+sizeof(StringDictionaryHASHUFFDAC)+256*sizeof(bool);
+	return dac->getSize()+hash->getSize()+256*sizeof(Codeword)+table->getSize()+sizeof(StringDictionaryHASHUFFDAC)+256*sizeof(bool)+((rankIndex != NULL) ? rankIndex->getSize() : 0)+((membershipFilter != NULL) ? membershipFilter->getSize() : 0);
 }
 
 void
@@ -355,30 +440,40 @@ StringDictionaryHASHUFFDAC::save(ofstream &out)
 	// Decoding Table
 	saveValue<Codeword>(out, codewords, 256);
 	table->save(out);
+
+	// Optional alphabetical permutation
+	if (rankIndex != NULL) rankIndex->save(out);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 
 
 StringDictionary*
-StringDictionaryHASHUFFDAC::load(ifstream &in)
+StringDictionaryHASHUFFDAC::load(ifstream &in, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 	if (type != HASHUFFDAC) return NULL;
 
 	StringDictionaryHASHUFFDAC *dict = new StringDictionaryHASHUFFDAC();
+	dict->memoryMapping = mapping;
 
 	dict->type = HASHUFFDAC;
 	dict->elements = loadValue<uint64_t>(in);
 	dict->maxlength = loadValue<uint32_t>(in);
 
 	dict->hash = HashDAC::load(in);
-	dict->dac = DAC_BVLS::load(in);
+	dict->dac = DAC_BVLS::load(in, mapping);
 	dict->hash->setData(dict->dac);
 
 	dict->codewords = loadValue<Codeword>(in, 256);
 	dict->table = DecodingTable::load(in);
 	dict->coder = new StatCoder(dict->table, dict->codewords);
 
+	dict->rankIndex = RankIndex::load(in, dict, mapping);
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
+
 	return dict;
 }
 
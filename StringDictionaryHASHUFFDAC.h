@@ -71,15 +71,28 @@ class StringDictionaryHASHUFFDAC : public StringDictionary
 		    @param len: stream size (in bytes).
 		    @param overhead: overhead that the hash table will use over
 		      the size of the dictionary
+		    @param tablebits: number of bits of the chunks used by the
+		      decoding table (from MINK to MAXK).
 		*/
-		StringDictionaryHASHUFFDAC(IteratorDictString *it, uint len, int overhead);
+		StringDictionaryHASHUFFDAC(IteratorDictString *it, size_t len, int overhead, uint tablebits=TABLEBITSO);
 
 		/** Retrieves the ID corresponding to the given string.
 		    @param str: the string to be searched.
 		    @param strLen: the string length.
 		    @returns the ID (or NORESULT if it is not in the bucket).
 		*/
-		uint locate(uchar *str, uint str_length);
+		size_t locate(uchar *str, uint str_length) const;
+
+		/** Retrieves the IDs corresponding to a batch of strings. All
+		    of them are encoded in advance, so the hash probes can be
+		    interleaved.
+		    @param strs: the strings to be searched.
+		    @param lens: the string lengths.
+		    @param n: the number of strings.
+		    @param out: the resulting IDs (NORESULT for those strings
+		      which are not in the dictionary).
+		*/
+		void locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const;
 
 		/** Obtains the string associated with the given ID.
 		    @param id: the ID to be extracted.
@@ -87,7 +100,25 @@ class StringDictionaryHASHUFFDAC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		 */
-		uchar* extract(size_t id, uint *strLen);
+		uchar* extract(size_t id, uint *strLen) const;
+
+		/** Obtains the string associated with the given ID into a
+		    buffer owned by the caller. The string is directly decoded
+		    on the buffer if its capacity is not lower than
+		    extractCapacity().
+		    @param id: the ID to be extracted.
+		    @param buf: the buffer.
+		    @param cap: the buffer capacity.
+		    @returns the string length (0 if the ID is not in the
+		      dictionary).
+		*/
+		uint extractInto(size_t id, uchar *buf, uint cap) const;
+
+		/** Obtains the buffer capacity with which extractInto decodes
+		    in place: the DAC bytes (up to 4 per
+		    symbol) are read after the room for the chunk decoder.
+		*/
+		uint extractCapacity() const;
 
 		/** Locates all IDs of those elements prefixed by the given
 		    string.
@@ -95,7 +126,7 @@ class StringDictionaryHASHUFFDAC : public StringDictionary
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locatePrefix(uchar *str, uint strLen);
+		IteratorDictID* locatePrefix(uchar *str, uint strLen) const;
 
 		/** Locates all IDs of those elements containing the given
 		    substring.
@@ -103,27 +134,27 @@ class StringDictionaryHASHUFFDAC : public StringDictionary
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locateSubstr(uchar *str, uint strLen);
+		IteratorDictID* locateSubstr(uchar *str, uint strLen) const;
 
 		/** Retrieves the ID with rank k according to its alphabetical order.
 		    @param rank: the alphabetical ranking.
 		    @returns the ID.
 		*/
-		uint locateRank(uint rank);
+		size_t locateRank(size_t rank) const;
 
 		/** Extracts all elements prefixed by the given string.
 		    @param str: the prefix to be searched.
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractPrefix(uchar *str, uint strLen);
+		IteratorDictString* extractPrefix(uchar *str, uint strLen) const;
 
 		/** Extracts all elements containing by the given substring.
 		    @param str: the substring to be searched.
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractSubstr(uchar *str, uint strLen);
+		IteratorDictString* extractSubstr(uchar *str, uint strLen) const;
 
 		/** Obtains the string  with rank k according to its
 		    alphabetical order.
@@ -132,18 +163,28 @@ class StringDictionaryHASHUFFDAC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		*/
-		uchar* extractRank(uint rank, uint *strLen);
+		uchar* extractRank(size_t rank, uint *strLen) const;
 
 		/** Extracts all strings in the dictionary sorted in
 		    alphabetical order.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractTable();
+		IteratorDictString* extractTable() const;
+
+		/** Builds the alphabetical permutation of the IDs, which
+		    enables prefix and rank operations.
+		*/
+		void indexRanks();
+
+		/** Builds the approximate membership filter, so locate 
+		    discards most of the strings not in the dictionary.
+		*/
+		void indexMembership();
 
 		/** Computes the size of the structure in bytes.
 		    @returns the dictionary size in bytes.
 		*/
-		size_t getSize();
+		size_t getSize() const;
 
 		/** Stores the dictionary into an ofstream.
 		    @param out: the oftstream.
@@ -152,9 +193,11 @@ class StringDictionaryHASHUFFDAC : public StringDictionary
 
 		/** Loads a dictionary from an ifstream.
 		    @param in: the ifstream.
+		    @param mapping: the memory mapping of the file (if any). The
+		      dictionary takes its ownership.
 		    @returns the loaded dictionary.
 		*/
-		static StringDictionary *load(ifstream &in);
+		static StringDictionary *load(ifstream &in, MemoryMapping *mapping=NULL);
 
 		/** Generic destructor. */
 		~StringDictionaryHASHUFFDAC();
@@ -176,11 +219,12 @@ class StringDictionaryHASHUFFDAC : public StringDictionary
 		/* Uses the decoding table for extracting the string from the DAC
 		 * representation.
 		 *  @param id: the ID to be extracted.
-		 *  @param strLen: pointer to the extracted string length.
-		 *  @returns the requested string (or NULL if it is not in the
-		      dictionary).
+		 *  @param dec: the buffer for the DAC bytes (4*maxlength).
+		 *  @param tmp: the buffer in which the string is decoded
+		      (4*maxlength+K).
+		 *  @returns the string length.
 		 */
-		inline uchar* extractString(size_t id, uint *strLen);
+		inline uint extractString(size_t id, uchar *dec, uchar *tmp) const;
 };
 
 #endif  /* _STRINGDICTIONARY_HASHHUFFDAC_H */
@@ -43,10 +43,27 @@ StringDictionaryHHTFC::StringDictionaryHHTFC()
 	this->bytesStrings = 0;
 }
 
-StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucketsize)
+StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucketsize, uint tablebits)
 {
 	this->type = HHTFC;
+	setBucketsize(bucketsize);
 
+	// 1) Bulding the Front-Coding representation
+	encodeBuckets(new StringDictionaryPFC(it, this->bucketsize), tablebits);
+}
+
+StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictStringPlain *it, uint bucketsize, uint threads, uint tablebits)
+{
+	this->type = HHTFC;
+	setBucketsize(bucketsize);
+
+	// 1) Bulding the Front-Coding representation in parallel
+	encodeBuckets(new StringDictionaryPFC(it, this->bucketsize, threads), tablebits);
+}
+
+void
+StringDictionaryHHTFC::setBucketsize(uint bucketsize)
+{
 	if (bucketsize < 2)
 	{
 		cerr << "[WARNING] The bucketsize value must be greater than 1. ";
@@ -54,9 +71,11 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 		this->bucketsize = 2;
 	}
 	else this->bucketsize = bucketsize;
+}
 
-	// 1) Bulding the Front-Coding representation
-	StringDictionaryPFC *dict = new StringDictionaryPFC(it, this->bucketsize);
+void
+StringDictionaryHHTFC::encodeBuckets(StringDictionaryPFC *dict, uint tablebits)
+{
 	this->maxlength = dict->maxlength;
 	this->elements = dict->elements;
 	this->buckets = dict->buckets;
@@ -71,7 +90,7 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 	for (uint i=0; i<256; i++) { freqsHT[i]=1; freqsHU[i]=1; }
 
 	size_t pbeg = 0, pend = 0;
-	uint bucket = 1;
+	size_t bucket = 1;
 
 	while (bucket <= dict->buckets)
 	{
@@ -92,17 +111,19 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 	Huffman *hu = new Huffman(freqsHU);
 
 	// Initializing the HuTucker builder
-	DecodingTableBuilder *builderHT = new DecodingTableBuilder();
+	DecodingTableBuilder *builderHT = new DecodingTableBuilder(255, tablebits);
 	builderHT->initializeFromHuTucker(ht);
 	codewordsHT = builderHT->getCodewords();
 	delete [] freqsHT; delete ht;
 
 	// Initializing the Huffman builder
-	DecodingTableBuilder *builderHU = new DecodingTableBuilder();
+	DecodingTableBuilder *builderHU = new DecodingTableBuilder(255, tablebits);
 	builderHU->initializeFromHuffman(hu);
 	codewordsHU = builderHU->getCodewords();
 	delete [] freqsHU; delete hu;
 
+	uint k = builderHT->getK();
+
 	// 3) Compressing the dictionary and building the decoding table
 	{
 		vector<size_t> xblStrings;
@@ -123,7 +144,7 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 		coderHT = new StatCoder(codewordsHT);
 		coderHU = new StatCoder(codewordsHU);
 
-		for (uint current=1; current<=elements; current++)
+		for (size_t current=1; current<=elements; current++)
 		{
 			// Checking the available space in textStrings and 
 			// realloc if required
@@ -165,7 +186,7 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 				if (textSubstr.size() > 0)
 				{
 					// #######################
-					// It is necessary to read up to TABLEBITSO bits for indexing the
+					// It is necessary to read up to k bits for indexing the
 					// substring in the DecodingTable
 					if (offset > 0)
 					{
@@ -174,25 +195,27 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 						ptrSubstr += (8-offset); offset = 0;
 					}
 
-					if (ptrSubstr > TABLEBITSO)
+					if (ptrSubstr > k)
 					{
-						codeSubstr = codeSubstr >> (ptrSubstr - TABLEBITSO);
-						ptrSubstr = TABLEBITSO;
+						codeSubstr = codeSubstr >> (ptrSubstr - k);
+						ptrSubstr = k;
 					}
 					else
 					{
 						if (current == elements)
 						{
-							// The last element is directly padded
-							codeSubstr = (codeSubstr << (TABLEBITSO-ptrSubstr));
-							ptrSubstr = TABLEBITSO;
+							// The last element is directly padded (the
+							// closing byte is read as padding in decoding)
+							codeSubstr = (codeSubstr << (k-ptrSubstr));
+							ptrSubstr = k;
+							textStrings[bytesStrings] = 0;
 							break;
 						}
 
 						uint read = 0;
 						uint nextst = current+1;
 
-						while (TABLEBITSO > ptrSubstr)
+						while (k > ptrSubstr)
 						{
 							{
 								// The VByte value is independently encoded to avoid confusions due to '\0' bytes
@@ -205,7 +228,7 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 									uint bits = codewordsHU[(int)symbol].bits;
 									uint codeword = codewordsHU[(int)symbol].codeword;
 
-									if ((bits+ptrSubstr) <= TABLEBITSO)
+									if ((bits+ptrSubstr) <= k)
 									{
 										codeSubstr = (codeSubstr << bits) | codeword;
 										ptrSubstr += bits;
@@ -213,23 +236,23 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 									}
 									else
 									{
-										uint remaining = TABLEBITSO-ptrSubstr;
+										uint remaining = k-ptrSubstr;
 
 										codeSubstr = (codeSubstr << remaining) | (codeword >> (bits-remaining));
-										ptrSubstr = TABLEBITSO;
+										ptrSubstr = k;
 
 										break;
 									}
 								}
 							}
 
-							while (TABLEBITSO > ptrSubstr)
+							while (k > ptrSubstr)
 							{
 								uint symbol = dict->textStrings[ptr+read]; read++;
 								uint bits = codewordsHU[(int)symbol].bits;
 								uint codeword = codewordsHU[(int)symbol].codeword;
 
-								if ((bits+ptrSubstr) <= TABLEBITSO)
+								if ((bits+ptrSubstr) <= k)
 								{
 									codeSubstr = (codeSubstr << bits) | codeword;
 									ptrSubstr += bits;
@@ -241,13 +264,13 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 									{
 										if ((nextst % bucketsize) == 0)
 										{
-											if (((ptrSubstr+(8-offset)) > TABLEBITSO))
+											if (((ptrSubstr+(8-offset)) > k))
 											{
 												offset = offset % 8;
 
 												// The padding bits are enough...
-												codeSubstr = (codeSubstr << (TABLEBITSO-ptrSubstr));
-												ptrSubstr = TABLEBITSO;
+												codeSubstr = (codeSubstr << (k-ptrSubstr));
+												ptrSubstr = k;
 											}
 											else
 											{
@@ -257,7 +280,7 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 													uint bits = codewordsHT[(int)symbol].bits;
 													uint codeword = codewordsHT[(int)symbol].codeword;
 
-													if ((bits+ptrSubstr) <= TABLEBITSO)
+													if ((bits+ptrSubstr) <= k)
 													{
 														codeSubstr = (codeSubstr << bits) | codeword;
 														ptrSubstr += bits;
@@ -266,10 +289,10 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 													}
 													else
 													{
-														uint remaining = TABLEBITSO-ptrSubstr;
+														uint remaining = k-ptrSubstr;
 
 														codeSubstr = (codeSubstr << remaining) | (codeword >> (bits-remaining));
-														ptrSubstr = TABLEBITSO;
+														ptrSubstr = k;
 
 														break;
 													}
@@ -280,10 +303,10 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 								}
 								else
 								{
-									uint remaining = TABLEBITSO-ptrSubstr;
+									uint remaining = k-ptrSubstr;
 
 									codeSubstr = (codeSubstr << remaining) | (codeword >> (bits-remaining));
-									ptrSubstr = TABLEBITSO;
+									ptrSubstr = k;
 
 									break;
 								}
@@ -347,9 +370,17 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 
 		delete [] tmp;
 
+		// Obtaining the positional index (the last string is encoded
+		// as a header or as an internal string)
+		if (textSubstr.size() > 0)
+		{
+			if (((elements-1)%bucketsize) == 0) builderHT->insertEndingSubstr(&codeSubstr, &ptrSubstr, &textSubstr, &lenSubstr);
+			else builderHU->insertEndingSubstr(&codeSubstr, &ptrSubstr, &textSubstr, &lenSubstr);
+		}
+
 		bytesStrings++;
 		xblStrings.push_back(bytesStrings);
-		blStrings = new LogSequence(&xblStrings, bits(bytesStrings));
+		blStrings = new LogSequence(&xblStrings, bits(bytesStrings), true);
 
 		maxcomplength += 4; // The value is increased because advanced readings in decoding...
 	}
@@ -361,10 +392,12 @@ StringDictionaryHHTFC::StringDictionaryHHTFC(IteratorDictString *it, uint bucket
 	tableHU = builderHU->getTable(); delete builderHU;
 }
 
-uint 
-StringDictionaryHHTFC::locate(uchar *str, uint strLen)
+size_t 
+StringDictionaryHHTFC::locate(uchar *str, uint strLen) const
 {
-	uint id = NORESULT;
+	// Strings discarded by the membership filter are not in the dictionary
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
+
 	// Encoding the string
 	uint encLen, offset;
 	uchar *encoded = coderHT->encodeString(str, strLen+1, &encLen, &offset);
@@ -375,73 +408,111 @@ StringDictionaryHHTFC::locate(uchar *str, uint strLen)
 	delete [] encoded;
 
 	// The string is the header of the bucket
-	if (cmp) id = ((idbucket-1)*bucketsize)+1;
-	else
+	if (cmp) return ((idbucket-1)*bucketsize)+1;
+	// The bucket is sequentially scanned to find the string
+	else return locateInBucket(idbucket, str, strLen);
+}
+
+void
+StringDictionaryHHTFC::locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const
+{
+	uchar *encoded[BATCHSIZE];
+	uint encLen[BATCHSIZE];
+	size_t slot[BATCHSIZE], idbuckets[BATCHSIZE];
+	bool headers[BATCHSIZE];
+	uint offset;
+
+	for (size_t i=0; i<n; i+=BATCHSIZE)
 	{
-		// The string is previous to any other one in the dictionary
-		if (idbucket != NORESULT)
+		size_t group = min(BATCHSIZE, n-i), searched = 0;
+
+		// Encoding the strings (those discarded by the membership
+		// filter are not searched)
+		for (size_t j=0; j<group; j++)
+		{
+			if ((membershipFilter != NULL) && !membershipFilter->contains(strs[i+j], lens[i+j]))
+			{
+				out[i+j] = NORESULT;
+				continue;
+			}
+
+			encoded[searched] = coderHT->encodeString((uchar*)strs[i+j], lens[i+j]+1, &encLen[searched], &offset);
+			slot[searched++] = i+j;
+		}
+
+		locateBucketBatch(encoded, encLen, searched, idbuckets, headers);
+
+		for (size_t j=0; j<searched; j++)
 		{
-			// The bucket is sequentially scanned to find the string
-			ChunkScan c = decodeHeader(idbucket);
-			resetScan(&c, idbucket);
+			size_t s = slot[j];
 
-			uint scanneable = bucketsize;
-			if ((idbucket == buckets) && ((elements%bucketsize) != 0)) scanneable = (elements%bucketsize);
+			if (headers[j]) out[s] = ((idbuckets[j]-1)*bucketsize)+1;
+			else out[s] = locateInBucket(idbuckets[j], (uchar*)strs[s], lens[s]);
 
-			if (scanneable > 1)
-			{
-				uint sharedCurr=0, sharedPrev=0;
-				int cmp=0;
+			delete [] encoded[j];
+		}
+	}
+}
+
+size_t
+StringDictionaryHHTFC::locateInBucket(size_t idbucket, uchar *str, uint strLen) const
+{
+	size_t id = NORESULT;
+
+	// The string is previous to any other one in the dictionary
+	if (idbucket != NORESULT)
+	{
+		// The bucket is sequentially scanned to find the string
+		ChunkScan c = decodeHeader(idbucket);
+		resetScan(&c, idbucket);
 
-				// Processing the first internal string
-				sharedPrev = coderHU->decodeString(&c);
-				cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
+		uint scanneable = bucketsize;
+		if ((idbucket == buckets) && ((elements%bucketsize) != 0)) scanneable = (elements%bucketsize);
 
-				if (cmp != 0)
+		if (scanneable > 1)
+		{
+			uint sharedCurr=0, sharedPrev=0;
+			int cmp=0;
+
+			// Processing the first internal string
+			sharedPrev = coderHU->decodeString(&c);
+			cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
+
+			if (cmp != 0)
+			{
+				for (uint i=2; i<scanneable; i++)
 				{
-					for (uint i=2; i<scanneable; i++)
-					{
-						sharedPrev = coderHU->decodeString(&c);
-						if  (sharedPrev < sharedCurr) break;
+					sharedPrev = coderHU->decodeString(&c);
+					if  (sharedPrev < sharedCurr) break;
 
-						cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
+					cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
 
-						if (cmp==0)
-						{
-							id = ((idbucket-1)*bucketsize)+i+1;
-							break;
-						}
-						else if (cmp > 0) break;
+					if (cmp==0)
+					{
+						id = ((idbucket-1)*bucketsize)+i+1;
+						break;
 					}
+					else if (cmp > 0) break;
 				}
-				else id = ((idbucket-1)*bucketsize)+2;
 			}
-
-			delete [] c.str;
+			else id = ((idbucket-1)*bucketsize)+2;
 		}
-    	}
+
+		delete [] c.str;
+	}
 
 	return id;
 }
 
 uchar *
-StringDictionaryHHTFC::extract(size_t id, uint *strLen)
+StringDictionaryHHTFC::extract(size_t id, uint *strLen) const
 {
 	if ((id > 0) && (id <= elements))
 	{
-		uint idbucket = 1+((id-1)/bucketsize);
-		uint pos = ((id-1)%bucketsize);
+		uchar *s = new uchar[extractCapacity()];
+		*strLen = extractInto(id, s, extractCapacity());
 
-		ChunkScan c = decodeHeader(idbucket);
-
-		if (pos > 0)
-		{
-			resetScan(&c, idbucket);
-			for (uint i=1; i<=pos; i++) coderHU->decodeString(&c);
-		}
-
-		*strLen = c.strLen-1;
-		return c.str;
+		return s;
 	}
 	else
 	{
@@ -450,8 +521,90 @@ StringDictionaryHHTFC::extract(size_t id, uint *strLen)
 	}
 }
 
+uint
+StringDictionaryHHTFC::extractInto(size_t id, uchar *buf, uint cap) const
+{
+	// The chunks are decoded on the buffer if it has enough slack
+	if (cap < extractCapacity()) return StringDictionary::extractInto(id, buf, cap);
+
+	if ((id == 0) || (id > elements))
+	{
+		buf[0] = (uchar)'\0';
+		return 0;
+	}
+
+	size_t idbucket = 1+((id-1)/bucketsize);
+	uint pos = ((id-1)%bucketsize);
+
+	ChunkScan c = decodeHeader(idbucket, buf);
+
+	if (pos > 0)
+	{
+		resetScan(&c, idbucket);
+		for (uint i=1; i<=pos; i++) coderHU->decodeString(&c);
+	}
+
+	buf[c.strLen-1] = (uchar)'\0';
+	return c.strLen-1;
+}
+
+uint
+StringDictionaryHHTFC::extractCapacity() const
+{
+	return 4*maxlength+max(tableHT->getK(), tableHU->getK());
+}
+
+void
+StringDictionaryHHTFC::extractBatch(const size_t *ids, size_t n, ByteArena &arena, size_t *offsets, uint *lengths) const
+{
+	vector<pair<size_t, size_t> > requests;
+	sortRequests(ids, n, &requests);
+
+	ChunkScan c;
+	uchar *scratch = new uchar[extractCapacity()];
+	size_t idbucket = 0;
+	uint pos = 0;
+
+	for (size_t i=0; i<n; i++)
+	{
+		size_t id = requests[i].first, req = requests[i].second;
+
+		if ((i > 0) && (id == requests[i-1].first))
+		{
+			// Repeated ID: the previous decoding is referenced
+			offsets[req] = offsets[requests[i-1].second];
+			lengths[req] = lengths[requests[i-1].second];
+			continue;
+		}
+
+		if ((id == 0) || (id > elements))
+		{
+			offsets[req] = arena.append((uchar*)"", 0);
+			lengths[req] = 0;
+			continue;
+		}
+
+		if (1+((id-1)/bucketsize) != idbucket)
+		{
+			// Moving to the header of a new bucket
+			idbucket = 1+((id-1)/bucketsize);
+			c = decodeHeader(idbucket, scratch);
+			pos = 0;
+		}
+
+		// Decoding up to the requested string
+		if ((pos == 0) && (((id-1)%bucketsize) > 0)) resetScan(&c, idbucket);
+		for (; pos<((id-1)%bucketsize); pos++) coderHU->decodeString(&c);
+
+		offsets[req] = arena.append(c.str, c.strLen-1);
+		lengths[req] = c.strLen-1;
+	}
+
+	delete [] scratch;
+}
+
 IteratorDictID*
-StringDictionaryHHTFC::locatePrefix(uchar *str, uint strLen)
+StringDictionaryHHTFC::locatePrefix(uchar *str, uint strLen) const
 {
 	// Encoding the string
 	uint encLen, offset;
@@ -530,62 +683,91 @@ StringDictionaryHHTFC::locatePrefix(uchar *str, uint strLen)
 }
 
 IteratorDictID*
-StringDictionaryHHTFC::locateSubstr(uchar *str, uint strLen)
+StringDictionaryHHTFC::locateSubstr(uchar *str, uint strLen) const
 {
+	if (substringIndex != NULL) return substringIndex->locate(str, strLen);
+
 	cerr << "This dictionary does not provide substring location" << endl;
 	return NULL;
 }
 
-uint 
-StringDictionaryHHTFC::locateRank(uint rank)
+size_t 
+StringDictionaryHHTFC::locateRank(size_t rank) const
 {
 	return rank;
 }
 
 IteratorDictString*
-StringDictionaryHHTFC::extractPrefix(uchar *str, uint strLen)
+StringDictionaryHHTFC::extractPrefix(uchar *str, uint strLen) const
 {
 	IteratorDictIDContiguous *it = (IteratorDictIDContiguous*)locatePrefix(str, strLen);
 	size_t left = it->getLeftLimit();
+	size_t right = it->getRightLimit();
 
-	if (left != NORESULT)
-	{
-		// Positioning the LEFT Limit
-		uint leftbucket = 1+((left-1)/bucketsize);
-		uint leftpos = ((left-1)%bucketsize);
-
-		// Positioning the RIGHT Limit
-		size_t right = it->getRightLimit();
-		delete it;
+	delete it;
 
-		return new IteratorDictStringHHTFC(tableHT, tableHU, codewordsHT, textStrings, blStrings, leftbucket, leftpos, bucketsize, right-left+1, maxlength, maxcomplength);
-	}
+	if (left != NORESULT) return extractRange(left, right);
 	else return NULL;
 }
 
 IteratorDictString*
-StringDictionaryHHTFC::extractSubstr(uchar *str, uint strLen)
+StringDictionaryHHTFC::extractRange(size_t left, size_t right) const
+{
+	// Positioning the LEFT Limit
+	size_t leftbucket = 1+((left-1)/bucketsize);
+	uint leftpos = ((left-1)%bucketsize);
+
+	return new IteratorDictStringHHTFC(tableHT, tableHU, codewordsHT, textStrings, blStrings, leftbucket, leftpos, bucketsize, right-left+1, maxlength, maxcomplength);
+}
+
+IteratorDictString*
+StringDictionaryHHTFC::extractSubstr(uchar *str, uint strLen) const
 {
+	if (substringIndex != NULL) return substringIndex->extract(str, strLen);
+
 	cerr << "This dictionary does not provide substring extraction" << endl;
 	return 0; 
 }
 
 uchar *
-StringDictionaryHHTFC::extractRank(uint rank, uint *strLen)
+StringDictionaryHHTFC::extractRank(size_t rank, uint *strLen) const
 {
 	return extract(rank, strLen);
 }
 
 IteratorDictString*
-StringDictionaryHHTFC::extractTable()
+StringDictionaryHHTFC::extractTable() const
 {
 	return new IteratorDictStringHHTFC(tableHT, tableHU, codewordsHT, textStrings, blStrings, 1, 0, bucketsize, elements, maxlength, maxcomplength);
 }
 
 size_t 
-StringDictionaryHHTFC::getSize()
+StringDictionaryHHTFC::getSize() const
+{
+	size_t size = bytesStrings*sizeof(uchar)+blStrings->getSize()+256*2*sizeof(Codeword)+tableHT->getSize()+tableHU->getSize()+sizeof(StringDictionaryHHTFC);
+	if (headerIndex != NULL) size += headerIndex->getSize();
+	if (substringIndex != NULL) size += substringIndex->getSize();
+	if (membershipFilter != NULL) size += membershipFilter->getSize();
+
+	return size;
+}
+
+void
+StringDictionaryHHTFC::indexHeaders()
+{
+	if (headerIndex == NULL) headerIndex = new HeaderIndex(textStrings, bytesStrings, blStrings, buckets, false);
+}
+
+void
+StringDictionaryHHTFC::indexSubstrings()
+{
+	if (substringIndex == NULL) substringIndex = new SubstringIndex(this, bucketsize);
+}
+
+void
+StringDictionaryHHTFC::indexMembership()
 {
-	return bytesStrings*sizeof(uchar)+blStrings->getSize()+256*2*sizeof(Codeword)+tableHT->getSize()+tableHU->getSize()+sizeof(StringDictionaryHHTFC);
+	if (membershipFilter == NULL) membershipFilter = new MembershipFilter(this);
 }
 
 void 
@@ -595,26 +777,34 @@ StringDictionaryHHTFC::save(ofstream &out)
 	saveValue<uint64_t>(out, elements);
 	saveValue<uint32_t>(out, maxlength);
 	saveValue<uint32_t>(out, maxcomplength);
-	saveValue<uint32_t>(out, buckets);
+	saveValue<uint32_t>(out, (buckets < WIDEBUCKETS) ? (uint32_t)buckets : WIDEBUCKETS);
 	saveValue<uint32_t>(out, bucketsize);
 
 	saveValue<uint64_t>(out, bytesStrings);
 	saveValue<uchar>(out, textStrings, bytesStrings);
 	blStrings->save(out);	
+	if (buckets >= WIDEBUCKETS) saveValue<uint64_t>(out, buckets);
 
 	saveValue<Codeword>(out, codewordsHT, 256);
 	tableHT->save(out);
 	saveValue<Codeword>(out, codewordsHU, 256);
 	tableHU->save(out);
+
+	// Optional substring index
+	if (substringIndex != NULL) substringIndex->save(out);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 StringDictionary*
-StringDictionaryHHTFC::load(ifstream &in)
+StringDictionaryHHTFC::load(ifstream &in, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 	if(type != HHTFC) return NULL;
 
 	StringDictionaryHHTFC *dict = new StringDictionaryHHTFC();
+	dict->memoryMapping = mapping;
 
 	dict->type = HHTFC;
 	dict->elements = loadValue<uint64_t>(in);
@@ -624,8 +814,9 @@ StringDictionaryHHTFC::load(ifstream &in)
 	dict->bucketsize = loadValue<uint32_t>(in);
 
 	dict->bytesStrings = loadValue<uint64_t>(in);
-	dict->textStrings = loadValue<uchar>(in, dict->bytesStrings);
-	dict->blStrings = new LogSequence(in);
+	dict->textStrings = MemoryMapping::loadArray<uchar>(mapping, in, dict->bytesStrings);
+	dict->blStrings = new LogSequence(in, mapping);
+	if (dict->buckets == WIDEBUCKETS) dict->buckets = loadValue<uint64_t>(in);
 
 	dict->codewordsHT = loadValue<Codeword>(in, 256);
 	dict->tableHT = DecodingTable::load(in);
@@ -635,11 +826,14 @@ StringDictionaryHHTFC::load(ifstream &in)
 	dict->tableHU = DecodingTable::load(in);
 	dict->coderHU = new StatCoder(dict->tableHU, dict->codewordsHU);
 
+	dict->substringIndex = SubstringIndex::load(in, dict, mapping);
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
+
 	return dict;
 }
 
 uchar*
-StringDictionaryHHTFC::getHeader(size_t idbucket)
+StringDictionaryHHTFC::getHeader(size_t idbucket) const
 {
 	size_t ptrH = blStrings->getField(idbucket);
 	uchar *header = textStrings+ptrH;
@@ -647,11 +841,30 @@ StringDictionaryHHTFC::getHeader(size_t idbucket)
 	return header;
 }
 
+int
+StringDictionaryHHTFC::compareHeader(size_t idbucket, uchar *str, uint strLen, uchar cmask) const
+{
+	if (strLen == 0) return 0;
+
+	// Hu-Tucker codes preserve the order, so the encoded header and the
+	// encoded string are directly compared. They differ before the end
+	// of the shortest one, so no byte beyond the strings is required.
+	uchar *header = getHeader(idbucket);
+	size_t avail = textStrings+bytesStrings-header;
+	if (avail < strLen) return compareBytes(header, str, avail);
+
+	int cmp = compareBytes(header, str, strLen-1);
+	if (cmp != 0) return cmp;
+
+	return (header[strLen-1] & cmask) - str[strLen-1];
+}
+
 ChunkScan
-StringDictionaryHHTFC::decodeHeader(size_t idbucket)
+StringDictionaryHHTFC::decodeHeader(size_t idbucket, uchar *buf) const
 {
 	uchar* ptr = textStrings+blStrings->getField(idbucket);
-	ChunkScan chunk = {0, 0, ptr, maxcomplength, new uchar[4*maxlength+tableHT->getK()], 0, 0, 1};
+	uint remain = min((size_t)maxcomplength, (size_t)(textStrings+bytesStrings-ptr));
+	ChunkScan chunk = {0, 0, ptr, remain, (buf != NULL) ? buf : new uchar[extractCapacity()], 0, 0, 1};
 
 	// Variables used for adjusting purposes
 	uint plen = 0;
@@ -682,19 +895,19 @@ StringDictionaryHHTFC::decodeHeader(size_t idbucket)
 }
 
 bool 
-StringDictionaryHHTFC::locateBucket(uchar *str, uint strLen, size_t *idbucket)
+StringDictionaryHHTFC::locateBucket(uchar *str, uint strLen, size_t *idbucket) const
 {
 	size_t left = 1, right = buckets, center = 0;
     int cmp = 0;
 
-	uchar *header;
+	// Narrowing the search to the buckets whose headers share the key
+	if (headerIndex != NULL) headerIndex->narrow(str, strLen, &left, &right);
 
 	while (left <= right)
     {
 		center = (left+right)/2;
-		header = getHeader(center);
 
-       		cmp = memcmp(header, str, strLen);
+       		cmp = compareHeader(center, str, strLen, 0xFF);
 
 		// The string is in any preceding bucket
 		if (cmp > 0) right = center-1;
@@ -708,31 +921,84 @@ StringDictionaryHHTFC::locateBucket(uchar *str, uint strLen, size_t *idbucket)
 		}
 	}
 
-	// c is the candidate bucket for the string
-	if (cmp < 0) *idbucket = center;
-	// c-1 is the candidate bucket for the string
-	else *idbucket = center-1;
+	// The rightmost bucket whose header is lower than the string is
+	// the candidate one
+	*idbucket = right;
 
 	return false;
 }
 
 void
-StringDictionaryHHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offset, size_t *left, size_t *right)
+StringDictionaryHHTFC::locateBucketBatch(uchar **strs, const uint *lens, size_t n, size_t *idbuckets, bool *headers) const
+{
+	size_t left[BATCHSIZE], right[BATCHSIZE], center[BATCHSIZE];
+	size_t active = n;
+
+	for (size_t i=0; i<n; i++)
+	{
+		left[i] = 1; right[i] = buckets; headers[i] = false;
+		if (headerIndex != NULL) headerIndex->narrow(strs[i], lens[i], &left[i], &right[i]);
+
+		if (left[i] > right[i])
+		{
+			// The header key already determines the candidate bucket
+			idbuckets[i] = right[i];
+			active--;
+		}
+		else
+		{
+			center[i] = (left[i]+right[i])/2;
+			blStrings->prefetch(center[i]);
+		}
+	}
+
+	while (active > 0)
+	{
+		// Reading the header positions and prefetching the headers
+		for (size_t i=0; i<n; i++)
+			if (left[i] <= right[i]) PREFETCH(getHeader(center[i]));
+
+		// Comparing the headers while the remaining ones are loaded
+		for (size_t i=0; i<n; i++)
+		{
+			if (left[i] > right[i]) continue;
+
+			int cmp = compareHeader(center[i], strs[i], lens[i], 0xFF);
+
+			if (cmp > 0) right[i] = center[i]-1;
+			else if (cmp < 0) left[i] = center[i]+1;
+			else { headers[i] = true; left[i] = center[i]+1; right[i] = center[i]; }
+
+			if (left[i] > right[i])
+			{
+				// The rightmost bucket whose header is not greater
+				// than the string is the candidate one
+				idbuckets[i] = right[i];
+				active--;
+			}
+			else
+			{
+				center[i] = (left[i]+right[i])/2;
+				blStrings->prefetch(center[i]);
+			}
+		}
+	}
+}
+
+void
+StringDictionaryHHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offset, size_t *left, size_t *right) const
 {
 	size_t center = 0;
 	int cmp = 0;
 
-	uchar *header = new uchar[4*strLen];
-
-	uchar cmask = (uchar)(~(mask(8) >> offset));
+	// Only the used bits of the last byte are compared
+	uchar cmask = (offset != 0) ? (uchar)(~(mask(8) >> offset)) : 0xFF;
 
 	while (*left <= *right)
 	{
 		center = (*left+*right)/2;
 
-		memcpy(header, getHeader(center), strLen);
-		if (offset != 0) header[strLen-1] = header[strLen-1] & cmask;
-       		cmp = memcmp(header, str, strLen);
+		cmp = compareHeader(center, str, strLen, cmask);
 
 		if (cmp > 0) *right = center-1;
 		else if (cmp < 0) *left = center+1;
@@ -745,22 +1011,19 @@ StringDictionaryHHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offse
         	if (cmp < 0) { *left = center; *right = center;}
 	    	else { *left = center-1; *right = center-1; }
 
-		delete [] header;
 		return;
 	}
 
 	if (center > 1)
 	{
 		// Looking for the left boundary
-		uint ll = *left, lr = center-1, lc;
+		size_t ll = *left, lr = center-1, lc;
 
 		while (ll <= lr)
 		{
 			lc = (ll+lr)/2;
 
-			memcpy(header, getHeader(lc), strLen);
-			if (offset != 0) header[strLen-1] = header[strLen-1] & cmask;
-		    cmp = memcmp(header, str, strLen);
+			cmp = compareHeader(lc, str, strLen, cmask);
 
 			if (cmp == 0) lr = lc-1;
 			else ll = lc+1;
@@ -773,15 +1036,13 @@ StringDictionaryHHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offse
 	if (center < buckets)
 	{
 		// Looking for the right boundary
-		uint rl = center, rr = *right+1, rc;
+		size_t rl = center, rr = *right+1, rc;
 
 		while (rl < (rr-1))
 		{
 			rc = (rl+rr)/2;
 
-			memcpy(header, getHeader(rc), strLen);
-			if (offset != 0) header[strLen-1] = header[strLen-1] & cmask;
-		    cmp = memcmp(header, str, strLen);
+			cmp = compareHeader(rc, str, strLen, cmask);
 
 			if (cmp == 0) rl = rc;
 		    else rr = rc;
@@ -789,12 +1050,10 @@ StringDictionaryHHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offse
 
 		*right = rl;
 	}
-
-	delete [] header;
 }
 
 uint 
-StringDictionaryHHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen)
+StringDictionaryHHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen) const
 {
 	uint id = NORESULT;
 
@@ -804,7 +1063,7 @@ StringDictionaryHHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str, u
 	uint i=1;
 	while (true)
 	{
-		cmp=longestCommonPrefix(c->str+sharedCurr, str+sharedCurr, c->strLen-sharedCurr-1, &sharedCurr);
+		cmp=longestCommonPrefix(c->str+sharedCurr, str+sharedCurr, min(c->strLen-1, strLen)-sharedCurr, &sharedCurr);
 
 		if (sharedCurr==strLen) { id = i; break; }
 		else
@@ -823,7 +1082,7 @@ StringDictionaryHHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str, u
 
 
 uint
-StringDictionaryHHTFC::searchDistinctPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen)
+StringDictionaryHHTFC::searchDistinctPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen) const
 {
 	uint id = 1;
 
@@ -836,7 +1095,7 @@ StringDictionaryHHTFC::searchDistinctPrefix(ChunkScan* c, uint scanneable, uchar
 }
 
 void
-StringDictionaryHHTFC::resetScan(ChunkScan *c, size_t idbucket)
+StringDictionaryHHTFC::resetScan(ChunkScan *c, size_t idbucket) const
 {
 	c->c_chunk = 0;
 	c->c_valid = 0;
@@ -847,7 +1106,7 @@ StringDictionaryHHTFC::resetScan(ChunkScan *c, size_t idbucket)
 
 StringDictionaryHHTFC::~StringDictionaryHHTFC()
 {
-	delete [] textStrings; delete blStrings;
+	MemoryMapping::release(memoryMapping, textStrings); delete blStrings;
 	delete coderHT; delete coderHU;
 	delete [] codewordsHT;  delete [] codewordsHU;
 	delete tableHT; delete tableHU;
@@ -43,10 +43,27 @@ StringDictionaryHTFC::StringDictionaryHTFC()
 	this->bytesStrings = 0;
 }
 
-StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsize)
+StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsize, uint tablebits)
 {
 	this->type = HTFC;
+	setBucketsize(bucketsize);
 
+	// 1) Bulding the Front-Coding representation
+	encodeBuckets(new StringDictionaryPFC(it, this->bucketsize), tablebits);
+}
+
+StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictStringPlain *it, uint bucketsize, uint threads, uint tablebits)
+{
+	this->type = HTFC;
+	setBucketsize(bucketsize);
+
+	// 1) Bulding the Front-Coding representation in parallel
+	encodeBuckets(new StringDictionaryPFC(it, this->bucketsize, threads), tablebits);
+}
+
+void
+StringDictionaryHTFC::setBucketsize(uint bucketsize)
+{
 	if (bucketsize < 2)
 	{
 		cerr << "[WARNING] The bucketsize value must be greater than 1. ";
@@ -54,9 +71,11 @@ StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsi
 		this->bucketsize = 2;
 	}
 	else this->bucketsize = bucketsize;
+}
 
-	// 1) Bulding the Front-Coding representation
-	StringDictionaryPFC *dict = new StringDictionaryPFC(it, this->bucketsize);
+void
+StringDictionaryHTFC::encodeBuckets(StringDictionaryPFC *dict, uint tablebits)
+{
 	this->maxlength = dict->maxlength;
 	this->elements = dict->elements;
 	this->maxcomplength = 0;
@@ -73,11 +92,13 @@ StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsi
 	HuTucker *ht = new HuTucker(freqs);
 
 	// Initializing the builder
-	DecodingTableBuilder *builder = new DecodingTableBuilder();
+	DecodingTableBuilder *builder = new DecodingTableBuilder(255, tablebits);
 	builder->initializeFromHuTucker(ht);
 	codewords = builder->getCodewords();
 	delete [] freqs; delete ht;
 
+	uint k = builder->getK();
+
 	// 3) Compressing the dictionary and building the decoding table
 	{
 		vector<size_t> xblStrings;
@@ -97,7 +118,7 @@ StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsi
 
 		coder = new StatCoder(codewords);
 
-		for (uint current=1; current<=elements; current++)
+		for (size_t current=1; current<=elements; current++)
 		{
 			// Checking the available space in textStrings and 
 			// realloc if required
@@ -144,25 +165,27 @@ StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsi
 						ptrSubstr += (8-offset); offset = 0;
 					}
 
-					if (ptrSubstr > TABLEBITSO)
+					if (ptrSubstr > k)
 					{
-						codeSubstr = codeSubstr >> (ptrSubstr - TABLEBITSO);
-						ptrSubstr = TABLEBITSO;
+						codeSubstr = codeSubstr >> (ptrSubstr - k);
+						ptrSubstr = k;
 					}
 					else
 					{
 						if (current == elements)
 						{
-							// The last element is directly padded
-							codeSubstr = (codeSubstr << (TABLEBITSO-ptrSubstr));
-							ptrSubstr = TABLEBITSO;
+							// The last element is directly padded (the
+							// closing byte is read as padding in decoding)
+							codeSubstr = (codeSubstr << (k-ptrSubstr));
+							ptrSubstr = k;
+							textStrings[bytesStrings] = 0;
 							break;
 						}
 
 						uint read = 0;
 						uint nextst = current+1;
 
-						while (TABLEBITSO > ptrSubstr)
+						while (k > ptrSubstr)
 						{
 							{
 								// The VByte value is independently encoded to avoid confusions due to '\0' bytes
@@ -175,7 +198,7 @@ StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsi
 									uint bits = codewords[(int)symbol].bits;
 									uint codeword = codewords[(int)symbol].codeword;
 
-									if ((bits+ptrSubstr) <= TABLEBITSO)
+									if ((bits+ptrSubstr) <= k)
 									{
 										codeSubstr = (codeSubstr << bits) | codeword;
 										ptrSubstr += bits;
@@ -183,10 +206,10 @@ StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsi
 									}
 									else
 									{
-										uint remaining = TABLEBITSO-ptrSubstr;
+										uint remaining = k-ptrSubstr;
 
 										codeSubstr = (codeSubstr << remaining) | (codeword >> (bits-remaining));
-										ptrSubstr = TABLEBITSO;
+										ptrSubstr = k;
 
 										break;
 									}
@@ -199,7 +222,7 @@ StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsi
 								uint bits = codewords[(int)symbol].bits;
 								uint codeword = codewords[(int)symbol].codeword;
 
-								if ((bits+ptrSubstr) <= TABLEBITSO)
+								if ((bits+ptrSubstr) <= k)
 								{
 									codeSubstr = (codeSubstr << bits) | codeword;
 									ptrSubstr += bits;
@@ -211,23 +234,23 @@ StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsi
 										{
 											if ((nextst % bucketsize) == 0)
 											{
-												if (((ptrSubstr+(8-offset)) > TABLEBITSO))
+												if (((ptrSubstr+(8-offset)) > k))
 												{
 													offset = offset % 8;
 
 													// The padding bits are enough...
-													codeSubstr = (codeSubstr << (TABLEBITSO-ptrSubstr));
-													ptrSubstr = TABLEBITSO;
+													codeSubstr = (codeSubstr << (k-ptrSubstr));
+													ptrSubstr = k;
 												}
 											}
 										}
 								}
 								else
 								{
-									uint remaining = TABLEBITSO-ptrSubstr;
+									uint remaining = k-ptrSubstr;
 
 									codeSubstr = (codeSubstr << remaining) | (codeword >> (bits-remaining));
-									ptrSubstr = TABLEBITSO;
+									ptrSubstr = k;
 
 									break;
 								}
@@ -297,7 +320,7 @@ StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsi
 
 		bytesStrings++;
 		xblStrings.push_back(bytesStrings);
-		blStrings = new LogSequence(&xblStrings, bits(bytesStrings));
+		blStrings = new LogSequence(&xblStrings, bits(bytesStrings), true);
 
 		maxcomplength += 4; // The value is increased because advanced readings in decoding...
 	}
@@ -308,10 +331,11 @@ StringDictionaryHTFC::StringDictionaryHTFC(IteratorDictString *it, uint bucketsi
 	delete builder;
 }
 
-uint 
-StringDictionaryHTFC::locate(uchar *str, uint strLen)
+size_t 
+StringDictionaryHTFC::locate(uchar *str, uint strLen) const
 {
-	uint id = NORESULT;
+	// Strings discarded by the membership filter are not in the dictionary
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
 
 	// Encoding the string
 	uint encLen, offset;
@@ -323,72 +347,111 @@ StringDictionaryHTFC::locate(uchar *str, uint strLen)
 	delete [] encoded;
 
 	// The string is the header of the bucket
-	if (cmp) id = ((idbucket-1)*bucketsize)+1;
-	else
+	if (cmp) return ((idbucket-1)*bucketsize)+1;
+	// The bucket is sequentially scanned to find the string
+	else return locateInBucket(idbucket, str, strLen);
+}
+
+void
+StringDictionaryHTFC::locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const
+{
+	uchar *encoded[BATCHSIZE];
+	uint encLen[BATCHSIZE];
+	size_t slot[BATCHSIZE], idbuckets[BATCHSIZE];
+	bool headers[BATCHSIZE];
+	uint offset;
+
+	for (size_t i=0; i<n; i+=BATCHSIZE)
 	{
-		if (idbucket != NORESULT)
+		size_t group = min(BATCHSIZE, n-i), searched = 0;
+
+		// Encoding the strings (those discarded by the membership
+		// filter are not searched)
+		for (size_t j=0; j<group; j++)
 		{
-			// The bucket is sequentially scanned to find the string
-			ChunkScan c = decodeHeader(idbucket);
-			resetScan(&c, idbucket);
+			if ((membershipFilter != NULL) && !membershipFilter->contains(strs[i+j], lens[i+j]))
+			{
+				out[i+j] = NORESULT;
+				continue;
+			}
 
-			uint scanneable = bucketsize;
-			if ((idbucket == buckets) && ((elements%bucketsize) != 0)) scanneable = (elements%bucketsize);
+			encoded[searched] = coder->encodeString((uchar*)strs[i+j], lens[i+j]+1, &encLen[searched], &offset);
+			slot[searched++] = i+j;
+		}
 
-			if (scanneable > 1)
-			{
-				uint sharedCurr=0, sharedPrev=0;
-				int cmp=0;
+		locateBucketBatch(encoded, encLen, searched, idbuckets, headers);
+
+		for (size_t j=0; j<searched; j++)
+		{
+			size_t s = slot[j];
+
+			if (headers[j]) out[s] = ((idbuckets[j]-1)*bucketsize)+1;
+			else out[s] = locateInBucket(idbuckets[j], (uchar*)strs[s], lens[s]);
+
+			delete [] encoded[j];
+		}
+	}
+}
+
+size_t
+StringDictionaryHTFC::locateInBucket(size_t idbucket, uchar *str, uint strLen) const
+{
+	size_t id = NORESULT;
+
+	// The string is previous to any other one in the dictionary
+	if (idbucket != NORESULT)
+	{
+		// The bucket is sequentially scanned to find the string
+		ChunkScan c = decodeHeader(idbucket);
+		resetScan(&c, idbucket);
+
+		uint scanneable = bucketsize;
+		if ((idbucket == buckets) && ((elements%bucketsize) != 0)) scanneable = (elements%bucketsize);
+
+		if (scanneable > 1)
+		{
+			uint sharedCurr=0, sharedPrev=0;
+			int cmp=0;
 
-				// Processing the first internal string
-				sharedPrev = coder->decodeString(&c);
-				cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
+			// Processing the first internal string
+			sharedPrev = coder->decodeString(&c);
+			cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
 
-				if (cmp != 0)
+			if (cmp != 0)
+			{
+				for (uint i=2; i<scanneable; i++)
 				{
-					for (uint i=2; i<scanneable; i++)
-					{
-						sharedPrev = coder->decodeString(&c);
-						if  (sharedPrev < sharedCurr) break;
+					sharedPrev = coder->decodeString(&c);
+					if  (sharedPrev < sharedCurr) break;
 
-						cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
+					cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
 
-						if (cmp==0)
-						{
-							id = ((idbucket-1)*bucketsize)+i+1;
-							break;
-						}
-						else if (cmp > 0) break;
+					if (cmp==0)
+					{
+						id = ((idbucket-1)*bucketsize)+i+1;
+						break;
 					}
+					else if (cmp > 0) break;
 				}
-				else id = ((idbucket-1)*bucketsize)+2;
 			}
-
-			delete [] c.str;
+			else id = ((idbucket-1)*bucketsize)+2;
 		}
+
+		delete [] c.str;
 	}
 
 	return id;
 }
 
 uchar *
-StringDictionaryHTFC::extract(size_t id, uint *strLen)
+StringDictionaryHTFC::extract(size_t id, uint *strLen) const
 {
 	if ((id > 0) && (id <= elements))
 	{
-		uint idbucket = 1+((id-1)/bucketsize);
-		uint pos = ((id-1)%bucketsize);
-
-		ChunkScan c = decodeHeader(idbucket);
+		uchar *s = new uchar[extractCapacity()];
+		*strLen = extractInto(id, s, extractCapacity());
 
-		if (pos > 0)
-		{
-			resetScan(&c, idbucket);
-			for (uint i=1; i<=pos; i++) coder->decodeString(&c);
-		}
-
-		*strLen = c.strLen-1;
-		return c.str;
+		return s;
 	}
 	else
 	{
@@ -397,8 +460,90 @@ StringDictionaryHTFC::extract(size_t id, uint *strLen)
 	}
 }
 
+uint
+StringDictionaryHTFC::extractInto(size_t id, uchar *buf, uint cap) const
+{
+	// The chunks are decoded on the buffer if it has enough slack
+	if (cap < extractCapacity()) return StringDictionary::extractInto(id, buf, cap);
+
+	if ((id == 0) || (id > elements))
+	{
+		buf[0] = (uchar)'\0';
+		return 0;
+	}
+
+	size_t idbucket = 1+((id-1)/bucketsize);
+	uint pos = ((id-1)%bucketsize);
+
+	ChunkScan c = decodeHeader(idbucket, buf);
+
+	if (pos > 0)
+	{
+		resetScan(&c, idbucket);
+		for (uint i=1; i<=pos; i++) coder->decodeString(&c);
+	}
+
+	buf[c.strLen-1] = (uchar)'\0';
+	return c.strLen-1;
+}
+
+uint
+StringDictionaryHTFC::extractCapacity() const
+{
+	return 4*maxlength+table->getK();
+}
+
+void
+StringDictionaryHTFC::extractBatch(const size_t *ids, size_t n, ByteArena &arena, size_t *offsets, uint *lengths) const
+{
+	vector<pair<size_t, size_t> > requests;
+	sortRequests(ids, n, &requests);
+
+	ChunkScan c;
+	uchar *scratch = new uchar[extractCapacity()];
+	size_t idbucket = 0;
+	uint pos = 0;
+
+	for (size_t i=0; i<n; i++)
+	{
+		size_t id = requests[i].first, req = requests[i].second;
+
+		if ((i > 0) && (id == requests[i-1].first))
+		{
+			// Repeated ID: the previous decoding is referenced
+			offsets[req] = offsets[requests[i-1].second];
+			lengths[req] = lengths[requests[i-1].second];
+			continue;
+		}
+
+		if ((id == 0) || (id > elements))
+		{
+			offsets[req] = arena.append((uchar*)"", 0);
+			lengths[req] = 0;
+			continue;
+		}
+
+		if (1+((id-1)/bucketsize) != idbucket)
+		{
+			// Moving to the header of a new bucket
+			idbucket = 1+((id-1)/bucketsize);
+			c = decodeHeader(idbucket, scratch);
+			pos = 0;
+		}
+
+		// Decoding up to the requested string
+		if ((pos == 0) && (((id-1)%bucketsize) > 0)) resetScan(&c, idbucket);
+		for (; pos<((id-1)%bucketsize); pos++) coder->decodeString(&c);
+
+		offsets[req] = arena.append(c.str, c.strLen-1);
+		lengths[req] = c.strLen-1;
+	}
+
+	delete [] scratch;
+}
+
 IteratorDictID*
-StringDictionaryHTFC::locatePrefix(uchar *str, uint strLen)
+StringDictionaryHTFC::locatePrefix(uchar *str, uint strLen) const
 {
 	// Encoding the string
 	uint encLen, offset;
@@ -477,62 +622,91 @@ StringDictionaryHTFC::locatePrefix(uchar *str, uint strLen)
 }
 
 IteratorDictID*
-StringDictionaryHTFC::locateSubstr(uchar *str, uint strLen)
+StringDictionaryHTFC::locateSubstr(uchar *str, uint strLen) const
 {
+	if (substringIndex != NULL) return substringIndex->locate(str, strLen);
+
 	cerr << "This dictionary does not provide substring location" << endl;
 	return NULL;
 }
 
-uint 
-StringDictionaryHTFC::locateRank(uint rank)
+size_t 
+StringDictionaryHTFC::locateRank(size_t rank) const
 {
 	return rank;
 }
 
 IteratorDictString*
-StringDictionaryHTFC::extractPrefix(uchar *str, uint strLen)
+StringDictionaryHTFC::extractPrefix(uchar *str, uint strLen) const
 {
 	IteratorDictIDContiguous *it = (IteratorDictIDContiguous*)locatePrefix(str, strLen);
 	size_t left = it->getLeftLimit();
+	size_t right = it->getRightLimit();
 
-	if (left != NORESULT)
-	{
-		// Positioning the LEFT Limit
-		uint leftbucket = 1+((left-1)/bucketsize);
-		uint leftpos = ((left-1)%bucketsize);
-
-		// Positioning the RIGHT Limit
-		size_t right = it->getRightLimit();
-		delete it;
+	delete it;
 
-		return new IteratorDictStringHTFC(table, codewords, textStrings, blStrings, leftbucket, leftpos, bucketsize, right-left+1, maxlength, maxcomplength);
-	}
+	if (left != NORESULT) return extractRange(left, right);
 	else return NULL;
 }
 
 IteratorDictString*
-StringDictionaryHTFC::extractSubstr(uchar *str, uint strLen)
+StringDictionaryHTFC::extractRange(size_t left, size_t right) const
+{
+	// Positioning the LEFT Limit
+	size_t leftbucket = 1+((left-1)/bucketsize);
+	uint leftpos = ((left-1)%bucketsize);
+
+	return new IteratorDictStringHTFC(table, codewords, textStrings, blStrings, leftbucket, leftpos, bucketsize, right-left+1, maxlength, maxcomplength);
+}
+
+IteratorDictString*
+StringDictionaryHTFC::extractSubstr(uchar *str, uint strLen) const
 {
+	if (substringIndex != NULL) return substringIndex->extract(str, strLen);
+
 	cerr << "This dictionary does not provide substring extraction" << endl;
 	return 0; 
 }
 
 uchar *
-StringDictionaryHTFC::extractRank(uint rank, uint *strLen)
+StringDictionaryHTFC::extractRank(size_t rank, uint *strLen) const
 {
 	return extract(rank, strLen);
 }
 
 IteratorDictString*
-StringDictionaryHTFC::extractTable()
+StringDictionaryHTFC::extractTable() const
 {
 	return new IteratorDictStringHTFC(table, codewords, textStrings, blStrings, 1, 0, bucketsize, elements, maxlength, maxcomplength);
 }
 
 size_t 
-StringDictionaryHTFC::getSize()
+StringDictionaryHTFC::getSize() const
+{
+	size_t size = bytesStrings*sizeof(uchar)+blStrings->getSize()+256*sizeof(Codeword)+table->getSize()+sizeof(StringDictionaryHTFC);
+	if (headerIndex != NULL) size += headerIndex->getSize();
+	if (substringIndex != NULL) size += substringIndex->getSize();
+	if (membershipFilter != NULL) size += membershipFilter->getSize();
+
+	return size;
+}
+
+void
+StringDictionaryHTFC::indexHeaders()
+{
+	if (headerIndex == NULL) headerIndex = new HeaderIndex(textStrings, bytesStrings, blStrings, buckets, false);
+}
+
+void
+StringDictionaryHTFC::indexSubstrings()
 {
-	return bytesStrings*sizeof(uchar)+blStrings->getSize()+256*sizeof(Codeword)+table->getSize()+sizeof(StringDictionaryHTFC);
+	if (substringIndex == NULL) substringIndex = new SubstringIndex(this, bucketsize);
+}
+
+void
+StringDictionaryHTFC::indexMembership()
+{
+	if (membershipFilter == NULL) membershipFilter = new MembershipFilter(this);
 }
 
 void 
@@ -542,24 +716,32 @@ StringDictionaryHTFC::save(ofstream &out)
 	saveValue<uint64_t>(out, elements);
 	saveValue<uint32_t>(out, maxlength);
 	saveValue<uint32_t>(out, maxcomplength);
-	saveValue<uint32_t>(out, buckets);
+	saveValue<uint32_t>(out, (buckets < WIDEBUCKETS) ? (uint32_t)buckets : WIDEBUCKETS);
 	saveValue<uint32_t>(out, bucketsize);
 
 	saveValue<uint64_t>(out, bytesStrings);
 	saveValue<uchar>(out, textStrings, bytesStrings);
 	blStrings->save(out);	
+	if (buckets >= WIDEBUCKETS) saveValue<uint64_t>(out, buckets);
 
 	saveValue<Codeword>(out, codewords, 256);
 	table->save(out);
+
+	// Optional substring index
+	if (substringIndex != NULL) substringIndex->save(out);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 StringDictionary*
-StringDictionaryHTFC::load(ifstream &in)
+StringDictionaryHTFC::load(ifstream &in, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 	if(type != HTFC) return NULL;
 
 	StringDictionaryHTFC *dict = new StringDictionaryHTFC();
+	dict->memoryMapping = mapping;
 
 	dict->type = HTFC;
 	dict->elements = loadValue<uint64_t>(in);
@@ -569,18 +751,22 @@ StringDictionaryHTFC::load(ifstream &in)
 	dict->bucketsize = loadValue<uint32_t>(in);
 
 	dict->bytesStrings = loadValue<uint64_t>(in);
-	dict->textStrings = loadValue<uchar>(in, dict->bytesStrings);
-	dict->blStrings = new LogSequence(in);
+	dict->textStrings = MemoryMapping::loadArray<uchar>(mapping, in, dict->bytesStrings);
+	dict->blStrings = new LogSequence(in, mapping);
+	if (dict->buckets == WIDEBUCKETS) dict->buckets = loadValue<uint64_t>(in);
 
 	dict->codewords = loadValue<Codeword>(in, 256);
 	dict->table = DecodingTable::load(in);
 	dict->coder = new StatCoder(dict->table, dict->codewords);
 
+	dict->substringIndex = SubstringIndex::load(in, dict, mapping);
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
+
 	return dict;
 }
 
 uchar*
-StringDictionaryHTFC::getHeader(size_t idbucket)
+StringDictionaryHTFC::getHeader(size_t idbucket) const
 {
 	size_t ptrH = blStrings->getField(idbucket);
 	uchar *header = textStrings+ptrH;
@@ -588,11 +774,32 @@ StringDictionaryHTFC::getHeader(size_t idbucket)
 	return header;
 }
 
+int
+StringDictionaryHTFC::compareHeader(size_t idbucket, uchar *str, uint strLen, uchar cmask) const
+{
+	if (strLen == 0) return 0;
+
+	// Hu-Tucker codes preserve the order, so the encoded header and the
+	// encoded string are directly compared. They differ before the end
+	// of the shortest one, so no byte beyond the strings is required.
+	uchar *header = getHeader(idbucket);
+	size_t avail = textStrings+bytesStrings-header;
+	if (avail < strLen) return compareBytes(header, str, avail);
+
+	int cmp = compareBytes(header, str, strLen-1);
+	if (cmp != 0) return cmp;
+
+	return (header[strLen-1] & cmask) - str[strLen-1];
+}
+
 ChunkScan
-StringDictionaryHTFC::decodeHeader(size_t idbucket)
+StringDictionaryHTFC::decodeHeader(size_t idbucket, uchar *buf) const
 {
 	uchar* ptr = textStrings+blStrings->getField(idbucket);
-	ChunkScan chunk = {0, 0, ptr, maxcomplength, new uchar[4*maxlength+table->getK()], 0, 0, 1};
+	// The chunks are refilled 64 bits at a time, so the readable bytes
+	// are bounded by the end of the strings
+	uint remain = min((size_t)maxcomplength, (size_t)(textStrings+bytesStrings-ptr));
+	ChunkScan chunk = {0, 0, ptr, remain, (buf != NULL) ? buf : new uchar[extractCapacity()], 0, 0, 1};
 
 	// Variables used for adjusting purposes
 	uint plen = 0;
@@ -623,19 +830,19 @@ StringDictionaryHTFC::decodeHeader(size_t idbucket)
 }
 
 bool 
-StringDictionaryHTFC::locateBucket(uchar *str, uint strLen, size_t *idbucket)
+StringDictionaryHTFC::locateBucket(uchar *str, uint strLen, size_t *idbucket) const
 {
 	size_t left = 1, right = buckets, center = 0;
 	int cmp = 0;
 
-	uchar *header;
+	// Narrowing the search to the buckets whose headers share the key
+	if (headerIndex != NULL) headerIndex->narrow(str, strLen, &left, &right);
 
 	while (left <= right)
     	{
 		center = (left+right)/2;
-		header = getHeader(center);
 
-		cmp = memcmp(header, str, strLen);
+		cmp = compareHeader(center, str, strLen, 0xFF);
 
 		// The string is in any preceding bucket
 		if (cmp > 0) right = center-1;
@@ -649,31 +856,84 @@ StringDictionaryHTFC::locateBucket(uchar *str, uint strLen, size_t *idbucket)
 		}
 	}
 
-	// c is the candidate bucket for the string
-	if (cmp < 0) *idbucket = center;
-	// c-1 is the candidate bucket for the string
-	else *idbucket = center-1;
+	// The rightmost bucket whose header is lower than the string is
+	// the candidate one
+	*idbucket = right;
 
 	return false;
 }
 
 void
-StringDictionaryHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offset, size_t *left, size_t *right)
+StringDictionaryHTFC::locateBucketBatch(uchar **strs, const uint *lens, size_t n, size_t *idbuckets, bool *headers) const
+{
+	size_t left[BATCHSIZE], right[BATCHSIZE], center[BATCHSIZE];
+	size_t active = n;
+
+	for (size_t i=0; i<n; i++)
+	{
+		left[i] = 1; right[i] = buckets; headers[i] = false;
+		if (headerIndex != NULL) headerIndex->narrow(strs[i], lens[i], &left[i], &right[i]);
+
+		if (left[i] > right[i])
+		{
+			// The header key already determines the candidate bucket
+			idbuckets[i] = right[i];
+			active--;
+		}
+		else
+		{
+			center[i] = (left[i]+right[i])/2;
+			blStrings->prefetch(center[i]);
+		}
+	}
+
+	while (active > 0)
+	{
+		// Reading the header positions and prefetching the headers
+		for (size_t i=0; i<n; i++)
+			if (left[i] <= right[i]) PREFETCH(getHeader(center[i]));
+
+		// Comparing the headers while the remaining ones are loaded
+		for (size_t i=0; i<n; i++)
+		{
+			if (left[i] > right[i]) continue;
+
+			int cmp = compareHeader(center[i], strs[i], lens[i], 0xFF);
+
+			if (cmp > 0) right[i] = center[i]-1;
+			else if (cmp < 0) left[i] = center[i]+1;
+			else { headers[i] = true; left[i] = center[i]+1; right[i] = center[i]; }
+
+			if (left[i] > right[i])
+			{
+				// The rightmost bucket whose header is not greater
+				// than the string is the candidate one
+				idbuckets[i] = right[i];
+				active--;
+			}
+			else
+			{
+				center[i] = (left[i]+right[i])/2;
+				blStrings->prefetch(center[i]);
+			}
+		}
+	}
+}
+
+void
+StringDictionaryHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offset, size_t *left, size_t *right) const
 {
 	size_t center = 0;
 	int cmp = 0;
 
-	uchar *header = new uchar[4*strLen];
-
-	uchar cmask = (uchar)(~(mask(8) >> offset));
+	// Only the used bits of the last byte are compared
+	uchar cmask = (offset != 0) ? (uchar)(~(mask(8) >> offset)) : 0xFF;
 
 	while (*left <= *right)
 	{
 		center = (*left+*right)/2;
 
-		memcpy(header, getHeader(center), strLen);
-		if (offset != 0) header[strLen-1] = header[strLen-1] & cmask;
-		cmp = memcmp(header, str, strLen);
+		cmp = compareHeader(center, str, strLen, cmask);
 
 		if (cmp > 0) *right = center-1;
 		else if (cmp < 0) *left = center+1;
@@ -686,22 +946,19 @@ StringDictionaryHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offset
        		if (cmp < 0) { *left = center; *right = center;}
 		else { *left = center-1; *right = center-1; }
 
-		delete [] header;
 		return;
 	}
 
 	if (center > 1)
 	{
 		// Looking for the left boundary
-		uint ll = *left, lr = center-1, lc;
+		size_t ll = *left, lr = center-1, lc;
 
 		while (ll <= lr)
 		{
 			lc = (ll+lr)/2;
 
-			memcpy(header, getHeader(lc), strLen);
-			if (offset != 0) header[strLen-1] = header[strLen-1] & cmask;
-		    cmp = memcmp(header, str, strLen);
+			cmp = compareHeader(lc, str, strLen, cmask);
 
 			if (cmp == 0) lr = lc-1;
 			else ll = lc+1;
@@ -714,15 +971,13 @@ StringDictionaryHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offset
 	if (center < buckets)
 	{
 		// Looking for the right boundary
-		uint rl = center, rr = *right+1, rc;
+		size_t rl = center, rr = *right+1, rc;
 
 		while (rl < (rr-1))
 		{
 			rc = (rl+rr)/2;
 
-			memcpy(header, getHeader(rc), strLen);
-			if (offset != 0) header[strLen-1] = header[strLen-1] & cmask;
-			cmp = memcmp(header, str, strLen);
+			cmp = compareHeader(rc, str, strLen, cmask);
 
 			if (cmp == 0) rl = rc;
 		        else rr = rc;
@@ -730,12 +985,10 @@ StringDictionaryHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offset
 
 		*right = rl;
 	}
-
-	delete [] header;
 }
 
 uint 
-StringDictionaryHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen)
+StringDictionaryHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen) const
 {
 	uint id = NORESULT;
 
@@ -745,7 +998,7 @@ StringDictionaryHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str, ui
 	uint i=1;
 	while (true)
 	{
-		cmp=longestCommonPrefix(c->str+sharedCurr, str+sharedCurr, c->strLen-sharedCurr-1, &sharedCurr);
+		cmp=longestCommonPrefix(c->str+sharedCurr, str+sharedCurr, min(c->strLen-1, strLen)-sharedCurr, &sharedCurr);
 
 		if (sharedCurr==strLen) { id = i; break; }
 		else
@@ -763,7 +1016,7 @@ StringDictionaryHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str, ui
 }
 
 uint
-StringDictionaryHTFC::searchDistinctPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen)
+StringDictionaryHTFC::searchDistinctPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen) const
 {
 	uint id = 1;
 
@@ -774,7 +1027,7 @@ StringDictionaryHTFC::searchDistinctPrefix(ChunkScan* c, uint scanneable, uchar
 }
 
 void
-StringDictionaryHTFC::resetScan(ChunkScan *c, size_t idbucket)
+StringDictionaryHTFC::resetScan(ChunkScan *c, size_t idbucket) const
 {
 	c->c_chunk = 0;
 	c->c_valid = 0;
@@ -784,7 +1037,7 @@ StringDictionaryHTFC::resetScan(ChunkScan *c, size_t idbucket)
 
 StringDictionaryHTFC::~StringDictionaryHTFC()
 {
-	delete [] textStrings; delete blStrings;
+	MemoryMapping::release(memoryMapping, textStrings); delete blStrings;
 	delete [] codewords;  delete table;
 	delete coder;
 }
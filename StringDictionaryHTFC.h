@@ -65,6 +65,8 @@ using namespace cds_utils;
 
 #define MEMALLOC 32768
 
+class StringDictionaryPFC;
+
 class StringDictionaryHTFC : public StringDictionary 
 {
 	public:
@@ -74,15 +76,40 @@ class StringDictionaryHTFC : public StringDictionary
 		/** Class Constructor.
 		    @param it: iterator scanning the original set of strings.
 		    @param bucketsize: number of strings represented per bucket.
+		    @param tablebits: number of bits of the chunks used by the
+		      decoding table (from MINK to MAXK).
 		*/
-		StringDictionaryHTFC(IteratorDictString *it, uint bucketsize);
+		StringDictionaryHTFC(IteratorDictString *it, uint bucketsize, uint tablebits=TABLEBITSO);
+
+		/** Parallel Class Constructor. The Front-Coding representation
+		    is built in parallel (see StringDictionaryPFC), and it is
+		    then Hu-Tucker encoded.
+		    @param it: iterator over the plain (in-memory) strings.
+		    @param bucketsize: number of strings represented per bucket.
+		    @param threads: number of threads used for Front-Coding.
+		    @param tablebits: number of bits of the chunks used by the
+		      decoding table (from MINK to MAXK).
+		*/
+		StringDictionaryHTFC(IteratorDictStringPlain *it, uint bucketsize, uint threads, uint tablebits=TABLEBITSO);
 		
 		/** Retrieves the ID corresponding to the given string.
 		    @param str: the string to be searched.
 		    @param strLen: the string length.
 		    @returns the ID (or NORESULT if it is not in the bucket).
 		*/
-		uint locate(uchar *str, uint str_length);
+		size_t locate(uchar *str, uint str_length) const;
+
+		/** Retrieves the IDs corresponding to a batch of strings. The
+		    strings are encoded in advance and the binary searches over
+		    the (encoded) bucket headers advance in lockstep, so each 
+		    step prefetches the header compared in the next one.
+		    @param strs: the strings to be searched.
+		    @param lens: the string lengths.
+		    @param n: the number of strings.
+		    @param out: the resulting IDs (NORESULT for those strings
+		      which are not in the dictionary).
+		*/
+		void locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const;
 		
 		/** Obtains the string associated with the given ID.
 		    @param id: the ID to be extracted.
@@ -90,7 +117,36 @@ class StringDictionaryHTFC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		 */
-		uchar* extract(size_t id, uint *strLen);
+		uchar* extract(size_t id, uint *strLen) const;
+
+		/** Obtains the string associated with the given ID into a
+		    buffer owned by the caller. The string is directly decoded
+		    on the buffer if its capacity is not lower than
+		    extractCapacity().
+		    @param id: the ID to be extracted.
+		    @param buf: the buffer.
+		    @param cap: the buffer capacity.
+		    @returns the string length (0 if the ID is not in the
+		      dictionary).
+		*/
+		uint extractInto(size_t id, uchar *buf, uint cap) const;
+
+		/** Obtains the buffer capacity with which extractInto decodes
+		    in place: the chunk decoder writes up to 4 bytes per
+		    symbol plus a whole chunk beyond the string.
+		*/
+		uint extractCapacity() const;
+
+		/** Obtains the strings associated with a batch of IDs. The
+		    IDs are sorted, so each bucket is decoded (at most) once.
+		    @param ids: the IDs to be extracted.
+		    @param n: the number of IDs.
+		    @param arena: the arena in which the strings are written.
+		    @param offsets: the offset (within the arena) of each string.
+		    @param lengths: the length of each string (0 if the ID is
+		      not in the dictionary).
+		*/
+		void extractBatch(const size_t *ids, size_t n, ByteArena &arena, size_t *offsets, uint *lengths) const;
 		
 		/** Locates all IDs of those elements prefixed by the given 
 		    string.
@@ -98,7 +154,7 @@ class StringDictionaryHTFC : public StringDictionary
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locatePrefix(uchar *str, uint strLen);
+		IteratorDictID* locatePrefix(uchar *str, uint strLen) const;
 		
 		/** Locates all IDs of those elements containing the given 
 		    substring.
@@ -106,27 +162,27 @@ class StringDictionaryHTFC : public StringDictionary
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locateSubstr(uchar *str, uint strLen);
+		IteratorDictID* locateSubstr(uchar *str, uint strLen) const;
 		
 		/** Retrieves the ID with rank k according to its alphabetical order. 
 		    @param rank: the alphabetical ranking.
 		    @returns the ID.
 		*/
-		uint locateRank(uint rank);
+		size_t locateRank(size_t rank) const;
 		
 		/** Extracts all elements prefixed by the given string.
 		    @param str: the prefix to be searched.
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractPrefix(uchar *str, uint strLen);
+		IteratorDictString* extractPrefix(uchar *str, uint strLen) const;
 		
 		/** Extracts all elements containing by the given substring.
 		    @param str: the substring to be searched.
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractSubstr(uchar *str, uint strLen);
+		IteratorDictString* extractSubstr(uchar *str, uint strLen) const;
 		
 		/** Obtains the string  with rank k according to its 
 		    alphabetical order.
@@ -135,18 +191,39 @@ class StringDictionaryHTFC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		*/
-		uchar* extractRank(uint rank, uint *strLen);
+		uchar* extractRank(size_t rank, uint *strLen) const;
 		
 		/** Extracts all strings in the dictionary sorted in 
 		    alphabetical order. 
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractTable();
+		IteratorDictString* extractTable() const;
+
+		/** Extracts the strings whose IDs are in the given range (in
+		    ID order).
+		    @param left: the first ID.
+		    @param right: the last ID.
+		    @returns an iterator for direct scanning of the strings.
+		*/
+		IteratorDictString* extractRange(size_t left, size_t right) const;
+
+		/** Builds the q-gram index which enables substring operations.
+		*/
+		void indexSubstrings();
+
+		/** Builds the approximate membership filter, so locate 
+		    discards most of the strings not in the dictionary.
+		*/
+		void indexMembership();
 		
 		/** Computes the size of the structure in bytes. 
 		    @returns the dictionary size in bytes.
 		*/
-		size_t getSize();
+		size_t getSize() const;
+
+		/** Builds the cache-resident index over the bucket headers.
+		*/
+		void indexHeaders();
 		
 		/** Stores the dictionary into an ofstream.
 		    @param out: the oftstream.
@@ -155,9 +232,11 @@ class StringDictionaryHTFC : public StringDictionary
 		
 		/** Loads a dictionary from an ifstream.
 		    @param in: the ifstream.
+		    @param mapping: the memory mapping of the file (if any). The
+		      dictionary takes its ownership.
 		    @returns the loaded dictionary.
 		*/
-		static StringDictionary *load(ifstream &in);
+		static StringDictionary *load(ifstream &in, MemoryMapping *mapping=NULL);
 
 		/** Generic destructor. */
 		~StringDictionaryHTFC();
@@ -165,7 +244,7 @@ class StringDictionaryHTFC : public StringDictionary
 	protected:
 		uint32_t maxcomplength;	//! The largest compressed header
 
-		uint32_t buckets;	//! Number of total buckets in the dictionary
+		uint64_t buckets;	//! Number of total buckets in the dictionary
 		uint32_t bucketsize;	//! Number of strings per bucket
 
 		uint64_t bytesStrings;	//! Length of the strings representation
@@ -176,11 +255,37 @@ class StringDictionaryHTFC : public StringDictionary
 		Codeword *codewords;	//! Hu-Tucker codeword assignment
 		DecodingTable *table; 	//! Decoding table
 
+		/** Checks the bucketsize value (it must be greater than 1).
+		    @param bucketsize: the requested bucketsize.
+		*/
+		void setBucketsize(uint bucketsize);
+
+		/** Encodes the Front-Coding representation and builds the
+		    decoding table. The encoding is sequential because the
+		    decoding table is built in the same scanning order.
+		    @param dict: the Front-Coding representation (it is
+		      deleted after encoding).
+		    @param tablebits: number of bits of the chunks used by the
+		      decoding table.
+		*/
+		void encodeBuckets(StringDictionaryPFC *dict, uint tablebits);
+
 		/** Obtaining the (encoded) header string for the given bucket.
 		    @param idbucket: the bucket.
 		    @returns the encoded header.
 		*/
-		inline uchar *getHeader(size_t idbucket);
+		inline uchar *getHeader(size_t idbucket) const;
+
+		/** Compares the (encoded) header of the given bucket with an
+		    encoded string, without decoding the header.
+		    @param idbucket: the bucket.
+		    @param str: the encoded string.
+		    @param strLen: the encoded string length.
+		    @param cmask: mask of the bits compared in the last byte.
+		    @returns a negative value, zero or a positive value if the
+		      header is lower than, equal to or greater than the string.
+		*/
+		inline int compareHeader(size_t idbucket, uchar *str, uint strLen, uchar cmask) const;
 
 		/** Performs the Hu-Tucker encoding of the string.
 		    @param str: the string to be encoded.
@@ -190,7 +295,7 @@ class StringDictionaryHTFC : public StringDictionary
 		      byte.
 		    @returns the encoded string.
 		*/
-		inline uchar* encodeString(uchar *str, uint strLen, uint *encLen, uint *offset);
+		inline uchar* encodeString(uchar *str, uint strLen, uint *encLen, uint *offset) const;
 
 		/** Performs the Hu-Tucker encoding of the symbol in the text
 		    jumping, in the current byte, the given number of bits.
@@ -199,20 +304,22 @@ class StringDictionaryHTFC : public StringDictionary
 		    @param offset: the number of bits to be jumped.
 		    @returns the number of advanced bytes in this operation.
 		*/
-		inline uint encodeSymbol(uchar symbol, uchar *text, uint *offset);
+		inline uint encodeSymbol(uchar symbol, uchar *text, uint *offset) const;
 
 		/** Decodes the first string in the bucket. 
 		    @idbucket: the bucket storing the required header.
+		    @buf: the buffer (of extractCapacity() bytes) in which the
+		      strings are decoded (it is allocated if NULL).
 		    @returns the scanning data
 		*/
-		inline ChunkScan decodeHeader(size_t idbucket);
+		inline ChunkScan decodeHeader(size_t idbucket, uchar *buf=NULL) const;
 
 		/** Decodes the next internal string according to the 
 		    scanning data
 		    @c: pointer to the scanning data
 		    returns the number of chars shared with the previous string
 		*/
-		inline uint decodeNextString(ChunkScan* c);
+		inline uint decodeNextString(ChunkScan* c) const;
 
 		/** Decodes the next internal string according to the
 		    scanning data
@@ -229,7 +336,27 @@ class StringDictionaryHTFC : public StringDictionary
 		    @returns a boolean value telling if the string is the 
 		      header of the bucket.
 		*/
-		inline bool locateBucket(uchar *str, uint strLen, size_t *idbucket);
+		inline bool locateBucket(uchar *str, uint strLen, size_t *idbucket) const;
+
+		/** Locates the candidate buckets for a group of (at most
+		    BATCHSIZE) encoded strings.
+		    @param strs: the encoded strings to be located.
+		    @param lens: the encoded string lengths.
+		    @param n: the number of strings.
+		    @param idbuckets: the candidate buckets.
+		    @param headers: tells, for each string, if it is the header
+		      of its bucket.
+		*/
+		inline void locateBucketBatch(uchar **strs, const uint *lens, size_t n, size_t *idbuckets, bool *headers) const;
+
+		/** Scans the candidate bucket for the given string (which is
+		    not its header).
+		    @param idbucket: the candidate bucket.
+		    @param str: the string to be located.
+		    @param strLen: the string length.
+		    @returns the ID (or NORESULT if it is not in the bucket).
+		*/
+		inline size_t locateInBucket(size_t idbucket, uchar *str, uint strLen) const;
 
 		/** Locates the buckets which delimits the representation of
 		    all possible elments prefixed by the given string.
@@ -239,7 +366,7 @@ class StringDictionaryHTFC : public StringDictionary
 		    @param left: pointer to the left boundary bucket.
 		    @param right: pointer to the right boundary bucket.
 		*/
-		inline void locateBoundaryBuckets(uchar *str, uint strLen, uint offset, size_t *left, size_t *right);
+		inline void locateBoundaryBuckets(uchar *str, uint strLen, uint offset, size_t *left, size_t *right) const;
 
 		/** Searches the first string prefixed for the given one.
 		    @param c: pointer to the scanning data
@@ -248,7 +375,7 @@ class StringDictionaryHTFC : public StringDictionary
 		    @param strLen: the prefix length.
 		    @returns the internal ID (of 0 if it is not in the bucket).
 		*/
-		inline uint searchPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen);
+		inline uint searchPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen) const;
 
 		/** Searches the first string non-prefixed for the given one.
 		    @param c: pointer to the scanning data
@@ -257,13 +384,13 @@ class StringDictionaryHTFC : public StringDictionary
 		    @param strLen: the prefix length.
 		    @returns the internal ID (of 0 if it is not in the bucket).
 		*/
-		inline uint searchDistinctPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen);
+		inline uint searchDistinctPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen) const;
 
 		/** Resets the scanning value for the given bucket.
 		    @c: pointer to the scanning data
 		    @param idbucket: pointer to the current bucket.
 		*/
-		inline void resetScan(ChunkScan *c, size_t idbucket);
+		inline void resetScan(ChunkScan *c, size_t idbucket) const;
 
 		/** Processes the next encoded symbol and checks if the current
 		    sequence encodes a decodeable substring. In this case,
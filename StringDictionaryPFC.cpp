@@ -27,6 +27,8 @@
  */
 
 
+#include <pthread.h>
+
 #include "StringDictionaryPFC.h"
 
 StringDictionaryPFC::StringDictionaryPFC()
@@ -119,13 +121,205 @@ StringDictionaryPFC::StringDictionaryPFC(IteratorDictString *it, uint bucketsize
 
 	// Obtaining the positional indexes
 	xblStrings.push_back(bytesStrings);
-	blStrings = new LogSequence(&xblStrings, bits(bytesStrings));
+	blStrings = new LogSequence(&xblStrings, bits(bytesStrings), true);
+}
+
+/** Bucket-aligned range of the plain text which is Front-Coded by a
+    single thread in the parallel construction. */
+struct FrontCodingChunk
+{
+	uchar *text;		//! Plain text
+	size_t begin;		//! First byte of the range
+	size_t end;		//! First byte after the range
+	uint bucketsize;	//! Number of strings per bucket
+
+	size_t elements;	//! Number of strings in the range
+	uint maxlength;		//! Length of the longest string (plus one)
+	uchar *encoded;		//! Front-Coded strings
+	size_t bytes;		//! Number of encoded bytes
+	vector<size_t> headers;	//! Offset of each bucket header in 'encoded'
+};
+
+static void*
+countChunk(void *arg)
+{
+	FrontCodingChunk *chunk = (FrontCodingChunk*)arg;
+	chunk->elements = 0;
+
+	for (size_t pos=chunk->begin; pos<chunk->end; chunk->elements++)
+		pos += strlen((char*)(chunk->text+pos))+1;
+
+	return NULL;
+}
+
+static void*
+encodeChunk(void *arg)
+{
+	FrontCodingChunk *chunk = (FrontCodingChunk*)arg;
+	chunk->elements = 0; chunk->maxlength = 0; chunk->bytes = 0;
+
+	size_t reserved = MEMALLOC*chunk->bucketsize;
+	chunk->encoded = new uchar[reserved];
+
+	uchar *strPrev = NULL;
+	uint lenPrev = 0;
+
+	for (size_t pos=chunk->begin; pos<chunk->end; )
+	{
+		uchar *strCurrent = chunk->text+pos;
+		uint lenCurrent = strlen((char*)strCurrent);
+		pos += lenCurrent+1;
+
+		if (lenCurrent >= chunk->maxlength) chunk->maxlength = lenCurrent+1;
+
+		while ((chunk->bytes+(2*lenCurrent)+1) > reserved)
+			reserved = Reallocate(&(chunk->encoded), reserved);
+
+		if ((chunk->elements % chunk->bucketsize) == 0)
+		{
+			// The bucket header is explicitly copied
+			chunk->headers.push_back(chunk->bytes);
+			memcpy(chunk->encoded+chunk->bytes, strCurrent, lenCurrent);
+			chunk->bytes += lenCurrent;
+		}
+		else
+		{
+			// The lcp value is VByte encoded before the suffix
+			uint lcp = 0;
+			longestCommonPrefix(strPrev, strCurrent, lenPrev, &lcp);
+			chunk->bytes += VByte::encode(lcp, chunk->encoded+chunk->bytes);
+			memcpy(chunk->encoded+chunk->bytes, strCurrent+lcp, lenCurrent-lcp);
+			chunk->bytes += lenCurrent-lcp;
+		}
+
+		chunk->encoded[chunk->bytes] = '\0';
+		chunk->bytes++;
+
+		chunk->elements++;
+		strPrev = strCurrent;
+		lenPrev = lenCurrent;
+	}
+
+	return NULL;
+}
+
+/** Runs the given function over all chunks (one thread per chunk). The
+    chunk is processed by the calling thread if its thread cannot be
+    created. */
+static void
+runChunks(vector<FrontCodingChunk> &chunks, void *(*function)(void*))
+{
+	vector<pthread_t> workers(chunks.size());
+	vector<bool> running(chunks.size(), false);
+
+	for (size_t i=0; i<chunks.size(); i++)
+	{
+		if (pthread_create(&workers[i], NULL, function, &chunks[i]) == 0) running[i] = true;
+		else function(&chunks[i]);
+	}
+
+	for (size_t i=0; i<chunks.size(); i++)
+		if (running[i]) pthread_join(workers[i], NULL);
+}
+
+StringDictionaryPFC::StringDictionaryPFC(IteratorDictStringPlain *it, uint bucketsize, uint threads)
+{
+	this->type = PFC;
+	this->elements = 0;
+	this->maxlength = 0;
+
+	if (bucketsize < 2)
+	{
+		cerr << "[WARNING] The bucketsize value must be greater than 1. ";
+		cerr << "The dictionary is built using buckets of size 2" << endl;
+		this->bucketsize = 2;
+	}
+	else this->bucketsize = bucketsize;
+
+	this->buckets = 0;
+	this->bytesStrings = 0;
+
+	if (threads == 0) threads = 1;
+
+	uchar *text = it->getPlainText();
+	size_t length = it->size();
+
+	// 1) The text is split in ranges starting at string boundaries and
+	//    the strings in each range are counted
+	vector<FrontCodingChunk> chunks(threads);
+
+	for (uint i=0; i<threads; i++)
+	{
+		size_t begin = (i*length)/threads;
+		while ((begin > 0) && (begin < length) && (text[begin-1] != '\0')) begin++;
+
+		chunks[i].text = text;
+		chunks[i].begin = begin;
+		chunks[i].bucketsize = this->bucketsize;
+		chunks[i].encoded = NULL;
+	}
+
+	for (uint i=0; i<threads; i++)
+		chunks[i].end = (i+1 < threads) ? chunks[i+1].begin : length;
+
+	runChunks(chunks, countChunk);
+
+	// 2) Each range is moved forward to the first bucket header within
+	//    it (the previous range grows accordingly)
+	size_t first = 0;
+
+	for (uint i=0; i<threads; i++)
+	{
+		size_t skip = (this->bucketsize - (first % this->bucketsize)) % this->bucketsize;
+		first += chunks[i].elements;
+
+		for (size_t j=0; (j<skip) && (chunks[i].begin<length); j++)
+			chunks[i].begin += strlen((char*)(text+chunks[i].begin))+1;
+
+		if (i > 0) chunks[i-1].end = chunks[i].begin;
+	}
+
+	// 3) Encoding the bucket-aligned ranges
+	runChunks(chunks, encodeChunk);
+
+	// 4) Stitching the encoded ranges
+	for (uint i=0; i<threads; i++)
+	{
+		elements += chunks[i].elements;
+		bytesStrings += chunks[i].bytes;
+		if (chunks[i].maxlength > maxlength) maxlength = chunks[i].maxlength;
+	}
+
+	textStrings = new uchar[bytesStrings];
+	vector<size_t> xblStrings;
+	xblStrings.push_back(0);
+
+	size_t base = 0;
+
+	for (uint i=0; i<threads; i++)
+	{
+		for (size_t j=0; j<chunks[i].headers.size(); j++)
+			xblStrings.push_back(base+chunks[i].headers[j]);
+
+		buckets += chunks[i].headers.size();
+
+		memcpy(textStrings+base, chunks[i].encoded, chunks[i].bytes);
+		base += chunks[i].bytes;
+		delete [] chunks[i].encoded;
+	}
+
+	delete it;
+
+	// Obtaining the positional indexes
+	xblStrings.push_back(bytesStrings);
+	blStrings = new LogSequence(&xblStrings, bits(bytesStrings), true);
 }
 
-uint 
-StringDictionaryPFC::locate(uchar *str, uint strLen)
+size_t 
+StringDictionaryPFC::locate(uchar *str, uint strLen) const
 {
-	uint id = NORESULT;
+	// Strings discarded by the membership filter are not in the dictionary
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
 
 	// Locating the candidate bucket for the string
 	size_t idbucket;
@@ -133,89 +327,188 @@ StringDictionaryPFC::locate(uchar *str, uint strLen)
 
 	// The string is the header of the bucket
 	if (cmp) return ((idbucket-1)*bucketsize)+1;
-	else
+	// The bucket is sequentially scanned to find the string
+	else return locateInBucket(idbucket, str, strLen);
+}
+
+void
+StringDictionaryPFC::locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const
+{
+	size_t idbuckets[BATCHSIZE];
+	bool headers[BATCHSIZE];
+
+	for (size_t i=0; i<n; i+=BATCHSIZE)
 	{
-		// The string is previous to any other one in the dictionary
-		if (idbucket != NORESULT)
+		size_t group = min(BATCHSIZE, n-i);
+		locateBucketBatch(strs+i, group, idbuckets, headers);
+
+		for (size_t j=0; j<group; j++)
 		{
-			// The bucket is sequentially scanned to find the string
-			uchar *decoded; uint decLen;
-			uchar *ptr = getHeader(idbucket, &decoded, &decLen);
+			if (headers[j]) out[i+j] = ((idbuckets[j]-1)*bucketsize)+1;
+			else if ((membershipFilter != NULL) && !membershipFilter->contains(strs[i+j], lens[i+j])) out[i+j] = NORESULT;
+			else out[i+j] = locateInBucket(idbuckets[j], (uchar*)strs[i+j], lens[i+j]);
+		}
+	}
+}
 
-			uint scanneable = bucketsize;
-			if ((idbucket == buckets) && ((elements%bucketsize) != 0)) scanneable = (elements%bucketsize);
+size_t
+StringDictionaryPFC::locateInBucket(size_t idbucket, uchar *str, uint strLen) const
+{
+	size_t id = NORESULT;
 
-			if (scanneable > 1)
-			{
-				uint sharedCurr=0, sharedPrev=0;
-				int cmp=0;
+	// The string is previous to any other one in the dictionary
+	if (idbucket != NORESULT)
+	{
+		// The bucket is sequentially scanned to find the string
+		uchar *decoded; uint decLen;
+		uchar *ptr = getHeader(idbucket, &decoded, &decLen);
 
-				// Processing the first internal string
-				ptr += VByte::decode(&sharedPrev, ptr);
-				decodeNextString(&ptr, sharedPrev, decoded, &decLen);
-				cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, decLen-sharedCurr+1, &sharedCurr);
+		uint scanneable = bucketsize;
+		if ((idbucket == buckets) && ((elements%bucketsize) != 0)) scanneable = (elements%bucketsize);
+
+		if (scanneable > 1)
+		{
+			uint sharedCurr=0, sharedPrev=0;
+			int cmp=0;
 
-				if (cmp != 0)
+			// Processing the first internal string
+			ptr += VByte::decode(&sharedPrev, ptr);
+			decodeNextString(&ptr, sharedPrev, decoded, &decLen);
+			cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, decLen-sharedCurr+1, &sharedCurr);
+
+			if (cmp != 0)
+			{
+				for (uint i=2; i<scanneable; i++)
 				{
-					for (uint i=2; i<scanneable; i++)
-					{
-						ptr += VByte::decode(&sharedPrev, ptr);
+					ptr += VByte::decode(&sharedPrev, ptr);
 
-						if  (sharedPrev < sharedCurr) break;
-						decodeNextString(&ptr, sharedPrev, decoded, &decLen);
+					if  (sharedPrev < sharedCurr) break;
+					decodeNextString(&ptr, sharedPrev, decoded, &decLen);
 
-						if (sharedPrev == sharedCurr)
-							cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, decLen-sharedCurr+1, &sharedCurr);
+					if (sharedPrev == sharedCurr)
+						cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, decLen-sharedCurr+1, &sharedCurr);
 
-						if (cmp == 0)
-						{
-							id = ((idbucket-1)*bucketsize)+i+1;
-							delete [] decoded;
-							return id;
-						}
-						else if (cmp > 0) break;
+					if (cmp == 0)
+					{
+						id = ((idbucket-1)*bucketsize)+i+1;
+						delete [] decoded;
+						return id;
 					}
+					else if (cmp > 0) break;
 				}
-				else id = ((idbucket-1)*bucketsize)+2;
 			}
-
-			delete [] decoded;
+			else id = ((idbucket-1)*bucketsize)+2;
 		}
+
+		delete [] decoded;
 	}
 
 	return id;
 }
 
 uchar *
-StringDictionaryPFC::extract(size_t id, uint *strLen)
+StringDictionaryPFC::extract(size_t id, uint *strLen) const
+{
+	if ((id > 0) && (id <= elements))
+	{
+		uchar *decoded = new uchar[maxlength+1];
+		*strLen = extractInto(id, decoded, maxlength+1);
+
+		return decoded;
+	}
+	else
+	{
+		*strLen = 0;
+		return NULL;
+	}
+}
+
+uint
+StringDictionaryPFC::extractInto(size_t id, uchar *buf, uint cap) const
 {
+	// Any string in the bucket can be decoded on the buffer
+	if (cap <= maxlength) return StringDictionary::extractInto(id, buf, cap);
+
 	if ((id > 0) && (id <= elements))
 	{
-		uint idbucket = 1+((id-1)/bucketsize);
+		size_t idbucket = 1+((id-1)/bucketsize);
 		uint pos = ((id-1)%bucketsize);
 
-		uchar *decoded; uint decLen;
-		uchar *ptr = getHeader(idbucket, &decoded, &decLen);
+		uint decLen = decodeHeader(idbucket, buf);
+		uchar *ptr = textStrings+blStrings->getField(idbucket)+decLen+1;
 		uint lenPrefix;
 
-		if (pos > 0) for (uint i=1; i<=pos; i++)
+		for (uint i=1; i<=pos; i++)
 		{
 			ptr += VByte::decode(&lenPrefix, ptr);
-			decodeNextString(&ptr, lenPrefix, decoded, &decLen);
+			decodeNextString(&ptr, lenPrefix, buf, &decLen);
 		}
 
-		*strLen = decLen;
-		return decoded;
+		return decLen;
 	}
 	else
 	{
-		*strLen = 0;
-		return NULL;
+		buf[0] = '\0';
+		return 0;
+	}
+}
+
+void
+StringDictionaryPFC::extractBatch(const size_t *ids, size_t n, ByteArena &arena, size_t *offsets, uint *lengths) const
+{
+	vector<pair<size_t, size_t> > requests;
+	sortRequests(ids, n, &requests);
+
+	uchar *decoded = new uchar[maxlength+1];
+	uint decLen = 0, lenPrefix;
+	size_t idbucket = 0;
+	uint pos = 0;
+	uchar *ptr = NULL;
+
+	for (size_t i=0; i<n; i++)
+	{
+		size_t id = requests[i].first, req = requests[i].second;
+
+		if ((i > 0) && (id == requests[i-1].first))
+		{
+			// Repeated ID: the previous decoding is referenced
+			offsets[req] = offsets[requests[i-1].second];
+			lengths[req] = lengths[requests[i-1].second];
+			continue;
+		}
+
+		if ((id == 0) || (id > elements))
+		{
+			offsets[req] = arena.append(decoded, 0);
+			lengths[req] = 0;
+			continue;
+		}
+
+		if (1+((id-1)/bucketsize) != idbucket)
+		{
+			// Moving to the header of a new bucket
+			idbucket = 1+((id-1)/bucketsize);
+			decLen = decodeHeader(idbucket, decoded);
+			ptr = textStrings+blStrings->getField(idbucket)+decLen+1;
+			pos = 0;
+		}
+
+		// Decoding up to the requested string
+		for (; pos<((id-1)%bucketsize); pos++)
+		{
+			ptr += VByte::decode(&lenPrefix, ptr);
+			decodeNextString(&ptr, lenPrefix, decoded, &decLen);
+		}
+
+		offsets[req] = arena.append(decoded, decLen);
+		lengths[req] = decLen;
 	}
+
+	delete [] decoded;
 }
 
 IteratorDictID*
-StringDictionaryPFC::locatePrefix(uchar *str, uint strLen)
+StringDictionaryPFC::locatePrefix(uchar *str, uint strLen) const
 {
 	size_t leftBucket = 1, rightBucket = buckets;
 	size_t leftID = 0, rightID = 0;
@@ -283,57 +576,62 @@ StringDictionaryPFC::locatePrefix(uchar *str, uint strLen)
 }
 
 IteratorDictID*
-StringDictionaryPFC::locateSubstr(uchar *str, uint strLen)
+StringDictionaryPFC::locateSubstr(uchar *str, uint strLen) const
 {
+	if (substringIndex != NULL) return substringIndex->locate(str, strLen);
+
 	cerr << "This dictionary does not provide substring location" << endl;
 	return NULL;
 }
 
-uint 
-StringDictionaryPFC::locateRank(uint rank)
+size_t 
+StringDictionaryPFC::locateRank(size_t rank) const
 {
 	return rank;
 }
 
 IteratorDictString*
-StringDictionaryPFC::extractPrefix(uchar *str, uint strLen)
+StringDictionaryPFC::extractPrefix(uchar *str, uint strLen) const
 {
 	IteratorDictIDContiguous *it = (IteratorDictIDContiguous*)locatePrefix(str, strLen);
+	size_t left = it->getLeftLimit();
+	size_t right = it->getRightLimit();
 
-	if (it->getLeftLimit() != NORESULT)
-	{
-		// Positioning the LEFT Limit
-		size_t left = it->getLeftLimit();
-		uint leftbucket = 1+((left-1)/bucketsize);
-		uint leftpos = ((left-1)%bucketsize);
+	delete it;
 
-		// Positioning the RIGHT Limit
-		size_t right = it->getRightLimit();
+	if (left != NORESULT) return extractRange(left, right);
+	else return NULL;
+}
 
-		delete it;
+IteratorDictString*
+StringDictionaryPFC::extractRange(size_t left, size_t right) const
+{
+	// Positioning the LEFT Limit
+	size_t leftbucket = 1+((left-1)/bucketsize);
+	uint leftpos = ((left-1)%bucketsize);
 
-		size_t ptrS = blStrings->getField(leftbucket);
+	size_t ptrS = blStrings->getField(leftbucket);
 
-		return new IteratorDictStringPFC(textStrings+ptrS, leftpos, bucketsize, right-left+1, maxlength);
-	}
-	else return NULL;
+	return new IteratorDictStringPFC(textStrings+ptrS, leftpos, bucketsize, right-left+1, maxlength);
 }
 
 IteratorDictString*
-StringDictionaryPFC::extractSubstr(uchar *str, uint strLen)
+StringDictionaryPFC::extractSubstr(uchar *str, uint strLen) const
 {
+	if (substringIndex != NULL) return substringIndex->extract(str, strLen);
+
 	cerr << "This dictionary does not provide substring extraction" << endl;
 	return 0; 
 }
 
 uchar *
-StringDictionaryPFC::extractRank(uint rank, uint *strLen)
+StringDictionaryPFC::extractRank(size_t rank, uint *strLen) const
 {
 	return extract(rank, strLen);
 }
 
 IteratorDictString*
-StringDictionaryPFC::extractTable()
+StringDictionaryPFC::extractTable() const
 {
 	size_t ptrS = blStrings->getField(1);
 
@@ -341,9 +639,32 @@ StringDictionaryPFC::extractTable()
 }
 
 size_t 
-StringDictionaryPFC::getSize()
+StringDictionaryPFC::getSize() const
 {
-	return (bytesStrings*sizeof(uchar))+blStrings->getSize()+sizeof(StringDictionaryPFC);
+	size_t size = (bytesStrings*sizeof(uchar))+blStrings->getSize()+sizeof(StringDictionaryPFC);
+	if (headerIndex != NULL) size += headerIndex->getSize();
+	if (substringIndex != NULL) size += substringIndex->getSize();
+	if (membershipFilter != NULL) size += membershipFilter->getSize();
+
+	return size;
+}
+
+void
+StringDictionaryPFC::indexHeaders()
+{
+	if (headerIndex == NULL) headerIndex = new HeaderIndex(textStrings, bytesStrings, blStrings, buckets, true);
+}
+
+void
+StringDictionaryPFC::indexSubstrings()
+{
+	if (substringIndex == NULL) substringIndex = new SubstringIndex(this, bucketsize);
+}
+
+void
+StringDictionaryPFC::indexMembership()
+{
+	if (membershipFilter == NULL) membershipFilter = new MembershipFilter(this);
 }
 
 void 
@@ -352,21 +673,112 @@ StringDictionaryPFC::save(ofstream &out)
 	saveValue<uint32_t>(out, type);
 	saveValue<uint64_t>(out, elements);
 	saveValue<uint32_t>(out, maxlength);
-	saveValue<uint32_t>(out, buckets);
+	saveValue<uint32_t>(out, (buckets < WIDEBUCKETS) ? (uint32_t)buckets : WIDEBUCKETS);
 	saveValue<uint32_t>(out, bucketsize);
 	saveValue<uint64_t>(out, bytesStrings);
 	saveValue<uchar>(out, textStrings, bytesStrings);
 	blStrings->save(out);	
+	if (buckets >= WIDEBUCKETS) saveValue<uint64_t>(out, buckets);
+
+	// Optional substring index
+	if (substringIndex != NULL) substringIndex->save(out);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 
+size_t
+StringDictionaryPFC::build(IteratorDictString *it, uint bucketsize, ofstream &out)
+{
+	if (bucketsize < 2)
+	{
+		cerr << "[WARNING] The bucketsize value must be greater than 1. ";
+		cerr << "The dictionary is built using buckets of size 2" << endl;
+		bucketsize = 2;
+	}
+
+	uint64_t elements = 0, bytesStrings = 0, buckets = 0;
+	uint32_t maxlength = 0;
+
+	// The header is rewritten when the final values are known
+	streampos header = out.tellp();
+	saveValue<uint32_t>(out, PFC);
+	saveValue<uint64_t>(out, elements);
+	saveValue<uint32_t>(out, maxlength);
+	saveValue<uint32_t>(out, (uint32_t)buckets);
+	saveValue<uint32_t>(out, bucketsize);
+	saveValue<uint64_t>(out, bytesStrings);
+
+	// Bucket offsets are spilled to disk
+	FILE *offsets = tmpfile();
+	if (offsets == NULL) throw "Unable to create the temporary file for the bucket offsets.";
+	fwrite(&bytesStrings, sizeof(size_t), 1, offsets);
+
+	uchar *strCurrent=NULL, *strPrev=NULL;
+	uint lenCurrent=0, lenPrev=0;
+	uchar vbyte[8];
+
+	while (it->hasNext())
+	{
+		strCurrent = it->next(&lenCurrent);
+		if (lenCurrent >= maxlength) maxlength = lenCurrent+1;
+
+		if ((elements % bucketsize) == 0)
+		{
+			// First string in the current bucket: explicitly copied
+			fwrite(&bytesStrings, sizeof(size_t), 1, offsets);
+			buckets++;
+
+			out.write((char*)strCurrent, lenCurrent+1);
+			bytesStrings += lenCurrent+1;
+		}
+		else
+		{
+			// Regular string: VByte(lcp) and the remaining suffix
+			uint lcp = 0;
+			longestCommonPrefix(strPrev, strCurrent, lenPrev, &lcp);
+
+			uint bytesLcp = VByte::encode(lcp, vbyte);
+			out.write((char*)vbyte, bytesLcp);
+			out.write((char*)strCurrent+lcp, lenCurrent-lcp+1);
+			bytesStrings += bytesLcp+lenCurrent-lcp+1;
+		}
+
+		elements++;
+		strPrev = strCurrent;
+		lenPrev = lenCurrent;
+	}
+
+	delete it;
+
+	// Obtaining the positional indexes
+	fwrite(&bytesStrings, sizeof(size_t), 1, offsets);
+	LogSequence::save(out, offsets, buckets+2, LogSequence::alignedNumbits(bits(bytesStrings), buckets+2));
+	fclose(offsets);
+	if (buckets >= WIDEBUCKETS) saveValue<uint64_t>(out, buckets);
+
+	streampos end = out.tellp();
+	out.seekp(header);
+	saveValue<uint32_t>(out, PFC);
+	saveValue<uint64_t>(out, elements);
+	saveValue<uint32_t>(out, maxlength);
+	saveValue<uint32_t>(out, (buckets < WIDEBUCKETS) ? (uint32_t)buckets : WIDEBUCKETS);
+	saveValue<uint32_t>(out, bucketsize);
+	saveValue<uint64_t>(out, bytesStrings);
+	out.seekp(end);
+
+	return elements;
+}
+
 StringDictionary*
-StringDictionaryPFC::load(ifstream &in)
+StringDictionaryPFC::load(ifstream &in, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 	if(type != PFC) return NULL;
 
 	StringDictionaryPFC *dict = new StringDictionaryPFC();
+	dict->memoryMapping = mapping;
 
 	dict->type = PFC;
 	dict->elements = loadValue<uint64_t>(in);
@@ -374,26 +786,40 @@ StringDictionaryPFC::load(ifstream &in)
 	dict->buckets = loadValue<uint32_t>(in);
 	dict->bucketsize = loadValue<uint32_t>(in);
 	dict->bytesStrings = loadValue<uint64_t>(in);
-	dict->textStrings = loadValue<uchar>(in, dict->bytesStrings);
-	dict->blStrings = new LogSequence(in);
+	dict->textStrings = MemoryMapping::loadArray<uchar>(mapping, in, dict->bytesStrings);
+	dict->blStrings = new LogSequence(in, mapping);
+	if (dict->buckets == WIDEBUCKETS) dict->buckets = loadValue<uint64_t>(in);
+
+	dict->substringIndex = SubstringIndex::load(in, dict, mapping);
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
 
 	return dict;
 }
 
 inline uchar*
-StringDictionaryPFC::getHeader(size_t idbucket, uchar **str, uint *strLen)
+StringDictionaryPFC::getHeader(size_t idbucket, uchar **str, uint *strLen) const
 {
 	uchar *ptr = textStrings+blStrings->getField(idbucket);
 	*strLen = strlen((char*)ptr);
 
-	*str = new uchar[maxlength];
+	*str = new uchar[maxlength+1];
 	strncpy((char*)*str, (char*)ptr, *strLen+1);
 
 	return ptr+(*strLen)+1;
 }
 
+uint
+StringDictionaryPFC::decodeHeader(size_t idbucket, uchar *str) const
+{
+	uchar *ptr = textStrings+blStrings->getField(idbucket);
+	uint strLen = strlen((char*)ptr);
+
+	memcpy(str, ptr, strLen+1);
+	return strLen;
+}
+
 void
-StringDictionaryPFC::decodeNextString(uchar **ptr, uint lenPrefix, uchar *str, uint *strLen)
+StringDictionaryPFC::decodeNextString(uchar **ptr, uint lenPrefix, uchar *str, uint *strLen) const
 {
 	uint lenSuffix;
 
@@ -405,11 +831,14 @@ StringDictionaryPFC::decodeNextString(uchar **ptr, uint lenPrefix, uchar *str, u
 }
 
 bool 
-StringDictionaryPFC::locateBucket(uchar *str, size_t *idbucket)
+StringDictionaryPFC::locateBucket(uchar *str, size_t *idbucket) const
 {
 	size_t left = 1, right = buckets, center = 0;
 	int cmp = 0;
 
+	// Narrowing the search to the buckets whose headers share the key
+	if (headerIndex != NULL) headerIndex->narrow(str, 0, &left, &right);
+
 	while (left <= right)
 	{
 		center = (left+right)/2;
@@ -423,16 +852,78 @@ StringDictionaryPFC::locateBucket(uchar *str, size_t *idbucket)
 		else { *idbucket = center; return true; }
 	}
 
-	// c is the candidate bucket for the string
-	if (cmp < 0) *idbucket = center;
-	// c-1 is the candidate bucket for the string
-	else *idbucket = center-1;
+	// The rightmost bucket whose header is lower than the string is
+	// the candidate one
+	*idbucket = right;
 
 	return false;
 }
 
 void
-StringDictionaryPFC::locateBoundaryBuckets(uchar *str, uint strLen, size_t *left, size_t *right)
+StringDictionaryPFC::locateBucketBatch(const uchar **strs, size_t n, size_t *idbuckets, bool *headers) const
+{
+	size_t left[BATCHSIZE], right[BATCHSIZE], center[BATCHSIZE];
+	uchar *header[BATCHSIZE];
+	size_t active = n;
+
+	for (size_t i=0; i<n; i++)
+	{
+		left[i] = 1; right[i] = buckets; headers[i] = false;
+		if (headerIndex != NULL) headerIndex->narrow(strs[i], 0, &left[i], &right[i]);
+
+		if (left[i] > right[i])
+		{
+			// The header key already determines the candidate bucket
+			idbuckets[i] = right[i];
+			active--;
+		}
+		else
+		{
+			center[i] = (left[i]+right[i])/2;
+			blStrings->prefetch(center[i]);
+		}
+	}
+
+	while (active > 0)
+	{
+		// Reading the header positions and prefetching the headers
+		for (size_t i=0; i<n; i++)
+		{
+			if (left[i] > right[i]) continue;
+
+			header[i] = textStrings+blStrings->getField(center[i]);
+			PREFETCH(header[i]);
+		}
+
+		// Comparing the headers while the remaining ones are loaded
+		for (size_t i=0; i<n; i++)
+		{
+			if (left[i] > right[i]) continue;
+
+			int cmp = strcmp((char*)header[i], (char*)strs[i]);
+
+			if (cmp > 0) right[i] = center[i]-1;
+			else if (cmp < 0) left[i] = center[i]+1;
+			else { headers[i] = true; left[i] = center[i]+1; right[i] = center[i]; }
+
+			if (left[i] > right[i])
+			{
+				// The rightmost bucket whose header is not greater
+				// than the string is the candidate one
+				idbuckets[i] = right[i];
+				active--;
+			}
+			else
+			{
+				center[i] = (left[i]+right[i])/2;
+				blStrings->prefetch(center[i]);
+			}
+		}
+	}
+}
+
+void
+StringDictionaryPFC::locateBoundaryBuckets(uchar *str, uint strLen, size_t *left, size_t *right) const
 {
 	size_t center = 0;
 	int cmp = 0;
@@ -457,7 +948,7 @@ StringDictionaryPFC::locateBoundaryBuckets(uchar *str, uint strLen, size_t *left
 	if (center > 1)
 	{
 		// Looking for the left boundary
-		uint ll = *left, lr = center-1, lc;
+		size_t ll = *left, lr = center-1, lc;
 
 		while (ll <= lr)
 		{
@@ -475,7 +966,7 @@ StringDictionaryPFC::locateBoundaryBuckets(uchar *str, uint strLen, size_t *left
 	if (center < buckets)
 	{
 		// Looking for the right boundary
-		uint rl = center, rr = *right+1, rc;
+		size_t rl = center, rr = *right+1, rc;
 
 		while (rl < (rr-1))
 		{
@@ -491,24 +982,27 @@ StringDictionaryPFC::locateBoundaryBuckets(uchar *str, uint strLen, size_t *left
 }
 
 uint
-StringDictionaryPFC::searchPrefix(uchar **ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen)
+StringDictionaryPFC::searchPrefix(uchar **ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen) const
 {
+	uint id=NORESULT;
+
 	uint sharedCurr=0, sharedPrev=0;
-	int cmp=0; uint id=1;
+	int cmp=0;
 
+	uint i=1;
 	while (true)
 	{
-		cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, *decLen-sharedCurr, &sharedCurr);
+		cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, min(*decLen, strLen)-sharedCurr, &sharedCurr);
 
-		if (sharedCurr==strLen) break;
+		if (sharedCurr==strLen) { id = i; break; }
 		else
 		{
-			id++;
-			if ((cmp > 0) || (id > scanneable)) break;
+			if ((cmp > 0) || (i == scanneable)) break;
 
 			*ptr += VByte::decode(&sharedPrev, *ptr);
 			if  (sharedPrev < sharedCurr) break;
 			decodeNextString(ptr, sharedPrev, decoded, decLen);
+			i++;
 		}
 	}
 
@@ -516,7 +1010,7 @@ StringDictionaryPFC::searchPrefix(uchar **ptr, uint scanneable, uchar *decoded,
 }
 
 uint
-StringDictionaryPFC::searchDistinctPrefix(uchar *ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen)
+StringDictionaryPFC::searchDistinctPrefix(uchar *ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen) const
 {
 	uint id = 1;
 	uint lenPrefix;
@@ -533,6 +1027,6 @@ StringDictionaryPFC::searchDistinctPrefix(uchar *ptr, uint scanneable, uchar *de
 
 StringDictionaryPFC::~StringDictionaryPFC()
 {
-	delete [] textStrings; delete blStrings;
+	MemoryMapping::release(memoryMapping, textStrings); delete blStrings;
 }
 
@@ -64,18 +64,40 @@ class StringDictionaryPFC : public StringDictionary
 		/** Generic Constructor. */
 		StringDictionaryPFC();
 
-		/** Class Constructor.
+		/** Class Constructor. The dictionary is built in memory (see
+		    build for writing it directly into a file).
 		    @param it: iterator scanning the original set of strings.
 		    @param bucketsize: number of strings represented per bucket.
 		*/
 		StringDictionaryPFC(IteratorDictString *it, uint bucketsize);
+
+		/** Parallel Class Constructor. The plain text is split in
+		    bucket-aligned chunks which are independently Front-Coded
+		    by the given number of threads. The resulting dictionary is
+		    identical to that obtained by the sequential constructor.
+		    @param it: iterator over the plain (in-memory) strings.
+		    @param bucketsize: number of strings represented per bucket.
+		    @param threads: number of threads used for encoding.
+		*/
+		StringDictionaryPFC(IteratorDictStringPlain *it, uint bucketsize, uint threads);
 		
 		/** Retrieves the ID corresponding to the given string.
 		    @param str: the string to be searched.
 		    @param strLen: the string length.
 		    @returns the ID (or NORESULT if it is not in the bucket).
 		*/
-		uint locate(uchar *str, uint strLen);
+		size_t locate(uchar *str, uint strLen) const;
+
+		/** Retrieves the IDs corresponding to a batch of strings. The
+		    binary searches over the bucket headers advance in lockstep
+		    and each step prefetches the header compared in the next one.
+		    @param strs: the strings to be searched.
+		    @param lens: the string lengths.
+		    @param n: the number of strings.
+		    @param out: the resulting IDs (NORESULT for those strings
+		      which are not in the dictionary).
+		*/
+		void locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const;
 		
 		/** Obtains the string associated with the given ID.
 		    @param id: the ID to be extracted.
@@ -83,7 +105,29 @@ class StringDictionaryPFC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		 */
-		uchar* extract(size_t id, uint *strLen);
+		uchar* extract(size_t id, uint *strLen) const;
+
+		/** Obtains the string associated with the given ID into a
+		    buffer owned by the caller. The string is directly decoded
+		    on the buffer if its capacity is greater than maxLength().
+		    @param id: the ID to be extracted.
+		    @param buf: the buffer.
+		    @param cap: the buffer capacity.
+		    @returns the string length (0 if the ID is not in the
+		      dictionary).
+		*/
+		uint extractInto(size_t id, uchar *buf, uint cap) const;
+
+		/** Obtains the strings associated with a batch of IDs. The
+		    IDs are sorted, so each bucket is decoded (at most) once.
+		    @param ids: the IDs to be extracted.
+		    @param n: the number of IDs.
+		    @param arena: the arena in which the strings are written.
+		    @param offsets: the offset (within the arena) of each string.
+		    @param lengths: the length of each string (0 if the ID is
+		      not in the dictionary).
+		*/
+		void extractBatch(const size_t *ids, size_t n, ByteArena &arena, size_t *offsets, uint *lengths) const;
 		
 		/** Locates all IDs of those elements prefixed by the given 
 		    string.
@@ -91,7 +135,7 @@ class StringDictionaryPFC : public StringDictionary
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locatePrefix(uchar *str, uint strLen);
+		IteratorDictID* locatePrefix(uchar *str, uint strLen) const;
 		
 		/** Locates all IDs of those elements containing the given 
 		    substring.
@@ -99,27 +143,27 @@ class StringDictionaryPFC : public StringDictionary
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locateSubstr(uchar *str, uint strLen);
+		IteratorDictID* locateSubstr(uchar *str, uint strLen) const;
 		
 		/** Retrieves the ID with rank k according to its alphabetical order. 
 		    @param rank: the alphabetical ranking.
 		    @returns the ID.
 		*/
-		uint locateRank(uint rank);
+		size_t locateRank(size_t rank) const;
 		
 		/** Extracts all elements prefixed by the given string.
 		    @param str: the prefix to be searched.
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractPrefix(uchar *str, uint strLen);
+		IteratorDictString* extractPrefix(uchar *str, uint strLen) const;
 		
 		/** Extracts all elements containing by the given substring.
 		    @param str: the substring to be searched.
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractSubstr(uchar *str, uint strLen);
+		IteratorDictString* extractSubstr(uchar *str, uint strLen) const;
 		
 		/** Obtains the string  with rank k according to its 
 		    alphabetical order.
@@ -128,18 +172,39 @@ class StringDictionaryPFC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		*/
-		uchar* extractRank(uint rank, uint *strLen);
+		uchar* extractRank(size_t rank, uint *strLen) const;
 		
 		/** Extracts all strings in the dictionary sorted in 
 		    alphabetical order. 
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractTable();
+		IteratorDictString* extractTable() const;
+
+		/** Extracts the strings whose IDs are in the given range (in
+		    ID order).
+		    @param left: the first ID.
+		    @param right: the last ID.
+		    @returns an iterator for direct scanning of the strings.
+		*/
+		IteratorDictString* extractRange(size_t left, size_t right) const;
+
+		/** Builds the q-gram index which enables substring operations.
+		*/
+		void indexSubstrings();
+
+		/** Builds the approximate membership filter, so locate 
+		    discards most of the strings not in the dictionary.
+		*/
+		void indexMembership();
 		
 		/** Computes the size of the structure in bytes. 
 		    @returns the dictionary size in bytes.
 		*/
-		size_t getSize();
+		size_t getSize() const;
+
+		/** Builds the cache-resident index over the bucket headers.
+		*/
+		void indexHeaders();
 		
 		/** Stores the dictionary into an ofstream.
 		    @param out: the oftstream.
@@ -148,15 +213,30 @@ class StringDictionaryPFC : public StringDictionary
 		
 		/** Loads a dictionary from an ifstream.
 		    @param in: the ifstream.
+		    @param mapping: the memory mapping of the file (if any). The
+		      dictionary takes its ownership.
 		    @returns the loaded dictionary.
 		*/
-		static StringDictionary *load(ifstream &in);
+		static StringDictionary *load(ifstream &in, MemoryMapping *mapping=NULL);
+
+		/** Builds the dictionary directly into an ofstream. Each string is
+		    written as soon as it is encoded and the bucket offsets are
+		    spilled to a temporary file, so the memory used only depends
+		    on the length of the largest string. The result is the same
+		    as saving the dictionary built by the class constructor.
+		    @param it: iterator scanning the original set of strings (it
+		      is deleted when the dictionary is built).
+		    @param bucketsize: number of strings represented per bucket.
+		    @param out: the ofstream.
+		    @returns the number of strings in the dictionary.
+		*/
+		static size_t build(IteratorDictString *it, uint bucketsize, ofstream &out);
 
 		/** Generic destructor. */
 		~StringDictionaryPFC();
 
 	protected:
-		uint32_t buckets;	//! Number of total buckets in the dictionary
+		uint64_t buckets;	//! Number of total buckets in the dictionary
 		uint32_t bucketsize;	//! Number of strings per bucket
 
 		uint64_t bytesStrings;	//! Length of the strings representation
@@ -169,7 +249,14 @@ class StringDictionaryPFC : public StringDictionary
 		    @param strLen: pointer to the header length.
 		    @returns pointer to the next unprocessed char.
 		*/
-		inline uchar *getHeader(size_t idbucket, uchar **str, uint *strLen);
+		inline uchar *getHeader(size_t idbucket, uchar **str, uint *strLen) const;
+
+		/** Copies the header string of the given bucket into a buffer.
+		    @param idbucket: the bucket.
+		    @param str: the buffer (with room for maxlength+1 chars).
+		    @returns the header length.
+		*/
+		inline uint decodeHeader(size_t idbucket, uchar *str) const;
 
 		/** Decodes the next internal string according to the 
 		    scanning data
@@ -179,7 +266,7 @@ class StringDictionaryPFC : public StringDictionary
 		    @param strLen: pointer to the string length.
 		    returns the number of chars shared with the previous string
 		*/
-		inline void decodeNextString(uchar **ptr, uint lenPrefix, uchar *str, uint *strLen);
+		inline void decodeNextString(uchar **ptr, uint lenPrefix, uchar *str, uint *strLen) const;
 
 		/** Locates the candidate bucket in which the given string can
 		    be represented.
@@ -188,7 +275,26 @@ class StringDictionaryPFC : public StringDictionary
 		    @returns a boolean value telling if the string is the 
 		      header of the bucket.
 		*/
-		inline bool locateBucket(uchar *str, size_t *idbucket);
+		inline bool locateBucket(uchar *str, size_t *idbucket) const;
+
+		/** Locates the candidate buckets for a group of (at most
+		    BATCHSIZE) strings.
+		    @param strs: the strings to be located.
+		    @param n: the number of strings.
+		    @param idbuckets: the candidate buckets.
+		    @param headers: tells, for each string, if it is the header
+		      of its bucket.
+		*/
+		inline void locateBucketBatch(const uchar **strs, size_t n, size_t *idbuckets, bool *headers) const;
+
+		/** Scans the candidate bucket for the given string (which is
+		    not its header).
+		    @param idbucket: the candidate bucket.
+		    @param str: the string to be located.
+		    @param strLen: the string length.
+		    @returns the ID (or NORESULT if it is not in the bucket).
+		*/
+		inline size_t locateInBucket(size_t idbucket, uchar *str, uint strLen) const;
 
 		/** Locates the buckets which delimits the representation of
 		    all possible elments prefixed by the given string.
@@ -197,7 +303,7 @@ class StringDictionaryPFC : public StringDictionary
 		    @param left: pointer to the left boundary bucket.
 		    @param right: pointer to the right boundary bucket.
 		*/
-		inline void locateBoundaryBuckets(uchar *str, uint strLen, size_t *left, size_t *right);
+		inline void locateBoundaryBuckets(uchar *str, uint strLen, size_t *left, size_t *right) const;
 
 		/** Searches the first string prefixed for the given one.
 		    @param ptr: pointer to the next unprocessed string.
@@ -208,7 +314,7 @@ class StringDictionaryPFC : public StringDictionary
 			@param strLen: the prefix length.
 			@returns the internal ID (of 0 if it is not in the bucket).
 		*/
-		inline uint searchPrefix(uchar **ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen);
+		inline uint searchPrefix(uchar **ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen) const;
 
 		/** Searches the first string non-prefixed for the given one.
 		    @param ptr: pointer to the next unprocessed string.
@@ -219,7 +325,7 @@ class StringDictionaryPFC : public StringDictionary
 		    @param strLen: the prefix length.
 		    @returns the internal ID (of 0 if it is not in the bucket).
 		*/
-		inline uint searchDistinctPrefix(uchar *ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen);
+		inline uint searchDistinctPrefix(uchar *ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen) const;
 
 	friend class StringDictionaryRPFC;
 	friend class StringDictionaryHTFC;
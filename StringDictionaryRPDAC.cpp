@@ -98,14 +98,16 @@ StringDictionaryRPDAC::StringDictionaryRPDAC(IteratorDictString *it)
 	delete [] dict;
 
 	// Building the array for the sequence
-	rp->Cdac = new DAC_VLS(cdict, ic-2, bits(rp->rules+rp->terminals), maxseq);
+	rp->Cdac = new DAC_VLS(cdict, ic-1, bits(rp->rules+rp->terminals), maxseq);
 
 	delete [] cdict;
 }
 
-uint 
-StringDictionaryRPDAC::locate(uchar *str, uint strLen)
+size_t 
+StringDictionaryRPDAC::locate(uchar *str, uint strLen) const
 {
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
+
 	// Binary search comparing s with respect to the corresponding
 	// pivot rule.
 	size_t left = 1, right = elements, center = 0;
@@ -128,41 +130,57 @@ StringDictionaryRPDAC::locate(uchar *str, uint strLen)
 }
 
 uchar *
-StringDictionaryRPDAC::extract(size_t id, uint *strLen)
+StringDictionaryRPDAC::extract(size_t id, uint *strLen) const
 {
 	if ((id > 0) && (id <= elements))
 	{
-		uint *rules;
-		uint len = rp->Cdac->access(id, &rules);
 		uchar *s = new uchar[maxlength+1];
-			
+		*strLen = extractInto(id, s, maxlength+1);
+
+		return s;
+	}
+	else
+	{
 		*strLen = 0;
-			
+		return NULL;
+	}
+}
+
+uint
+StringDictionaryRPDAC::extractInto(size_t id, uchar *buf, uint cap) const
+{
+	// The rules of any string can be expanded on the buffer
+	if (cap <= maxlength) return StringDictionary::extractInto(id, buf, cap);
+
+	uint strLen = 0;
+
+	if ((id > 0) && (id <= elements))
+	{
+		uint *rules;
+		uint len = rp->Cdac->access(id, &rules);
+
 		for (uint i=0; i<len; i++)
 		{
-			if (rules[i] >= rp->terminals) (*strLen) += rp->expandRule(rules[i]-rp->terminals, (s+(*strLen)));
+			if (rules[i] >= rp->terminals) strLen += rp->expandRule(rules[i]-rp->terminals, buf+strLen);
 			else
 			{
-				s[*strLen] = (uchar)rules[i];
-				(*strLen)++;
+				buf[strLen] = (uchar)rules[i];
+				strLen++;
 			}
 		}
-			
-		s[*strLen] = (uchar)'\0';
+
 		delete [] rules;
-			
-		return s;
-	}
-	else
-	{
-		*strLen = 0;
-		return NULL;
 	}
+
+	buf[strLen] = (uchar)'\0';
+	return strLen;
 }
 
 IteratorDictID*
-StringDictionaryRPDAC::locatePrefix(uchar *str, uint strLen)
+StringDictionaryRPDAC::locatePrefix(uchar *str, uint strLen) const
 {
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
+
 	// Binary search comparing s with respect to the corresponding
 	// pivot rule.
 	size_t left = 1, right = elements, center = 0;
@@ -187,7 +205,7 @@ StringDictionaryRPDAC::locatePrefix(uchar *str, uint strLen)
 	if (center > 1)
 	{
 		// Looking for the left boundary
-		uint ll = left, lr = center-1, lc;
+		size_t ll = left, lr = center-1, lc;
 
 		while (ll <= lr)
 		{
@@ -206,7 +224,7 @@ StringDictionaryRPDAC::locatePrefix(uchar *str, uint strLen)
 	if (center < elements)
 	{
 		// Looking for the right boundary
-		uint rl = center, rr = right+1, rc;
+		size_t rl = center, rr = right+1, rc;
 
 		while (rl < (rr-1))
 		{
@@ -226,53 +244,81 @@ StringDictionaryRPDAC::locatePrefix(uchar *str, uint strLen)
 
 
 IteratorDictID*
-StringDictionaryRPDAC::locateSubstr(uchar *str, uint strLen)
+StringDictionaryRPDAC::locateSubstr(uchar *str, uint strLen) const
 {
+	if (substringIndex != NULL) return substringIndex->locate(str, strLen);
+
 	cout << "This dictionary does not provide substring location" << endl;
 	return NULL;
 }
 
-uint 
-StringDictionaryRPDAC::locateRank(uint rank)
+size_t 
+StringDictionaryRPDAC::locateRank(size_t rank) const
 {
 	return rank;
 }
 
 IteratorDictString*
-StringDictionaryRPDAC::extractPrefix(uchar *str, uint strLen)
+StringDictionaryRPDAC::extractPrefix(uchar *str, uint strLen) const
 {
 	IteratorDictIDContiguous *it = (IteratorDictIDContiguous*)locatePrefix(str, strLen);
 
-	size_t offset = it->getLeftLimit()-1;
-	size_t scanneable = it->getRightLimit();
+	size_t left = it->getLeftLimit();
+	size_t right = it->getRightLimit();
 
 	delete it;
-	return new IteratorDictStringRPDAC(rp->G, rp->terminals, rp->Cdac, offset, scanneable, maxlength);
+	return extractRange(left, right);
+}
+
+IteratorDictString*
+StringDictionaryRPDAC::extractRange(size_t left, size_t right) const
+{
+	return new IteratorDictStringRPDAC(rp, left-1, right, maxlength);
 }
 
 IteratorDictString*
-StringDictionaryRPDAC::extractSubstr(uchar *str, uint strLen)
+StringDictionaryRPDAC::extractSubstr(uchar *str, uint strLen) const
 {
+	if (substringIndex != NULL) return substringIndex->extract(str, strLen);
+
 	cout << "This dictionary does not provide substring extraction" << endl;
 	return 0; 
 }
 
 uchar *
-StringDictionaryRPDAC::extractRank(uint rank, uint *strLen)
+StringDictionaryRPDAC::extractRank(size_t rank, uint *strLen) const
 {
 	return extract(rank, strLen);
 }
 
 IteratorDictString*
-StringDictionaryRPDAC::extractTable()
+StringDictionaryRPDAC::extractTable() const
 {
-	return new IteratorDictStringRPDAC(rp->G, rp->terminals, rp->Cdac, 0, elements, maxlength);
+	return new IteratorDictStringRPDAC(rp, 0, elements, maxlength);
+}
+
+void
+StringDictionaryRPDAC::indexSubstrings()
+{
+	if (substringIndex == NULL) substringIndex = new SubstringIndex(this, SUBSTRBLOCK);
+}
+
+void
+StringDictionaryRPDAC::indexMembership()
+{
+	if (membershipFilter == NULL) membershipFilter = new MembershipFilter(this);
+}
+
+void
+StringDictionaryRPDAC::indexGrammar()
+{
+	rp->unpack();
 }
 
 size_t 
-StringDictionaryRPDAC::getSize()
+StringDictionaryRPDAC::getSize() const
 {
-	return rp->getSize()+sizeof(StringDictionaryRPDAC);
+	return rp->getSize()+sizeof(StringDictionaryRPDAC)+((substringIndex != NULL) ? substringIndex->getSize() : 0)+((membershipFilter != NULL) ? membershipFilter->getSize() : 0);
 }
 
 void 
@@ -282,21 +328,31 @@ StringDictionaryRPDAC::save(ofstream &out)
 	saveValue<uint64_t>(out, elements);
 	saveValue<uint32_t>(out, maxlength);
 	rp->save(out, RPDAC);
+
+	// Optional substring index
+	if (substringIndex != NULL) substringIndex->save(out);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 
 StringDictionary*
-StringDictionaryRPDAC::load(ifstream &in)
+StringDictionaryRPDAC::load(ifstream &in, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 	if(type != RPDAC) return NULL;
 
 	StringDictionaryRPDAC *dict = new StringDictionaryRPDAC();
+	dict->memoryMapping = mapping;
 
 	dict->type = RPDAC;
 	dict->elements = loadValue<uint64_t>(in);
 	dict->maxlength = loadValue<uint32_t>(in);
-	dict->rp = RePair::load(in);
+	dict->rp = RePair::load(in, mapping);
+
+	dict->substringIndex = SubstringIndex::load(in, dict, mapping);
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
 
 	return dict;
 }
@@ -74,7 +74,7 @@ class StringDictionaryRPDAC : public StringDictionary
 		    @param strLen: the string length.
 		    @returns the ID (or NORESULT if it is not in the bucket).
 		*/
-		uint locate(uchar *str, uint strLen);
+		size_t locate(uchar *str, uint strLen) const;
 		
 		/** Obtains the string associated with the given ID.
 		    @param id: the ID to be extracted.
@@ -82,7 +82,18 @@ class StringDictionaryRPDAC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		 */
-		uchar* extract(size_t id, uint *strLen);
+		uchar* extract(size_t id, uint *strLen) const;
+
+		/** Obtains the string associated with the given ID into a
+		    buffer owned by the caller. The rules are directly expanded
+		    on the buffer if its capacity is greater than maxLength().
+		    @param id: the ID to be extracted.
+		    @param buf: the buffer.
+		    @param cap: the buffer capacity.
+		    @returns the string length (0 if the ID is not in the
+		      dictionary).
+		*/
+		uint extractInto(size_t id, uchar *buf, uint cap) const;
 		
 		/** Locates all IDs of those elements prefixed by the given 
 		    string.
@@ -90,7 +101,7 @@ class StringDictionaryRPDAC : public StringDictionary
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locatePrefix(uchar *str, uint strLen);
+		IteratorDictID* locatePrefix(uchar *str, uint strLen) const;
 		
 		/** Locates all IDs of those elements containing the given 
 		    substring.
@@ -98,27 +109,27 @@ class StringDictionaryRPDAC : public StringDictionary
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locateSubstr(uchar *str, uint strLen);
+		IteratorDictID* locateSubstr(uchar *str, uint strLen) const;
 		
 		/** Retrieves the ID with rank k according to its alphabetical order. 
 		    @param rank: the alphabetical ranking.
 		    @returns the ID.
 		*/
-		uint locateRank(uint rank);
+		size_t locateRank(size_t rank) const;
 		
 		/** Extracts all elements prefixed by the given string.
 		    @param str: the prefix to be searched.
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractPrefix(uchar *str, uint strLen);
+		IteratorDictString* extractPrefix(uchar *str, uint strLen) const;
 		
 		/** Extracts all elements containing by the given substring.
 		    @param str: the substring to be searched.
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractSubstr(uchar *str, uint strLen);
+		IteratorDictString* extractSubstr(uchar *str, uint strLen) const;
 		
 		/** Obtains the string  with rank k according to its 
 		    alphabetical order.
@@ -127,18 +138,40 @@ class StringDictionaryRPDAC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		*/
-		uchar* extractRank(uint rank, uint *strLen);
+		uchar* extractRank(size_t rank, uint *strLen) const;
 		
 		/** Extracts all strings in the dictionary sorted in 
 		    alphabetical order. 
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractTable();
+		IteratorDictString* extractTable() const;
+
+		/** Extracts the strings whose IDs are in the given range (in
+		    ID order).
+		    @param left: the first ID.
+		    @param right: the last ID.
+		    @returns an iterator for direct scanning of the strings.
+		*/
+		IteratorDictString* extractRange(size_t left, size_t right) const;
+
+		/** Builds the q-gram index which enables substring operations.
+		*/
+		void indexSubstrings();
 		
+		/** Builds the approximate membership filter, so locate 
+		    discards most of the strings not in the dictionary.
+		*/
+		void indexMembership();
+
+		/** Unpacks the RePair grammar (expansions and comparisons
+		    avoid bit unpacking).
+		*/
+		void indexGrammar();
+
 		/** Computes the size of the structure in bytes. 
 		    @returns the dictionary size in bytes.
 		*/
-		size_t getSize();
+		size_t getSize() const;
 		
 		/** Stores the dictionary into an ofstream.
 		    @param out: the oftstream.
@@ -147,9 +180,11 @@ class StringDictionaryRPDAC : public StringDictionary
 		
 		/** Loads a dictionary from an ifstream.
 		    @param in: the ifstream.
+		    @param mapping: the memory mapping of the file (if any). The
+		      dictionary takes its ownership.
 		    @returns the loaded dictionary.
 		*/
-		static StringDictionary *load(ifstream &in);
+		static StringDictionary *load(ifstream &in, MemoryMapping *mapping=NULL);
 
 		/** Generic destructor. */
 		~StringDictionaryRPDAC();
@@ -69,7 +69,7 @@ StringDictionaryRPFC::StringDictionaryRPFC(IteratorDictString *it, uint bucketsi
 	int* rpdict = new int[reservedInts];
 
 	size_t pbeg = 0, pend = 0;
-	uint bucket = 1; uint buckets = dict->buckets;
+	size_t bucket = 1, buckets = dict->buckets;
 	size_t ptrpdict = 0;
 
 	uint ends = 0;
@@ -92,11 +92,11 @@ StringDictionaryRPFC::StringDictionaryRPFC(IteratorDictString *it, uint bucketsi
 		{
 			// Extracting the internal strings for Re-Pair compression
 
-			if ((ptrpdict+(size_t)(bucketsize*maxlength)) > reservedInts)
+			while ((ptrpdict+(size_t)(bucketsize*maxlength)) > reservedInts)
 				reservedInts = Reallocate(&rpdict, reservedInts);
 
 			// Stores the last position with 0 to avoid confusions with 0 values encoding VBytes.
-			uint zero = pbeg-1;
+			size_t zero = pbeg-1;
 
 
 			for (; pbeg < pend; pbeg++)
@@ -128,9 +128,9 @@ StringDictionaryRPFC::StringDictionaryRPFC(IteratorDictString *it, uint bucketsi
 	vector<size_t> beginnings(buckets+1);	// Bucket beginnings
 
 	size_t ibytes = 0;
-	uint io = 0, strings = 0;
+	size_t io = 0, strings = 0;
 	beginnings[0] = 0;
-	uint zero = 0;
+	size_t zero = 0;
 
 	while (io<ptrpdict)
 	{
@@ -156,7 +156,9 @@ StringDictionaryRPFC::StringDictionaryRPFC(IteratorDictString *it, uint bucketsi
 		}
 	}
 
-	beginnings[1+strings/(bucketsize-1)] = ibytes;
+	// The last bucket always ends with the last internal string (it is
+	// empty if the bucket only contains its header)
+	beginnings[buckets] = ibytes;
 	delete [] rpdict;
 
 	// 3) Compressing the dictionary
@@ -192,13 +194,13 @@ StringDictionaryRPFC::StringDictionaryRPFC(IteratorDictString *it, uint bucketsi
 
 			// Updating the ptr value to the beginning of the corresponding internal string
 			ptrB = beginnings[bucket-1];
-			ptrE = beginnings[bucket]-1;
+			ptrE = beginnings[bucket];
 
 			// Processing the internal strings
 			offset = 0;
 			textStrings[bytesStrings] = 0;
 
-			for (; ptrB <= ptrE; ptrB++)
+			for (; ptrB < ptrE; ptrB++)
 				bytesStrings += encodeSymbol(intStrings[ptrB], &(textStrings[bytesStrings]), &offset);
 
 			if (offset > 0) bytesStrings++;
@@ -208,15 +210,16 @@ StringDictionaryRPFC::StringDictionaryRPFC(IteratorDictString *it, uint bucketsi
 
 		// bytesStrings++;
 		xblStrings.push_back(bytesStrings+1);
-		blStrings = new LogSequence(&xblStrings, bits(bytesStrings+1));
+		blStrings = new LogSequence(&xblStrings, bits(bytesStrings+1), true);
 	}
 }
 
 
-uint 
-StringDictionaryRPFC::locate(uchar *str, uint strLen)
+size_t 
+StringDictionaryRPFC::locate(uchar *str, uint strLen) const
 {
-	uint id = NORESULT;
+	// Strings discarded by the membership filter are not in the dictionary
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
 
 	// Locating the candidate bucket for the string
 	size_t idbucket;
@@ -224,78 +227,92 @@ StringDictionaryRPFC::locate(uchar *str, uint strLen)
 
 	// The string is the header of the bucket
 	if (cmp) return ((idbucket-1)*bucketsize)+1;
-	else
+	// The bucket is sequentially scanned to find the string
+	else return locateInBucket(idbucket, str, strLen);
+}
+
+void
+StringDictionaryRPFC::locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const
+{
+	size_t idbuckets[BATCHSIZE];
+	bool headers[BATCHSIZE];
+
+	for (size_t i=0; i<n; i+=BATCHSIZE)
 	{
-		// The string is previous to any other one in the dictionary
-		if (idbucket != NORESULT)
+		size_t group = min(BATCHSIZE, n-i);
+		locateBucketBatch(strs+i, group, idbuckets, headers);
+
+		for (size_t j=0; j<group; j++)
 		{
-			// The bucket is sequentially scanned to find the string
-			uchar *decoded; uint decLen;
-			uchar *ptr = getHeader(idbucket, &decoded, &decLen);
+			if (headers[j]) out[i+j] = ((idbuckets[j]-1)*bucketsize)+1;
+			else if ((membershipFilter != NULL) && !membershipFilter->contains(strs[i+j], lens[i+j])) out[i+j] = NORESULT;
+			else out[i+j] = locateInBucket(idbuckets[j], (uchar*)strs[i+j], lens[i+j]);
+		}
+	}
+}
 
-			uint scanneable = bucketsize;
-			if ((idbucket == buckets) && ((elements%bucketsize) != 0)) scanneable = (elements%bucketsize);
+size_t
+StringDictionaryRPFC::locateInBucket(size_t idbucket, uchar *str, uint strLen) const
+{
+	size_t id = NORESULT;
 
-			if (scanneable > 1)
-			{
-				uint sharedCurr=0, sharedPrev=0;
-				uint offset=0;
-				int cmp=0;
+	// The string is previous to any other one in the dictionary
+	if (idbucket != NORESULT)
+	{
+		// The bucket is sequentially scanned to find the string
+		uchar *decoded; uint decLen;
+		uchar *ptr = getHeader(idbucket, &decoded, &decLen);
 
-				// Processing the first internal string
-				sharedPrev = decodeString(decoded, &decLen, &ptr, &offset);
-				cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, decLen-sharedCurr, &sharedCurr);
+		uint scanneable = bucketsize;
+		if ((idbucket == buckets) && ((elements%bucketsize) != 0)) scanneable = (elements%bucketsize);
+
+		if (scanneable > 1)
+		{
+			uint sharedCurr=0, sharedPrev=0;
+			uint offset=0;
+			int cmp=0;
 
-				if (cmp != 0)
+			// Processing the first internal string
+			sharedPrev = decodeString(decoded, &decLen, &ptr, &offset);
+			cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, decLen-sharedCurr, &sharedCurr);
+
+			if (cmp != 0)
+			{
+				for (uint i=2; i<scanneable; i++)
 				{
-					for (uint i=2; i<scanneable; i++)
-					{
-						// TODO: Esta operación se podría dividir en dos, leer primero
-						// el VByte y si todo esta OK, seguir decodificando.
-						// MIRAR lo que equivalente en PFC
-						sharedPrev = decodeString(decoded, &decLen, &ptr, &offset);
+					// TODO: Esta operación se podría dividir en dos, leer primero
+					// el VByte y si todo esta OK, seguir decodificando.
+					// MIRAR lo que equivalente en PFC
+					sharedPrev = decodeString(decoded, &decLen, &ptr, &offset);
 
-						if  (sharedPrev < sharedCurr) break;
+					if  (sharedPrev < sharedCurr) break;
 
-						cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, decLen-sharedCurr, &sharedCurr);
+					cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, decLen-sharedCurr, &sharedCurr);
 
-						if (cmp == 0)
-						{
-							id = ((idbucket-1)*bucketsize)+i+1;
-							break;
-						}
-						else if (cmp > 0) break;
+					if (cmp == 0)
+					{
+						id = ((idbucket-1)*bucketsize)+i+1;
+						break;
 					}
+					else if (cmp > 0) break;
 				}
-				else id = ((idbucket-1)*bucketsize)+2;
 			}
-
-			delete [] decoded;
+			else id = ((idbucket-1)*bucketsize)+2;
 		}
+
+		delete [] decoded;
 	}
 
 	return id;
 }
 
 uchar *
-StringDictionaryRPFC::extract(size_t id, uint *strLen)
+StringDictionaryRPFC::extract(size_t id, uint *strLen) const
 {
 	if ((id > 0) && (id <= elements))
 	{
-		uint idbucket = 1+((id-1)/bucketsize);
-		uint pos = ((id-1)%bucketsize);
-
-		uchar *decoded; uint decLen;
-		uchar *ptr = getHeader(idbucket, &decoded, &decLen);
-
-		if (pos > 0)
-		{
-			uint offset = 0;
-			for (uint i=1; i<=pos; i++)
-				decodeString(decoded, &decLen, &ptr, &offset);
-			*strLen = decLen-1;
-		}
-		else *strLen = decLen;
+		uchar *decoded = new uchar[maxlength+1];
+		*strLen = extractInto(id, decoded, maxlength+1);
 
 		return decoded;
 	}
@@ -306,8 +323,96 @@ StringDictionaryRPFC::extract(size_t id, uint *strLen)
 	}
 }
 
+uint
+StringDictionaryRPFC::extractInto(size_t id, uchar *buf, uint cap) const
+{
+	// Any string in the bucket can be decoded on the buffer
+	if (cap <= maxlength) return StringDictionary::extractInto(id, buf, cap);
+
+	if ((id > 0) && (id <= elements))
+	{
+		size_t idbucket = 1+((id-1)/bucketsize);
+		uint pos = ((id-1)%bucketsize);
+
+		// The header is plainly stored
+		uchar *ptr = textStrings+blStrings->getField(idbucket);
+		uint decLen = strlen((char*)ptr);
+
+		memcpy(buf, ptr, decLen+1);
+		ptr += decLen+1;
+
+		if (pos == 0) return decLen;
+
+		uint offset = 0;
+		for (uint i=1; i<=pos; i++)
+			decodeString(buf, &decLen, &ptr, &offset);
+
+		// Internal strings are decoded with their terminator
+		return decLen-1;
+	}
+	else
+	{
+		buf[0] = '\0';
+		return 0;
+	}
+}
+
+void
+StringDictionaryRPFC::extractBatch(const size_t *ids, size_t n, ByteArena &arena, size_t *offsets, uint *lengths) const
+{
+	vector<pair<size_t, size_t> > requests;
+	sortRequests(ids, n, &requests);
+
+	uchar *decoded = NULL, *ptr = NULL;
+	uint decLen = 0, offset = 0;
+	size_t idbucket = 0;
+	uint pos = 0;
+
+	for (size_t i=0; i<n; i++)
+	{
+		size_t id = requests[i].first, req = requests[i].second;
+
+		if ((i > 0) && (id == requests[i-1].first))
+		{
+			// Repeated ID: the previous decoding is referenced
+			offsets[req] = offsets[requests[i-1].second];
+			lengths[req] = lengths[requests[i-1].second];
+			continue;
+		}
+
+		if ((id == 0) || (id > elements))
+		{
+			offsets[req] = arena.append((uchar*)"", 0);
+			lengths[req] = 0;
+			continue;
+		}
+
+		if (1+((id-1)/bucketsize) != idbucket)
+		{
+			// Moving to the header of a new bucket
+			if (decoded != NULL) delete [] decoded;
+
+			idbucket = 1+((id-1)/bucketsize);
+			ptr = getHeader(idbucket, &decoded, &decLen);
+			offset = 0; pos = 0;
+		}
+
+		// Decoding up to the requested string
+		for (; pos<((id-1)%bucketsize); pos++)
+			decodeString(decoded, &decLen, &ptr, &offset);
+
+		// Internal strings are decoded with their terminator
+		if (pos > 0) lengths[req] = decLen-1;
+		else lengths[req] = decLen;
+
+		offsets[req] = arena.append(decoded, lengths[req]);
+	}
+
+	if (decoded != NULL) delete [] decoded;
+}
+
 IteratorDictID*
-StringDictionaryRPFC::locatePrefix(uchar *str, uint strLen)
+StringDictionaryRPFC::locatePrefix(uchar *str, uint strLen) const
 {
 	size_t leftBucket = 1, rightBucket = buckets;
 	size_t leftID = 0, rightID = 0;
@@ -384,64 +489,99 @@ StringDictionaryRPFC::locatePrefix(uchar *str, uint strLen)
 }
 
 IteratorDictID*
-StringDictionaryRPFC::locateSubstr(uchar *str, uint strLen)
+StringDictionaryRPFC::locateSubstr(uchar *str, uint strLen) const
 {
+	if (substringIndex != NULL) return substringIndex->locate(str, strLen);
+
 	cerr << "This dictionary does not provide substring location" << endl;
 	return NULL;
 }
 
-uint 
-StringDictionaryRPFC::locateRank(uint rank)
+size_t 
+StringDictionaryRPFC::locateRank(size_t rank) const
 {
 	return rank;
 }
 
 IteratorDictString*
-StringDictionaryRPFC::extractPrefix(uchar *str, uint strLen)
+StringDictionaryRPFC::extractPrefix(uchar *str, uint strLen) const
 {
 	IteratorDictIDContiguous *it = (IteratorDictIDContiguous*)locatePrefix(str, strLen);
 	size_t left = it->getLeftLimit();
+	size_t right = it->getRightLimit();
 
-	if (left != NORESULT)
-	{
-		// Positioning the LEFT Limit
-		uint leftbucket = 1+((left-1)/bucketsize);
-		uint leftpos = ((left-1)%bucketsize);
+	delete it;
 
-		// Positioning the RIGHT Limit
-		size_t right = it->getRightLimit();
-		delete it;
+	if (left != NORESULT) return extractRange(left, right);
+	else return NULL;
+}
+
+IteratorDictString*
+StringDictionaryRPFC::extractRange(size_t left, size_t right) const
+{
+	// Positioning the LEFT Limit
+	size_t leftbucket = 1+((left-1)/bucketsize);
+	uint leftpos = ((left-1)%bucketsize);
 
-		size_t ptrS = blStrings->getField(leftbucket);
+	size_t ptrS = blStrings->getField(leftbucket);
 
-		return new IteratorDictStringRPFC(rp, bitsrp, textStrings+ptrS, leftpos, bucketsize, right-left+1, maxlength);
-	}
-	else return NULL;
+	return new IteratorDictStringRPFC(rp, bitsrp, textStrings+ptrS, leftpos, bucketsize, right-left+1, maxlength);
 }
 
 IteratorDictString*
-StringDictionaryRPFC::extractSubstr(uchar *str, uint strLen)
+StringDictionaryRPFC::extractSubstr(uchar *str, uint strLen) const
 {
+	if (substringIndex != NULL) return substringIndex->extract(str, strLen);
+
 	cerr << "This dictionary does not provide substring extraction" << endl;
 	return 0; 
 }
 
 uchar *
-StringDictionaryRPFC::extractRank(uint rank, uint *strLen)
+StringDictionaryRPFC::extractRank(size_t rank, uint *strLen) const
 {
 	return extract(rank, strLen);
 }
 
 IteratorDictString*
-StringDictionaryRPFC::extractTable()
+StringDictionaryRPFC::extractTable() const
 {
 	return new IteratorDictStringRPFC(rp, bitsrp, textStrings, 0, bucketsize, elements, maxlength);
 }
 
+void
+StringDictionaryRPFC::indexGrammar()
+{
+	rp->unpack();
+}
+
 size_t 
-StringDictionaryRPFC::getSize()
+StringDictionaryRPFC::getSize() const
+{
+	size_t size = bytesStrings*sizeof(uchar)+blStrings->getSize()+rp->getSize()+sizeof(StringDictionaryRPFC);
+	if (headerIndex != NULL) size += headerIndex->getSize();
+	if (substringIndex != NULL) size += substringIndex->getSize();
+	if (membershipFilter != NULL) size += membershipFilter->getSize();
+
+	return size;
+}
+
+void
+StringDictionaryRPFC::indexHeaders()
+{
+	if (headerIndex == NULL) headerIndex = new HeaderIndex(textStrings, bytesStrings, blStrings, buckets, true);
+}
+
+void
+StringDictionaryRPFC::indexSubstrings()
+{
+	if (substringIndex == NULL) substringIndex = new SubstringIndex(this, bucketsize);
+}
+
+void
+StringDictionaryRPFC::indexMembership()
 {
-	return bytesStrings*sizeof(uchar)+blStrings->getSize()+rp->getSize()+sizeof(StringDictionaryRPFC);
+	if (membershipFilter == NULL) membershipFilter = new MembershipFilter(this);
 }
 
 void 
@@ -450,25 +590,33 @@ StringDictionaryRPFC::save(ofstream &out)
 	saveValue<uint32_t>(out, type);
 	saveValue<uint64_t>(out, elements);
 	saveValue<uint32_t>(out, maxlength);
-	saveValue<uint32_t>(out, buckets);
+	saveValue<uint32_t>(out, (buckets < WIDEBUCKETS) ? (uint32_t)buckets : WIDEBUCKETS);
 	saveValue<uint32_t>(out, bucketsize);
 
 
 	saveValue<uint64_t>(out, bytesStrings);
 	saveValue<uchar>(out, textStrings, bytesStrings);
 	blStrings->save(out);
+	if (buckets >= WIDEBUCKETS) saveValue<uint64_t>(out, buckets);
 
 	saveValue<uint32_t>(out, bitsrp);
 	rp->save(out);
+
+	// Optional substring index
+	if (substringIndex != NULL) substringIndex->save(out);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 StringDictionary*
-StringDictionaryRPFC::load(ifstream &in)
+StringDictionaryRPFC::load(ifstream &in, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 	if(type != RPFC) return NULL;
 
 	StringDictionaryRPFC *dict = new StringDictionaryRPFC();
+	dict->memoryMapping = mapping;
 
 	dict->type = RPFC;
 	dict->elements = loadValue<uint64_t>(in);
@@ -477,34 +625,41 @@ StringDictionaryRPFC::load(ifstream &in)
 	dict->bucketsize = loadValue<uint32_t>(in);
 
 	dict->bytesStrings = loadValue<uint64_t>(in);
-	dict->textStrings = loadValue<uchar>(in, dict->bytesStrings);
-	dict->blStrings = new LogSequence(in);
+	dict->textStrings = MemoryMapping::loadArray<uchar>(mapping, in, dict->bytesStrings);
+	dict->blStrings = new LogSequence(in, mapping);
+	if (dict->buckets == WIDEBUCKETS) dict->buckets = loadValue<uint64_t>(in);
 
 	dict->bitsrp = loadValue<uint32_t>(in);
-	dict->rp = RePair::loadNoSeq(in);
+	dict->rp = RePair::loadNoSeq(in, mapping);
 	
+	dict->substringIndex = SubstringIndex::load(in, dict, mapping);
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
+
 	return dict;
 }
 
 
 inline uchar*
-StringDictionaryRPFC::getHeader(size_t idbucket, uchar **str, uint *strLen)
+StringDictionaryRPFC::getHeader(size_t idbucket, uchar **str, uint *strLen) const
 {
 	uchar *ptr = textStrings+blStrings->getField(idbucket);
 	*strLen = strlen((char*)ptr);
 
-	*str = new uchar[maxlength];
+	*str = new uchar[maxlength+1];
 	strncpy((char*)*str, (char*)ptr, *strLen+1);
 
 	return ptr+(*strLen)+1;
 }
 
 bool 
-StringDictionaryRPFC::locateBucket(uchar *str, size_t *idbucket)
+StringDictionaryRPFC::locateBucket(uchar *str, size_t *idbucket) const
 {
 	size_t left = 1, right = buckets, center = 0;
 	int cmp = 0;
 
+	// Narrowing the search to the buckets whose headers share the key
+	if (headerIndex != NULL) headerIndex->narrow(str, 0, &left, &right);
+
 	while (left <= right)
 	{
 		center = (left+right)/2;
@@ -518,16 +673,78 @@ StringDictionaryRPFC::locateBucket(uchar *str, size_t *idbucket)
 		else { *idbucket = center; return true; }
 	}
 
-	// c is the candidate bucket for the string
-	if (cmp < 0) *idbucket = center;
-	// c-1 is the candidate bucket for the string
-	else *idbucket = center-1;
+	// The rightmost bucket whose header is lower than the string is
+	// the candidate one
+	*idbucket = right;
 
 	return false;
 }
 
 void
-StringDictionaryRPFC::locateBoundaryBuckets(uchar *str, uint strLen, size_t *left, size_t *right)
+StringDictionaryRPFC::locateBucketBatch(const uchar **strs, size_t n, size_t *idbuckets, bool *headers) const
+{
+	size_t left[BATCHSIZE], right[BATCHSIZE], center[BATCHSIZE];
+	uchar *header[BATCHSIZE];
+	size_t active = n;
+
+	for (size_t i=0; i<n; i++)
+	{
+		left[i] = 1; right[i] = buckets; headers[i] = false;
+		if (headerIndex != NULL) headerIndex->narrow(strs[i], 0, &left[i], &right[i]);
+
+		if (left[i] > right[i])
+		{
+			// The header key already determines the candidate bucket
+			idbuckets[i] = right[i];
+			active--;
+		}
+		else
+		{
+			center[i] = (left[i]+right[i])/2;
+			blStrings->prefetch(center[i]);
+		}
+	}
+
+	while (active > 0)
+	{
+		// Reading the header positions and prefetching the headers
+		for (size_t i=0; i<n; i++)
+		{
+			if (left[i] > right[i]) continue;
+
+			header[i] = textStrings+blStrings->getField(center[i]);
+			PREFETCH(header[i]);
+		}
+
+		// Comparing the headers while the remaining ones are loaded
+		for (size_t i=0; i<n; i++)
+		{
+			if (left[i] > right[i]) continue;
+
+			int cmp = strcmp((char*)header[i], (char*)strs[i]);
+
+			if (cmp > 0) right[i] = center[i]-1;
+			else if (cmp < 0) left[i] = center[i]+1;
+			else { headers[i] = true; left[i] = center[i]+1; right[i] = center[i]; }
+
+			if (left[i] > right[i])
+			{
+				// The rightmost bucket whose header is not greater
+				// than the string is the candidate one
+				idbuckets[i] = right[i];
+				active--;
+			}
+			else
+			{
+				center[i] = (left[i]+right[i])/2;
+				blStrings->prefetch(center[i]);
+			}
+		}
+	}
+}
+
+void
+StringDictionaryRPFC::locateBoundaryBuckets(uchar *str, uint strLen, size_t *left, size_t *right) const
 {
 	size_t center = 0;
 	int cmp = 0;
@@ -553,7 +770,7 @@ StringDictionaryRPFC::locateBoundaryBuckets(uchar *str, uint strLen, size_t *lef
 	if (center > 1)
 	{
 		// Looking for the left boundary
-		uint ll = *left, lr = center-1, lc;
+		size_t ll = *left, lr = center-1, lc;
 
 		while (ll <= lr)
 		{
@@ -571,7 +788,7 @@ StringDictionaryRPFC::locateBoundaryBuckets(uchar *str, uint strLen, size_t *lef
 	if (center < buckets)
 	{
 		// Looking for the right boundary
-		uint rl = center, rr = *right+1, rc;
+		size_t rl = center, rr = *right+1, rc;
 
 		while (rl < (rr-1))
 		{
@@ -587,7 +804,7 @@ StringDictionaryRPFC::locateBoundaryBuckets(uchar *str, uint strLen, size_t *lef
 }
 
 uint 
-StringDictionaryRPFC::searchPrefix(uchar **ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen, uint *offset)
+StringDictionaryRPFC::searchPrefix(uchar **ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen, uint *offset) const
 {
 	uint id=NORESULT;
 
@@ -597,7 +814,7 @@ StringDictionaryRPFC::searchPrefix(uchar **ptr, uint scanneable, uchar *decoded,
 	uint i=1;
 	while (true)
 	{
-		cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, *decLen-sharedCurr-1, &sharedCurr);
+		cmp=longestCommonPrefix(decoded+sharedCurr, str+sharedCurr, min(*decLen-1, strLen)-sharedCurr, &sharedCurr);
 
 		if (sharedCurr==strLen) { id = i; break; }
 		else
@@ -616,7 +833,7 @@ StringDictionaryRPFC::searchPrefix(uchar **ptr, uint scanneable, uchar *decoded,
 
 
 uint
-StringDictionaryRPFC::searchDistinctPrefix(uchar *ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen, uint *offset)
+StringDictionaryRPFC::searchDistinctPrefix(uchar *ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen, uint *offset) const
 {
 	uint id = 1;
 
@@ -627,7 +844,7 @@ StringDictionaryRPFC::searchDistinctPrefix(uchar *ptr, uint scanneable, uchar *d
 }
 
 inline uint
-StringDictionaryRPFC::encodeSymbol(uint symbol, uchar *text, uint *offset)
+StringDictionaryRPFC::encodeSymbol(uint symbol, uchar *text, uint *offset) const
 {
 	uint processed = 0;
 	uint bytes = 0;
@@ -655,7 +872,7 @@ StringDictionaryRPFC::encodeSymbol(uint symbol, uchar *text, uint *offset)
 }
 
 inline uint
-StringDictionaryRPFC::decodeSymbol(uint *symbol, uchar *ptr, uint *offset)
+StringDictionaryRPFC::decodeSymbol(uint *symbol, uchar *ptr, uint *offset) const
 {
 	*symbol = 0;
 
@@ -680,7 +897,7 @@ StringDictionaryRPFC::decodeSymbol(uint *symbol, uchar *ptr, uint *offset)
 }
 
 inline uint
-StringDictionaryRPFC::decodeString(uchar *str, uint *strLen, uchar **ptr, uint *offset)
+StringDictionaryRPFC::decodeString(uchar *str, uint *strLen, uchar **ptr, uint *offset) const
 {
 	uchar *vb = new uchar[maxlength];
 	uint read = 0;
@@ -732,7 +949,7 @@ StringDictionaryRPFC::decodeString(uchar *str, uint *strLen, uchar **ptr, uint *
 
 StringDictionaryRPFC::~StringDictionaryRPFC()
 {
-	delete [] textStrings; delete blStrings;
+	MemoryMapping::release(memoryMapping, textStrings); delete blStrings;
 	delete rp;
 }
 
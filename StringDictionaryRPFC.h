@@ -90,7 +90,18 @@ class StringDictionaryRPFC : public StringDictionary
 		    @param strLen: the string length.
 		    @returns the ID (or NORESULT if it is not in the bucket).
 		*/
-		uint locate(uchar *str, uint str_length);
+		size_t locate(uchar *str, uint str_length) const;
+
+		/** Retrieves the IDs corresponding to a batch of strings. The
+		    binary searches over the bucket headers advance in lockstep
+		    and each step prefetches the header compared in the next one.
+		    @param strs: the strings to be searched.
+		    @param lens: the string lengths.
+		    @param n: the number of strings.
+		    @param out: the resulting IDs (NORESULT for those strings
+		      which are not in the dictionary).
+		*/
+		void locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const;
 		
 		/** Obtains the string associated with the given ID.
 		    @param id: the ID to be extracted.
@@ -98,7 +109,29 @@ class StringDictionaryRPFC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		 */
-		uchar* extract(size_t id, uint *strLen);
+		uchar* extract(size_t id, uint *strLen) const;
+
+		/** Obtains the string associated with the given ID into a
+		    buffer owned by the caller. The string is directly decoded
+		    on the buffer if its capacity is greater than maxLength().
+		    @param id: the ID to be extracted.
+		    @param buf: the buffer.
+		    @param cap: the buffer capacity.
+		    @returns the string length (0 if the ID is not in the
+		      dictionary).
+		*/
+		uint extractInto(size_t id, uchar *buf, uint cap) const;
+
+		/** Obtains the strings associated with a batch of IDs. The
+		    IDs are sorted, so each bucket is decoded (at most) once.
+		    @param ids: the IDs to be extracted.
+		    @param n: the number of IDs.
+		    @param arena: the arena in which the strings are written.
+		    @param offsets: the offset (within the arena) of each string.
+		    @param lengths: the length of each string (0 if the ID is
+		      not in the dictionary).
+		*/
+		void extractBatch(const size_t *ids, size_t n, ByteArena &arena, size_t *offsets, uint *lengths) const;
 		
 		/** Locates all IDs of those elements prefixed by the given 
 		    string.
@@ -106,7 +139,7 @@ class StringDictionaryRPFC : public StringDictionary
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locatePrefix(uchar *str, uint strLen);
+		IteratorDictID* locatePrefix(uchar *str, uint strLen) const;
 		
 		/** Locates all IDs of those elements containing the given 
 		    substring.
@@ -114,27 +147,27 @@ class StringDictionaryRPFC : public StringDictionary
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the IDs.
 		*/
-		IteratorDictID* locateSubstr(uchar *str, uint strLen);
+		IteratorDictID* locateSubstr(uchar *str, uint strLen) const;
 		
 		/** Retrieves the ID with rank k according to its alphabetical order. 
 		    @param rank: the alphabetical ranking.
 		    @returns the ID.
 		*/
-		uint locateRank(uint rank);
+		size_t locateRank(size_t rank) const;
 		
 		/** Extracts all elements prefixed by the given string.
 		    @param str: the prefix to be searched.
 		    @param strLen: the prefix length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractPrefix(uchar *str, uint strLen);
+		IteratorDictString* extractPrefix(uchar *str, uint strLen) const;
 		
 		/** Extracts all elements containing by the given substring.
 		    @param str: the substring to be searched.
 		    @param strLen: the substring length.
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractSubstr(uchar *str, uint strLen);
+		IteratorDictString* extractSubstr(uchar *str, uint strLen) const;
 		
 		/** Obtains the string  with rank k according to its 
 		    alphabetical order.
@@ -143,18 +176,44 @@ class StringDictionaryRPFC : public StringDictionary
 		    @returns the requested string (or NULL if it is not in the
 		      dictionary).
 		*/
-		uchar* extractRank(uint rank, uint *strLen);
+		uchar* extractRank(size_t rank, uint *strLen) const;
 		
 		/** Extracts all strings in the dictionary sorted in 
 		    alphabetical order. 
 		    @returns an iterator for direct scanning of all the strings.
 		*/
-		IteratorDictString* extractTable();
+		IteratorDictString* extractTable() const;
+
+		/** Extracts the strings whose IDs are in the given range (in
+		    ID order).
+		    @param left: the first ID.
+		    @param right: the last ID.
+		    @returns an iterator for direct scanning of the strings.
+		*/
+		IteratorDictString* extractRange(size_t left, size_t right) const;
+
+		/** Builds the q-gram index which enables substring operations.
+		*/
+		void indexSubstrings();
+
+		/** Builds the approximate membership filter, so locate 
+		    discards most of the strings not in the dictionary.
+		*/
+		void indexMembership();
 		
+		/** Unpacks the RePair grammar (expansions and comparisons
+		    avoid bit unpacking).
+		*/
+		void indexGrammar();
+
 		/** Computes the size of the structure in bytes. 
 		    @returns the dictionary size in bytes.
 		*/
-		size_t getSize();
+		size_t getSize() const;
+
+		/** Builds the cache-resident index over the bucket headers.
+		*/
+		void indexHeaders();
 		
 		/** Stores the dictionary into an ofstream.
 		    @param out: the oftstream.
@@ -163,15 +222,17 @@ class StringDictionaryRPFC : public StringDictionary
 		
 		/** Loads a dictionary from an ifstream.
 		    @param in: the ifstream.
+		    @param mapping: the memory mapping of the file (if any). The
+		      dictionary takes its ownership.
 		    @returns the loaded dictionary.
 		*/
-		static StringDictionary *load(ifstream &in);
+		static StringDictionary *load(ifstream &in, MemoryMapping *mapping=NULL);
 
 		/** Generic destructor. */
 		~StringDictionaryRPFC();
 
 	protected:
-		uint32_t buckets;	//! Number of total buckets in the dictionary
+		uint64_t buckets;	//! Number of total buckets in the dictionary
 		uint32_t bucketsize;	//! Number of strings per bucket
 
 		uint64_t bytesStrings;	//! Length of the strings representation
@@ -187,7 +248,7 @@ class StringDictionaryRPFC : public StringDictionary
 		    @param strLen: pointer to the header length.
 		    @returns pointer to the next unprocessed char.
 		*/
-		inline uchar *getHeader(size_t idbucket, uchar **str, uint *strLen);
+		inline uchar *getHeader(size_t idbucket, uchar **str, uint *strLen) const;
 
 		/** Locates the candidate bucket in which the given string can
 		    be represented.
@@ -196,7 +257,26 @@ class StringDictionaryRPFC : public StringDictionary
 		    @returns a boolean value telling if the string is the 
 		      header of the bucket.
 		*/
-		inline bool locateBucket(uchar *str, size_t *idbucket);
+		inline bool locateBucket(uchar *str, size_t *idbucket) const;
+
+		/** Locates the candidate buckets for a group of (at most
+		    BATCHSIZE) strings.
+		    @param strs: the strings to be located.
+		    @param n: the number of strings.
+		    @param idbuckets: the candidate buckets.
+		    @param headers: tells, for each string, if it is the header
+		      of its bucket.
+		*/
+		inline void locateBucketBatch(const uchar **strs, size_t n, size_t *idbuckets, bool *headers) const;
+
+		/** Scans the candidate bucket for the given string (which is
+		    not its header).
+		    @param idbucket: the candidate bucket.
+		    @param str: the string to be located.
+		    @param strLen: the string length.
+		    @returns the ID (or NORESULT if it is not in the bucket).
+		*/
+		inline size_t locateInBucket(size_t idbucket, uchar *str, uint strLen) const;
 
 		/** Locates the buckets which delimits the representation of
 		    all possible elments prefixed by the given string.
@@ -205,7 +285,7 @@ class StringDictionaryRPFC : public StringDictionary
 		    @param left: pointer to the left boundary bucket.
 		    @param right: pointer to the right boundary bucket.
 		*/
-		inline void locateBoundaryBuckets(uchar *str, uint strLen, size_t *left, size_t *right);
+		inline void locateBoundaryBuckets(uchar *str, uint strLen, size_t *left, size_t *right) const;
 
 		/** Searches the first string prefixed for the given one.
 		    @param ptr: pointer to the next unprocessed string.
@@ -217,7 +297,7 @@ class StringDictionaryRPFC : public StringDictionary
 		    @param offset: the number of bits to be jumped.
 		    @returns the internal ID (of 0 if it is not in the bucket).
 		*/
-		inline uint searchPrefix(uchar **ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen, uint *offset);
+		inline uint searchPrefix(uchar **ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen, uint *offset) const;
 
 		/** Searches the first string non-prefixed for the given one.
 		    @param ptr: pointer to the next unprocessed string.
@@ -229,7 +309,7 @@ class StringDictionaryRPFC : public StringDictionary
 		    @param offset: the number of bits to be jumped.
 		    @returns the internal ID (of 0 if it is not in the bucket).
 		*/
-		inline uint searchDistinctPrefix(uchar *ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen, uint *offset);
+		inline uint searchDistinctPrefix(uchar *ptr, uint scanneable, uchar *decoded, uint *decLen, uchar *str, uint strLen, uint *offset) const;
 
 		/** Encodes the Re-Pair symbol in the text.
 		    @param symbol: the symbol to be encoded.
@@ -237,7 +317,7 @@ class StringDictionaryRPFC : public StringDictionary
 		    @param offset: the number of bits to be jumped.
 		    @returns the number of advanced bytes in this operation.
 		*/
-		inline uint encodeSymbol(uint symbol, uchar *text, uint *offset);
+		inline uint encodeSymbol(uint symbol, uchar *text, uint *offset) const;
 
 		/** Decodes the next symbol.
 		 	@param symbol: the symbol to be decoded.
@@ -245,7 +325,7 @@ class StringDictionaryRPFC : public StringDictionary
 		    @param offset: the number of bits to be jumped in the byte.
 		    @returns the number of advanced bytes in this operation.
 		*/
-		inline uint decodeSymbol(uint *symbol, uchar *ptr, uint *offset);
+		inline uint decodeSymbol(uint *symbol, uchar *ptr, uint *offset) const;
 
 		/** Decodes the next string.
 			@param str: the string to be decoded.
@@ -254,7 +334,7 @@ class StringDictionaryRPFC : public StringDictionary
 		    @param offset: the number of bits to be jumped in the byte.
 		    @returns the number of shared chars with the previous string.
 		 */
-		inline uint decodeString(uchar *str, uint *strLen, uchar **ptr, uint *offset);
+		inline uint decodeString(uchar *str, uint *strLen, uchar **ptr, uint *offset) const;
 
 }; 
 
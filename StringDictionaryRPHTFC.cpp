@@ -43,7 +43,7 @@ StringDictionaryRPHTFC::StringDictionaryRPHTFC()
 	this->bytesStrings = 0;
 }
 
-StringDictionaryRPHTFC::StringDictionaryRPHTFC(IteratorDictString *it, uint bucketsize)
+StringDictionaryRPHTFC::StringDictionaryRPHTFC(IteratorDictString *it, uint bucketsize, uint tablebits)
 {
 	this->type = RPHTFC;
 
@@ -74,7 +74,7 @@ StringDictionaryRPHTFC::StringDictionaryRPHTFC(IteratorDictString *it, uint buck
 	for (uint i=0; i<256; i++) freqs[i]=1;
 
 	size_t pbeg = 0, pend = 0;
-	uint bucket = 1; uint buckets = dict->buckets;
+	size_t bucket = 1, buckets = dict->buckets;
 	size_t ptrpdict = 0;
 
 	uint ends = 0;
@@ -98,11 +98,11 @@ StringDictionaryRPHTFC::StringDictionaryRPHTFC(IteratorDictString *it, uint buck
 		freqs[0]++; pbeg++;
 		bucket++;
 
-		if ((ptrpdict+(size_t)(bucketsize*maxlength)) > reservedInts)
+		while ((ptrpdict+(size_t)(bucketsize*maxlength)) > reservedInts)
 			reservedInts = Reallocate(&rpdict, reservedInts);
 
 		// Stores the last position with 0 to avoid confusions with 0 values encoding VBytes.
-		uint zero = pbeg-1;
+		size_t zero = pbeg-1;
 
 		// Extracting the internal strings for Re-Pair compression
 		for (; pbeg < pend; pbeg++)
@@ -127,10 +127,12 @@ StringDictionaryRPHTFC::StringDictionaryRPHTFC(IteratorDictString *it, uint buck
 	HuTucker *ht = new HuTucker(freqs);
 
 	// Initializing the HuTucker builder
-	DecodingTableBuilder *builderHT = new DecodingTableBuilder();
+	DecodingTableBuilder *builderHT = new DecodingTableBuilder(255, tablebits);
 	builderHT->initializeFromHuTucker(ht);
 	codewordsHT = builderHT->getCodewords();
 	delete [] freqs; delete ht;
+
+	uint k = builderHT->getK();
 	delete dict;
 
 	// Obtaining the Re-Pair encoding
@@ -141,9 +143,9 @@ StringDictionaryRPHTFC::StringDictionaryRPHTFC(IteratorDictString *it, uint buck
 	vector<size_t> beginnings(buckets+1);	// Bucket beginnings
 
 	size_t ibytes = 0;
-	uint io = 0, strings = 0;
+	size_t io = 0, strings = 0;
 	beginnings[0] = 0;
-	uint zero = 0;
+	size_t zero = 0;
 
 	while (io<ptrpdict)
 	{
@@ -169,7 +171,9 @@ StringDictionaryRPHTFC::StringDictionaryRPHTFC(IteratorDictString *it, uint buck
 		}
 	}
 
-	beginnings[1+strings/(bucketsize-1)] = ibytes;
+	// The last bucket always ends with the last internal string (it is
+	// empty if the bucket only contains its header)
+	beginnings[buckets] = ibytes;
 	delete [] rpdict;
 
 	// 3) Compressing the dictionary and building the decoding table
@@ -227,13 +231,13 @@ StringDictionaryRPHTFC::StringDictionaryRPHTFC(IteratorDictString *it, uint buck
 
 			// Updating the ptr value to the beginning of the corresponding internal string
 			ptrB = beginnings[bucket-1];
-			ptrE = beginnings[bucket]-1;
+			ptrE = beginnings[bucket];
 
 			// Adding an ending decodeable string  (if required)
 			if (textSubstr.size() > 0)
 			{
 				// #######################
-				// It is necessary to read up to TABLEBITSO bits for indexing the
+				// It is necessary to read up to k bits for indexing the
 				// substring in the DecodingTable
 
 				if (offset > 0)
@@ -243,45 +247,29 @@ StringDictionaryRPHTFC::StringDictionaryRPHTFC(IteratorDictString *it, uint buck
 					ptrSubstr += (8-offset); offset = 0;
 				}
 
-				if (ptrSubstr > TABLEBITSO)
+				if (ptrSubstr > k)
 				{
-					codeSubstr = codeSubstr >> (ptrSubstr - TABLEBITSO);
-					ptrSubstr = TABLEBITSO;
+					codeSubstr = codeSubstr >> (ptrSubstr - k);
+					ptrSubstr = k;
 				}
 				else
 				{
-					if ((bucket == buckets) && (elements % bucketsize == 0))
-					{
-						// The last element is directly padded
-						codeSubstr = (codeSubstr << (TABLEBITSO-ptrSubstr));
-						ptrSubstr = TABLEBITSO;
-					}
-					else
-					{
-						// The first symbol encoding the internal strings is enough for padding because it uses, at least, 16 bits
-						uint remaining = TABLEBITSO-ptrSubstr;
-						uint codeword =  intStrings[ptrB];
-
-						if (remaining < bitsrp)
-						{
-							codeSubstr = (codeSubstr << remaining) | (codeword >> (bitsrp-remaining));
-						}
-						else
-						{
-							codeSubstr = (codeSubstr << bitsrp) | codeword;
-							codeSubstr = codeSubstr << (remaining-bitsrp);
-						}
-
-						ptrSubstr = TABLEBITSO;
-					}
+					// The chunk is completed with the bits following
+					// the header (as they are read in decoding)
+					uint remaining = k-ptrSubstr;
+					codeSubstr = (codeSubstr << remaining) | nextBits(bucket, remaining, headers, intStrings, beginnings);
+					ptrSubstr = k;
 				}
+
+				builderHT->insertEndingSubstr(&codeSubstr, &ptrSubstr, &textSubstr, &lenSubstr);
+				codeSubstr = 0;
 			}
 
 			// Processing the internal strings
 			offset = 0;
 			textStrings[bytesStrings] = 0;
 
-			for (; ptrB <= ptrE; ptrB++)
+			for (; ptrB < ptrE; ptrB++)
 				bytesStrings += encodeSymbol(intStrings[ptrB], &(textStrings[bytesStrings]), &offset);
 
 			if (offset > 0) bytesStrings++;
@@ -291,7 +279,7 @@ StringDictionaryRPHTFC::StringDictionaryRPHTFC(IteratorDictString *it, uint buck
 
 		// bytesStrings++;
 		xblStrings.push_back(bytesStrings+1);
-		blStrings = new LogSequence(&xblStrings, bits(bytesStrings+1));
+		blStrings = new LogSequence(&xblStrings, bits(bytesStrings+1), true);
 
 		maxcomplength += 4; // The value is increased because advanced readings in decoding...
 	}
@@ -300,10 +288,11 @@ StringDictionaryRPHTFC::StringDictionaryRPHTFC(IteratorDictString *it, uint buck
 }
 
 
-uint 
-StringDictionaryRPHTFC::locate(uchar *str, uint strLen)
+size_t 
+StringDictionaryRPHTFC::locate(uchar *str, uint strLen) const
 {
-	uint id = NORESULT;
+	// Strings discarded by the membership filter are not in the dictionary
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
 
 	// Encoding the string
 	uint encLen, offset;
@@ -315,75 +304,112 @@ StringDictionaryRPHTFC::locate(uchar *str, uint strLen)
 	delete [] encoded;
 
 	// The string is the header of the bucket
-	if (cmp) id = ((idbucket-1)*bucketsize)+1;
-	else
+	if (cmp) return ((idbucket-1)*bucketsize)+1;
+	// The bucket is sequentially scanned to find the string
+	else return locateInBucket(idbucket, str, strLen);
+}
+
+void
+StringDictionaryRPHTFC::locateBatch(const uchar **strs, const uint *lens, size_t n, size_t *out) const
+{
+	uchar *encoded[BATCHSIZE];
+	uint encLen[BATCHSIZE];
+	size_t slot[BATCHSIZE], idbuckets[BATCHSIZE];
+	bool headers[BATCHSIZE];
+	uint offset;
+
+	for (size_t i=0; i<n; i+=BATCHSIZE)
 	{
-		// The string is previous to any other one in the dictionary
-		if (idbucket != NORESULT)
+		size_t group = min(BATCHSIZE, n-i), searched = 0;
+
+		// Encoding the strings (those discarded by the membership
+		// filter are not searched)
+		for (size_t j=0; j<group; j++)
 		{
-			// The bucket is sequentially scanned to find the string
-			ChunkScan c = decodeHeader(idbucket);
+			if ((membershipFilter != NULL) && !membershipFilter->contains(strs[i+j], lens[i+j]))
+			{
+				out[i+j] = NORESULT;
+				continue;
+			}
 
-			uint scanneable = bucketsize;
-			if ((idbucket == buckets) && ((elements%bucketsize) != 0)) scanneable = (elements%bucketsize);
+			encoded[searched] = coderHT->encodeString((uchar*)strs[i+j], lens[i+j]+1, &encLen[searched], &offset);
+			slot[searched++] = i+j;
+		}
 
-			if (scanneable > 1)
-			{
-				uint sharedCurr=0, sharedPrev=0;
-				uint offset=0;
-				int cmp=0;
+		locateBucketBatch(encoded, encLen, searched, idbuckets, headers);
+
+		for (size_t j=0; j<searched; j++)
+		{
+			size_t s = slot[j];
 
-				// Processing the first internal string
-				sharedPrev = decodeString(c.str, &c.strLen, &c.b_ptr, &offset);
-				cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
+			if (headers[j]) out[s] = ((idbuckets[j]-1)*bucketsize)+1;
+			else out[s] = locateInBucket(idbuckets[j], (uchar*)strs[s], lens[s]);
 
-				if (cmp != 0)
+			delete [] encoded[j];
+		}
+	}
+}
+
+size_t
+StringDictionaryRPHTFC::locateInBucket(size_t idbucket, uchar *str, uint strLen) const
+{
+	size_t id = NORESULT;
+
+	// The string is previous to any other one in the dictionary
+	if (idbucket != NORESULT)
+	{
+		// The bucket is sequentially scanned to find the string
+		ChunkScan c = decodeHeader(idbucket);
+
+		uint scanneable = bucketsize;
+		if ((idbucket == buckets) && ((elements%bucketsize) != 0)) scanneable = (elements%bucketsize);
+
+		if (scanneable > 1)
+		{
+			uint sharedCurr=0, sharedPrev=0;
+			uint offset=0;
+			int cmp=0;
+
+			// Processing the first internal string
+			sharedPrev = decodeString(c.str, &c.strLen, &c.b_ptr, &offset);
+			cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
+
+			if (cmp != 0)
+			{
+				for (uint i=2; i<scanneable; i++)
 				{
-					for (uint i=2; i<scanneable; i++)
-					{
-						sharedPrev = decodeString(c.str, &c.strLen, &c.b_ptr, &offset);
+					sharedPrev = decodeString(c.str, &c.strLen, &c.b_ptr, &offset);
 
-						if  (sharedPrev < sharedCurr) break;
+					if  (sharedPrev < sharedCurr) break;
 
-						cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
+					cmp=longestCommonPrefix(c.str+sharedCurr, str+sharedCurr, c.strLen-sharedCurr, &sharedCurr);
 
-						if (cmp==0)
-						{
-							id = ((idbucket-1)*bucketsize)+i+1;
-							break;
-						}
-						else if (cmp > 0) break;
+					if (cmp==0)
+					{
+						id = ((idbucket-1)*bucketsize)+i+1;
+						break;
 					}
+					else if (cmp > 0) break;
 				}
-				else id = ((idbucket-1)*bucketsize)+2;
 			}
-
-			delete [] c.str;
+			else id = ((idbucket-1)*bucketsize)+2;
 		}
+
+		delete [] c.str;
 	}
 
 	return id;
 }
 
 uchar *
-StringDictionaryRPHTFC::extract(size_t id, uint *strLen)
+StringDictionaryRPHTFC::extract(size_t id, uint *strLen) const
 {
 	if ((id > 0) && (id <= elements))
 	{
-		uint idbucket = 1+((id-1)/bucketsize);
-		uint pos = ((id-1)%bucketsize);
-
-		ChunkScan c = decodeHeader(idbucket);
+		uchar *s = new uchar[extractCapacity()];
+		*strLen = extractInto(id, s, extractCapacity());
 
-		if (pos > 0)
-		{
-			uint offset = 0;
-			for (uint i=1; i<=pos; i++)
-				decodeString(c.str, &c.strLen, &c.b_ptr, &offset);
-		}
-
-		*strLen = c.strLen-1;
-		return c.str;
+		return s;
 	}
 	else
 	{
@@ -392,8 +418,91 @@ StringDictionaryRPHTFC::extract(size_t id, uint *strLen)
 	}
 }
 
+uint
+StringDictionaryRPHTFC::extractInto(size_t id, uchar *buf, uint cap) const
+{
+	// The chunks are decoded on the buffer if it has enough slack
+	if (cap < extractCapacity()) return StringDictionary::extractInto(id, buf, cap);
+
+	if ((id == 0) || (id > elements))
+	{
+		buf[0] = (uchar)'\0';
+		return 0;
+	}
+
+	size_t idbucket = 1+((id-1)/bucketsize);
+	uint pos = ((id-1)%bucketsize);
+
+	ChunkScan c = decodeHeader(idbucket, buf);
+
+	if (pos > 0)
+	{
+		uint offset = 0;
+		for (uint i=1; i<=pos; i++)
+			decodeString(c.str, &c.strLen, &c.b_ptr, &offset);
+	}
+
+	buf[c.strLen-1] = (uchar)'\0';
+	return c.strLen-1;
+}
+
+uint
+StringDictionaryRPHTFC::extractCapacity() const
+{
+	return 4*maxlength+tableHT->getK();
+}
+
+void
+StringDictionaryRPHTFC::extractBatch(const size_t *ids, size_t n, ByteArena &arena, size_t *offsets, uint *lengths) const
+{
+	vector<pair<size_t, size_t> > requests;
+	sortRequests(ids, n, &requests);
+
+	ChunkScan c;
+	uchar *scratch = new uchar[extractCapacity()];
+	size_t idbucket = 0;
+	uint pos = 0, offset = 0;
+
+	for (size_t i=0; i<n; i++)
+	{
+		size_t id = requests[i].first, req = requests[i].second;
+
+		if ((i > 0) && (id == requests[i-1].first))
+		{
+			// Repeated ID: the previous decoding is referenced
+			offsets[req] = offsets[requests[i-1].second];
+			lengths[req] = lengths[requests[i-1].second];
+			continue;
+		}
+
+		if ((id == 0) || (id > elements))
+		{
+			offsets[req] = arena.append((uchar*)"", 0);
+			lengths[req] = 0;
+			continue;
+		}
+
+		if (1+((id-1)/bucketsize) != idbucket)
+		{
+			// Moving to the header of a new bucket
+			idbucket = 1+((id-1)/bucketsize);
+			c = decodeHeader(idbucket, scratch);
+			pos = 0; offset = 0;
+		}
+
+		// Decoding up to the requested string
+		for (; pos<((id-1)%bucketsize); pos++)
+			decodeString(c.str, &c.strLen, &c.b_ptr, &offset);
+
+		offsets[req] = arena.append(c.str, c.strLen-1);
+		lengths[req] = c.strLen-1;
+	}
+
+	delete [] scratch;
+}
+
 IteratorDictID*
-StringDictionaryRPHTFC::locatePrefix(uchar *str, uint strLen)
+StringDictionaryRPHTFC::locatePrefix(uchar *str, uint strLen) const
 {
 	// Encoding the string
 	uint encLen, offset=0;
@@ -473,62 +582,97 @@ StringDictionaryRPHTFC::locatePrefix(uchar *str, uint strLen)
 }
 
 IteratorDictID*
-StringDictionaryRPHTFC::locateSubstr(uchar *str, uint strLen)
+StringDictionaryRPHTFC::locateSubstr(uchar *str, uint strLen) const
 {
+	if (substringIndex != NULL) return substringIndex->locate(str, strLen);
+
 	cerr << "This dictionary does not provide substring location" << endl;
 	return NULL;
 }
 
-uint 
-StringDictionaryRPHTFC::locateRank(uint rank)
+size_t 
+StringDictionaryRPHTFC::locateRank(size_t rank) const
 {
 	return rank;
 }
 
 IteratorDictString*
-StringDictionaryRPHTFC::extractPrefix(uchar *str, uint strLen)
+StringDictionaryRPHTFC::extractPrefix(uchar *str, uint strLen) const
 {
 	IteratorDictIDContiguous *it = (IteratorDictIDContiguous*)locatePrefix(str, strLen);
 	size_t left = it->getLeftLimit();
+	size_t right = it->getRightLimit();
 
-	if (left != NORESULT)
-	{
-		// Positioning the LEFT Limit
-		uint leftbucket = 1+((left-1)/bucketsize);
-		uint leftpos = ((left-1)%bucketsize);
-
-		// Positioning the RIGHT Limit
-		size_t right = it->getRightLimit();
-		delete it;
+	delete it;
 
-		return new IteratorDictStringRPHTFC(tableHT, codewordsHT, rp, bitsrp, textStrings, blStrings, leftbucket, leftpos, bucketsize, right-left+1, maxlength, maxcomplength);
-	}
+	if (left != NORESULT) return extractRange(left, right);
 	else return NULL;
 }
 
 IteratorDictString*
-StringDictionaryRPHTFC::extractSubstr(uchar *str, uint strLen)
+StringDictionaryRPHTFC::extractRange(size_t left, size_t right) const
 {
+	// Positioning the LEFT Limit
+	size_t leftbucket = 1+((left-1)/bucketsize);
+	uint leftpos = ((left-1)%bucketsize);
+
+	return new IteratorDictStringRPHTFC(tableHT, codewordsHT, rp, bitsrp, textStrings, blStrings, leftbucket, leftpos, bucketsize, right-left+1, maxlength, maxcomplength);
+}
+
+IteratorDictString*
+StringDictionaryRPHTFC::extractSubstr(uchar *str, uint strLen) const
+{
+	if (substringIndex != NULL) return substringIndex->extract(str, strLen);
+
 	cerr << "This dictionary does not provide substring extraction" << endl;
 	return 0; 
 }
 
 uchar *
-StringDictionaryRPHTFC::extractRank(uint rank, uint *strLen)
+StringDictionaryRPHTFC::extractRank(size_t rank, uint *strLen) const
 {
 	return extract(rank, strLen);
 }
 
 IteratorDictString*
-StringDictionaryRPHTFC::extractTable()
+StringDictionaryRPHTFC::extractTable() const
 {
 	return new IteratorDictStringRPHTFC(tableHT, codewordsHT, rp, bitsrp, textStrings, blStrings, 1, 0, bucketsize, elements, maxlength, maxcomplength);
 }
 
+void
+StringDictionaryRPHTFC::indexGrammar()
+{
+	rp->unpack();
+}
+
 size_t 
-StringDictionaryRPHTFC::getSize()
+StringDictionaryRPHTFC::getSize() const
+{
+	size_t size = bytesStrings*sizeof(uchar)+blStrings->getSize()+256*sizeof(Codeword)+tableHT->getSize()+rp->getSize()+sizeof(StringDictionaryRPHTFC);
+	if (headerIndex != NULL) size += headerIndex->getSize();
+	if (substringIndex != NULL) size += substringIndex->getSize();
+	if (membershipFilter != NULL) size += membershipFilter->getSize();
+
+	return size;
+}
+
+void
+StringDictionaryRPHTFC::indexHeaders()
+{
+	if (headerIndex == NULL) headerIndex = new HeaderIndex(textStrings, bytesStrings, blStrings, buckets, false);
+}
+
+void
+StringDictionaryRPHTFC::indexSubstrings()
 {
-	return bytesStrings*sizeof(uchar)+blStrings->getSize()+256*sizeof(Codeword)+tableHT->getSize()+rp->getSize()+sizeof(StringDictionaryRPHTFC);
+	if (substringIndex == NULL) substringIndex = new SubstringIndex(this, bucketsize);
+}
+
+void
+StringDictionaryRPHTFC::indexMembership()
+{
+	if (membershipFilter == NULL) membershipFilter = new MembershipFilter(this);
 }
 
 void 
@@ -538,27 +682,35 @@ StringDictionaryRPHTFC::save(ofstream &out)
 	saveValue<uint64_t>(out, elements);
 	saveValue<uint32_t>(out, maxlength);
 	saveValue<uint32_t>(out, maxcomplength);
-	saveValue<uint32_t>(out, buckets);
+	saveValue<uint32_t>(out, (buckets < WIDEBUCKETS) ? (uint32_t)buckets : WIDEBUCKETS);
 	saveValue<uint32_t>(out, bucketsize);
 
 	saveValue<uint64_t>(out, bytesStrings);
 	saveValue<uchar>(out, textStrings, bytesStrings);
 	blStrings->save(out);
+	if (buckets >= WIDEBUCKETS) saveValue<uint64_t>(out, buckets);
 
 	saveValue<Codeword>(out, codewordsHT, 256);
 	tableHT->save(out);
 
 	saveValue<uint32_t>(out, bitsrp);
 	rp->save(out);
+
+	// Optional substring index
+	if (substringIndex != NULL) substringIndex->save(out);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 StringDictionary*
-StringDictionaryRPHTFC::load(ifstream &in)
+StringDictionaryRPHTFC::load(ifstream &in, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 	if(type != RPHTFC) return NULL;
 
 	StringDictionaryRPHTFC *dict = new StringDictionaryRPHTFC();
+	dict->memoryMapping = mapping;
 
 	dict->type = RPHTFC;
 	dict->elements = loadValue<uint64_t>(in);
@@ -568,21 +720,25 @@ StringDictionaryRPHTFC::load(ifstream &in)
 	dict->bucketsize = loadValue<uint32_t>(in);
 
 	dict->bytesStrings = loadValue<uint64_t>(in);
-	dict->textStrings = loadValue<uchar>(in, dict->bytesStrings);
-	dict->blStrings = new LogSequence(in);
+	dict->textStrings = MemoryMapping::loadArray<uchar>(mapping, in, dict->bytesStrings);
+	dict->blStrings = new LogSequence(in, mapping);
+	if (dict->buckets == WIDEBUCKETS) dict->buckets = loadValue<uint64_t>(in);
 
 	dict->codewordsHT = loadValue<Codeword>(in, 256);
 	dict->tableHT = DecodingTable::load(in);
 	dict->coderHT = new StatCoder(dict->tableHT, dict->codewordsHT);
 
 	dict->bitsrp = loadValue<uint32_t>(in);
-	dict->rp = RePair::loadNoSeq(in);
+	dict->rp = RePair::loadNoSeq(in, mapping);
 	
+	dict->substringIndex = SubstringIndex::load(in, dict, mapping);
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
+
 	return dict;
 }
 
 uchar*
-StringDictionaryRPHTFC::getHeader(size_t idbucket)
+StringDictionaryRPHTFC::getHeader(size_t idbucket) const
 {
 	size_t ptrH = blStrings->getField(idbucket);
 	uchar *header = textStrings+ptrH;
@@ -590,11 +746,30 @@ StringDictionaryRPHTFC::getHeader(size_t idbucket)
 	return header;
 }
 
+int
+StringDictionaryRPHTFC::compareHeader(size_t idbucket, uchar *str, uint strLen, uchar cmask) const
+{
+	if (strLen == 0) return 0;
+
+	// Hu-Tucker codes preserve the order, so the encoded header and the
+	// encoded string are directly compared. They differ before the end
+	// of the shortest one, so no byte beyond the strings is required.
+	uchar *header = getHeader(idbucket);
+	size_t avail = textStrings+bytesStrings-header;
+	if (avail < strLen) return compareBytes(header, str, avail);
+
+	int cmp = compareBytes(header, str, strLen-1);
+	if (cmp != 0) return cmp;
+
+	return (header[strLen-1] & cmask) - str[strLen-1];
+}
+
 ChunkScan
-StringDictionaryRPHTFC::decodeHeader(size_t idbucket)
+StringDictionaryRPHTFC::decodeHeader(size_t idbucket, uchar *buf) const
 {
 	uchar* ptr = textStrings+blStrings->getField(idbucket);
-	ChunkScan chunk = {0, 0, ptr, maxcomplength, new uchar[4*maxlength+tableHT->getK()], 0, 0, 1};
+	uint remain = min((size_t)maxcomplength, (size_t)(textStrings+bytesStrings-ptr));
+	ChunkScan chunk = {0, 0, ptr, remain, (buf != NULL) ? buf : new uchar[extractCapacity()], 0, 0, 1};
 
 	// Variables used for adjusting purposes
 	uint plen = 0;
@@ -625,19 +800,19 @@ StringDictionaryRPHTFC::decodeHeader(size_t idbucket)
 }
 
 bool 
-StringDictionaryRPHTFC::locateBucket(uchar *str, uint strLen, size_t *idbucket)
+StringDictionaryRPHTFC::locateBucket(uchar *str, uint strLen, size_t *idbucket) const
 {
 	size_t left = 1, right = buckets, center = 0;
 	int cmp = 0;
 
-	uchar *header;
+	// Narrowing the search to the buckets whose headers share the key
+	if (headerIndex != NULL) headerIndex->narrow(str, strLen, &left, &right);
 
 	while (left <= right)
 	{
 		center = (left+right)/2;
-		header = getHeader(center);
 
-		cmp = memcmp(header, str, strLen);
+		cmp = compareHeader(center, str, strLen, 0xFF);
 		// The string is in any preceding bucket
 		if (cmp > 0) right = center-1;
 		// The string is in any subsequent bucket
@@ -650,31 +825,84 @@ StringDictionaryRPHTFC::locateBucket(uchar *str, uint strLen, size_t *idbucket)
 		}
 	}
 
-	// c is the candidate bucket for the string
-	if (cmp < 0) *idbucket = center;
-	// c-1 is the candidate bucket for the string
-	else *idbucket = center-1;
+	// The rightmost bucket whose header is lower than the string is
+	// the candidate one
+	*idbucket = right;
 
 	return false;
 }
 
 void
-StringDictionaryRPHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offset, size_t *left, size_t *right)
+StringDictionaryRPHTFC::locateBucketBatch(uchar **strs, const uint *lens, size_t n, size_t *idbuckets, bool *headers) const
+{
+	size_t left[BATCHSIZE], right[BATCHSIZE], center[BATCHSIZE];
+	size_t active = n;
+
+	for (size_t i=0; i<n; i++)
+	{
+		left[i] = 1; right[i] = buckets; headers[i] = false;
+		if (headerIndex != NULL) headerIndex->narrow(strs[i], lens[i], &left[i], &right[i]);
+
+		if (left[i] > right[i])
+		{
+			// The header key already determines the candidate bucket
+			idbuckets[i] = right[i];
+			active--;
+		}
+		else
+		{
+			center[i] = (left[i]+right[i])/2;
+			blStrings->prefetch(center[i]);
+		}
+	}
+
+	while (active > 0)
+	{
+		// Reading the header positions and prefetching the headers
+		for (size_t i=0; i<n; i++)
+			if (left[i] <= right[i]) PREFETCH(getHeader(center[i]));
+
+		// Comparing the headers while the remaining ones are loaded
+		for (size_t i=0; i<n; i++)
+		{
+			if (left[i] > right[i]) continue;
+
+			int cmp = compareHeader(center[i], strs[i], lens[i], 0xFF);
+
+			if (cmp > 0) right[i] = center[i]-1;
+			else if (cmp < 0) left[i] = center[i]+1;
+			else { headers[i] = true; left[i] = center[i]+1; right[i] = center[i]; }
+
+			if (left[i] > right[i])
+			{
+				// The rightmost bucket whose header is not greater
+				// than the string is the candidate one
+				idbuckets[i] = right[i];
+				active--;
+			}
+			else
+			{
+				center[i] = (left[i]+right[i])/2;
+				blStrings->prefetch(center[i]);
+			}
+		}
+	}
+}
+
+void
+StringDictionaryRPHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offset, size_t *left, size_t *right) const
 {
 	size_t center = 0;
 	int cmp = 0;
 
-	uchar *header = new uchar[4*strLen];
-
-	uchar cmask = (uchar)(~(mask(8) >> offset));
+	// Only the used bits of the last byte are compared
+	uchar cmask = (offset != 0) ? (uchar)(~(mask(8) >> offset)) : 0xFF;
 
 	while (*left <= *right)
 	{
 		center = (*left+*right)/2;
 
-		memcpy(header, getHeader(center), strLen);
-		if (offset != 0) header[strLen-1] = header[strLen-1] & cmask;
-		cmp = memcmp(header, str, strLen);
+		cmp = compareHeader(center, str, strLen, cmask);
 
 		if (cmp > 0) *right = center-1;
 		else if (cmp < 0) *left = center+1;
@@ -687,22 +915,19 @@ StringDictionaryRPHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offs
 		if (cmp < 0) { *left = center; *right = center;}
 		else { *left = center-1; *right = center-1; }
 
-		delete [] header;
 		return;
 	}
 
 	if (center > 1)
 	{
 		// Looking for the left boundary
-		uint ll = *left, lr = center-1, lc;
+		size_t ll = *left, lr = center-1, lc;
 
 		while (ll <= lr)
 		{
 			lc = (ll+lr)/2;
 
-			memcpy(header, getHeader(lc), strLen);
-			if (offset != 0) header[strLen-1] = header[strLen-1] & cmask;
-		    	cmp = memcmp(header, str, strLen);
+			cmp = compareHeader(lc, str, strLen, cmask);
 
 			if (cmp == 0) lr = lc-1;
 			else ll = lc+1;
@@ -715,15 +940,13 @@ StringDictionaryRPHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offs
 	if (center < buckets)
 	{
 		// Looking for the right boundary
-		uint rl = center, rr = *right+1, rc;
+		size_t rl = center, rr = *right+1, rc;
 
 		while (rl < (rr-1))
 		{
 			rc = (rl+rr)/2;
 
-			memcpy(header, getHeader(rc), strLen);
-			if (offset != 0) header[strLen-1] = header[strLen-1] & cmask;
-		    	cmp = memcmp(header, str, strLen);
+			cmp = compareHeader(rc, str, strLen, cmask);
 
 			if (cmp == 0) rl = rc;
 		    	else rr = rc;
@@ -731,12 +954,10 @@ StringDictionaryRPHTFC::locateBoundaryBuckets(uchar *str, uint strLen, uint offs
 
 		*right = rl;
 	}
-
-	delete [] header;
 }
 
 uint 
-StringDictionaryRPHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen, uint *offset)
+StringDictionaryRPHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen, uint *offset) const
 {
 	uint id = NORESULT;
 
@@ -746,7 +967,7 @@ StringDictionaryRPHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str,
 	uint i=1;
 	while (true)
 	{
-		cmp=longestCommonPrefix(c->str+sharedCurr, str+sharedCurr, c->strLen-sharedCurr-1, &sharedCurr);
+		cmp=longestCommonPrefix(c->str+sharedCurr, str+sharedCurr, min(c->strLen-1, strLen)-sharedCurr, &sharedCurr);
 
 		if (sharedCurr==strLen) { id = i; break; }
 		else
@@ -765,7 +986,7 @@ StringDictionaryRPHTFC::searchPrefix(ChunkScan* c, uint scanneable, uchar *str,
 
 
 uint
-StringDictionaryRPHTFC::searchDistinctPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen, uint *offset)
+StringDictionaryRPHTFC::searchDistinctPrefix(ChunkScan* c, uint scanneable, uchar *str, uint strLen, uint *offset) const
 {
 	uint id = 1;
 
@@ -776,7 +997,7 @@ StringDictionaryRPHTFC::searchDistinctPrefix(ChunkScan* c, uint scanneable, ucha
 }
 
 uint
-StringDictionaryRPHTFC::encodeSymbol(uint symbol, uchar *text, uint *offset)
+StringDictionaryRPHTFC::encodeSymbol(uint symbol, uchar *text, uint *offset) const
 {
 	uint processed = 0;
 	uint bytes = 0;
@@ -803,8 +1024,54 @@ StringDictionaryRPHTFC::encodeSymbol(uint symbol, uchar *text, uint *offset)
 	return bytes;
 }
 
+/** Appends (up to) the first 'wanted' bits of a codeword to a chunk. */
+static inline void
+appendBits(uint *chunk, uint *taken, uint wanted, uint64_t codeword, uint bits)
+{
+	uint append = min(bits, wanted-(*taken));
+
+	if (append > 0)
+	{
+		*chunk = (*chunk << append) | (uint)((codeword >> (bits-append)) & ((1ULL << append)-1));
+		*taken += append;
+	}
+}
+
+uint
+StringDictionaryRPHTFC::nextBits(size_t bucket, uint bits, vector< vector<uchar> > &headers, vector<size_t> &intStrings, vector<size_t> &beginnings) const
+{
+	uint chunk = 0, taken = 0;
+
+	for (size_t b=bucket; (b<=buckets) && (taken<bits); b++)
+	{
+		if (b > bucket)
+		{
+			// The next header (padded to a byte)
+			uint used = 0;
+
+			for (size_t i=0; i<headers[b].size(); i++)
+			{
+				Codeword cw = codewordsHT[headers[b][i]];
+				appendBits(&chunk, &taken, bits, cw.codeword, cw.bits);
+				used += cw.bits;
+			}
+
+			appendBits(&chunk, &taken, bits, 0, (8-(used%8))%8);
+		}
+
+		// The internal strings of the bucket (padded to a byte)
+		for (size_t i=beginnings[b-1]; i<beginnings[b]; i++)
+			appendBits(&chunk, &taken, bits, intStrings[i], bitsrp);
+
+		appendBits(&chunk, &taken, bits, 0, (8-(((beginnings[b]-beginnings[b-1])*bitsrp)%8))%8);
+	}
+
+	// The decoding pads the end of the strings with 0 bits
+	return chunk << (bits-taken);
+}
+
 inline uint
-StringDictionaryRPHTFC::decodeSymbol(uint *symbol, uchar *ptr, uint *offset)
+StringDictionaryRPHTFC::decodeSymbol(uint *symbol, uchar *ptr, uint *offset) const
 {
 	*symbol = 0;
 
@@ -829,7 +1096,7 @@ StringDictionaryRPHTFC::decodeSymbol(uint *symbol, uchar *ptr, uint *offset)
 }
 
 inline uint
-StringDictionaryRPHTFC::decodeString(uchar *str, uint *strLen, uchar **ptr, uint *offset)
+StringDictionaryRPHTFC::decodeString(uchar *str, uint *strLen, uchar **ptr, uint *offset) const
 {
 	uchar *vb = new uchar[maxlength];
 	uint read = 0;
@@ -879,7 +1146,7 @@ StringDictionaryRPHTFC::decodeString(uchar *str, uint *strLen, uchar **ptr, uint
 
 StringDictionaryRPHTFC::~StringDictionaryRPHTFC()
 {
-	delete [] textStrings; delete blStrings;
+	MemoryMapping::release(memoryMapping, textStrings); delete blStrings;
 	delete coderHT;
 	delete [] codewordsHT; delete tableHT;
 	delete rp;
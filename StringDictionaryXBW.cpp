@@ -39,13 +39,15 @@ StringDictionaryXBW::StringDictionaryXBW()
 	this->alpha = NULL;
 	this->last = NULL;
 	this->A = NULL;
+	this->sequence = WTREE;
 }
 
-StringDictionaryXBW::StringDictionaryXBW(IteratorDictString *it)
+StringDictionaryXBW::StringDictionaryXBW(IteratorDictString *it, uint sequence)
 {
 	this->type = DXBW;
 	this->elements = 0;
 	this->maxlength = 0;
+	this->sequence = sequence;
 
 	this->xbw = NULL;
 
@@ -79,6 +81,9 @@ StringDictionaryXBW::StringDictionaryXBW(IteratorDictString *it)
 		elements++;
 	}
 
+	// Trie nodes are addressed through 32-bit identifiers, as the libcds
+	// sequences representing the XBW are
+	if (nodes.size() >= UINT_MAX) throw "The XBW does not support tries of 2^32 nodes or more.";
 	len = nodes.size();
 
 	for(uint i=0;i<len;i++) assert(nodes[i]!=NULL);
@@ -122,9 +127,11 @@ StringDictionaryXBW::StringDictionaryXBW(IteratorDictString *it)
 	delete [] occ;
 }
 
-uint 
-StringDictionaryXBW::locate(uchar *str, uint strLen)
+size_t 
+StringDictionaryXBW::locate(uchar *str, uint strLen) const
 {
+	if ((membershipFilter != NULL) && !membershipFilter->contains(str, strLen)) return NORESULT;
+
 	uchar *qry = new uchar[strLen+1];
 	qry[0] = 0;
 	strncpy((char*)qry+1, (char*)str, strLen);
@@ -139,7 +146,7 @@ StringDictionaryXBW::locate(uchar *str, uint strLen)
 }
 
 uchar *
-StringDictionaryXBW::extract(size_t id, uint *strLen)
+StringDictionaryXBW::extract(size_t id, uint *strLen) const
 {
 	if ((id > 0) && (id <= elements))
 	{
@@ -157,7 +164,7 @@ StringDictionaryXBW::extract(size_t id, uint *strLen)
 }
 
 IteratorDictID*
-StringDictionaryXBW::locatePrefix(uchar *str, uint strLen)
+StringDictionaryXBW::locatePrefix(uchar *str, uint strLen) const
 {
 	uchar *qry = new uchar[strLen+1];
 	qry[0] = 0;
@@ -175,7 +182,7 @@ StringDictionaryXBW::locatePrefix(uchar *str, uint strLen)
 
 
 IteratorDictID*
-StringDictionaryXBW::locateSubstr(uchar *str, uint strLen)
+StringDictionaryXBW::locateSubstr(uchar *str, uint strLen) const
 {
 	uint left, right;
 	xbw->subPathSearch(str, strLen, &left, &right);
@@ -184,14 +191,14 @@ StringDictionaryXBW::locateSubstr(uchar *str, uint strLen)
 	else return new IteratorDictIDContiguous(NORESULT, NORESULT);
 }
 
-uint 
-StringDictionaryXBW::locateRank(uint rank)
+size_t 
+StringDictionaryXBW::locateRank(size_t rank) const
 {
 	return rank;
 }
 
 IteratorDictString*
-StringDictionaryXBW::extractPrefix(uchar *str, uint strLen)
+StringDictionaryXBW::extractPrefix(uchar *str, uint strLen) const
 {
 	uchar *qry = new uchar[strLen+2];
 	qry[0] = 0;
@@ -206,7 +213,7 @@ StringDictionaryXBW::extractPrefix(uchar *str, uint strLen)
 }
 
 IteratorDictString*
-StringDictionaryXBW::extractSubstr(uchar *str, uint strLen)
+StringDictionaryXBW::extractSubstr(uchar *str, uint strLen) const
 {
 	uint left, right;
 	xbw->subPathSearch(str, strLen, &left, &right);
@@ -216,22 +223,28 @@ StringDictionaryXBW::extractSubstr(uchar *str, uint strLen)
 }
 
 uchar *
-StringDictionaryXBW::extractRank(uint rank, uint *strLen)
+StringDictionaryXBW::extractRank(size_t rank, uint *strLen) const
 {
 	return extract(rank, strLen);
 }
 
 IteratorDictString*
-StringDictionaryXBW::extractTable()
+StringDictionaryXBW::extractTable() const
 {
-	cerr << "TO BE IMPLEMENTED" << endl;
-	return NULL;
+	return new IteratorDictStringXBWTable(xbw, elements, maxlength);
+}
+
+void
+StringDictionaryXBW::indexMembership()
+{
+	// The XBW is only available for loaded dictionaries
+	if ((membershipFilter == NULL) && (xbw != NULL)) membershipFilter = new MembershipFilter(this);
 }
 
 size_t 
-StringDictionaryXBW::getSize()
+StringDictionaryXBW::getSize() const
 {
-	return xbw->size()+sizeof(StringDictionaryXBW);
+	return xbw->size()+sizeof(StringDictionaryXBW)+((membershipFilter != NULL) ? membershipFilter->getSize() : 0);
 }
 
 
@@ -247,21 +260,28 @@ StringDictionaryXBW::save(ofstream &out)
 	out.write((char*) alpha, len * sizeof(uint));
 	out.write((char*) last, (len / W + 1) * sizeof(uint));
 	out.write((char*) A, (len / W + 2) * sizeof(uint));
+
+	if (sequence == WMATRIX) saveValue<uint32_t>(out, XBWMATRIX);
+
+	// Optional membership filter
+	if (membershipFilter != NULL) membershipFilter->save(out);
 }
 
 StringDictionary*
-StringDictionaryXBW::load(ifstream &in)
+StringDictionaryXBW::load(ifstream &in, MemoryMapping *mapping)
 {
 	size_t type = loadValue<uint32_t>(in);
 	if(type != DXBW) return NULL;
 
 	StringDictionaryXBW *dict = new StringDictionaryXBW();
+	dict->memoryMapping = mapping;
 
 	dict->type = DXBW;
 	dict->elements = loadValue<uint64_t>(in);
 	dict->maxlength = loadValue<uint32_t>(in);
 
 	dict->xbw = new XBW(in);
+	dict->membershipFilter = MembershipFilter::load(in, mapping);
 
 	return dict;
 }
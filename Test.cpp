@@ -36,8 +36,11 @@ using namespace std;
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <pthread.h>
 
 #include "StringDictionary.h"
+#include "iterators/IteratorDictStringPlain.h"
+#include "iterators/IteratorDictStringFile.h"
 
 #define RUNS 10
 
@@ -67,23 +70,46 @@ void useTest()
 	cerr << " *** Test script for the library of Compressed String Dictionaries (libCSD). *** " << endl;
 	cerr << " ******************************************************************************** " << endl;
 	cerr << endl;
-	cerr << " ----- test <mode> <opt> <in> <file>" << endl;
+	cerr << " ----- test <mode> <opt> <in> <file> [i]" << endl;
 	cerr << endl;
 	cerr << " <mode> r : Run the given test." << endl;
 	cerr << "    <opt> l : LOCATE test." << endl;
 	cerr << "    <opt> e : EXTRACT test." << endl;
 	cerr << "    <opt> pl : LOCATE PREFIX test." << endl;
 	cerr << "    <opt> pe : EXTRACT PREFIX test." << endl;
+	cerr << "    <opt> pp : LOCATE PREFIX test (first two pages of 10 IDs, through a cursor)." << endl;
 	cerr << "    <opt> sl : LOCATE SUBSTRING test." << endl;
 	cerr << "    <opt> se : EXTRACT SUBSTRING test." << endl;
+	cerr << "    <opt> sc : COUNT SUBSTRING test (upper bound)." << endl;
+	cerr << "    <opt> sx : COUNT SUBSTRING test (exact)." << endl;
 	cerr << " <mode> g : Generate the basic testbed." << endl;
 	cerr << "    <opt> number of patterns to be generated." << endl;
 	cerr << " <mode> p : Generate the prefix testbed." << endl;
 	cerr << "    <opt> mean string length." << endl;
 	cerr << " <mode> s : Generate the substring testbed." << endl;
 	cerr << "    <opt> mean string length." << endl;
+	cerr << " <mode> t : Run a concurrent stress test (LOCATE, EXTRACT and LOCATE PREFIX)" << endl;
+	cerr << "            over a single loaded dictionary." << endl;
+	cerr << "    <opt> number of threads." << endl;
+	cerr << " <mode> m : Compare each query on the memory-mapped dictionary with the same query" << endl;
+	cerr << "            on the loaded one (IDs and strings must be identical)." << endl;
+	cerr << "    <opt> queries: 'l' LOCATE, 'e' EXTRACT (all IDs), 'p' PREFIX and 's' SUBSTRING." << endl;
+	cerr << " <mode> b : Run the string comparison (longest common prefix) microbenchmark" << endl;
+	cerr << "            over URI-like pairs: test b <prefix> <pairs> (no dictionary)." << endl;
+	cerr << "    <opt> length of the prefix shared by each pair." << endl;
+	cerr << " <mode> c : Check LOCATE, EXTRACT and (empty) PREFIX queries on dictionaries built from" << endl;
+	cerr << "            the given (sorted, '\\0'-delimited) strings: test c <bucketsize> <strings>." << endl;
+	cerr << "            The Front-Coding and RPDAC dictionaries are also built for the subsets" << endl;
+	cerr << "            in which the last bucket is full or only contains its header, and the" << endl;
+	cerr << "            hash-based ones use a 50% overhead (no dictionary)." << endl;
+	cerr << "            Batch queries (locateBatch, extractBatch, extractInto) must agree with" << endl;
+	cerr << "            the single ones, and the PFC dictionary streamed to disk (Build '3 p')" << endl;
+	cerr << "            must be byte-identical to the saved one." << endl;
+	cerr << "    <opt> number of strings per bucket." << endl;
 	cerr << " <in> : input file containing the compressed string dictionary." << endl;
 	cerr << " <file> : file from which the patterns are loaded or in which are saved." << endl;
+	cerr << " [i] : builds the bucket header index (Front-Coding dictionaries) before testing." << endl;
+	cerr << "       Adding 'g' unpacks the grammar (RePair based dictionaries) before testing." << endl;
 	cerr << endl;
 }
 
@@ -141,7 +167,7 @@ void runLocate(StringDictionary *dict, char* in)
 void runExtract(StringDictionary *dict, char* in)
 {
 	ifstream inIds(in);
-	vector<uint> ids;
+	vector<size_t> ids;
 	char line[256];
 
 	while (true)
@@ -151,7 +177,7 @@ void runExtract(StringDictionary *dict, char* in)
 
 		if (len == 0) break;
 
-		ids.push_back(atoi(line));
+		ids.push_back(strtoull(line, NULL, 10));
 	}
 
 	uint patterns = ids.size();
@@ -241,6 +267,72 @@ void runLocatePrefix(StringDictionary *dict, char* in)
 	for (uint i=0; i<patterns; i++) delete [] strings[i];	
 }
 
+void runLocatePrefixPages(StringDictionary *dict, char* in)
+{
+	ifstream inStrings(in);
+
+	vector<uchar*> strings;
+	vector<uint> lengths;
+	uint maxlength = dict->maxLength();
+
+	while (true)
+	{
+		uchar *str = new uchar[maxlength+1];
+		inStrings.getline((char*)str, maxlength);
+		uint len = strlen((char*)str);
+
+		if (len == 0) { delete [] str; break; }
+
+		strings.push_back(str);
+		lengths.push_back(len);
+
+	}
+
+	inStrings.close();
+
+	const size_t page = 10;
+	uint patterns = strings.size();
+	double t0, t1, total=0;
+	size_t located;
+
+	for (uint i=1; i<=RUNS; i++)
+	{
+		located = 0;
+		t0 = getTime ();
+
+		for (uint j=0; j<patterns; j++)
+		{
+			PrefixCursor *cursor = dict->locatePrefixCursor(strings[j], lengths[j]);
+			if (cursor == NULL) continue;
+
+			for (uint p=0; (p<2) && cursor->hasNext(); p++)
+			{
+				IteratorDictID *it = dict->locatePrefixPage(cursor, page);
+				while (it->hasNext()) { it->next(); located++; }
+				delete it;
+			}
+
+			delete cursor;
+		}
+
+		t1 = (getTime () - t0);
+		cerr << (t1*SEC_TIME_DIVIDER) << " ";
+		total += t1;
+
+		sleep(5);
+	}
+
+	double avgrun = total/RUNS;
+	double avgpattern = avgrun/patterns;
+
+	cerr << ";;;" << (total*SEC_TIME_DIVIDER);
+	cerr << ";;;" << (avgrun*SEC_TIME_DIVIDER);
+	cerr << ";;;" << (avgpattern*MCSEC_TIME_DIVIDER) << " " << MCSEC_TIME_UNIT << endl;
+	cerr << (avgpattern*MCSEC_TIME_DIVIDER) << "  " << located << endl;
+
+	for (uint i=0; i<patterns; i++) delete [] strings[i];	
+}
+
 void runExtractPrefix(StringDictionary *dict, char* in)
 {
 	ifstream inStrings(in);
@@ -362,6 +454,56 @@ void runLocateSubstring(StringDictionary *dict, char* in)
 	for (uint i=0; i<patterns; i++) delete [] strings[i];	
 }
 
+void runCountSubstring(StringDictionary *dict, char* in, bool exact)
+{
+	ifstream inStrings(in);
+
+	vector<uchar*> strings;
+	vector<uint> lengths;
+	uint maxlength = dict->maxLength();
+
+	while (true)
+	{
+		uchar *str = new uchar[maxlength+1];
+		inStrings.getline((char*)str, maxlength);
+		uint len = strlen((char*)str);
+
+		if (len == 0) { delete [] str; break; }
+
+		strings.push_back(str);
+		lengths.push_back(len);
+
+	}
+
+	inStrings.close();
+
+	uint patterns = strings.size();
+	double t0, t1, total=0;
+	size_t counted;
+
+	for (uint i=1; i<=RUNS; i++)
+	{
+		counted = 0;
+		t0 = getTime ();
+
+		for (uint j=0; j<patterns; j++)
+			counted += dict->countSubstr(strings[j], lengths[j], exact);
+
+		t1 = (getTime () - t0);
+		cerr << (t1*SEC_TIME_DIVIDER) << " ";
+		total += t1;
+
+		sleep(5);
+	}
+
+
+	cerr << endl;
+	double avgrun = total/RUNS;
+	cerr << dict->getSize() << ";" << avgrun << ";" << counted << endl;
+
+	for (uint i=0; i<patterns; i++) delete [] strings[i];	
+}
+
 void runExtractSubstring(StringDictionary *dict, char* in)
 {
 	ifstream inStrings(in);
@@ -424,10 +566,590 @@ void runExtractSubstring(StringDictionary *dict, char* in)
 	for (uint i=0; i<patterns; i++) delete [] strings[i];	
 }
 
+struct StressTest
+{
+	const StringDictionary *dict;	//! Dictionary shared by all threads
+	vector<uchar*> *strings;	//! Patterns
+	vector<uint> *lengths;		//! Pattern lengths
+	vector<size_t> *ids;		//! Expected IDs
+	vector<size_t> *prefixes;	//! Expected number of IDs for each prefix (empty if not supported)
+	size_t first;			//! First pattern processed by the thread
+	size_t errors;			//! Number of wrong answers
+};
+
+size_t countPrefix(const StringDictionary *dict, uchar *str, uint strLen)
+{
+	size_t count = 0;
+	IteratorDictID *it = dict->locatePrefix(str, (strLen+1)/2);
+
+	if (it == NULL) return (size_t)-1;
+	while (it->hasNext()) { it->next(); count++; }
+	delete it;
+
+	return count;
+}
+
+void *runStressThread(void *arg)
+{
+	StressTest *test = (StressTest*)arg;
+	size_t patterns = test->strings->size();
+	uint cap = test->dict->extractCapacity();
+	uchar *buf = new uchar[cap];
+
+	for (size_t i=0; i<RUNS*patterns; i++)
+	{
+		size_t j = (test->first+i) % patterns;
+		uchar *str = (*test->strings)[j];
+		uint len = (*test->lengths)[j];
+
+		size_t id = test->dict->locate(str, len);
+		if (id != (*test->ids)[j]) { test->errors++; continue; }
+
+		uint strLen;
+		uchar *ext = test->dict->extract(id, &strLen);
+		if ((ext == NULL) || (strLen != len) || (memcmp(ext, str, len) != 0)) test->errors++;
+		delete [] ext;
+
+		strLen = test->dict->extractInto(id, buf, cap);
+		if ((strLen != len) || (memcmp(buf, str, len) != 0)) test->errors++;
+
+		if (!test->prefixes->empty() && (countPrefix(test->dict, str, len) != (*test->prefixes)[j]))
+			test->errors++;
+	}
+
+	delete [] buf;
+	return NULL;
+}
+
+void runStress(StringDictionary *dict, uint threads, char* in)
+{
+	ifstream inStrings(in);
+
+	vector<uchar*> strings;
+	vector<uint> lengths;
+	uint maxlength = dict->maxLength();
+
+	while (true)
+	{
+		uchar *str = new uchar[maxlength+1];
+		inStrings.getline((char*)str, maxlength+1);
+		uint len = strlen((char*)str);
+
+		if (len == 0) { delete [] str; break; }
+
+		strings.push_back(str);
+		lengths.push_back(len);
+	}
+
+	inStrings.close();
+
+	if ((strings.size() == 0) || (threads == 0)) { useTest(); return; }
+
+	// The expected answers are obtained sequentially
+	vector<size_t> ids(strings.size());
+	vector<size_t> prefixes;
+
+	for (size_t i=0; i<strings.size(); i++) ids[i] = dict->locate(strings[i], lengths[i]);
+
+	if (countPrefix(dict, strings[0], lengths[0]) != (size_t)-1)
+	{
+		prefixes.resize(strings.size());
+		for (size_t i=0; i<strings.size(); i++) prefixes[i] = countPrefix(dict, strings[i], lengths[i]);
+	}
+
+	vector<pthread_t> workers(threads);
+	vector<StressTest> tests(threads);
+	double t0 = getTime();
+
+	for (uint i=0; i<threads; i++)
+	{
+		StressTest test = { dict, &strings, &lengths, &ids, &prefixes, (i*strings.size())/threads, 0 };
+		tests[i] = test;
+		pthread_create(&workers[i], NULL, runStressThread, &tests[i]);
+	}
+
+	size_t errors = 0;
+
+	for (uint i=0; i<threads; i++)
+	{
+		pthread_join(workers[i], NULL);
+		errors += tests[i].errors;
+	}
+
+	double t1 = getTime()-t0;
+
+	cerr << threads << " threads;;;" << (t1*SEC_TIME_DIVIDER);
+	cerr << ";;;" << (threads*RUNS*strings.size()) << " patterns;;;" << errors << " errors" << endl;
+
+	for (size_t i=0; i<strings.size(); i++) delete [] strings[i];
+}
+
+/* Returns 0 if both ID iterators (which can be NULL) contain the same
+   IDs (and releases them); 1 otherwise. */
+size_t compareIDs(IteratorDictID *a, IteratorDictID *b)
+{
+	size_t wrong = ((a == NULL) != (b == NULL)) ? 1 : 0;
+
+	if ((a != NULL) && (b != NULL))
+	{
+		while (a->hasNext() && b->hasNext())
+			if (a->next() != b->next()) { wrong = 1; break; }
+
+		if ((wrong == 0) && (a->hasNext() || b->hasNext())) wrong = 1;
+	}
+
+	delete a; delete b;
+	return wrong;
+}
+
+/* Returns 0 if both string iterators (which can be NULL) contain the 
+   same strings (and releases them); 1 otherwise. */
+size_t compareStrings(IteratorDictString *a, IteratorDictString *b)
+{
+	size_t wrong = ((a == NULL) != (b == NULL)) ? 1 : 0;
+
+	if ((a != NULL) && (b != NULL))
+	{
+		while ((wrong == 0) && a->hasNext() && b->hasNext())
+		{
+			uint lenA, lenB;
+			uchar *strA = a->next(&lenA);
+			uchar *strB = b->next(&lenB);
+
+			if ((lenA != lenB) || (memcmp(strA, strB, lenA) != 0)) wrong = 1;
+			delete [] strA; delete [] strB;
+		}
+
+		if ((wrong == 0) && (a->hasNext() || b->hasNext())) wrong = 1;
+	}
+
+	delete a; delete b;
+	return wrong;
+}
+
+void runMapped(StringDictionary *dict, StringDictionary *mapped, char *opt, char* in)
+{
+	ifstream inStrings(in);
+
+	vector<uchar*> strings;
+	vector<uint> lengths;
+	uint maxlength = dict->maxLength();
+
+	while (true)
+	{
+		uchar *str = new uchar[maxlength+1];
+		inStrings.getline((char*)str, maxlength+1);
+		uint len = strlen((char*)str);
+
+		if (len == 0) { delete [] str; break; }
+
+		strings.push_back(str);
+		lengths.push_back(len);
+	}
+
+	inStrings.close();
+
+	size_t queries = 0, wrong = 0;
+
+	if ((mapped == NULL) || (mapped->numElements() != dict->numElements())) wrong++;
+	else
+	{
+		for (size_t i=0; i<strings.size(); i++)
+		{
+			uchar *str = strings[i];
+			uint len = lengths[i];
+
+			if (strchr(opt, 'l') != NULL)
+			{
+				if (dict->locate(str, len) != mapped->locate(str, len)) wrong++;
+				queries++;
+			}
+
+			if (strchr(opt, 'p') != NULL)
+			{
+				uint plen = (len+1)/2;
+				wrong += compareIDs(dict->locatePrefix(str, plen), mapped->locatePrefix(str, plen));
+				wrong += compareStrings(dict->extractPrefix(str, plen), mapped->extractPrefix(str, plen));
+				queries += 2;
+			}
+
+			if ((strchr(opt, 's') != NULL) && (len >= 3))
+			{
+				// A (shorter) substring from the middle of the string
+				uchar *sub = str+len/3;
+				uint slen = (len+2)/3;
+				wrong += compareIDs(dict->locateSubstr(sub, slen), mapped->locateSubstr(sub, slen));
+				queries++;
+			}
+		}
+
+		if (strchr(opt, 'e') != NULL)
+		{
+			uint cap = maxlength+1;
+			uchar *buf = new uchar[cap];
+
+			for (size_t id=1; id<=dict->numElements(); id++)
+			{
+				uint lenA, lenB;
+				uchar *strA = dict->extract(id, &lenA);
+				uchar *strB = mapped->extract(id, &lenB);
+
+				if ((lenA != lenB) || (memcmp(strA, strB, lenA) != 0)) wrong++;
+				if ((mapped->extractInto(id, buf, cap) != lenA) || (memcmp(buf, strA, lenA) != 0)) wrong++;
+
+				delete [] strA; delete [] strB;
+				queries += 2;
+			}
+
+			delete [] buf;
+		}
+	}
+
+	cerr << queries << " queries;;;" << wrong << " mismatches" << endl;
+
+	for (size_t i=0; i<strings.size(); i++) delete [] strings[i];
+}
+
+void runLCPBenchmark(uint prefix, uint pairs)
+{
+	if ((prefix == 0) || (pairs == 0)) { useTest(); return; }
+
+	// URI-like pairs sharing 'prefix' bytes and ending with distinct suffixes
+	srand(1);
+	const char *scheme = "http://dbpedia.org/resource/";
+	vector<uchar*> first(pairs), second(pairs);
+	vector<uint> lengths(pairs);
+
+	for (uint i=0; i<pairs; i++)
+	{
+		uint len = prefix+16;
+		first[i] = new uchar[len+1];
+		second[i] = new uchar[len+1];
+
+		for (uint j=0; j<len; j++)
+		{
+			uchar c = (j < strlen(scheme)) ? scheme[j] : 'a'+(rand()%26);
+			first[i][j] = second[i][j] = c;
+		}
+
+		second[i][prefix] = (first[i][prefix] == 'z') ? 'a' : first[i][prefix]+1;
+		first[i][len] = second[i][len] = '\0';
+		lengths[i] = len+1;
+	}
+
+	double t0, scalar = 0, vectorized = 0;
+	size_t lcpScalar = 0, lcpVectorized = 0;
+
+	for (uint r=0; r<RUNS; r++)
+	{
+		t0 = getTime();
+		for (uint i=0; i<pairs; i++)
+		{
+			uint lcp = 0;
+			longestCommonPrefixScalar(first[i], second[i], lengths[i], &lcp);
+			lcpScalar += lcp;
+		}
+		scalar += getTime()-t0;
+
+		t0 = getTime();
+		for (uint i=0; i<pairs; i++)
+		{
+			uint lcp = 0;
+			longestCommonPrefix(first[i], second[i], lengths[i], &lcp);
+			lcpVectorized += lcp;
+		}
+		vectorized += getTime()-t0;
+	}
+
+	cerr << "scalar;;;" << (scalar*SEC_TIME_DIVIDER) << ";;;vectorized;;;" << (vectorized*SEC_TIME_DIVIDER);
+	cerr << ";;;speedup;;;" << (scalar/vectorized);
+	cerr << ";;;" << ((lcpScalar == lcpVectorized) ? "same" : "different") << " lcp values" << endl;
+
+	for (uint i=0; i<pairs; i++) { delete [] first[i]; delete [] second[i]; }
+}
+
+/* Saves the dictionary into a temporary file and loads it again (the
+   checks run on the same representation used by the queries). */
+StringDictionary *reload(StringDictionary *dict, string tmp)
+{
+	ofstream out((char*)tmp.c_str());
+	dict->save(out);
+	out.close();
+	delete dict;
+
+	ifstream in((char*)tmp.c_str());
+	dict = StringDictionary::load(in, HASHRP);
+	in.close();
+	remove(tmp.c_str());
+
+	return dict;
+}
+
+/* Iterator over the first n strings. */
+IteratorDictString *firstStrings(vector<string> &strings, size_t n)
+{
+	size_t len = 0;
+	for (size_t i=0; i<n; i++) len += strings[i].size()+1;
+
+	uchar *str = new uchar[len+1];
+	size_t ptr = 0;
+
+	for (size_t i=0; i<n; i++)
+	{
+		memcpy(str+ptr, strings[i].c_str(), strings[i].size()+1);
+		ptr += strings[i].size()+1;
+	}
+
+	str[len] = '\0';
+	return new IteratorDictStringPlain(str, len);
+}
+
+/* Builds the PFC dictionary of the first n strings by streaming them
+   from a file to the output (as Build '3 p' does) and returns 1 if the
+   result differs from the file saved by the in-memory construction. */
+size_t checkStreamed(vector<string> &strings, size_t n, uint bucketsize, string tmp)
+{
+	string plain = tmp+string(".in"), streamed = tmp+string(".stream"), saved = tmp+string(".mem");
+
+	ofstream outStrings((char*)plain.c_str(), ios::binary);
+	for (size_t i=0; i<n; i++) outStrings.write(strings[i].c_str(), strings[i].size()+1);
+	outStrings.close();
+
+	ofstream out((char*)streamed.c_str(), ios::binary);
+	StringDictionaryPFC::build(new IteratorDictStringFile((char*)plain.c_str()), bucketsize, out);
+	out.close();
+
+	StringDictionary *dict = new StringDictionaryPFC(firstStrings(strings, n), bucketsize);
+	out.open((char*)saved.c_str(), ios::binary);
+	dict->save(out);
+	out.close();
+	delete dict;
+
+	ifstream a((char*)streamed.c_str(), ios::binary), b((char*)saved.c_str(), ios::binary);
+	string bytesA((istreambuf_iterator<char>(a)), istreambuf_iterator<char>());
+	string bytesB((istreambuf_iterator<char>(b)), istreambuf_iterator<char>());
+	a.close(); b.close();
+
+	remove(plain.c_str()); remove(streamed.c_str()); remove(saved.c_str());
+
+	return (bytesA == bytesB) ? 0 : 1;
+}
+
+/* Checks the dictionary built from the first n (sorted) strings and
+   returns the number of wrong answers. */
+size_t checkStrings(const StringDictionary *dict, vector<string> &strings, size_t n)
+{
+	size_t errors = 0;
+
+	if ((dict == NULL) || (dict->numElements() != n)) return n+1;
+
+	for (size_t i=0; i<n; i++)
+	{
+		uchar *str = (uchar*)strings[i].c_str();
+		uint len = strings[i].size();
+
+		if (dict->locate(str, len) != i+1) errors++;
+
+		uint strLen;
+		uchar *ext = dict->extract(i+1, &strLen);
+		if ((ext == NULL) || (strLen != len) || (memcmp(ext, str, len) != 0)) errors++;
+		delete [] ext;
+
+		// The prefix of a string is shared by a contiguous range
+		uint plen = (len+1)/2;
+		string prefix = strings[i].substr(0, plen);
+		size_t left = lower_bound(strings.begin(), strings.begin()+n, prefix)-strings.begin();
+		size_t right = left;
+		while ((right < n) && (strings[right].compare(0, plen, prefix) == 0)) right++;
+
+		IteratorDictID *it = dict->locatePrefix((uchar*)prefix.c_str(), plen);
+		size_t id = left;
+
+		while (it->hasNext())
+		{
+			if (it->next() != id+1) errors++;
+			id++;
+		}
+
+		if (id != right) errors++;
+		delete it;
+	}
+
+	// No (ASCII) string is prefixed by 0xFF bytes: both iterators are
+	// empty (or no string iterator is returned)
+	uchar none[] = { 0xFF, 0xFF, 0xFF, 0x00 };
+
+	IteratorDictID *itID = dict->locatePrefix(none, 3);
+	if (itID->hasNext()) errors++;
+	delete itID;
+
+	IteratorDictString *itStr = dict->extractPrefix(none, 3);
+	if ((itStr != NULL) && itStr->hasNext()) errors++;
+	delete itStr;
+
+	return errors;
+}
+
+/* Checks a dictionary (whose IDs do not follow the string order) built
+   from the first n strings and returns the number of wrong answers. */
+size_t checkUnsorted(const StringDictionary *dict, vector<string> &strings, size_t n)
+{
+	size_t errors = 0;
+
+	if ((dict == NULL) || (dict->numElements() != n)) return n+1;
+
+	for (size_t i=0; i<n; i++)
+	{
+		// Each string is extracted from the ID in which it is located
+		uchar *str = (uchar*)strings[i].c_str();
+		uint len = strings[i].size();
+		size_t id = dict->locate(str, len);
+
+		uint strLen;
+		uchar *ext = (id != NORESULT) ? dict->extract(id, &strLen) : NULL;
+		if ((ext == NULL) || (strLen != len) || (memcmp(ext, str, len) != 0)) errors++;
+		delete [] ext;
+
+		// Each ID is located from the string extracted from it
+		ext = dict->extract(i+1, &strLen);
+		if ((ext == NULL) || (dict->locate(ext, strLen) != i+1)) errors++;
+		delete [] ext;
+	}
+
+	return errors;
+}
+
+/* Checks that extractInto and extractBatch (in reverse order, with a
+   repeated ID) agree with extract, and that locateBatch (over the first n
+   strings plus absent ones) agrees with locate. It returns the number of
+   wrong answers. */
+size_t checkBatch(const StringDictionary *dict, vector<string> &strings, size_t n)
+{
+	size_t errors = 0;
+
+	vector<string> patterns(strings.begin(), strings.begin()+n);
+	for (size_t i=0; i<n; i+=3) patterns.push_back(strings[i]+"~");
+
+	vector<const uchar*> strs;
+	vector<uint> lens;
+
+	for (size_t i=0; i<patterns.size(); i++)
+	{
+		strs.push_back((const uchar*)patterns[i].c_str());
+		lens.push_back(patterns[i].size());
+	}
+
+	vector<size_t> located(patterns.size());
+	dict->locateBatch(&strs[0], &lens[0], patterns.size(), &located[0]);
+
+	for (size_t i=0; i<patterns.size(); i++)
+		if (located[i] != dict->locate((uchar*)strs[i], lens[i])) errors++;
+
+	vector<size_t> ids;
+	for (size_t i=n; i>0; i--) ids.push_back(i);
+	ids.push_back(n);
+
+	vector<size_t> offsets(ids.size());
+	vector<uint> lengths(ids.size());
+	ByteArena arena;
+	dict->extractBatch(&ids[0], ids.size(), arena, &offsets[0], &lengths[0]);
+
+	// The generic batch decodes in place through extractInto
+	vector<size_t> offsetsIn(ids.size());
+	vector<uint> lengthsIn(ids.size());
+	ByteArena arenaIn;
+	dict->StringDictionary::extractBatch(&ids[0], ids.size(), arenaIn, &offsetsIn[0], &lengthsIn[0]);
+
+	uint cap = dict->maxLength()+1;
+	uchar *buf = new uchar[cap];
+	uchar *bufIn = new uchar[dict->extractCapacity()];
+
+	for (size_t i=0; i<ids.size(); i++)
+	{
+		uint strLen;
+		uchar *ext = dict->extract(ids[i], &strLen);
+
+		if ((lengths[i] != strLen) || (memcmp(arena.getData()+offsets[i], ext, strLen) != 0)) errors++;
+		if ((lengthsIn[i] != strLen) || (memcmp(arenaIn.getData()+offsetsIn[i], ext, strLen) != 0) || (arenaIn.getData()[offsetsIn[i]+strLen] != '\0')) errors++;
+		if ((dict->extractInto(ids[i], buf, cap) != strLen) || (memcmp(buf, ext, strLen) != 0)) errors++;
+		if ((dict->extractInto(ids[i], bufIn, dict->extractCapacity()) != strLen) || (memcmp(bufIn, ext, strLen) != 0) || (bufIn[strLen] != '\0')) errors++;
+		delete [] ext;
+	}
+
+	delete [] buf; delete [] bufIn;
+	return errors;
+}
+
+void runCheck(uint bucketsize, char* in)
+{
+	ifstream inStrings(in);
+	if (!inStrings.good()) { checkFile(); return; }
+
+	vector<string> strings;
+	string str;
+
+	while (getline(inStrings, str, '\0')) strings.push_back(str);
+	inStrings.close();
+
+	if ((strings.size() == 0) || (bucketsize < 2)) { useTest(); return; }
+
+	// All strings, and the largest subsets in which the last bucket is
+	// full and in which it only contains its header
+	vector<size_t> sizes;
+	size_t n = strings.size();
+	size_t full = (n/bucketsize)*bucketsize;
+	size_t header = (n%bucketsize == 0) ? n-bucketsize+1 : full+1;
+
+	sizes.push_back(n);
+	if ((full > 0) && (full != n)) sizes.push_back(full);
+	if (header != n) sizes.push_back(header);
+
+	string tmp = string(in)+string(".check");
+	size_t errors = 0;
+
+	for (size_t s=0; s<sizes.size(); s++)
+	{
+		n = sizes[s];
+		const char *names[] = { "pfc", "rpfc", "htfc", "hhtfc", "rphtfc", "rpdac", "hashhf", "hashrpf", "hashuffdac", "hashrpdac" };
+
+		for (uint t=0; t<10; t++)
+		{
+			IteratorDictString *it = firstStrings(strings, n);
+			StringDictionary *dict = NULL;
+
+			switch (t)
+			{
+				case 0: dict = new StringDictionaryPFC(it, bucketsize); break;
+				case 1: dict = new StringDictionaryRPFC(it, bucketsize); break;
+				case 2: dict = new StringDictionaryHTFC(it, bucketsize); break;
+				case 3: dict = new StringDictionaryHHTFC(it, bucketsize); break;
+				case 4: dict = new StringDictionaryRPHTFC(it, bucketsize); break;
+				case 5: dict = new StringDictionaryRPDAC(it); break;
+				// The hash tables use a 50% overhead
+				case 6: dict = new StringDictionaryHASHHF(it, it->size(), 50); break;
+				case 7: dict = new StringDictionaryHASHRPF(it, it->size(), 50); break;
+				case 8: dict = new StringDictionaryHASHUFFDAC(it, it->size(), 50); break;
+				case 9: dict = new StringDictionaryHASHRPDAC(it, it->size(), 50); break;
+			}
+
+			dict = reload(dict, tmp);
+			size_t wrong = (t < 6) ? checkStrings(dict, strings, n) : checkUnsorted(dict, strings, n);
+			if (dict != NULL) wrong += checkBatch(dict, strings, n);
+			if (t == 0) wrong += checkStreamed(strings, n, bucketsize, tmp);
+			errors += wrong;
+
+			cerr << names[t] << ";;;" << n << " strings (" << (n%bucketsize) << " in the last bucket);;;" << wrong << " errors" << endl;
+			delete dict;
+		}
+	}
+
+	cerr << ((errors == 0) ? "OK" : "FAILED") << endl;
+}
+
 void generate(StringDictionary *dict, uint patterns, char* out)
 {
 	srand (time(NULL));
-	uint num = dict->numElements();
+	size_t num = dict->numElements();
 
 	vector<size_t> ids(patterns);
 
@@ -458,7 +1180,7 @@ void generate(StringDictionary *dict, uint patterns, char* out)
 void generateP(StringDictionary *dict, uint mean, char* out)
 {
 	srand (time(NULL));
-	uint num = dict->numElements();
+	size_t num = dict->numElements();
 
 	uint PREFIXES = 100000;
 	vector<size_t> ids(PREFIXES);
@@ -510,7 +1232,7 @@ void generateP(StringDictionary *dict, uint mean, char* out)
 void generateS(StringDictionary *dict, uint mean, char* out)
 {
 	srand (time(NULL));
-	uint num = dict->numElements();
+	size_t num = dict->numElements();
 
 	uint SUBSTRINGS = 100000;
 	vector<size_t> ids(SUBSTRINGS);
@@ -577,7 +1299,11 @@ void generateS(StringDictionary *dict, uint mean, char* out)
 int 
 main(int argc, char* argv[])
 {
-	if (argc >= 5)
+	if ((argc == 4) && (argv[1][0] == 'b'))
+		runLCPBenchmark(atoi(argv[2]), atoi(argv[3]));
+	else if ((argc == 4) && (argv[1][0] == 'c'))
+		runCheck(atoi(argv[2]), argv[3]);
+	else if (argc >= 5)
 	{
 		ifstream in(argv[3]);
 
@@ -587,6 +1313,8 @@ main(int argc, char* argv[])
 			in.close();
 
 			if (dict == NULL) { checkDict(); exit(0); }
+			if ((argc >= 6) && (strchr(argv[5], 'i') != NULL)) dict->indexHeaders();
+			if ((argc >= 6) && (strchr(argv[5], 'g') != NULL)) dict->indexGrammar();
 
 			char mode = argv[1][0];
 
@@ -614,6 +1342,8 @@ main(int argc, char* argv[])
 						{
 							if (argv[2][1] == 'l') 
 								runLocatePrefix(dict, argv[4]);
+							else if (argv[2][1] == 'p') 
+								runLocatePrefixPages(dict, argv[4]);
 							else 
 								runExtractPrefix(dict, argv[4]);
 
@@ -624,6 +1354,10 @@ main(int argc, char* argv[])
 						{
 							if (argv[2][1] == 'l') 
 								runLocateSubstring(dict, argv[4]);
+							else if (argv[2][1] == 'c') 
+								runCountSubstring(dict, argv[4], false);
+							else if (argv[2][1] == 'x') 
+								runCountSubstring(dict, argv[4], true);
 							else 
 								runExtractSubstring(dict, argv[4]);
 
@@ -661,6 +1395,25 @@ main(int argc, char* argv[])
 					break;
 				}
 
+				case 't':
+				{
+					uint threads = atoi(argv[2]);
+					runStress(dict, threads, argv[4]);
+					break;
+				}
+
+				case 'm':
+				{
+					StringDictionary *mapped = StringDictionary::loadMapped(argv[3], HASHRP);
+
+					if ((mapped != NULL) && (argc >= 6) && (strchr(argv[5], 'i') != NULL)) mapped->indexHeaders();
+					if ((mapped != NULL) && (argc >= 6) && (strchr(argv[5], 'g') != NULL)) mapped->indexGrammar();
+
+					runMapped(dict, mapped, argv[2], argv[4]);
+					delete mapped;
+					break;
+				}
+
 				default:
 				{
 					useTest();
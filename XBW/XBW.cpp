@@ -50,12 +50,25 @@ XBW::XBW(ifstream &input)
 	uint * AInt = new uint[nodesCount / W + 2];
 	input.read((char*) AInt, (nodesCount / W + 2) * sizeof(uint));
 
+	// An (optional) mark chooses a wavelet matrix for alpha. The stream
+	// is restored when it is missing (a membership filter may follow)
+	streampos pos = input.tellg();
+	uint32_t mark = loadValue<uint32_t>(input);
+	bool matrix = input.good() && (mark == XBWMATRIX);
+
+	if (!matrix)
+	{
+		input.clear();
+		input.seekg(pos, input.beg);
+	}
+
 	// Create the data structures
 	Mapper * am = new MapperNone();
-	wt_coder * wcc = new wt_coder_huff(alphaInt, nodesCount, am);
 	//BitSequenceBuilder * sbb = new BitSequenceBuilderRG(2);		// 2, 4, 20
 	BitSequenceBuilder * sbb = new BitSequenceBuilderRRR(128);		// 16, 64, 128
-	SequenceBuilder * ssb = new SequenceBuilderWaveletTree(sbb, am, wcc);
+	SequenceBuilder * ssb;
+	if (matrix) ssb = new SequenceBuilderWaveletMatrix(sbb, am);
+	else ssb = new SequenceBuilderWaveletTree(sbb, am, new wt_coder_huff(alphaInt, nodesCount, am));
 	alpha = ssb->build(alphaInt, nodesCount);
 	last = sbb->build(lastInt, nodesCount);
 	A = sbb->build(AInt, nodesCount + 1);
@@ -66,7 +79,6 @@ XBW::XBW(ifstream &input)
 			unmap[mapping[i]] = i;
 		}
 
-	input.close();
 	delete ((SequenceBuilderWaveletTree*)sbb);
 
 	// Free the temporary arrays
@@ -76,7 +88,7 @@ XBW::XBW(ifstream &input)
 }
 
 XBW::~XBW() {
-	delete ((WaveletTree*)alpha);
+	delete alpha;
 	delete last;
 	delete A;
 }
@@ -150,11 +162,11 @@ void XBW::subPathSearch(const uchar * qry, const uint ql, uint *left, uint *righ
 		y = select_A[s];
 		z = last->rank1(y - 1);
 
-		if (*left == 0) k1 = 0;
-		else k1 = alpha->rank(s, *left-1);
+		size_t r1, r2;
+		alpha->rankPair(s, (*left == 0) ? (size_t)-1 : *left-1, *right, r1, r2);
+		k1 = r1; k2 = r2;
 
 		*left = last->select1(z + (uint)k1) + 1;
-		k2 = alpha->rank(s, *right);
 		*right = last->select1(z + (uint)k2);
 	}
 }
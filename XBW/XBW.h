@@ -41,6 +41,8 @@ extern bool printing;
 #include <BitSequence.h>
 #include <Mapper.h>
 
+#include "../utils/Utils.h"
+
 using namespace cds_utils;
 using namespace cds_static;
 
@@ -147,6 +149,7 @@ protected:
 	friend class IteratorDictIDXBWDuplicates;
 	friend class IteratorDictStringXBW;
 	friend class IteratorDictStringXBWDuplicates;
+	friend class IteratorDictStringXBWTable;
 };
 
 
@@ -58,5 +58,6 @@ class IteratorDictID
 #include "IteratorDictIDDuplicates.h"
 #include "IteratorDictIDXBW.h"
 #include "IteratorDictIDXBWDuplicates.h"
+#include "IteratorDictIDRank.h"
 
 #endif  
@@ -0,0 +1,78 @@
+/* IteratorDictIDRank.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Iterator class for scanning streams of IDs in alphabetical order from a
+ * RankIndex (IDs are lazily retrieved from the ranks).
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#ifndef _ITERATORDICTIDRANK_H
+#define _ITERATORDICTIDRANK_H
+
+
+#include <iostream>
+using namespace std;
+
+#include "../utils/RankIndex.h"
+
+class IteratorDictIDRank : public IteratorDictID
+{
+	public:
+		/** ID Iterator Constructor for streams of ranked elements.
+		    @param index: the rank index.
+		    @param offset: the first rank in the stream.
+		    @param scanneable: number of elements in the stream.
+		*/
+		IteratorDictIDRank(const RankIndex *index, size_t offset, size_t scanneable)
+		{
+			this->index = index;
+			this->offset = offset;
+			this->scanneable = scanneable;
+
+			this->processed = 0;
+		}
+
+		/** Extracts the next ID in the stream. 
+		    @returns the next ID.
+		*/
+	    	size_t next() { return index->locateRank(offset+(processed++)); }
+
+		/** Obtains the first rank in the stream.
+		    @returns the left limit.
+		*/
+		size_t getLeftLimit() { return offset; }
+
+		/** Obtains the rank following the last one in the stream.
+		    @returns the right limit.
+		*/
+		size_t getRightLimit() { return offset+scanneable; }
+
+		/** Generic destructor */
+		~IteratorDictIDRank() {}
+
+	protected:
+		const RankIndex *index;	// Rank index
+		size_t offset;		// First rank in the stream
+};
+
+#endif  
@@ -53,7 +53,7 @@ class IteratorDictString
 		virtual ~IteratorDictString() {} ;
 
 		/** Returns the stream size */
-		uint size() { return scanneable; }
+		size_t size() { return scanneable; }
 
 
 	protected:
@@ -63,6 +63,7 @@ class IteratorDictString
 };
 
 #include "IteratorDictStringPlain.h"
+#include "IteratorDictStringFile.h"
 #include "IteratorDictStringVector.h"
 
 #include "IteratorDictStringPFC.h"
@@ -73,8 +74,10 @@ class IteratorDictString
 #include "IteratorDictStringRPDAC.h"
 #include "IteratorDictStringXBW.h"
 #include "IteratorDictStringXBWDuplicates.h"
+#include "IteratorDictStringXBWTable.h"
 #include "IteratorDictStringFMINDEX.h"
 #include "IteratorDictStringFMINDEXDuplicates.h"
+#include "IteratorDictStringRank.h"
 
 
 #endif  
@@ -0,0 +1,166 @@
+/* IteratorDictStringFile.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Iterator class for streaming a file of strings delimited by '\0' symbols.
+ * The file is read through a fixed-size buffer, so the memory used does not
+ * depend on the file size.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#ifndef _ITERATORDICTSTRINGFILE_H
+#define _ITERATORDICTSTRINGFILE_H
+
+#include <string.h>
+
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+#include "../utils/Utils.h"
+
+class IteratorDictStringFile : public IteratorDictString
+{
+	public:
+		/** Constructor for the File Iterator:
+		    @filename: the file of strings.
+		    @bufsize: size of the read buffer (in bytes).
+		*/
+	    	IteratorDictStringFile(const char *filename, size_t bufsize=READBUFFER)
+		{
+			this->in.open(filename, ios::binary);
+			this->scanneable = 0;
+
+			if (in.good())
+			{
+				in.seekg(0, ios_base::end);
+				this->scanneable = in.tellg();
+				in.seekg(0, ios_base::beg);
+			}
+
+			this->bufsize = (bufsize > 0) ? bufsize : 1;
+			this->buffer = new uchar[this->bufsize];
+			this->filled = 0;
+			this->pos = 0;
+
+			for (uint i=0; i<2; i++)
+			{
+				this->strings[i] = new uchar[1];
+				this->reserved[i] = 1;
+			}
+
+			this->current = 0;
+			this->processed = 0;
+		}
+
+		/** Extracts the next string in the stream. The string is
+		    valid until the next-but-one call, so the previous string
+		    can be compared with the current one.
+		    @param strLen pointer to the string length.
+		    @returns the next string.
+		*/
+		unsigned char* next(uint *str_length)
+		{
+			current = 1-current;
+			size_t len = 0;
+
+			while ((pos < filled) || fill())
+			{
+				uchar *end = (uchar*)memchr(buffer+pos, '\0', filled-pos);
+				size_t chunk = (end == NULL) ? filled-pos : (size_t)(end-(buffer+pos));
+
+				reserve(len+chunk+1);
+				memcpy(strings[current]+len, buffer+pos, chunk);
+				len += chunk; pos += chunk;
+
+				// The delimiter is skipped
+				if (end != NULL) { pos++; break; }
+			}
+
+			strings[current][len] = '\0';
+			*str_length = len;
+			processed++;
+
+			return strings[current];
+		}
+
+		/** Checks for non-processed strings in the stream.
+		    @returns if remains non-processed strings.
+		*/
+	   	bool hasNext()
+		{
+			return (pos < filled) || fill();
+		}
+
+		/** Generic destructor. */
+		~IteratorDictStringFile()
+		{
+			in.close();
+
+			delete [] buffer;
+			delete [] strings[0];
+			delete [] strings[1];
+		}
+
+	protected:
+		ifstream in;		// The file of strings
+		uchar *buffer;		// The read buffer
+		size_t bufsize;		// Size of the read buffer
+		size_t filled;		// Number of bytes in the read buffer
+		size_t pos;		// Pointer to the current position in the read buffer
+
+		uchar *strings[2];	// The current and the previous strings
+		size_t reserved[2];	// Space reserved for each string
+		uint current;		// Index of the current string
+
+		/** Reads the next block of the file in the buffer.
+		    @returns if any byte has been read.
+		*/
+		bool fill()
+		{
+			in.read((char*)buffer, bufsize);
+			filled = in.gcount();
+			pos = 0;
+
+			return filled > 0;
+		}
+
+		/** Ensures room for len bytes in the current string.
+		    @param len: the required length.
+		*/
+		void reserve(size_t len)
+		{
+			if (len <= reserved[current]) return;
+
+			size_t nreserved = 2*reserved[current];
+			if (nreserved < len) nreserved = len;
+
+			uchar *nstring = new uchar[nreserved];
+			memcpy(nstring, strings[current], reserved[current]);
+			delete [] strings[current];
+
+			strings[current] = nstring;
+			reserved[current] = nreserved;
+		}
+};
+
+#endif
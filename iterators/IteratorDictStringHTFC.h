@@ -150,10 +150,22 @@ class IteratorDictStringHTFC : public IteratorDictString
 
 		ChunkScan chunk;	//! Chunk scanning structure
 
+		/** Computes the number of bytes which can be read for decoding
+		    the header in the current position: the chunks are refilled
+		    64 bits at a time, so they are bounded by the end of the
+		    strings.
+		    @returns the number of readable bytes.
+		*/
+		inline uint headerRemain()
+		{
+			size_t end = blStrings->getField(blStrings->getNumberOfElements()-1);
+			return (uint)min((size_t)maxcomplength, (size_t)(ptr+end-chunk.b_ptr));
+		}
+
 		inline void decodeHeader()
 		{
 			chunk.strLen = 0; chunk.advanced = 0; chunk.extracted = 1;
-			chunk.c_chunk = 0; chunk.c_valid = 0;chunk.b_remain = maxcomplength;
+			chunk.c_chunk = 0; chunk.c_valid = 0;chunk.b_remain = headerRemain();
 
 			// Variables used for adjusting purposes
 			uint plen = 0;
@@ -35,24 +35,21 @@ using namespace std;
 
 #include "../utils/DAC_VLS.h"
 #include "../utils/LogSequence.h"
+#include "../RePair/RePair.h"
 
 class IteratorDictStringRPDAC : public IteratorDictString
 {
 	public:
 		/** RPDAC Iterator Constructor designed for scanning a 
 		    RePair+DAC representation.
-		    @param G: Re-Pair grammar.
-		    @terminals:	number of terminals in the grammar.
-		    @param C: Re-Pair sequence.
+		    @param rp: the RePair structure (grammar and sequence).
 		    @param offset: number of elements to be discarded.
  		    @param scanneable: bucket size.
 		    @param maxlength: largest string length.
 		*/
-	        IteratorDictStringRPDAC(LogSequence *G, uint64_t terminals, DAC_VLS *C, size_t offset, size_t scanneable, uint maxlength)
+	        IteratorDictStringRPDAC(RePair *rp, size_t offset, size_t scanneable, uint maxlength)
 		{ 
-			this->G = G;
-			this->terminals = terminals;
-			this->C = C;
+			this->rp = rp;
 
 			this->scanneable = scanneable;
 			this->maxlength = maxlength;
@@ -60,6 +57,10 @@ class IteratorDictStringRPDAC : public IteratorDictString
 
 			this->strCurr = new uchar[2*this->maxlength];
 			this->lenCurr = 0;
+
+			// The cursor is positioned on the first extraction, so
+			// empty ranges never access the DAC sequence
+			this->cursor = NULL;
 		}
 
 		/** Checks for non-processed strings in the stream. 
@@ -76,16 +77,17 @@ class IteratorDictStringRPDAC : public IteratorDictString
 		*/
 		unsigned char* next(uint *strLen) 
 		{
+			if (cursor == NULL) cursor = new DAC_VLSCursor(rp->Cdac, processed+1);
 			processed++;
 
-			uint *rules;
-			uint len = C->access(processed, &rules);	
+			uint len;
+			const uint *rules = cursor->next(&len);
 
 			lenCurr = 0;
 			
 			for (uint j=0; j<len; j++)
 			{
-				if (rules[j] >= terminals) expandRule(rules[j]-terminals);
+				if (rules[j] >= rp->terminals) lenCurr += rp->expandRule(rules[j]-rp->terminals, strCurr+lenCurr);
 				else
 				{
 					strCurr[lenCurr] = (uchar)rules[j];
@@ -99,8 +101,6 @@ class IteratorDictStringRPDAC : public IteratorDictString
 			uchar *str = new uchar[lenCurr+1];
 			strncpy((char*)str, (char*)strCurr, lenCurr+1);
 
-			delete [] rules;
-
 			return str;
 		}
 
@@ -109,28 +109,15 @@ class IteratorDictStringRPDAC : public IteratorDictString
 		~IteratorDictStringRPDAC() 
 		{
 			delete [] strCurr;
+			delete cursor;
 		}
 
 	protected:
-		LogSequence *G;		//! RePair grammar
-		uint64_t terminals;	//! Number of terminals in the grammar
-		DAC_VLS *C;		//! RePair sequence
+		RePair *rp;		//! RePair grammar and sequence
+		DAC_VLSCursor *cursor;	//! Sequential decoder of the DAC sequence
 
 		uchar *strCurr;		//! Current string
 		uint lenCurr;		//! Length of 'strCurr'
-
-		void 
-		expandRule(uint rule)
-		{
-			uint left = G->getField(2*rule);
-			uint right = G->getField((2*rule)+1);
-
-			if (left >= terminals) expandRule(left-terminals);
-			else { strCurr[lenCurr] = (char)left; lenCurr++; }
-		
-			if (right >= terminals) expandRule(right-terminals);
-			else { strCurr[lenCurr] = (char)right; lenCurr++; }
-		}
 };
 
 #endif  
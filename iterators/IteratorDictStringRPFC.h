@@ -218,7 +218,9 @@ class IteratorDictStringRPFC : public IteratorDictString
 				}
 			}
 
+			// The terminator is not part of the string
 			strCurr[lenCurr-1] = 0;
+			lenCurr--;
 		}
 };
 
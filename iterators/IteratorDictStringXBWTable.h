@@ -0,0 +1,80 @@
+/* IteratorDictStringXBWTable.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Iterator class for scanning all strings (in ID order) in a XBW.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#ifndef _ITERATORDICTSTRINGXBWTABLE_H
+#define _ITERATORDICTSTRINGXBWTABLE_H
+
+#include <iostream>
+using namespace std;
+
+#include "../XBW/XBW.h"
+
+class IteratorDictStringXBWTable : public IteratorDictString
+{
+	public:
+		/** String Iterator Constructor for streams of all elements.
+		    @param xbw: the XBW.
+		    @param elements: number of strings in the XBW.
+		    @param maxlength: largest string length.
+		*/
+		IteratorDictStringXBWTable(XBW *xbw, size_t elements, uint maxlength)
+		{
+			this->xbw = xbw;
+			this->maxlength = maxlength;
+
+			this->scanneable = elements;
+			this->processed = 0;
+		}
+
+		/** Checks for non-processed strings in the stream. 
+		    @returns if remains non-processed strings. 
+		*/
+		bool hasNext() { return processed<scanneable; }
+
+		/** Extracts the next string in the stream. 
+		    @param strLen: pointer to the string length.
+		    @returns the next string.
+		*/
+		unsigned char* next(uint *strLen)
+		{
+			// The leaf of the i-th string is the i-th 'maxLabel'
+			uchar *str;
+			processed++;
+			xbw->idToStr(xbw->alpha->select(xbw->maxLabel, processed), strLen, &str, 0);
+			(*strLen)--; str[*strLen] = 0;
+
+			return str;
+		}
+
+		/** Generic destructor. */
+		~IteratorDictStringXBWTable() {}
+
+	protected:
+		XBW *xbw;		// The XBW
+};
+
+#endif  
@@ -0,0 +1,118 @@
+/* WaveletMatrix.h
+ * Copyright (C) 2014, Francisco Claude, all rights reserved.
+ *
+ * WaveletMatrix definition
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef _WVMATRIX_H
+#define _WVMATRIX_H
+
+#include <iostream>
+#include <cassert>
+#include <libcdsBasics.h>
+#include <BitSequence.h>
+#include <BitSequenceBuilder.h>
+#include <Sequence.h>
+#include <Mapper.h>
+
+using namespace std;
+
+namespace cds_static
+{
+
+    /** Wavelet Matrix: the levels of a pointerless wavelet tree are
+     *  stably partitioned (zeros before ones) in a single bitmap per
+     *  level, so each operation only computes one rank/select per level
+     *  and does not need to track the node boundaries.
+     *
+     *  "The Wavelet Matrix", F. Claude, G. Navarro. SPIRE 2012.
+     */
+    class WaveletMatrix : public Sequence
+    {
+        public:
+
+            /** Builds a Wavelet Matrix for the string stored in a.
+             * @param bmb builder for the bitmaps in each level.
+             * @param am alphabet mapper.
+             * */
+            WaveletMatrix(const Array & a, BitSequenceBuilder * bmb, Mapper * am);
+
+            /** Builds a Wavelet Matrix for the string
+             * pointed by symbols assuming its length
+             * equals n and uses bmb to build the bitsequence
+             * @param bmb builder for the bitmaps in each level.
+             * @param am alphabet mapper.
+             * */
+            WaveletMatrix(uint * symbols, size_t n, BitSequenceBuilder * bmb, Mapper * am, bool deleteSymbols = false);
+
+            /** Destroys the Wavelet Matrix */
+            virtual ~WaveletMatrix();
+
+            virtual size_t rank(uint symbol, size_t pos) const;
+            virtual void rankPair(uint symbol, size_t i, size_t j, size_t & ri, size_t & rj) const;
+            virtual size_t select(uint symbol, size_t j) const;
+            virtual uint access(size_t pos) const;
+            virtual uint access(size_t pos, size_t & r) const;
+            virtual size_t getSize() const;
+
+            virtual void save(ofstream & fp) const;
+            static WaveletMatrix * load(ifstream & fp);
+
+        protected:
+            WaveletMatrix();
+
+            Mapper * am;
+            /** One bitmap per level. */
+            BitSequence **bitstring;
+
+            /** Number of zeros in each level. */
+            size_t *zeros;
+
+            /** Position of the first occurrence of each symbol
+             * in the last level (computed on construction). */
+            size_t *starts;
+
+            /** Length of the string. */
+            size_t n;
+
+            /** Height of the Wavelet Matrix. */
+            uint height, max_v;
+
+            /** Builds the levels from the (mapped) symbols, which
+             * are deleted. */
+            void build_levels(uint *symbols, BitSequenceBuilder * bmb);
+
+            /** Computes the starts of the symbols in the last level. */
+            void build_starts();
+
+            /** How many bits are needed to represent val */
+            uint bits(uint val);
+
+            /** Returns true if val has its ind-th bit set
+             * to one. */
+            inline bool is_set(uint val, uint ind) const {
+                return (val & (1<<(height-ind-1)))!=0;
+            }
+
+            /** Number of ones in bitstring[level] before pos */
+            inline size_t ones(uint level, size_t pos) const {
+                return (pos==0)?0:bitstring[level]->rank1(pos-1);
+            }
+    };
+};
+#endif
@@ -114,6 +114,10 @@ namespace cds_static
         return (rank1(i)-(i!=0?rank1(i-1):0))>0;
     }
 
+    void BitSequence::prefetch(const size_t i) const
+    {
+    }
+
     size_t BitSequence::getLength() const
     {
         return length;
@@ -136,6 +140,7 @@ namespace cds_static
         switch(r) {
             case RRR02_HDR: return BitSequenceRRR::load(fp);
             case BRW32_HDR: return BitSequenceRG::load(fp);
+            case CACHELINE_HDR: return BitSequenceCL::load(fp);
             //case RRR02_LIGHT_HDR: return BitSequence_rrr02_light::load(fp);
             case SDARRAY_HDR: return BitSequenceSDArray::load(fp);
 						case DARRAY_HDR: return BitSequenceDArray::load(fp);
@@ -30,6 +30,7 @@
 #define SDARRAY_HDR 5
 #define DARRAY_HDR 6
 #define BRW32_375 7
+#define CACHELINE_HDR 8
 
 #include <libcdsBasics.h>
 #include <Array.h>
@@ -94,6 +95,11 @@ namespace cds_static
             /** Returns the i-th bit */
             virtual bool access(const size_t i) const;
 
+            /** Prefetches the memory read by access(i) and rank1(i), so
+             * the latency of a later query overlaps with other work (the
+             * default implementation does nothing) */
+            virtual void prefetch(const size_t i) const;
+
             /** Returns the length in bits of the bitmap */
             virtual size_t getLength() const;
 
@@ -124,6 +130,7 @@ namespace cds_static
 
 #include<BitSequenceRG.h>
 #include<BitSequence375.h>
+#include<BitSequenceCL.h>
 #include<BitSequenceRRR.h>
 #include<BitSequenceSDArray.h>
 #include<BitSequenceDArray.h>
@@ -54,6 +54,7 @@ namespace cds_static
 
 #include <BitSequenceBuilderRG.h>
 #include <BitSequenceBuilder375.h>
+#include <BitSequenceBuilderCL.h>
 #include <BitSequenceBuilderRRR.h>
 #include <BitSequenceBuilderSDArray.h>
 #include <BitSequenceBuilderDArray.h>
@@ -0,0 +1,34 @@
+/* BitSequenceBuilderCL.cpp
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <BitSequenceBuilderCL.h>
+
+namespace cds_static
+{
+    BitSequence * BitSequenceBuilderCL::build(uint * bitseq, size_t len) const
+    {
+        return new BitSequenceCL(bitseq, len);
+    }
+
+    BitSequence * BitSequenceBuilderCL::build(const BitString & bs) const
+    {
+        return new BitSequenceCL(bs);
+    }
+};
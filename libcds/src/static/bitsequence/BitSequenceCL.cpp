@@ -0,0 +1,285 @@
+/* BitSequenceCL.cpp
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Rank/select bitmap in which the rank counters are interleaved with the
+ * bits, so that a rank query only touches one cache line.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <BitSequenceCL.h>
+#include <vector>
+
+// The popcounts of this file are compiled to the hardware instruction
+// (available in every x86-64 processor since 2008) even when the library
+// is built for a generic target.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__POPCNT__)
+#pragma GCC target("popcnt")
+#endif
+
+namespace cds_static
+{
+    static inline uint popcount64(const uint64_t x) {
+        return __builtin_popcountll(x);
+    }
+
+    /** Position of the x-th one (x>0) in the word w */
+    static inline uint selectWord(uint64_t w, uint x) {
+        uint pos = 0;
+        uint c = popcount64(w & 0xFFFFFFFFULL);
+        if (c < x) { x -= c; w >>= 32; pos += 32; }
+        c = popcount64(w & 0xFFFF);
+        if (c < x) { x -= c; w >>= 16; pos += 16; }
+        c = popcount64(w & 0xFF);
+        if (c < x) { x -= c; w >>= 8; pos += 8; }
+        for (x--; x > 0; x--) w &= w-1;
+        return pos + __builtin_ctzll(w);
+    }
+
+    BitSequenceCL::BitSequenceCL() {
+        lines = buffer = NULL;
+        blocks = 0;
+        samples1 = samples0 = NULL;
+        nsamples1 = nsamples0 = 0;
+        length = ones = 0;
+    }
+
+    BitSequenceCL::BitSequenceCL(const uint *bitarray, size_t n) {
+        build(bitarray, n);
+    }
+
+    BitSequenceCL::BitSequenceCL(const BitString & bs) {
+        build(bs.getData(), bs.getLength());
+    }
+
+    BitSequenceCL::~BitSequenceCL() {
+        delete [] buffer;
+        delete [] samples1;
+        delete [] samples0;
+    }
+
+    void BitSequenceCL::allocate(size_t blocks) {
+        this->blocks = blocks;
+        buffer = new uint64_t[blocks*CL_WORDS+CL_WORDS-1];
+        size_t misalignment = ((size_t)buffer) % (CL_WORDS*sizeof(uint64_t));
+        lines = buffer + (misalignment ? (CL_WORDS*sizeof(uint64_t)-misalignment)/sizeof(uint64_t) : 0);
+        for (size_t i=0; i<blocks*CL_WORDS; i++) lines[i] = 0;
+    }
+
+    void BitSequenceCL::build(const uint *bitarray, size_t n) {
+        length = n;
+        allocate(n/CL_BITS+1);
+
+        // 32-bit words never straddle a 64-bit word (nor a block)
+        size_t integers = uint_len(n,1);
+        for (size_t j=0; j<integers; j++) {
+            uint value = bitarray[j];
+            if ((j == integers-1) && (n%W != 0)) value &= (1u << (n%W))-1;
+
+            size_t offset = (j*W) % CL_BITS;
+            lines[((j*W)/CL_BITS)*CL_WORDS + 1 + offset/64] |= ((uint64_t)value) << (offset%64);
+        }
+
+        // Headers
+        uint64_t total = 0;
+        for (size_t b=0; b<blocks; b++) {
+            uint64_t *line = lines+b*CL_WORDS;
+            uint64_t header = total << 27;
+            uint sub = 0;
+
+            for (uint w=0; w<CL_WORDS-1; w++) {
+                if ((w > 0) && (w%2 == 0)) header |= ((uint64_t)sub) << (9*(w/2-1));
+                sub += popcount64(line[1+w]);
+            }
+
+            line[0] = header;
+            total += sub;
+        }
+        ones = total;
+
+        buildSamples();
+    }
+
+    void BitSequenceCL::buildSamples() {
+        // The block of every CL_SAMPLE-th one and zero
+        vector<size_t> s1, s0;
+        size_t next1 = 1, next0 = 1;
+        for (size_t b=0; b<blocks; b++) {
+            size_t end = (b+1 < blocks) ? onesBefore(b+1) : ones;
+            size_t bits = (length > (b+1)*CL_BITS) ? CL_BITS : length-b*CL_BITS;
+            size_t endZeros = zerosBefore(b) + bits - (end-onesBefore(b));
+
+            for (; next1 <= end; next1 += CL_SAMPLE) s1.push_back(b);
+            for (; next0 <= endZeros; next0 += CL_SAMPLE) s0.push_back(b);
+        }
+
+        nsamples1 = s1.size();
+        samples1 = new size_t[nsamples1+1];
+        for (size_t i=0; i<nsamples1; i++) samples1[i] = s1[i];
+
+        nsamples0 = s0.size();
+        samples0 = new size_t[nsamples0+1];
+        for (size_t i=0; i<nsamples0; i++) samples0[i] = s0[i];
+    }
+
+    size_t BitSequenceCL::rank(const size_t p) const
+    {
+        size_t r = p % CL_BITS;
+        const uint64_t *line = lines + (p/CL_BITS)*CL_WORDS;
+        uint64_t header = line[0];
+        uint w = r/64;
+
+        size_t res = header >> 27;
+        if (w >= 2) res += (header >> (9*(w/2-1))) & 511;
+        if (w & 1) res += popcount64(line[w]);
+        return res + popcount64(line[1+w] & ((1ULL << (r%64))-1));
+    }
+
+    bool BitSequenceCL::access(const size_t i) const
+    {
+        size_t r = i % CL_BITS;
+        return (lines[(i/CL_BITS)*CL_WORDS + 1 + r/64] >> (r%64)) & 1;
+    }
+
+    void BitSequenceCL::prefetch(const size_t i) const
+    {
+        // The header and the bits of a position share a single line
+        __builtin_prefetch(lines + (i/CL_BITS)*CL_WORDS);
+    }
+
+    size_t BitSequenceCL::rank1(const size_t i) const
+    {
+        return rank(i+1);
+    }
+
+    size_t BitSequenceCL::rank0(const size_t i) const
+    {
+        return i+1-rank(i+1);
+    }
+
+    size_t BitSequenceCL::selectBlock1(const size_t b, size_t x) const
+    {
+        const uint64_t *line = lines + b*CL_WORDS;
+        uint64_t header = line[0];
+        uint w = 0;
+
+        for (uint k=3; k>0; k--) {
+            size_t sub = (header >> (9*(k-1))) & 511;
+            if (sub < x) { x -= sub; w = 2*k; break; }
+        }
+
+        uint c = popcount64(line[1+w]);
+        if (c < x) { x -= c; w++; }
+        return w*64 + selectWord(line[1+w], x);
+    }
+
+    size_t BitSequenceCL::selectBlock0(const size_t b, size_t x) const
+    {
+        const uint64_t *line = lines + b*CL_WORDS;
+        uint64_t header = line[0];
+        uint w = 0;
+
+        for (uint k=3; k>0; k--) {
+            size_t sub = 128*k - ((header >> (9*(k-1))) & 511);
+            if (sub < x) { x -= sub; w = 2*k; break; }
+        }
+
+        uint c = 64 - popcount64(line[1+w]);
+        if (c < x) { x -= c; w++; }
+        return w*64 + selectWord(~line[1+w], x);
+    }
+
+    size_t BitSequenceCL::select1(const size_t i) const
+    {
+        if ((i == 0) || (i > ones)) return (size_t)-1;
+
+        // The block is the last one with less than i ones before it
+        size_t k = (i-1)/CL_SAMPLE;
+        size_t lo = samples1[k];
+        size_t hi = (k+1 < nsamples1) ? samples1[k+1] : blocks-1;
+        while (lo < hi) {
+            size_t mid = (lo+hi+1)/2;
+            if (onesBefore(mid) < i) lo = mid;
+            else hi = mid-1;
+        }
+
+        return lo*CL_BITS + selectBlock1(lo, i-onesBefore(lo));
+    }
+
+    size_t BitSequenceCL::select0(const size_t i) const
+    {
+        if ((i == 0) || (i > length-ones)) return (size_t)-1;
+
+        size_t k = (i-1)/CL_SAMPLE;
+        size_t lo = samples0[k];
+        size_t hi = (k+1 < nsamples0) ? samples0[k+1] : blocks-1;
+        while (lo < hi) {
+            size_t mid = (lo+hi+1)/2;
+            if (zerosBefore(mid) < i) lo = mid;
+            else hi = mid-1;
+        }
+
+        return lo*CL_BITS + selectBlock0(lo, i-zerosBefore(lo));
+    }
+
+    size_t BitSequenceCL::selectNext1(const size_t i) const
+    {
+        if (i >= length) return length;
+
+        // Ones in the same word are found without any rank
+        size_t r = i % CL_BITS;
+        uint64_t word = lines[(i/CL_BITS)*CL_WORDS + 1 + r/64] & (~0ULL << (r%64));
+        if (word) return i - r%64 + __builtin_ctzll(word);
+
+        size_t next = rank(i)+1;
+        if (next > ones) return length;
+        return select1(next);
+    }
+
+    size_t BitSequenceCL::getSize() const
+    {
+        return sizeof(BitSequenceCL) + blocks*CL_WORDS*sizeof(uint64_t) + (nsamples1+nsamples0)*sizeof(size_t);
+    }
+
+    void BitSequenceCL::save(ofstream & f) const
+    {
+        uint wr = CACHELINE_HDR;
+        saveValue(f,wr);
+        saveValue<size_t>(f,length);
+        saveValue<size_t>(f,blocks);
+        saveValue(f,lines,blocks*CL_WORDS);
+    }
+
+    BitSequenceCL * BitSequenceCL::load(ifstream & f)
+    {
+        assert(f.good());
+        uint type = loadValue<uint>(f);
+        if (type != CACHELINE_HDR) {
+            abort();
+        }
+
+        BitSequenceCL * ret = new BitSequenceCL();
+        ret->length = loadValue<size_t>(f);
+        ret->allocate(loadValue<size_t>(f));
+        f.read((char*)ret->lines, ret->blocks*CL_WORDS*sizeof(uint64_t));
+
+        // Only the select samples are rebuilt (the headers are stored)
+        ret->ones = ret->rank(ret->length);
+        ret->buildSamples();
+        return ret;
+    }
+};
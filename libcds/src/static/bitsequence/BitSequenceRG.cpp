@@ -146,6 +146,12 @@ namespace cds_static
         return (1u << (i % W)) & data[i/W];
     }
 
+    void BitSequenceRG::prefetch(const size_t i) const
+    {
+        __builtin_prefetch(data+i/W);
+        __builtin_prefetch(Rs+(i+1)/s);
+    }
+
     void BitSequenceRG::save(ofstream & f) const
     {
         uint wr = BRW32_HDR;
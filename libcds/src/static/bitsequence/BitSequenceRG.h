@@ -79,6 +79,7 @@ namespace cds_static
             ~BitSequenceRG();    //destructor
             
             virtual bool access(const size_t i) const;
+            virtual void prefetch(const size_t i) const;
                                  //Nivel 1 bin, nivel 2 sec-pop y nivel 3 sec-bit
             virtual size_t rank1(const size_t i) const;
 
@@ -35,6 +35,12 @@ namespace cds_static
         return count;
     }
 
+    void Sequence::rankPair(uint c, size_t i, size_t j, size_t & ri, size_t & rj) const
+    {
+        ri = (i==(size_t)-1)?0:rank(c,i);
+        rj = rank(c,j);
+    }
+
     size_t Sequence::select(uint c, size_t j) const
     {
         size_t count = 0;
@@ -80,6 +86,7 @@ namespace cds_static
 	    case BS_HDR: return BitmapsSequence::load(fp);
 	    case WVTREE_HDR: return WaveletTree::load(fp);
 	    case WVTREE_NOPTRS_HDR: return WaveletTreeNoptrs::load(fp);
+	    case WVMATRIX_HDR: return WaveletMatrix::load(fp);
 	}
         return NULL;
     }
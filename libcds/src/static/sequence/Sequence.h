@@ -37,6 +37,7 @@ namespace cds_static
     #define GMR_HDR 4
     #define GMR_CHUNK_HDR 5
     #define ALPHPART_HDR 6
+    #define WVMATRIX_HDR 7
 
     /** Sequence base class
      *
@@ -54,6 +55,13 @@ namespace cds_static
              */
             virtual size_t rank(uint c, size_t i) const;
 
+            /** Counts the occurrences of c up to positions i and j
+             * (included) at once, which is cheaper than two ranks in
+             * those sequences sharing work between both (i may be
+             * (size_t)-1, then ri=0).
+             */
+            virtual void rankPair(uint c, size_t i, size_t j, size_t & ri, size_t & rj) const;
+
             /** Retrieve the i-th position where c appears.
              * It returns (size_t)-1 if i=0 and length if the number of 
              * c's is less than i
@@ -99,6 +107,7 @@ namespace cds_static
 #include <BitmapsSequence.h>
 #include <WaveletTree.h>
 #include <WaveletTreeNoptrs.h>
+#include <WaveletMatrix.h>
 #include <SequenceGMR.h>
 #include <SequenceGMRChunk.h>
 #include <SequenceAlphPart.h>
@@ -42,6 +42,7 @@ namespace cds_static {
 };
 
 #include <SequenceBuilderWaveletTreeNoptrs.h>
+#include <SequenceBuilderWaveletMatrix.h>
 #include <SequenceBuilderGMRChunk.h>
 #include <SequenceBuilderGMR.h>
 #include <SequenceBuilderAlphPart.h>
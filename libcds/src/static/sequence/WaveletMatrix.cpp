@@ -0,0 +1,268 @@
+/* WaveletMatrix.cpp
+ * Copyright (C) 2014, Francisco Claude, all rights reserved.
+ *
+ * WaveletMatrix definition
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <WaveletMatrix.h>
+
+namespace cds_static
+{
+    WaveletMatrix::WaveletMatrix(const Array & a, BitSequenceBuilder * bmb, Mapper * am) : Sequence(0) {
+        bmb->use();
+        this->n=a.getLength();
+        this->length = n;
+        this->am=am;
+        am->use();
+        uint * symbols = new uint[n];
+        max_v = 0;
+        for(size_t i=0;i<n;i++) {
+            symbols[i] = am->map(a[i]);
+            max_v = max(symbols[i],max_v);
+        }
+        height=bits(max_v);
+        build_levels(symbols,bmb);
+        build_starts();
+        bmb->unuse();
+    }
+
+    WaveletMatrix::WaveletMatrix(uint * symbols, size_t n, BitSequenceBuilder * bmb, Mapper * am, bool deleteSymbols) : Sequence(n) {
+        bmb->use();
+        this->n=n;
+        this->am=am;
+        am->use();
+        uint * mapped = new uint[n];
+        max_v = 0;
+        for(size_t i=0;i<n;i++) {
+            mapped[i] = am->map(symbols[i]);
+            max_v = max(mapped[i],max_v);
+        }
+        if (deleteSymbols) {
+            delete [] symbols;
+            symbols = 0;
+        }
+        height=bits(max_v);
+        build_levels(mapped,bmb);
+        build_starts();
+        bmb->unuse();
+    }
+
+    WaveletMatrix::WaveletMatrix():Sequence(0) {
+        bitstring = NULL;
+        zeros = NULL;
+        starts = NULL;
+        am = NULL;
+    }
+
+    WaveletMatrix::~WaveletMatrix() {
+        if(bitstring) {
+            for(uint i=0;i<height;i++)
+                if(bitstring[i])
+                    delete bitstring[i];
+            delete [] bitstring;
+        }
+        if(zeros)
+            delete [] zeros;
+        if(starts)
+            delete [] starts;
+        if(am)
+            am->unuse();
+    }
+
+    void WaveletMatrix::build_levels(uint *symbols, BitSequenceBuilder * bmb) {
+        bitstring = new BitSequence*[height];
+        zeros = new size_t[height];
+        uint * next = new uint[n];
+        uint * bm = new uint[n/W+1];
+        for(uint level=0;level<height;level++) {
+            for(size_t i=0;i<n/W+1;i++)
+                bm[i] = 0;
+            size_t cleft = 0;
+            for(size_t i=0;i<n;i++)
+                if(!is_set(symbols[i],level))
+                    cleft++;
+            // Stable partition: zeros first, ones after them
+            size_t pleft = 0, pright = cleft;
+            for(size_t i=0;i<n;i++) {
+                if(is_set(symbols[i],level)) {
+                    bitset(bm,i);
+                    next[pright++] = symbols[i];
+                }
+                else next[pleft++] = symbols[i];
+            }
+            bitstring[level] = bmb->build(bm,n);
+            zeros[level] = cleft;
+            swap(symbols,next);
+        }
+        delete [] bm;
+        delete [] next;
+        delete [] symbols;
+    }
+
+    void WaveletMatrix::build_starts() {
+        starts = new size_t[max_v+1];
+        for(uint c=0;c<=max_v;c++) {
+            size_t sp = 0;
+            for(uint level=0;level<height;level++) {
+                if(is_set(c,level)) sp = zeros[level]+ones(level,sp);
+                else sp -= ones(level,sp);
+            }
+            starts[c] = sp;
+        }
+    }
+
+    void WaveletMatrix::save(ofstream & fp) const
+    {
+        uint wr = WVMATRIX_HDR;
+        saveValue(fp,wr);
+        saveValue<size_t>(fp,n);
+        saveValue(fp,max_v);
+        saveValue(fp,height);
+        am->save(fp);
+        saveValue<size_t>(fp,zeros,height);
+        for(uint i=0;i<height;i++)
+            bitstring[i]->save(fp);
+    }
+
+    WaveletMatrix * WaveletMatrix::load(ifstream & fp) {
+        uint rd = loadValue<uint>(fp);
+        if(rd!=WVMATRIX_HDR) return NULL;
+        WaveletMatrix * ret = new WaveletMatrix();
+        ret->n = loadValue<size_t>(fp);
+        ret->length = ret->n;
+        ret->max_v = loadValue<uint>(fp);
+        ret->height = loadValue<uint>(fp);
+        ret->am = Mapper::load(fp);
+        if(ret->am==NULL) {
+            delete ret;
+            return NULL;
+        }
+        ret->am->use();
+        ret->zeros = loadValue<size_t>(fp,ret->height);
+        ret->bitstring = new BitSequence*[ret->height];
+        for(uint i=0;i<ret->height;i++) 
+            ret->bitstring[i] = NULL;
+        for(uint i=0;i<ret->height;i++) {
+            ret->bitstring[i] = BitSequence::load(fp);
+            if(ret->bitstring[i]==NULL) {
+                delete ret;
+                return NULL;
+            }
+        }
+        ret->build_starts();
+        return ret;
+    }
+
+    uint WaveletMatrix::access(size_t pos) const
+    {
+        uint ret=0;
+        for(uint level=0;level<height;level++) {
+            ret <<= 1;
+            if(bitstring[level]->access(pos)) {
+                ret |= 1;
+                pos = zeros[level]+ones(level,pos);
+            }
+            else pos -= ones(level,pos);
+        }
+        return am->unmap(ret);
+    }
+
+    uint WaveletMatrix::access(size_t pos, size_t & r) const
+    {
+        uint ret=0;
+        for(uint level=0;level<height;level++) {
+            ret <<= 1;
+            if(bitstring[level]->access(pos)) {
+                ret |= 1;
+                pos = zeros[level]+ones(level,pos);
+            }
+            else pos -= ones(level,pos);
+        }
+        r = pos-starts[ret]+1;
+        return am->unmap(ret);
+    }
+
+    size_t WaveletMatrix::rank(uint symbol, size_t pos) const
+    {
+        symbol = am->map(symbol);
+        if(symbol>max_v) return 0;
+        // Works on the exclusive end (0 for pos=(size_t)-1)
+        size_t end = min(pos+1,n);
+        for(uint level=0;level<height;level++) {
+            if(is_set(symbol,level)) end = zeros[level]+ones(level,end);
+            else end -= ones(level,end);
+        }
+        return end-starts[symbol];
+    }
+
+    void WaveletMatrix::rankPair(uint symbol, size_t i, size_t j, size_t & ri, size_t & rj) const
+    {
+        symbol = am->map(symbol);
+        if(symbol>max_v) {
+            ri = rj = 0;
+            return;
+        }
+        size_t endi = min(i+1,n);
+        size_t endj = min(j+1,n);
+        for(uint level=0;level<height;level++) {
+            if(is_set(symbol,level)) {
+                endi = zeros[level]+ones(level,endi);
+                endj = zeros[level]+ones(level,endj);
+            }
+            else {
+                endi -= ones(level,endi);
+                endj -= ones(level,endj);
+            }
+        }
+        ri = endi-starts[symbol];
+        rj = endj-starts[symbol];
+    }
+
+    size_t WaveletMatrix::select(uint symbol, size_t j) const
+    {
+        if(j==0) return (size_t)-1;
+        symbol = am->map(symbol);
+        if(symbol>max_v) return n;
+        if(j>rank(am->unmap(symbol),n-1)) return n;
+        size_t pos = starts[symbol]+j-1;
+        for(uint level=height;level-->0;) {
+            if(is_set(symbol,level)) pos = bitstring[level]->select1(pos-zeros[level]+1);
+            else pos = bitstring[level]->select0(pos+1);
+        }
+        return pos;
+    }
+
+    size_t WaveletMatrix::getSize() const
+    {
+        size_t ptrs = sizeof(WaveletMatrix)+height*(sizeof(BitSequence*)+sizeof(size_t));
+        size_t bytesBitstrings = 0;
+        for(uint i=0;i<height;i++)
+            bytesBitstrings += bitstring[i]->getSize();
+        return bytesBitstrings+ptrs+(max_v+1)*sizeof(size_t);
+    }
+
+    uint WaveletMatrix::bits(uint val) {
+        uint ret = 0;
+        while(val!=0) {
+            ret++;
+            val >>= 1;
+        }
+        return ret;
+    }
+
+};
@@ -89,6 +89,15 @@ int main(int argc, char ** argv) {
 	cout << "RG OK\n" << endl; 
   delete (BitSequenceRG *)s;
 
+	BitSequenceCL bsCL(a);
+	s = saveLoad(&bsCL);
+	if(!testBitSequence(a,s)) {
+		cerr << "ERROR TESTING BitSequenceCL" << endl;
+		return -1;
+	}
+	cout << "CL OK\n" << endl; 
+	delete (BitSequenceCL *)s;
+
 	BitSequenceDArray bsDArray(a);
 	s = saveLoad(&bsDArray);
 	if(!testBitSequence(a,s)) {
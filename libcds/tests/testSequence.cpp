@@ -31,6 +31,14 @@ void testSequence(Array & a, Sequence & bs) {
                 exit(-1);
             }
         }
+        size_t ri, rj;
+        seq->rankPair(a[i],i-1,i,ri,rj);
+        if(ri!=count[a[i]]-1 || rj!=count[a[i]]) {
+            cerr << "ERROR RANKPAIR " << endl;
+            cerr << " RankPair result: " << ri << "," << rj << " count=" << count[a[i]] << endl;
+            cerr << " symbol=" << a[i] << " position=" << i << endl;
+            exit(-4);
+        }
         if(seq->select(a[i],count[a[i]])!=i) {
             cerr << "ERROR SELECT " << endl;
             cerr << "a[i]=" << a[i] << " maxv=" << maxv << endl;
@@ -81,6 +89,16 @@ int main(int argc, char ** argv) {
   WaveletTreeNoptrs wt3(a, new BitSequenceBuilderRRR(32), mapper);
   cout << "bs.size() = " << wt3.getSize() << endl;
   testSequence(a, wt3);
+
+  cout << "Test 3 : Wavelet matrix" << endl;
+  WaveletMatrix wm1(a, new BitSequenceBuilderRG(20), mapper2);
+  cout << "bs.size() = " << wm1.getSize() << endl;
+  testSequence(a, wm1);
+
+  cout << "Test 4 : Wavelet matrix (mapped alphabet)" << endl;
+  WaveletMatrix wm2(a, new BitSequenceBuilderRRR(32), mapper);
+  cout << "bs.size() = " << wm2.getSize() << endl;
+  testSequence(a, wm2);
   mapper->unuse();
   mapper2->unuse();
   return 0;
@@ -0,0 +1,141 @@
+/* ByteArena.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Growable byte buffer owned by the caller. It is used for extracting
+ * batches of strings without performing an allocation per string: the
+ * strings are appended ('\0'-terminated) and referenced by offsets, so
+ * the buffer can be reused (clear) across batches.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+
+#ifndef _BYTEARENA_H
+#define _BYTEARENA_H
+
+#include <string.h>
+
+#include <libcdsBasics.h>
+using namespace cds_utils;
+
+class ByteArena
+{
+	public:
+		/** Generic constructor.
+		    @param capacity: initial capacity (in bytes).
+		*/
+		ByteArena(size_t capacity=4096)
+		{
+			this->capacity = (capacity > 0) ? capacity : 1;
+			this->length = 0;
+			this->data = new uchar[this->capacity];
+		}
+
+		/** Ensures room for writing (at least) len bytes at the end of
+		    the arena. The returned pointer is valid until the next call
+		    modifying the arena.
+		    @param len: number of bytes to be written.
+		    @returns a pointer to the first free byte.
+		*/
+		uchar *reserve(size_t len)
+		{
+			if (length+len > capacity)
+			{
+				size_t ncapacity = 2*capacity;
+				while (length+len > ncapacity) ncapacity *= 2;
+
+				uchar *ndata = new uchar[ncapacity];
+				memcpy(ndata, data, length);
+				delete [] data;
+
+				data = ndata;
+				capacity = ncapacity;
+			}
+
+			return data+length;
+		}
+
+		/** Commits len bytes previously written on the reserved room.
+		    @param len: number of bytes written.
+		*/
+		void advance(size_t len)
+		{
+			length += len;
+		}
+
+		/** Appends a string (and its '\0' terminator) to the arena.
+		    @param str: the string.
+		    @param len: the string length.
+		    @returns the offset of the string in the arena.
+		*/
+		size_t append(const uchar *str, uint len)
+		{
+			uchar *ptr = reserve(len+1);
+			memcpy(ptr, str, len);
+			ptr[len] = '\0';
+
+			size_t offset = length;
+			length += len+1;
+			return offset;
+		}
+
+		/** Obtains the arena contents.
+		    @returns a pointer to the first byte.
+		*/
+		uchar *getData()
+		{
+			return data;
+		}
+
+		/** Obtains the number of bytes used in the arena.
+		    @returns the arena length.
+		*/
+		size_t getLength()
+		{
+			return length;
+		}
+
+		/** Empties the arena (its memory is kept for reuse). */
+		void clear()
+		{
+			length = 0;
+		}
+
+		/** Generic destructor. */
+		~ByteArena()
+		{
+			delete [] data;
+		}
+
+	protected:
+		uchar *data;		//! Arena contents
+		size_t length;		//! Number of used bytes
+		size_t capacity;	//! Number of allocated bytes
+
+	private:
+		/** The arena owns its contents, so it cannot be copied. */
+		ByteArena(const ByteArena &);
+		ByteArena &operator=(const ByteArena &);
+};
+
+#endif  /* _BYTEARENA_H */
+
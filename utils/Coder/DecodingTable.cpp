@@ -31,20 +31,20 @@
 void
 DecodingTable::setDecodingTable(uint k, DecodeableSubstr* substrs)
 {
-	assert (k <= MAXK);
+	assert ((k >= MINK) && (k <= MAXK));
 
 	this->k = k;
 	this->bytesStream = 0;
 
 	// Scanning the table and building its compact representation
-	uint entries = pow(2, this->k);
-	endings = new BitString(entries);
+	uint chunks = pow(2, this->k);
+	BitString *endings = new BitString(chunks);
 
 	map<vector<uchar>, uint> tmp;
 	map<vector<uchar>, uint>::iterator it;
 
 	// Collecting all different decodeable substrings in the representation
-	for (uint i=0; i<entries; i++)
+	for (uint i=0; i<chunks; i++)
 	{
 		if (substrs[i].length > 0)
 		{
@@ -71,14 +71,14 @@ DecodingTable::setDecodingTable(uint k, DecodeableSubstr* substrs)
 		}
 	}
 
-	table = new uint[entries];
+	uint *table = new uint[chunks];
 
-	size_t reservedStream = entries;
+	size_t reservedStream = chunks;
 	stream = new uchar[reservedStream];
 	stream[bytesStream] = (uchar)0; bytesStream++;
 
 	// Serializing the table
-	for (uint i=0; i<entries; i++)
+	for (uint i=0; i<chunks; i++)
 	{
 		if (substrs[i].dbits > 0)
 		{
@@ -122,6 +122,42 @@ DecodingTable::setDecodingTable(uint k, DecodeableSubstr* substrs)
 		}
 		else table[i] = 0;
 	}
+
+	buildEntries(table, endings);
+
+	delete [] table;
+	delete endings;
+}
+
+void
+DecodingTable::buildEntries(uint *table, BitString *endings)
+{
+	uint size = pow(2, k);
+	entries = new Entry[size];
+
+	for (uint i=0; i<size; i++)
+	{
+		uint position = table[i];
+		uint length, bits;
+		decodeInfo(stream[position], &length, &bits);
+
+		Entry entry;
+		memset(&entry, 0, sizeof(Entry));
+		entry.length = length;
+		entry.bits = bits;
+
+		if ((length > 0) && endings->getBit(i))
+			entry.ending = strlen((char*)&(stream[position+1]))+1;
+
+		if ((length > 0) && (length <= INLINESYMBOLS))
+		{
+			entry.inlined = 1;
+			memcpy(entry.symbols, &(stream[position+1]), length);
+		}
+		else memcpy(entry.symbols, &position, sizeof(uint));
+
+		entries[i] = entry;
+	}
 }
 
 uint
@@ -132,19 +168,19 @@ DecodingTable::setDecodingSubtree(DecodingTree *tree)
 }
 
 bool
-DecodingTable::getSubstring(ChunkScan *c)
+DecodingTable::getSubstring(ChunkScan *c) const
 {
 	uint index = (uint)((c->c_chunk >> (c->c_valid-k)) & mask(k));
-
-	uint position = table[index];
-	Entry x = ventry[stream[position]];
+	const Entry &x = entries[index];
 
 	if (x.length != 0)
 	{
 		c->c_valid -= x.bits;
-		position++;
 
-		for (uint i=0; i<x.length; i++) { c->str[c->strLen+i] = stream[position+i]; }
+		// The strings are allocated with (at least) k extra bytes, so
+		// the inlined symbols are always copied at once
+		if (x.inlined) memcpy(c->str+c->strLen, x.symbols, INLINESYMBOLS);
+		else memcpy(c->str+c->strLen, &(stream[getPosition(x)+1]), x.length);
 		c->extracted += x.length;
 
 		if (c->extracted <= 2)
@@ -155,12 +191,10 @@ DecodingTable::getSubstring(ChunkScan *c)
 		}
 		else
 		{
-			if (endings->getBit(index))
+			if (x.ending != 0)
 			{
-				uint substrLen = strlen((char*)&(stream[position]))+1;
-
-				c->strLen += substrLen;
-				c->advanced = x.length-substrLen;
+				c->strLen += x.ending;
+				c->advanced = x.length-x.ending;
 				return true;
 			}
 			else
@@ -176,10 +210,8 @@ DecodingTable::getSubstring(ChunkScan *c)
 		// The current index prefixes a large codeword: the 
 		// corresponding subtree must be traversed for decoding the 
 		// symbol
-		position++;
-
 		uint idTree;
-		VByte::decode(&idTree, &(stream[position]));
+		VByte::decode(&idTree, &(stream[getPosition(x)+1]));
 
 		DecodingTree *tree = subtrees[idTree];
 		TreeNode node = tree->tree[0];
@@ -211,8 +243,26 @@ DecodingTable::getSubstring(ChunkScan *c)
 
 
 bool
-DecodingTable::processChunk(ChunkScan *c)
+DecodingTable::processChunk(ChunkScan *c) const
 {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	if ((c->c_valid < k) && (c->b_remain >= sizeof(uint64_t)))
+	{
+		// All the whole bytes fitting in the chunk are refilled from a
+		// single (big-endian) 64-bit load
+		uint bytes = (64-c->c_valid)/8;
+
+		uint64_t word;
+		memcpy(&word, c->b_ptr, sizeof(uint64_t));
+		word = __builtin_bswap64(word);
+
+		if (bytes == sizeof(uint64_t)) c->c_chunk = word;
+		else c->c_chunk = (c->c_chunk << (8*bytes)) | (word >> (64-8*bytes));
+
+		c->c_valid += 8*bytes; c->b_ptr += bytes; c->b_remain -= bytes;
+	}
+#endif
+
 	while (c->c_valid < k)
 	{
 		if (c->b_remain == 0)
@@ -235,27 +285,70 @@ DecodingTable::processChunk(ChunkScan *c)
 }
 
 size_t 
-DecodingTable::getSize()
+DecodingTable::getSize() const
 {
 	uint treesize = 0;
 	for (uint i=0; i<nodes; i++) treesize += subtrees[i]->getSize();
 
-	return pow(2,k)*sizeof(uint)+bytesStream*sizeof(uchar)+endings->getSize()+treesize+sizeof(DecodingTable);
+	return pow(2,k)*sizeof(Entry)+bytesStream*sizeof(uchar)+treesize+sizeof(DecodingTable);
 }
 
 void 
 DecodingTable::save(ofstream &out)
 {
+	uint size = pow(2, k);
+
+	// The regular substrings are located in the stream (together with
+	// their control byte) for recovering the serialized table
+	map<vector<uchar>, uint> positions;
+
+	for (uint position=1; position<bytesStream; )
+	{
+		uint length, bits;
+		decodeInfo(stream[position], &length, &bits);
+
+		if (length > 0)
+		{
+			vector<uchar> substr(stream+position, stream+position+1+length);
+			positions.insert(pair<vector<uchar>, uint> (substr, position));
+			position += 1+length;
+		}
+		else
+		{
+			uint ptr;
+			position += 1+VByte::decode(&ptr, &(stream[position+1]));
+		}
+	}
+
+	uint *table = new uint[size];
+	BitString *endings = new BitString(size);
+
+	for (uint i=0; i<size; i++)
+	{
+		if (entries[i].inlined)
+		{
+			vector<uchar> substr(1, encodeInfo(entries[i].length, entries[i].bits));
+			substr.insert(substr.end(), entries[i].symbols, entries[i].symbols+entries[i].length);
+			table[i] = positions[substr];
+		}
+		else table[i] = getPosition(entries[i]);
+
+		if (entries[i].ending != 0) endings->setBit(i);
+	}
+
 	saveValue<uint32_t>(out, k);
 
 	saveValue<uint64_t>(out, bytesStream);
 	saveValue<uchar>(out, stream, bytesStream);
 
-	saveValue<uint>(out, table, pow(2, k));
+	saveValue<uint>(out, table, size);
 	endings->save(out);
 	saveValue<uint32_t>(out, nodes);
 
 	for (uint i=0; i<nodes; i++) subtrees[i]->save(out);
+
+	delete [] table;
+	delete endings;
 }
 
 
@@ -268,19 +361,16 @@ DecodingTable::load(ifstream &in)
 	table->bytesStream = loadValue<uint64_t>(in);
 	table->stream = loadValue<uchar>(in, table->bytesStream);
 
-	table->table = loadValue<uint>(in, pow(2, table->k));
-	table->endings = new BitString(in);
+	uint *positions = loadValue<uint>(in, pow(2, table->k));
+	BitString *endings = new BitString(in);
+	table->buildEntries(positions, endings);
+	delete [] positions;
+	delete endings;
 
 	table->nodes = loadValue<uint32_t>(in);
 	table->subtrees = new DecodingTree*[table->nodes];
 	for (uint i=0; i<table->nodes; i++) table->subtrees[i]=DecodingTree::load(in);
 
-	for (uint i=0; i<255; i++)
-	{
-		table->ventry[i].length = ((i & 240) >> 4);
-		table->ventry[i].bits = ((i & 15)+1);;
-	}
-
 	return table;
 }
 
@@ -292,7 +382,7 @@ DecodingTable::encodeInfo(uint length, uint bits)
 }
 
 inline void
-DecodingTable::decodeInfo(uchar code, uint *length, uint *bits)
+DecodingTable::decodeInfo(uchar code, uint *length, uint *bits) const
 {
 	*length = ((code & 240) >> 4);
 	*bits = ((code & 15)+1);
@@ -301,8 +391,7 @@ DecodingTable::decodeInfo(uchar code, uint *length, uint *bits)
 DecodingTable::~DecodingTable()
 {
 	delete [] stream;
-	delete [] table; 
-	delete endings;
+	delete [] entries;
 
 	for (uint i=0; i<nodes; i++) delete subtrees[i];
 	delete [] subtrees;
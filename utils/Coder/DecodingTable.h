@@ -38,7 +38,17 @@
  * representing the pointer to the corresponding node in the code tree. These
  * pointer is encoded (using VByte) in the following c bytes.
  *
- * This structure must be used with values of k <= 16.
+ * The table and the stream are the serialized representation. In memory, 
+ * each k-bit chunk is decoded through a fixed-width entry (8 bytes) storing
+ * the control information and, for substrings of up to INLINESYMBOLS chars,
+ * the substring itself; so most lookups need a single memory access and the
+ * chars are copied at once. Longer substrings and large codewords keep
+ * their position in the stream.
+ *
+ * The compressed text is refilled 64 bits at a time, so the decoding table
+ * can use any value MINK <= k <= MAXK. Small values of k fit the table in
+ * the L1/L2 caches, and large values decode more chars per lookup.
+ *
  *
  * This library is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
@@ -85,7 +95,9 @@ using namespace cds_utils;
 #include "../Utils.h"
 
 #define MAXK 16
+#define MINK 8
 #define CHNK 16
+#define INLINESYMBOLS 6
 
 class DecodeableSubstr
 {
@@ -187,7 +199,7 @@ class DecodeableSubstr
 
 
 struct ChunkScan {
-	uint c_chunk;		// Bytes to be currently processed
+	uint64_t c_chunk;	// Bytes to be currently processed
 	ushort c_valid;		// Number of 'valid' bits in the current chunk
 
 	uchar *b_ptr;		// Pointer to the current byte in the dictionary chunk
@@ -202,8 +214,11 @@ struct ChunkScan {
 class DecodingTable
 {	
 	struct Entry {
-	   ushort length; 	// Number of symbols
-	   ushort bits;		// Number of processed bits
+	   ushort length : 4; 	// Number of symbols (0 for large codewords)
+	   ushort bits : 5;	// Number of processed bits
+	   ushort ending : 4;	// Symbols up to the '\0' (included), or 0 if there is no '\0'
+	   ushort inlined : 1;	// Tells if the symbols are stored in the entry
+	   uchar symbols[INLINESYMBOLS];	// The symbols (or their position in the stream)
 	};
 
 	public:
@@ -214,7 +229,7 @@ class DecodingTable
 		DecodingTable(uint sigma) { this->nodes = 0; this->subtrees = new DecodingTree*[sigma]; };
 
 		/** @returns the chunk length used in the table */
-		uint getK() { return k; }
+		uint getK() const { return k; }
 
 		/** Set the decoding table.
 		    @param k: number of bits used in the chunk used for 
@@ -236,12 +251,12 @@ class DecodingTable
  		    @c: pointer to the scanning data
 		    @returns a boolean value telling if the susbtring contains '\0'.
 		*/
-		bool processChunk(ChunkScan *c);
+		bool processChunk(ChunkScan *c) const;
 
 		/** Computes the size of the structure in bytes. 
 		    @returns the dictionary size in bytes.
 		*/
-		size_t getSize();
+		size_t getSize() const;
 
 		/** Stores the decoding table structure into an ofstream.
 		    @param out: the oftstream.
@@ -264,11 +279,26 @@ class DecodingTable
 		uint64_t bytesStream;		//! The stream length (in bytes)
 		uchar *stream;			//! The stream encoding the decodeable substrings
 
-		uint *table;			//! The table pointing to the substring information
+		Entry *entries;			//! The entries of the 2^k chunks
 		DecodingTree **subtrees;	//! Decoding subtrees for large codewords
-		BitString *endings;		//! Bitstring setting the streams with '\0'
 
-		Entry ventry[256];
+		/** Builds the entries from the serialized table.
+		    @param table: the table pointing to the substring 
+		      information in the stream.
+		    @param endings: bitstring setting the substrings with '\0'.
+		*/
+		void buildEntries(uint *table, BitString *endings);
+
+		/** Gets the position in the stream of a non-inlined entry.
+		    @param entry: the entry.
+		    @returns the position of its control byte in the stream.
+		*/
+		inline uint getPosition(const Entry &entry) const
+		{
+			uint position;
+			memcpy(&position, entry.symbols, sizeof(uint));
+			return position;
+		}
 
 		/** Encodes in a byte the information used for decoding a
 		    given susbtring.
@@ -283,14 +313,14 @@ class DecodingTable
 		    @param length: the substring length.
 		    @param bits: the number of decoded bits.
 		*/
-		inline void decodeInfo(uchar code, uint *length, uint *bits);
+		inline void decodeInfo(uchar code, uint *length, uint *bits) const;
 
 		/** Returns the substring and updates the information used
 		    for the next decodification step.
  		    @c: pointer to the scanning data
 		    @returns a boolean value telling if the susbtring contains '\0'.
 		*/
-		bool getSubstring(ChunkScan *c);
+		bool getSubstring(ChunkScan *c) const;
 
 		friend class StringDictionaryHASHUFFDAC;
 };
@@ -28,27 +28,29 @@
 
 #include "DecodingTableBuilder.h"
 
-DecodingTableBuilder::DecodingTableBuilder(uint maxv)
+DecodingTableBuilder::DecodingTableBuilder(uint maxv, uint tablebits)
 {
 	this->maxv = maxv;
+	setK(tablebits);
 }
 
-DecodingTableBuilder::DecodingTableBuilder(Codeword *codews)
+DecodingTableBuilder::DecodingTableBuilder(Codeword *codews, uint tablebits)
 {
 	this->maxv = 255;
+	setK(tablebits);
 	codewords = codews;
-	tableSubstr = new DecodeableSubstr[(int)pow((float)2,(int)TABLEBITSO)];
+	tableSubstr = new DecodeableSubstr[(int)pow((float)2,(int)k)];
 	table = new DecodingTable(maxv);
 
 	uint i=0;
 
 	while (i<maxv)
 	{
-		if (codewords[i].bits > TABLEBITSO)
+		if (codewords[i].bits > k)
 		{
 			// The first k bits are used as key for
 			// traversing the Huffman tree
-			uint index = codewords[i].codeword >> (codewords[i].bits-TABLEBITSO);
+			uint index = codewords[i].codeword >> (codewords[i].bits-k);
 
 			// Check if the tree is now stored
 			if (tableSubstr[index].dbits == 0)
@@ -65,25 +67,25 @@ void
 DecodingTableBuilder::initializeFromHuffman(Huffman *huff)
 {
 	codewords = huff->obtainCodewords();
-	tableSubstr = new DecodeableSubstr[(int)pow((float)2,(int)TABLEBITSO)];
+	tableSubstr = new DecodeableSubstr[(int)pow((float)2,(int)k)];
 	table = new DecodingTable(maxv);
 
 	uint i=0;
 
 	while (i<maxv)
 	{
-		if (codewords[i].bits > TABLEBITSO)
+		if (codewords[i].bits > k)
 		{
 			// The first k bits are used as key for
 			// traversing the Huffman tree
-			uint index = codewords[i].codeword >> (codewords[i].bits-TABLEBITSO);
+			uint index = codewords[i].codeword >> (codewords[i].bits-k);
 
 			// Check if the tree is now stored
 			if (tableSubstr[index].dbits == 0)
 			{
 				// Obtaining the subtree and inserting it in the
 				// decoding table
-				DecodingTree *tree = huff->obtainSubtree(index, TABLEBITSO);
+				DecodingTree *tree = huff->obtainSubtree(index, k);
 
 				uint pos = table->setDecodingSubtree(tree);
 				tableSubstr[index].setLargeSubstr(pos);
@@ -100,22 +102,22 @@ DecodingTableBuilder::initializeFromHuTucker(HuTucker *ht)
 	maxv++;
 
 	codewords = ht->obtainCodewords();
-	tableSubstr = new DecodeableSubstr[(int)pow((float)2,(int)TABLEBITSO)];
+	tableSubstr = new DecodeableSubstr[(int)pow((float)2,(int)k)];
 	table = new DecodingTable(maxv);
 
 	uint i=0;
 
 	while (i<maxv)
 	{
-		if (codewords[i].bits > TABLEBITSO)
+		if (codewords[i].bits > k)
 		{
 			// The first k bits are used as key for
 			// traversing the Hu-Tucker tree
-			uint index = codewords[i].codeword >> (codewords[i].bits-TABLEBITSO);
+			uint index = codewords[i].codeword >> (codewords[i].bits-k);
 
 			// Obtaining the subtree and inserting it in the
 			// decoding table
-			DecodingTree *tree = ht->obtainSubtree(index, TABLEBITSO);
+			DecodingTree *tree = ht->obtainSubtree(index, k);
 
 			uint pos = table->setDecodingSubtree(tree);
 			tableSubstr[index].setLargeSubstr(pos);
@@ -133,27 +135,27 @@ DecodingTableBuilder::insertDecodeableSubstr(uchar symbol, uint *seq, ushort *pt
 	uint bits = codewords[(int)symbol].bits;
 	uint codeword = codewords[(int)symbol].codeword;
 
-	if (bits <= TABLEBITSO)
+	if (bits <= k)
 	{
 		*seq = (*seq << bits) | codeword;
 		*ptr += bits;
 	}
 	else
 	{
-		*seq = (*seq << TABLEBITSO) | (codeword >> (bits-TABLEBITSO));
-		*ptr += TABLEBITSO;
+		*seq = (*seq << k) | (codeword >> (bits-k));
+		*ptr += k;
 	}
 
-	if (*ptr >= TABLEBITSO)
+	if (*ptr >= k)
 	{
-		uint index = (*seq >> (*ptr-TABLEBITSO)) & mask(TABLEBITSO);
+		uint index = (*seq >> (*ptr-k)) & mask(k);
 
-		if (bits > TABLEBITSO) *ptr += (bits-TABLEBITSO);
+		if (bits > k) *ptr += (bits-k);
 
 		if ((substr->size() > 0) && (tableSubstr[index].dbits <= 1))
 		{
 			// This substring has not been previously indexed
-			if ((*ptr == TABLEBITSO) && (bits <= TABLEBITSO))
+			if ((*ptr == k) && (bits <= k))
 			{
 				// The encoded symbol is fully represented in
 				// the current chunk
@@ -173,19 +175,19 @@ DecodingTableBuilder::insertDecodeableSubstr(uchar symbol, uint *seq, ushort *pt
 				*ptr = bits;
 				substr->push_back(symbol); lenSubstr->push_back(bits);
 
-				if (*ptr >= TABLEBITSO)
+				if (*ptr >= k)
 				{
 					// The encoded symbol fills the chunk
 					// and must be indexed if its length is
-					// equals to TABLEBITSO. Otherwise, its
+					// equals to k. Otherwise, its
 					// corresponding subtree is already in
 					// the table.
 
-					if (*ptr == TABLEBITSO)
+					if (*ptr == k)
 					{
 						index = codeword;
 						if (tableSubstr[index].length == 0)
-							tableSubstr[index].setSubstr(substr, 1, TABLEBITSO);
+							tableSubstr[index].setSubstr(substr, 1, k);
 					}
 
 					*ptr = 0;
@@ -202,12 +204,12 @@ DecodingTableBuilder::insertDecodeableSubstr(uchar symbol, uint *seq, ushort *pt
 				*ptr = bits;
 				substr->push_back(symbol); lenSubstr->push_back(bits);
 
-				if (*ptr == TABLEBITSO)
+				if (*ptr == k)
 				{
 					index = codeword;
 
 					if (tableSubstr[index].length == 0)
-						tableSubstr[index].setSubstr(substr, 1, TABLEBITSO);
+						tableSubstr[index].setSubstr(substr, 1, k);
 				}
 
 				*ptr = 0;
@@ -217,19 +219,19 @@ DecodingTableBuilder::insertDecodeableSubstr(uchar symbol, uint *seq, ushort *pt
 			{
 				substr->clear(); lenSubstr->clear();
 
-				if ((*ptr == TABLEBITSO) && (bits <= TABLEBITSO)) *ptr = 0;
+				if ((*ptr == k) && (bits <= k)) *ptr = 0;
 				else
 				{
 					*ptr = bits;
 					substr->push_back(symbol); lenSubstr->push_back(bits);
 
-					if (*ptr >= TABLEBITSO)
+					if (*ptr >= k)
 					{
-						if (*ptr == TABLEBITSO)
+						if (*ptr == k)
 						{
 							index = codeword;
 							if (tableSubstr[index].length == 0)
-								tableSubstr[index].setSubstr(substr, 1, TABLEBITSO);
+								tableSubstr[index].setSubstr(substr, 1, k);
 						}
 
 						*ptr = 0;
@@ -249,9 +251,9 @@ DecodingTableBuilder::insertDecodeableSubstr(uchar symbol, uint *seq, ushort *pt
 void
 DecodingTableBuilder::insertEndingSubstr(uint *seq, ushort *ptr, vector<uchar> *substr, vector<ushort> *lenSubstr)
 {
-	uint bits = TABLEBITSO-(*ptr);
+	uint bits = k-(*ptr);
 	*seq = (*seq << bits);
-	uint index = (*seq) & mask(TABLEBITSO);
+	uint index = (*seq) & mask(k);
 
 	if (tableSubstr[index].length == 0)
 		tableSubstr[index].setSpecialSubstr(substr, substr->size());
@@ -273,10 +275,28 @@ DecodingTableBuilder::getMax()
 	return maxv;
 }
 
+uint
+DecodingTableBuilder::getK()
+{
+	return k;
+}
+
+void
+DecodingTableBuilder::setK(uint tablebits)
+{
+	if ((tablebits < MINK) || (tablebits > MAXK))
+	{
+		cerr << "[WARNING] The decoding table uses chunks from " << MINK << " to " << MAXK << " bits. ";
+		cerr << "The table is built using chunks of " << TABLEBITSO << " bits" << endl;
+		this->k = TABLEBITSO;
+	}
+	else this->k = tablebits;
+}
+
 DecodingTable*
 DecodingTableBuilder::getTable()
 {
-	table->setDecodingTable(TABLEBITSO, tableSubstr);
+	table->setDecodingTable(k, tableSubstr);
 	return table;
 }
 
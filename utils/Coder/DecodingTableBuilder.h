@@ -48,9 +48,10 @@ class DecodingTableBuilder
 	public:
 		// Generic constructor
 		// @maxv: maximum value used in the alphabet (all ASCII chars are assumed by default)
-		DecodingTableBuilder(uint maxv=255);
+		// @tablebits: number of bits of the chunks used for decoding (from MINK to MAXK)
+		DecodingTableBuilder(uint maxv=255, uint tablebits=TABLEBITSO);
 
-		DecodingTableBuilder(Codeword *codews);
+		DecodingTableBuilder(Codeword *codews, uint tablebits=TABLEBITSO);
 
 		// Initializes the manager from a Huffman code
 		// @huff: the Huffman code.
@@ -70,6 +71,11 @@ class DecodingTableBuilder
 		 */
 		uint getMax();
 
+		/** Gets the chunk length used in the table
+		    @returns the chunk length (in bits).
+		 */
+		uint getK();
+
 		/** Gets the resulting table for decodification
 		    @returns the set of codewords.
 		 */
@@ -108,6 +114,12 @@ class DecodingTableBuilder
 
 	protected:
 		uint maxv;	// Max value in the code
+		uint k;		// Chunk length (in bits)
+
+		/** Sets the chunk length, which must be in [MINK, MAXK].
+		    @param tablebits: the chunk length.
+		*/
+		void setK(uint tablebits);
 };
 
 #endif /* DECODINGTABLEBUILDER_H_ */
@@ -42,7 +42,7 @@ DecodingTree::DecodingTree(uint codeword, BitString *partree, vector<uint> *symb
 size_t 
 DecodingTree::getSize()
 {
-	return nodes*sizeof(TreeNode)+sizeof(DecodingTree)+leaves*sizeof(uint);
+	return nodes*sizeof(TreeNode)+sizeof(DecodingTree)+leaves*sizeof(uint)+((partree != NULL) ? partree->getSize() : 0);
 }
 
 void 
@@ -52,8 +52,6 @@ DecodingTree::save(ofstream &out)
 	saveValue<uint>(out, leaves);
 	partree->save(out);
 	for (uint i=0; i<leaves; i++) saveValue<uint>(out, symbols[i]);
-
-	delete partree;
 }
 
 
@@ -68,7 +66,6 @@ DecodingTree::load(ifstream &in)
 	table->partree = new BitString(in);
 	for (uint i=0; i<table->leaves; i++) table->symbols.push_back(loadValue<uint>(in));
 	table->buildTree(table->partree->getLength());
-	delete table->partree;
 
 	return table;
 }
@@ -124,4 +121,5 @@ DecodingTree::buildTree(uint bits)
 DecodingTree::~DecodingTree()
 {
 	delete [] tree;
+	if (partree != NULL) delete partree;
 }
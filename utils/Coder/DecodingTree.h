@@ -70,7 +70,7 @@ class DecodingTree
 {	
 	public:
 		/** Generic constructor. */
-		DecodingTree() { this->leaves = 0; this->tree = NULL; };
+		DecodingTree() { this->leaves = 0; this->tree = NULL; this->partree = NULL; };
 
 		/** Class constructor. 
 		    @param codeword: the root prefix.
@@ -29,7 +29,7 @@
 #include "StatCoder.h"
 
 uint
-StatCoder::encodeSymbol(uchar symbol, uchar *text, uint *offset)
+StatCoder::encodeSymbol(uchar symbol, uchar *text, uint *offset) const
 {
 	uint codeword = codewords[(int)symbol].codeword;
 	uint bits = codewords[(int)symbol].bits;
@@ -60,7 +60,7 @@ StatCoder::encodeSymbol(uchar symbol, uchar *text, uint *offset)
 }
 
 uchar*
-StatCoder::encodeString(uchar *str, uint strLen, uint *encLen, uint *offset)
+StatCoder::encodeString(uchar *str, uint strLen, uint *encLen, uint *offset) const
 {
 	uchar *encoded = new uchar[4*strLen];
 	*encLen = 0; encoded[*encLen] = 0;
@@ -75,7 +75,7 @@ StatCoder::encodeString(uchar *str, uint strLen, uint *encLen, uint *offset)
 }
 
 uint
-StatCoder::decodeString(ChunkScan* c)
+StatCoder::decodeString(ChunkScan* c) const
 {
 	c->extracted = 0;
 
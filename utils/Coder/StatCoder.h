@@ -58,7 +58,7 @@ class StatCoder
 		    @param offset: the number of bits to be jumped.
 		    @returns the number of advanced bytes in this operation.
 		*/
-		uint encodeSymbol(uchar symbol, uchar *text, uint *offset);
+		uint encodeSymbol(uchar symbol, uchar *text, uint *offset) const;
 
 		/** Performs the Hu-Tucker encoding of the string.
 		    @param str: the string to be encoded.
@@ -68,9 +68,9 @@ class StatCoder
 		      byte.
 		    @returns the encoded string.
 		*/
-		uchar* encodeString(uchar *str, uint strLen, uint *encLen, uint *offset);
+		uchar* encodeString(uchar *str, uint strLen, uint *encLen, uint *offset) const;
 
-		uint decodeString(ChunkScan* c);
+		uint decodeString(ChunkScan* c) const;
 
 		~StatCoder() { };
 
@@ -35,6 +35,7 @@
 #include "DAC_BVLS.h"
 
 DAC_BVLS::DAC_BVLS(){
+	mapping = NULL;
 	tamCode = 0;
 	nLevels = 0;      
 	levelsIndex = NULL; 
@@ -44,10 +45,11 @@ DAC_BVLS::DAC_BVLS(){
 }
 
 DAC_BVLS::DAC_BVLS(uint tamCode, uint nLevels, vector<uint> * levelsIndex, vector<uint> * rankLevels, uchar *levels, BitString *bS){
+	mapping = NULL;
 	this->tamCode = tamCode;
 	this->nLevels = nLevels;
 	this->levels = levels;
-	this->bS = new BitSequenceRG(*bS, 4);
+	this->bS = buildRankBitmap(*bS, 4);
 	this->levelsIndex = new uint[nLevels];
 	this->rankLevels = new uint[nLevels];
 
@@ -67,7 +69,7 @@ uint DAC_BVLS::access(uint pos, uint **seq) const{
 	sequence[j] = levels[ini];
 	l_seq =1;
 
-	while(bitget(((BitSequenceRG *)bS)->data,ini)){
+	while(bS->access(ini)){
 		rankini = bS->rank1(ini) - rankLevels[j];
 		j++;
 			
@@ -93,7 +95,7 @@ uint DAC_BVLS::access_next(uint l, uint *pos) const{
 		return seq;
 	}
 
-	if(bitget(((BitSequenceRG *)bS)->data,ini))
+	if(bS->access(ini))
 	{
 		rankini = bS->rank1(ini) - rankLevels[l];
 		*pos = levelsIndex[l+1]+rankini;
@@ -122,12 +124,13 @@ void DAC_BVLS::save(ofstream & fp) const{
 	bS->save(fp);
 }
 
-DAC_BVLS* DAC_BVLS::load(ifstream & fp){
+DAC_BVLS* DAC_BVLS::load(ifstream & fp, MemoryMapping *mapping){
 	DAC_BVLS *rep = new DAC_BVLS();
+	rep->mapping = mapping;
 	rep->tamCode = loadValue<uint>(fp);
 	rep->nLevels = loadValue<uint>(fp);
 	rep->levelsIndex = loadValue<uint>(fp, rep->nLevels+1); 
-	rep->levels = loadValue<uchar>(fp, rep->tamCode);
+	rep->levels = MemoryMapping::loadArray<uchar>(mapping, fp, rep->tamCode);
 	rep->rankLevels = loadValue<uint>(fp, rep->nLevels);
 	rep->bS = BitSequence::load(fp);
 
@@ -137,9 +140,9 @@ DAC_BVLS* DAC_BVLS::load(ifstream & fp){
 DAC_BVLS::~DAC_BVLS()
 {
 	delete [] levelsIndex;
-	delete [] levels;
+	MemoryMapping::release(mapping, levels);
 	delete [] rankLevels;
-	delete (BitSequenceRG *)bS;
+	delete bS;
 }
 
 
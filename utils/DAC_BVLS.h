@@ -42,6 +42,9 @@
 #include <libcdsTrees.h>
 #include <BitSequence.h>
 
+#include "MemoryMapping.h"
+#include "RankBitmap.h"
+
 #define BYTE 8
 
 using namespace cds_static;
@@ -66,7 +69,8 @@ class DAC_BVLS
 			
 		virtual void save(ofstream & fp) const;
 			
-		static DAC_BVLS* load(ifstream & fp);
+		/*Loads the structure; the levels array is referenced within the mapping (if it is not NULL)*/
+		static DAC_BVLS* load(ifstream & fp, MemoryMapping *mapping=NULL);
 			
 		virtual ~DAC_BVLS();
 
@@ -78,7 +82,8 @@ class DAC_BVLS
 		uint * levelsIndex;
 		uchar * levels;
 		BitSequence * bS;
-		uint * rankLevels; 
+		uint * rankLevels;
+		MemoryMapping * mapping; 
 };
 
 #endif
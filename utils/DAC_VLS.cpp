@@ -35,7 +35,11 @@
 
 #include "DAC_VLS.h"
 
+// First value of a layout whose counters are written with 64 bits
+static const uint WIDE = (uint)-1;
+
 DAC_VLS::DAC_VLS(){
+	mapping = NULL;
 	tamCode = 0;
 	base_bits = 0;
 	listLength = 0;    
@@ -46,19 +50,20 @@ DAC_VLS::DAC_VLS(){
 	rankLevels = NULL;
 }
 
-DAC_VLS::DAC_VLS(int *list, uint l_Length, uint log_r, uint max_seq_length){
-	uint *levelSizeAux;
-	uint *contB;
-	uint bits_BS_len = 0;
+DAC_VLS::DAC_VLS(int *list, size_t l_Length, uint log_r, uint max_seq_length){
+	mapping = NULL;
+	size_t *levelSizeAux;
+	size_t *contB;
+	size_t bits_BS_len = 0;
 	listLength =0;
 	nLevels = max_seq_length;
-	levelSizeAux = new uint[nLevels];
+	levelSizeAux = new size_t[nLevels];
 	
 	for(uint i=0;i<nLevels;i++)
 		levelSizeAux[i]=0;
 
 	//Space needed for each level
-	for(uint i=0;i<l_Length;i++){
+	for(size_t i=0;i<l_Length;i++){
 		for(uint j=0; j < nLevels;j++){
 			if(list[i] >= 0){
 				levelSizeAux[j]++;
@@ -70,17 +75,17 @@ DAC_VLS::DAC_VLS(int *list, uint l_Length, uint log_r, uint max_seq_length){
 		listLength++;
 	}
 
-	levelsIndex = new uint[nLevels+1];
+	levelsIndex = new size_t[nLevels+1];
 	bits_BS_len =0;
 	base_bits = log_r;
 	//space needed for levels in bits
-	uint tamLevels =0;
+	size_t tamLevels =0;
 	for(uint i=0;i<nLevels;i++)
-		tamLevels+=base_bits*levelSizeAux[i];	
+		tamLevels+=(size_t)base_bits*levelSizeAux[i];	
 	tamCode=tamLevels;
 
 	levelsIndex[0]=0;
-	contB = new uint[nLevels];
+	contB = new size_t[nLevels];
 	for(uint j=0;j<nLevels;j++){
 		levelsIndex[j+1]=levelsIndex[j] + levelSizeAux[j];
 		contB[j]=levelsIndex[j];
@@ -88,7 +93,7 @@ DAC_VLS::DAC_VLS(int *list, uint l_Length, uint log_r, uint max_seq_length){
 
 	//init levels
 	levels = new uint[tamLevels/W+1];		
-	for(uint i=0; i< (tamLevels/W+1); i++)
+	for(size_t i=0; i< (tamLevels/W+1); i++)
 		levels[i] = 0;
 
 	//size of the bitmap
@@ -96,10 +101,10 @@ DAC_VLS::DAC_VLS(int *list, uint l_Length, uint log_r, uint max_seq_length){
 	//tha last position is 0. this save us time later in the queries
 	//init bitmap
 	uint * bits_BS = new uint[bits_BS_len/W+1];
-	for(uint i=0; i<((bits_BS_len)/W+1);i++)
+	for(size_t i=0; i<((bits_BS_len)/W+1);i++)
 		bits_BS[i]=0;
 
-	for(uint i=0;i<l_Length;i++){
+	for(size_t i=0;i<l_Length;i++){
 
 		for(uint j=0; j<nLevels; j++){
 			if(list[i]>=0){
@@ -116,8 +121,8 @@ DAC_VLS::DAC_VLS(int *list, uint l_Length, uint log_r, uint max_seq_length){
 
 	//set the bitmap data structure
 	bitset(bits_BS,bits_BS_len-1);
-	bS = new BitSequenceRG(bits_BS, bits_BS_len , 4); 	
-	rankLevels = new uint[nLevels];
+	bS = buildRankBitmap(bits_BS, bits_BS_len , 4); 	
+	rankLevels = new size_t[nLevels];
 	rankLevels[0]=0;
 	for(uint j=1;j<nLevels;j++)
 		rankLevels[j]= bS->rank1(levelsIndex[j]-1);
@@ -127,17 +132,19 @@ DAC_VLS::DAC_VLS(int *list, uint l_Length, uint log_r, uint max_seq_length){
 	delete [] bits_BS;
 }
 
-uint DAC_VLS::access(uint pos, uint **seq) const{
+uint DAC_VLS::access(size_t pos, uint **seq) const{
 	uint *sequence = new uint[nLevels];
 	uint l_seq =0;
-	uint ini = pos-1; 
+	size_t ini = pos-1; 
 	uint j=0;
-	uint rankini;
+	size_t rankini;
 
 	sequence[j] = get_field(levels, base_bits, ini); 
 	l_seq =1;
 
-	while(bitget(((BitSequenceRG *)bS)->data,ini)){
+	// The last level is never continued (with a single level, the first
+	// position of the bitmap is its final mark)
+	while((j < (uint)nLevels-1) && bS->access(ini)){
 		rankini = bS->rank1(ini) - rankLevels[j];
 		j++;
 			
@@ -152,66 +159,138 @@ uint DAC_VLS::access(uint pos, uint **seq) const{
 	return l_seq;
 }
 
-uint DAC_VLS::access_next(uint l, uint *pos) const{
-	uint ini=*pos-1; 
-	uint rankini;
+uint DAC_VLS::access_next(uint l, size_t *pos) const{
+	size_t ini=*pos-1; 
+	size_t rankini;
 	uint seq = get_field(levels, base_bits, ini);
 		
 	if(l==(uint)nLevels-1){
-		*pos = (uint)-1;
+		*pos = (size_t)-1;
 		return seq;
 	}
-	if(bitget(((BitSequenceRG *)bS)->data,ini)){
+	if(bS->access(ini)){
 		rankini = bS->rank1(ini) - rankLevels[l];
 		*pos = levelsIndex[l+1]+rankini;
 	}
 	else
-		*pos = (uint)-1;
+		*pos = (size_t)-1;
 	return seq;
 }
 
-uint DAC_VLS::getListLength() const{
+size_t DAC_VLS::getListLength() const{
 	return listLength;
 }
 
-uint DAC_VLS::getSize() const{
-	uint mem = sizeof(DAC_VLS);
-	mem += sizeof(uint)*(nLevels+1);
+size_t DAC_VLS::getSize() const{
+	size_t mem = sizeof(DAC_VLS);
+	mem += sizeof(size_t)*(nLevels+1);
 	mem += sizeof(uint)*(tamCode/W+1);
 	mem += bS->getSize();   
-	mem += sizeof(uint)*nLevels; 
+	mem += sizeof(size_t)*nLevels; 
 	return mem;
 }
 
 void DAC_VLS::save(ofstream & fp) const{
-	saveValue(fp, tamCode);
-	saveValue(fp, listLength);
+	// The level positions are below the number of bits in the levels,
+	// so they also fit in 32 bits when the counters do
+	bool wide = (tamCode >= WIDE) || (listLength >= WIDE);
+	if(!wide){
+		saveValue<uint>(fp, tamCode);
+		saveValue<uint>(fp, listLength);
+	}
+	else{
+		saveValue<uint>(fp, WIDE);
+		saveValue<uint64_t>(fp, tamCode);
+		saveValue<uint64_t>(fp, listLength);
+	}
 	saveValue(fp, nLevels);
 	saveValue(fp, base_bits);
-	saveValue(fp, levelsIndex, nLevels+1);
+	savePositions(fp, levelsIndex, nLevels+1, wide);
 	saveValue(fp, levels, tamCode/W+1);
-	saveValue(fp, rankLevels, nLevels);
+	savePositions(fp, rankLevels, nLevels, wide);
 	bS->save(fp);
 }
 
-DAC_VLS* DAC_VLS::load(ifstream & fp){
+void DAC_VLS::savePositions(ofstream & fp, const size_t *positions, uint n, bool wide){
+	for(uint i=0; i<n; i++){
+		if(wide) saveValue<uint64_t>(fp, positions[i]);
+		else saveValue<uint>(fp, (uint)positions[i]);
+	}
+}
+
+size_t *DAC_VLS::loadPositions(ifstream & fp, uint n, bool wide){
+	size_t *positions = new size_t[n];
+	for(uint i=0; i<n; i++){
+		if(wide) positions[i] = loadValue<uint64_t>(fp);
+		else positions[i] = loadValue<uint>(fp);
+	}
+	return positions;
+}
+
+DAC_VLS* DAC_VLS::load(ifstream & fp, MemoryMapping *mapping){
 	DAC_VLS *rep = new DAC_VLS();
+	rep->mapping = mapping;
 	rep->tamCode = loadValue<uint>(fp);
-	rep->listLength = loadValue<uint>(fp);
+	bool wide = (rep->tamCode == WIDE);
+	if(!wide)
+		rep->listLength = loadValue<uint>(fp);
+	else{
+		rep->tamCode = loadValue<uint64_t>(fp);
+		rep->listLength = loadValue<uint64_t>(fp);
+	}
 	rep->nLevels = loadValue<uint>(fp);
 	rep->base_bits = loadValue<ushort>(fp);
-	rep->levelsIndex = loadValue<uint>(fp, rep->nLevels+1); 
-	rep->levels = loadValue<uint>(fp, rep->tamCode/W+1);
-	rep->rankLevels = loadValue<uint>(fp, rep->nLevels);
+	rep->levelsIndex = loadPositions(fp, rep->nLevels+1, wide); 
+	rep->levels = MemoryMapping::loadArray<uint>(mapping, fp, rep->tamCode/W+1);
+	rep->rankLevels = loadPositions(fp, rep->nLevels, wide);
 	rep->bS = BitSequence::load(fp);
 	return rep;
 }
 
+DAC_VLSCursor::DAC_VLSCursor(const DAC_VLS *dac, size_t pos){
+	this->dac = dac;
+	this->current = pos;
+	positions = new size_t[dac->nLevels];
+	sequence = new uint[dac->nLevels];
+
+	// The values of level j+1 follow the order of the (continued) values of level j
+	positions[0] = pos-1;
+	for(uint j=0; j+1<dac->nLevels; j++){
+		size_t before = (positions[j] > 0) ? dac->bS->rank1(positions[j]-1) : 0;
+		positions[j+1] = dac->levelsIndex[j+1] + before - dac->rankLevels[j];
+	}
+}
+
+bool DAC_VLSCursor::hasNext() const{
+	return current <= dac->listLength;
+}
+
+const uint *DAC_VLSCursor::next(uint *len){
+	uint j = 0;
+	size_t ini = positions[0]++;
+
+	sequence[0] = get_field(dac->levels, dac->base_bits, ini);
+	while((j < dac->nLevels-1) && dac->bS->access(ini)){
+		j++;
+		ini = positions[j]++;
+		sequence[j] = get_field(dac->levels, dac->base_bits, ini);
+	}
+
+	current++;
+	*len = j+1;
+	return sequence;
+}
+
+DAC_VLSCursor::~DAC_VLSCursor(){
+	delete [] positions;
+	delete [] sequence;
+}
+
 DAC_VLS::~DAC_VLS(){
 	delete [] levelsIndex;
-	delete [] levels;
+	MemoryMapping::release(mapping, levels);
 	delete [] rankLevels;
-	delete (BitSequenceRG *)bS;
+	delete bS;
 }
 
 
@@ -41,20 +41,32 @@
 #include <libcdsTrees.h>
 #include <BitSequence.h>
 
+#include "MemoryMapping.h"
+#include "RankBitmap.h"
+
 using namespace cds_static;
 
+class DAC_VLSCursor;
+
 class DAC_VLS
 {
+	friend class DAC_VLSCursor;
+
 	private:
 		DAC_VLS();
-		uint tamCode;
+		size_t tamCode;
 		ushort base_bits;
-		uint listLength; 
+		size_t listLength; 
 		uint nLevels; 
-		uint * levelsIndex;
+		size_t * levelsIndex;
 		uint * levels;
 		BitSequence * bS;
-		uint * rankLevels;
+		size_t * rankLevels;
+		MemoryMapping * mapping;
+
+		/*Saves (loads) an array of level positions, with 64 bits in the wide layout*/
+		static void savePositions(ofstream & fp, const size_t *positions, uint n, bool wide);
+		static size_t *loadPositions(ifstream & fp, uint n, bool wide);
 
 	public:
 			
@@ -64,26 +76,54 @@ class DAC_VLS
 		 * @param log_r Number of bits used for each block 
 		 * @param max_seq_length Maximum length that a sequence can have
 		 * */
-		DAC_VLS(int *list, uint l_Length, uint log_r, uint max_seq_length);
+		DAC_VLS(int *list, size_t l_Length, uint log_r, uint max_seq_length);
 		
 		/*Return the length of the sequence that start at pos (pos start from 1 to n) and in seq store the sequence*/
-		virtual uint access(uint pos, uint **seq) const;
+		virtual uint access(size_t pos, uint **seq) const;
 			
 		/*Return the value stored in position pos in the level l. It also store in pos the position of the 
-		 * next value in the next level (if not exist next value return (uint)-1 in pos*/
-		virtual uint access_next(uint l, uint *pos) const;
+		 * next value in the next level (if not exist next value return (size_t)-1 in pos*/
+		virtual uint access_next(uint l, size_t *pos) const;
 		
 		/*Return the number of elements stored*/
-		virtual uint getListLength() const;
+		virtual size_t getListLength() const;
 			
 		/*Return the size, in bytes, used for DAC_VLS structure*/
-		virtual uint getSize() const;
+		virtual size_t getSize() const;
 			
+		/*Saves the structure; the counters are written with 64 bits only if they exceed 32 bits*/
 		virtual void save(ofstream & fp) const;
 			
-		static DAC_VLS* load(ifstream & fp);
+		/*Loads the structure; the levels array is referenced within the mapping (if it is not NULL)*/
+		static DAC_VLS* load(ifstream & fp, MemoryMapping *mapping=NULL);
 			
 		virtual ~DAC_VLS();
 };
 
+/*Sequential decoder of consecutive sequences. The j-th values of the sequences are stored
+ * consecutively in the level j, so the cursor keeps the next position at each level and
+ * advances it when a sequence reaches that level: rank operations are only performed to
+ * place the cursor at the first sequence*/
+class DAC_VLSCursor
+{
+	public:
+		/*Places the cursor at the sequence pos (pos start from 1 to n)*/
+		DAC_VLSCursor(const DAC_VLS *dac, size_t pos);
+
+		/*Checks if there are non-decoded sequences*/
+		bool hasNext() const;
+
+		/*Decodes the next sequence, storing its length in len. The returned values are
+		 * overwritten by the next call*/
+		const uint *next(uint *len);
+
+		~DAC_VLSCursor();
+
+	private:
+		const DAC_VLS *dac;
+		size_t *positions;	// Next position at each level
+		size_t current;		// Next sequence to be decoded
+		uint *sequence;		// Values of the last decoded sequence
+};
+
 #endif
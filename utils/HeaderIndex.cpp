@@ -0,0 +1,180 @@
+/* HeaderIndex.cpp
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Cache-conscious index over the bucket headers of the Front-Coding based
+ * dictionaries. The first 8 bytes of each header are stored as a big-endian
+ * integer in a dense array which is sampled, level by level, every
+ * HEADERFANOUT keys. The resulting implicit B-tree is traversed scanning a
+ * single cache line per level, so the binary search over the (bit-packed)
+ * header pointers only needs to compare those buckets whose headers share
+ * the first 8 bytes with the searched string.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#include "HeaderIndex.h"
+
+HeaderIndex::HeaderIndex(uchar *text, size_t length, LogSequence *positions, size_t buckets, bool terminated)
+{
+	this->terminated = terminated;
+	this->buckets = buckets;
+
+	// Computing the prefix shared by all headers
+	uchar *first = text+positions->getField(1);
+	size_t avail = length-positions->getField(1);
+	skip = (avail > MAXSKIP) ? MAXSKIP : avail;
+
+	if (terminated) skip = strnlen((char*)first, skip);
+
+	for (size_t i=2; (i<=buckets) && (skip > 0); i++)
+	{
+		size_t ptr = positions->getField(i);
+		uint lcp = 0;
+
+		while ((lcp < skip) && (ptr+lcp < length) && (first[lcp] == text[ptr+lcp])) lcp++;
+		skip = lcp;
+	}
+
+	prefix = new uchar[skip+1];
+	memcpy(prefix, first, skip);
+
+	// Computing the number of levels
+	levels = 1;
+	for (size_t n=buckets; n>HEADERFANOUT; n=(n+HEADERFANOUT-1)/HEADERFANOUT) levels++;
+
+	sizes = new size_t[levels];
+	keys = new uint64_t*[levels];
+
+	// The bottom level stores the keys of all headers
+	sizes[0] = buckets;
+	keys[0] = new uint64_t[buckets];
+
+	for (size_t i=0; i<buckets; i++)
+	{
+		size_t ptr = positions->getField(i+1);
+		keys[0][i] = key(text+ptr+skip, length-ptr-skip, 0);
+	}
+
+	// Each upper level samples the first key of each node below
+	for (uint l=1; l<levels; l++)
+	{
+		sizes[l] = (sizes[l-1]+HEADERFANOUT-1)/HEADERFANOUT;
+		keys[l] = new uint64_t[sizes[l]];
+
+		for (size_t i=0; i<sizes[l]; i++) keys[l][i] = keys[l-1][i*HEADERFANOUT];
+	}
+}
+
+void
+HeaderIndex::narrow(const uchar *str, size_t strLen, size_t *left, size_t *right) const
+{
+	uint len = (terminated || (strLen > skip)) ? skip : strLen;
+
+	for (uint i=0; i<len; i++)
+	{
+		if (str[i] != prefix[i])
+		{
+			// The string is lower (or greater) than all headers
+			if (str[i] < prefix[i]) { *left = 1; *right = 0; }
+			else { *left = buckets+1; *right = buckets; }
+			return;
+		}
+	}
+
+	// Shorter strings cannot be distinguished by the keys
+	if (!terminated && (strLen <= skip)) return;
+
+	str += skip; strLen -= skip;
+
+	if (terminated)
+	{
+		uint64_t k = key(str, 8, 0);
+
+		*left = rank(k, false)+1;
+		*right = rank(k, true);
+	}
+	else
+	{
+		// Bytes beyond the compared length can be any value
+		*left = rank(key(str, strLen, 0), false)+1;
+		*right = rank(key(str, strLen, 0xFF), true);
+	}
+}
+
+size_t
+HeaderIndex::getSize() const
+{
+	size_t size = sizeof(HeaderIndex)+skip+1+levels*(sizeof(size_t)+sizeof(uint64_t*));
+	for (uint l=0; l<levels; l++) size += sizes[l]*sizeof(uint64_t);
+
+	return size;
+}
+
+HeaderIndex::~HeaderIndex()
+{
+	for (uint l=0; l<levels; l++) delete [] keys[l];
+	delete [] keys; delete [] sizes;
+	delete [] prefix;
+}
+
+uint64_t
+HeaderIndex::key(const uchar *str, size_t len, uchar fill) const
+{
+	uint64_t k = 0;
+	uint i = 0;
+
+	if (len > 8) len = 8;
+
+	for (; i<len; i++)
+	{
+		// Terminated strings are not compared beyond the '\0'
+		if (terminated && (str[i] == 0)) break;
+		k = (k << 8) | str[i];
+	}
+
+	for (; i<8; i++) k = (k << 8) | fill;
+
+	return k;
+}
+
+size_t
+HeaderIndex::rank(uint64_t k, bool equal) const
+{
+	size_t node = 0;
+
+	for (uint l=levels; l>0; l--)
+	{
+		uint64_t *level = keys[l-1];
+		size_t i = node*HEADERFANOUT, end = i+HEADERFANOUT;
+		if (end > sizes[l-1]) end = sizes[l-1];
+
+		// All keys before the node are lower than k
+		if (equal) while ((i < end) && (level[i] <= k)) i++;
+		else while ((i < end) && (level[i] < k)) i++;
+
+		if ((l == 1) || (i == 0)) return i;
+		node = i-1;
+	}
+
+	return 0;
+}
+
@@ -0,0 +1,110 @@
+/* HeaderIndex.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Cache-conscious index over the bucket headers of the Front-Coding based
+ * dictionaries. The prefix shared by all headers is stored once and the next
+ * 8 bytes of each header are stored as a big-endian integer in a dense array
+ * which is sampled, level by level, every HEADERFANOUT keys. The resulting implicit B-tree is traversed scanning a
+ * single cache line per level, so the binary search over the (bit-packed)
+ * header pointers only needs to compare those buckets whose headers share
+ * the first 8 bytes with the searched string.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#ifndef _HEADERINDEX_H
+#define _HEADERINDEX_H
+
+#include <iostream>
+using namespace std;
+
+#include <libcdsBasics.h>
+using namespace cds_utils;
+
+#include "LogSequence.h"
+
+/* Number of keys per node (one 64-byte cache line) */
+static const size_t HEADERFANOUT = 8;
+/* Maximum length of the prefix shared by all headers */
+static const uint MAXSKIP = 255;
+
+class HeaderIndex
+{
+	public:
+		/** Class Constructor.
+		    @param text: the strings representation.
+		    @param length: the length of the strings representation.
+		    @param positions: the header pointers (1..buckets).
+		    @param buckets: the number of buckets.
+		    @param terminated: true if the headers are compared as
+		      NUL-terminated strings (strcmp) and false if they are
+		      compared as raw byte sequences (memcmp).
+		*/
+		HeaderIndex(uchar *text, size_t length, LogSequence *positions, size_t buckets, bool terminated);
+
+		/** Narrows the range of candidate buckets for the given string.
+		    All buckets on the left of the range have a lower header
+		    and all buckets on the right of the range a greater one.
+		    @param str: the string to be located.
+		    @param strLen: the number of bytes compared (ignored for
+		      terminated headers).
+		    @param left: pointer to the left boundary bucket.
+		    @param right: pointer to the right boundary bucket.
+		*/
+		void narrow(const uchar *str, size_t strLen, size_t *left, size_t *right) const;
+
+		/** Computes the size of the structure in bytes. 
+		    @returns the index size in bytes.
+		*/
+		size_t getSize() const;
+
+		/** Generic destructor. */
+		~HeaderIndex();
+
+	protected:
+		bool terminated;	//! Headers compared as NUL-terminated strings
+		size_t buckets;		//! Number of buckets
+		uint skip;		//! Length of the prefix shared by all headers
+		uchar *prefix;		//! Prefix shared by all headers
+		uint levels;		//! Number of levels in the index
+		size_t *sizes;		//! Number of keys per level
+		uint64_t **keys;	//! Keys per level (level 0 stores all headers)
+
+		/** Builds the key for the given bytes.
+		    @param str: the bytes.
+		    @param len: the number of available bytes.
+		    @param fill: the byte used for padding.
+		    @returns the big-endian key.
+		*/
+		uint64_t key(const uchar *str, size_t len, uchar fill) const;
+
+		/** Counts the headers whose keys are lower than (or equal to)
+		    the given one.
+		    @param k: the key.
+		    @param equal: true if equal keys are also counted.
+		    @returns the number of headers.
+		*/
+		size_t rank(uint64_t k, bool equal) const;
+};
+
+#endif  /* _HEADERINDEX_H */
+
@@ -33,24 +33,31 @@
 
 LogSequence::LogSequence()
 {
+  mapping = NULL;
 }
 
-LogSequence::LogSequence(unsigned int numbits, size_t capacity)
+LogSequence::LogSequence(unsigned int numbits, size_t capacity, bool aligned)
 {
+  if (aligned) numbits = alignedNumbits(numbits, capacity);
+
   this->numbits = numbits;
   this->numentries = capacity;
   this->maxval = maxVal(numbits);
+  this->mapping = NULL;
 
   arraysize = numElementsFor(numbits, numentries);
   array = new size_t[arraysize];
   for (size_t i=0; i<arraysize; i++) array[i] = 0;
 }
 
-LogSequence::LogSequence(vector<size_t> *v, unsigned int numbits)
+LogSequence::LogSequence(vector<size_t> *v, unsigned int numbits, bool aligned)
 {
+  if (aligned) numbits = alignedNumbits(numbits, v->size());
+
   this->numbits = numbits;
   this->numentries = v->size();
   this->maxval = maxVal(numbits);
+  this->mapping = NULL;
 
   arraysize = numElementsFor(numbits, numentries);
   array = new size_t[arraysize];
@@ -61,6 +68,7 @@ LogSequence::LogSequence(vector<size_t> *v, unsigned int numbits)
 
 LogSequence::LogSequence(ifstream &in)
 {
+  mapping = NULL;
   numbits = loadValue<uchar>(in);
   numentries = loadValue<size_t>(in);
 
@@ -72,16 +80,92 @@ LogSequence::LogSequence(ifstream &in)
   array = (size_t*)loadValue<uchar>(in, numbytes);
 }
 
-size_t LogSequence::getField(size_t position)
+LogSequence::LogSequence(ifstream &in, MemoryMapping *mapping)
 {
-  if(position>numentries) {
-    throw "Trying to get an element bigger than the array.";
+  this->mapping = mapping;
+  numbits = loadValue<uchar>(in);
+  numentries = loadValue<size_t>(in);
+
+  maxval = maxVal(numbits);
+  size_t numbytes = numBytesFor(numbits, numentries);
+  if ((numbytes % 8) != 0) numbytes += 8-(numbytes%8);
+
+  arraysize = numElementsFor(numbits, numentries);
+  array = (size_t*)MemoryMapping::loadArray<uchar>(mapping, in, numbytes);
+}
+
+void LogSequence::getRange(size_t start, size_t count, size_t *out) const
+{
+  if(start+count>numentries) {
+    throw "Trying to get elements beyond the array.";
+  }
+  if (count == 0) return;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  // Byte-aligned widths are plain (widening) copies, which the compiler
+  // vectorizes
+  const uchar *bytes = (const uchar*)array;
+  switch (numbits) {
+    case 8:
+      for (size_t k=0; k<count; k++) out[k] = bytes[start+k];
+      return;
+    case 16: {
+      const uchar *p = bytes+2*start;
+      for (size_t k=0; k<count; k++) { uint16_t v; memcpy(&v, p+2*k, 2); out[k] = v; }
+      return;
+    }
+    case 32: {
+      const uchar *p = bytes+4*start;
+      for (size_t k=0; k<count; k++) { uint32_t v; memcpy(&v, p+4*k, 4); out[k] = v; }
+      return;
+    }
+    case 64:
+      memcpy(out, array+start, count*sizeof(size_t));
+      return;
   }
+#endif
+
+  // Any other width: the current word is kept and each field is taken
+  // from it (and from the next word when it straddles both)
+  size_t bitPos = start*numbits;
+  size_t i = bitPos/WLS;
+  unsigned int j = bitPos%WLS;
+  size_t word = get_word(array, i);
+
+  for (size_t k=0; k<count; k++) {
+    size_t value = word >> j;
+    j += numbits;
+
+    if (j >= WLS) {
+      j -= WLS;
+
+      // The next word is not read after the last field, which may end the array
+      if ((j > 0) || (k+1 < count)) {
+        word = get_word(array, ++i);
+        if (j > 0) value |= word << (numbits-j);
+      }
+    }
+
+    out[k] = value & maxval;
+  }
+}
 
-  return get_field(&array[0], numbits, position);
+unsigned int LogSequence::alignedNumbits(unsigned int numbits, size_t numentries)
+{
+  if (numbits == 0) return numbits;
+
+  unsigned int aligned = 8;
+  while (aligned < numbits) aligned <<= 1;
+  if (aligned == numbits) return numbits;
+
+  uint64_t packed = (uint64_t)numbits*numentries/8;
+  uint64_t extra = (uint64_t)(aligned-numbits)*numentries/8;
+
+  if ((extra <= LOGALIGNBYTES) || (100*extra <= LOGALIGNOVERHEAD*packed)) return aligned;
+  return numbits;
 }
 
-size_t LogSequence::getNumberOfElements()
+size_t LogSequence::getNumberOfElements() const
 {
   return numentries;
 }
@@ -98,7 +182,7 @@ void LogSequence::setField(size_t position, size_t value)
   set_field(array, numbits, position, value);
 }
 
-size_t LogSequence::getSize()
+size_t LogSequence::getSize() const
 {
   return numBytesFor(numbits, numentries)+sizeof(LogSequence)+sizeof(vector<size_t>);
 }
@@ -115,7 +199,43 @@ void LogSequence::save(ofstream &out)
 	saveValue<uchar>(out, (uchar*)array, numbytes);
 }
 
+void LogSequence::save(ofstream &out, FILE *values, size_t numentries, unsigned int numbits)
+{
+	saveValue<uchar>(out, numbits);
+	saveValue<size_t>(out, numentries);
+
+	size_t chunk[1024];
+	size_t word = 0;
+	unsigned int used = 0;
+
+	rewind(values);
+
+	for (size_t i=0; i<numentries; )
+	{
+		size_t read = fread(chunk, sizeof(size_t), (numentries-i < 1024) ? numentries-i : 1024, values);
+		if (read == 0) throw "Trying to save more values than those stored in the file.";
+
+		for (size_t j=0; j<read; j++)
+		{
+			// Fields are packed from the least significant bit, as set_field does
+			word |= chunk[j] << used;
+
+			if (used+numbits >= WLS)
+			{
+				saveValue<size_t>(out, word);
+				word = (used == 0) ? 0 : chunk[j] >> (WLS-used);
+				used = used+numbits-WLS;
+			}
+			else used += numbits;
+		}
+
+		i += read;
+	}
+
+	if (used > 0) saveValue<size_t>(out, word);
+}
+
 LogSequence::~LogSequence() 
 {
-	delete [] array;
+	MemoryMapping::release(mapping, array);
 }
@@ -37,9 +37,14 @@
 #include <vector>
 using namespace std;
 
+#include <stdio.h>
+#include <string.h>
 #include <libcdsBasics.h>
 using namespace cds_utils;
 
+#include "MemoryMapping.h"
+#include "Utils.h"
+
 class LogSequence
 {
 public:
@@ -50,26 +55,76 @@ public:
 	 */
 	LogSequence(ifstream &in);
 
+	/** Loads a stream from an InputStream, referencing the packed array
+	 *  directly within the memory mapping (if it is not NULL).
+	 *  @param input: the InputStream to load from
+	 *  @param mapping: the mapping of the file read by the InputStream
+	 */
+	LogSequence(ifstream &in, MemoryMapping *mapping);
+
 	/** Create a data structure where each entry needs numbits, reserve 
-	    enough space to store capacity entries.
+	    enough space to store capacity entries. If aligned is true, the
+	    width is rounded up as alignedNumbits() decides.
 	 */
-	LogSequence(unsigned int numbits, size_t capacity);
+	LogSequence(unsigned int numbits, size_t capacity, bool aligned=false);
 
 	/** Create a data structure for storing the given vector using numbits
-	    for each entry.
+	    for each entry. If aligned is true, the width is rounded up as
+	    alignedNumbits() decides.
 	 */
-	LogSequence(vector<size_t> *v, unsigned int numbits);
+	LogSequence(vector<size_t> *v, unsigned int numbits, bool aligned=false);
 
 	/** Gets the element in a specific position
 	 *  @param position: the position of the element to be returned
 	 *  @return int
 	 */
-	size_t getField(size_t position);
+	inline size_t getField(size_t position) const {
+		if(position>numentries) {
+			throw "Trying to get an element bigger than the array.";
+		}
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+		// Byte-aligned widths are read with a single (unaligned) load
+		const uchar *bytes = (const uchar*)array;
+		switch (numbits) {
+			case 8: return bytes[position];
+			case 16: { uint16_t v; memcpy(&v, bytes+2*position, 2); return v; }
+			case 32: { uint32_t v; memcpy(&v, bytes+4*position, 4); return v; }
+			case 64: return get_word(array, position);
+		}
+#endif
+		return get_field(array, numbits, position);
+	}
+
+	/** Gets count consecutive elements, which are unpacked sequentially
+	 *  (word by word) instead of being located one by one.
+	 *  @param start: the position of the first element
+	 *  @param count: the number of elements
+	 *  @param out: the array (of count elements) receiving the elements
+	 */
+	void getRange(size_t start, size_t count, size_t *out) const;
+
+	/** Chooses the width of a sequence: numbits is rounded up to the next
+	 *  byte-aligned width (8, 16, 32 or 64 bits), whose elements are read
+	 *  with a single load, when it increases the sequence space at most
+	 *  by LOGALIGNOVERHEAD percent (or by LOGALIGNBYTES bytes).
+	 *  @param numbits: the minimum number of bits per element
+	 *  @param numentries: the number of elements
+	 *  @returns the number of bits per element
+	 */
+	static unsigned int alignedNumbits(unsigned int numbits, size_t numentries);
+
+	/** Prefetches the word storing the element in a specific position
+	 *  @param position: the position of the element to be prefetched
+	 */
+	inline void prefetch(size_t position) const {
+		__builtin_prefetch(array+(position*numbits)/WLS);
+	}
 
 	/** Gets the total number of elements in the stream
 	 *  @return int
 	 */
-	size_t getNumberOfElements();
+	size_t getNumberOfElements() const;
 
 	/** Sets the element in a specific position
 	 *  @param position: the position of the new element
@@ -78,16 +133,26 @@ public:
 	void setField(size_t position, size_t value);
 
 	/** Gets the total size in bytes of the data structure. */
-	size_t getSize();
+	size_t getSize() const;
 
 	/** Saves the stream 
 	 *  @param output: the OutputStream to be saved to
 	 */
 	void save(ofstream &out);
 
+	/** Saves a sequence of values read from a temporary file, with
+	 *  the same layout as save(). The values are packed as they are
+	 *  read, so the sequence is never loaded into memory.
+	 *  @param out: the OutputStream to be saved to
+	 *  @param values: binary file of size_t values (read from the beginning)
+	 *  @param numentries: number of values in the file
+	 *  @param numbits: number of bits used for each value
+	 */
+	static void save(ofstream &out, FILE *values, size_t numentries, unsigned int numbits);
+
 	/** Returns the number of bits effectively used for each position
 	 */
-	uint getNumbits() { return numbits; }
+	uint getNumbits() const { return numbits; }
 
 	/** Destructor. */
 	virtual ~LogSequence();
@@ -98,16 +163,17 @@ private:
 	size_t numentries;
 	size_t maxval;
 	size_t *array;
+	MemoryMapping *mapping; //! Mapping containing the array (if any)
 
 	static const unsigned int WLS = sizeof(size_t)*8;
 
 	/** size_t's required to represent n integers of e bits each */
-	inline size_t numElementsFor(const size_t bitsField, const size_t numEntries) {
+	inline size_t numElementsFor(const size_t bitsField, const size_t numEntries) const {
 		return (((uint64_t)bitsField*numEntries+WLS-1)/WLS);
 	}
 
 	/** Number of bytes required to represent n integers of e bits each */
-	inline size_t numBytesFor(const size_t bitsField, const size_t numEntries) {
+	inline size_t numBytesFor(const size_t bitsField, const size_t numEntries) const {
 		return ((uint64_t)bitsField*numEntries+7)/8;
 	}
 
@@ -116,21 +182,33 @@ private:
 	 * @param bitsField Length in bits of each field
 	 * @param index Position to store in
 	 */
-	inline size_t get_field(const size_t *data, const size_t bitsField, const size_t index) {
+	inline size_t get_field(const size_t *data, const size_t bitsField, const size_t index) const {
 		size_t bitPos = index*bitsField;
 		size_t i=bitPos/WLS;
 		size_t j=bitPos%WLS;
 		size_t result;
 
 		if (j+bitsField <= WLS) {
-			result = (data[i] << (WLS-j-bitsField)) >> (WLS-bitsField);
+			result = (get_word(data, i) << (WLS-j-bitsField)) >> (WLS-bitsField);
 		} else {
-			result = data[i] >> j;
-			result = result | (data[i+1] << ( (WLS<<1) -j-bitsField)) >> (WLS-bitsField);
+			result = get_word(data, i) >> j;
+			result = result | (get_word(data, i+1) << ( (WLS<<1) -j-bitsField)) >> (WLS-bitsField);
 		}
 		return result;
 	}
 
+	/** Reads the i-th word of the array. Mapped arrays are not required
+	 * to be word-aligned, so the read is performed through memcpy (which
+	 * is compiled into a single load).
+	 * @param data Array
+	 * @param i Word position
+	 */
+	inline size_t get_word(const size_t *data, const size_t i) const {
+		size_t word;
+		memcpy(&word, data+i, sizeof(size_t));
+		return word;
+	}
+
 	/** Store a given value in index into array A where every value uses len bits
 	 * @param data Array
 	 * @param bitsField Length in bits of each field
@@ -157,7 +235,7 @@ private:
 		return b;
 	}
 
-	inline size_t maxVal(unsigned int numbits) {
+	inline size_t maxVal(unsigned int numbits) const {
 	    // The << operator is undefined for the number of bits of the word,
 	    // Therefore we need to check for corner cases.
 	    if(numbits==32) {
@@ -0,0 +1,130 @@
+/* MembershipFilter.cpp
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Approximate membership filter (blocked Bloom filter) over the strings of
+ * a dictionary.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#include <string.h>
+
+#include "MembershipFilter.h"
+#include "../StringDictionary.h"
+
+MembershipFilter::MembershipFilter()
+{
+	this->blocks = 0;
+	this->words = NULL;
+	this->mapping = NULL;
+}
+
+MembershipFilter::MembershipFilter(const StringDictionary *dict, uint bits)
+{
+	build(dict->extractTable(), dict->numElements(), bits, true);
+}
+
+MembershipFilter::MembershipFilter(IteratorDictString *it, size_t elements, uint bits)
+{
+	build(it, elements, bits, false);
+}
+
+void
+MembershipFilter::build(IteratorDictString *it, size_t elements, uint bits, bool owned)
+{
+	// Each block holds 512 bits
+	size_t total = elements*bits;
+	this->blocks = (total+(64*FILTERBLOCK)-1)/(64*FILTERBLOCK);
+	if (this->blocks == 0) this->blocks = 1;
+
+	this->words = new uint64_t[blocks*FILTERBLOCK];
+	memset(words, 0, blocks*FILTERBLOCK*sizeof(uint64_t));
+	this->mapping = NULL;
+
+	while (it->hasNext())
+	{
+		uint strLen;
+		uchar *str = it->next(&strLen);
+
+		insert(str, strLen);
+		if (owned) delete [] str;
+	}
+
+	delete it;
+}
+
+void
+MembershipFilter::insert(const uchar *str, uint strLen)
+{
+	uint64_t h = wordhash((uchar*)str, strLen, FILTERSEED);
+	uint64_t *block = words+FILTERBLOCK*fast_range(h, blocks);
+	uint64_t offsets = avalanche(h ^ FILTERSEED);
+
+	for (uint i=0; i<FILTERPROBES; i++, offsets >>= 9)
+	{
+		uint bit = offsets & 511;
+		block[bit >> 6] |= (1ULL << (bit & 63));
+	}
+}
+
+size_t
+MembershipFilter::getSize() const
+{
+	return blocks*FILTERBLOCK*sizeof(uint64_t)+sizeof(MembershipFilter);
+}
+
+void
+MembershipFilter::save(ofstream &out)
+{
+	saveValue<uint32_t>(out, MEMBERSHIPFILTER);
+	saveValue<uint64_t>(out, blocks);
+	saveValue<uint64_t>(out, words, blocks*FILTERBLOCK);
+}
+
+MembershipFilter*
+MembershipFilter::load(ifstream &in, MemoryMapping *mapping)
+{
+	streampos pos = in.tellg();
+	uint32_t mark = 0;
+
+	in.read((char*)&mark, sizeof(uint32_t));
+
+	if (!in.good() || (mark != MEMBERSHIPFILTER))
+	{
+		// No filter is stored after the dictionary
+		in.clear();
+		in.seekg(pos, ios_base::beg);
+		return NULL;
+	}
+
+	MembershipFilter *filter = new MembershipFilter();
+	filter->blocks = loadValue<uint64_t>(in);
+	filter->words = MemoryMapping::loadArray<uint64_t>(mapping, in, filter->blocks*FILTERBLOCK);
+	filter->mapping = mapping;
+
+	return filter;
+}
+
+MembershipFilter::~MembershipFilter()
+{
+	if (words != NULL) MemoryMapping::release<uint64_t>(mapping, words);
+}
@@ -0,0 +1,136 @@
+/* MembershipFilter.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Approximate membership filter (blocked Bloom filter) over the strings of
+ * a dictionary. Each string sets FILTERPROBES bits within a single block
+ * of 512 bits, so a query reads one cache line. There are no false
+ * negatives: a negative answer proves that the string is not in the
+ * dictionary, and locate returns without accessing the compressed strings.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#ifndef _MEMBERSHIPFILTER_H
+#define _MEMBERSHIPFILTER_H
+
+#include <iostream>
+using namespace std;
+
+#include <libcdsBasics.h>
+using namespace cds_utils;
+
+#include "../Hash/HashUtils.h"
+#include "MemoryMapping.h"
+#include "Utils.h"
+
+class IteratorDictString;
+class StringDictionary;
+
+class MembershipFilter
+{
+	public:
+		/** Class Constructor. All strings are sequentially scanned.
+		    @param dict: the filtered dictionary.
+		    @param bits: number of bits per string.
+		*/
+		MembershipFilter(const StringDictionary *dict, uint bits=FILTERBITS);
+
+		/** Class Constructor. The strings are taken from an iterator
+		    over the original set of strings (as the one given to the
+		    dictionary constructors), so dictionaries streamed to disk
+		    can be filtered.
+		    @param it: the iterator (it is released, but not the
+		      strings it returns).
+		    @param elements: the number of strings in the iterator.
+		    @param bits: number of bits per string.
+		*/
+		MembershipFilter(IteratorDictString *it, size_t elements, uint bits=FILTERBITS);
+
+		/** Checks if the given string may be in the dictionary.
+		    @param str: the string to be checked.
+		    @param strLen: the string length.
+		    @returns false if the string is not in the dictionary; true
+		      if it is (or it is a false positive).
+		*/
+		bool contains(const uchar *str, uint strLen) const
+		{
+			uint64_t h = wordhash((uchar*)str, strLen, FILTERSEED);
+			const uint64_t *block = words+FILTERBLOCK*fast_range(h, blocks);
+
+			// The offsets are taken from a second mix of the hash,
+			// because fast_range depends on its highest bits
+			uint64_t offsets = avalanche(h ^ FILTERSEED);
+
+			for (uint i=0; i<FILTERPROBES; i++, offsets >>= 9)
+			{
+				uint bit = offsets & 511;
+				if ((block[bit >> 6] & (1ULL << (bit & 63))) == 0) return false;
+			}
+
+			return true;
+		}
+
+		/** Computes the size of the structure in bytes.
+		    @returns the filter size in bytes.
+		*/
+		size_t getSize() const;
+
+		/** Stores the filter into an ofstream (after the dictionary).
+		    @param out: the oftstream.
+		*/
+		void save(ofstream &out);
+
+		/** Loads the filter stored after the dictionary (if any). The
+		    stream is left unchanged when no filter is found.
+		    @param in: the ifstream.
+		    @param mapping: the memory mapping of the file (or NULL).
+		    @returns the loaded filter (or NULL).
+		*/
+		static MembershipFilter *load(ifstream &in, MemoryMapping *mapping);
+
+		/** Generic destructor. */
+		~MembershipFilter();
+
+	protected:
+		uint64_t blocks;		//! Number of blocks
+		uint64_t *words;		//! Bits of the blocks
+		MemoryMapping *mapping;		//! Mapping in which the bits are referenced (or NULL)
+
+		/** Generic Constructor. */
+		MembershipFilter();
+
+		/** Sizes the blocks and inserts all strings in the iterator.
+		    @param it: the iterator (which is released).
+		    @param elements: the number of strings in the iterator.
+		    @param bits: number of bits per string.
+		    @param owned: true if the returned strings must be released.
+		*/
+		void build(IteratorDictString *it, size_t elements, uint bits, bool owned);
+
+		/** Sets the bits of the given string.
+		    @param str: the string to be inserted.
+		    @param strLen: the string length.
+		*/
+		void insert(const uchar *str, uint strLen);
+};
+
+#endif  /* _MEMBERSHIPFILTER_H */
@@ -0,0 +1,83 @@
+/* MemoryMapping.cpp
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Read-only memory mapping of a serialized dictionary. It allows the large
+ * payload sections (string buffers, packed arrays) to be used in place
+ * instead of being copied into the heap at loading time.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "MemoryMapping.h"
+
+MemoryMapping::MemoryMapping(const char *filename)
+{
+	data = NULL; length = 0;
+
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0) return;
+
+	struct stat st;
+
+	if ((fstat(fd, &st) == 0) && (st.st_size > 0))
+	{
+		void *addr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+		if (addr != MAP_FAILED)
+		{
+			data = (uchar*)addr;
+			length = st.st_size;
+		}
+	}
+
+	// The mapping remains valid after closing the descriptor
+	close(fd);
+}
+
+bool
+MemoryMapping::isMapped()
+{
+	return data != NULL;
+}
+
+size_t
+MemoryMapping::getLength()
+{
+	return length;
+}
+
+bool
+MemoryMapping::contains(const void *ptr)
+{
+	return (data != NULL) && ((uchar*)ptr >= data) && ((uchar*)ptr < data+length);
+}
+
+MemoryMapping::~MemoryMapping()
+{
+	if (data != NULL) munmap(data, length);
+}
+
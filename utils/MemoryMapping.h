@@ -0,0 +1,107 @@
+/* MemoryMapping.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Read-only memory mapping of a serialized dictionary. It allows the large
+ * payload sections (string buffers, packed arrays) to be used in place
+ * instead of being copied into the heap at loading time.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+
+#ifndef _MEMORYMAPPING_H
+#define _MEMORYMAPPING_H
+
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+#include <libcdsBasics.h>
+using namespace cds_utils;
+
+class MemoryMapping
+{
+	public:
+		/** Maps the given file in read-only mode.
+		    @param filename: the file to be mapped.
+		*/
+		MemoryMapping(const char *filename);
+
+		/** Checks if the file has been successfully mapped.
+		    @returns true if the mapping is available.
+		*/
+		bool isMapped();
+
+		/** Obtains the mapped length.
+		    @returns the length (in bytes) of the mapped file.
+		*/
+		size_t getLength();
+
+		/** Checks if the given pointer references the mapped region.
+		    @param ptr: the pointer to be checked.
+		    @returns true if the pointer is within the mapping.
+		*/
+		bool contains(const void *ptr);
+
+		/** Loads an array of 'len' values from the current position of
+		    the stream. The array is directly referenced within the
+		    mapping if the section is suitably aligned for T; otherwise
+		    it is copied into the heap (as loadValue does). In both
+		    cases, the stream is placed after the array.
+		    @param mapping: the mapping (it can be NULL).
+		    @param in: the ifstream (opened on the mapped file).
+		    @param len: the number of values in the array.
+		    @returns the array.
+		*/
+		template <typename T> static T* loadArray(MemoryMapping *mapping, ifstream &in, size_t len)
+		{
+			if ((mapping == NULL) || (len == 0)) return loadValue<T>(in, len);
+
+			size_t offset = in.tellg();
+			uchar *ptr = mapping->data+offset;
+
+			if ((offset+len*sizeof(T) > mapping->length) || (((size_t)ptr % __alignof__(T)) != 0))
+				return loadValue<T>(in, len);
+
+			in.seekg(len*sizeof(T), ios_base::cur);
+			return (T*)ptr;
+		}
+
+		/** Frees an array obtained through loadArray.
+		    @param mapping: the mapping (it can be NULL).
+		    @param array: the array to be freed.
+		*/
+		template <typename T> static void release(MemoryMapping *mapping, T *array)
+		{
+			if ((mapping == NULL) || !mapping->contains(array)) delete [] array;
+		}
+
+		/** Unmaps the file. */
+		~MemoryMapping();
+
+	protected:
+		uchar *data;	//! Mapped region
+		size_t length;	//! Length of the mapped region
+};
+
+#endif  /* _MEMORYMAPPING_H */
+
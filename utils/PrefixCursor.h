@@ -0,0 +1,192 @@
+/* PrefixCursor.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Resumable position within the (alphabetically sorted) elements prefixed
+ * by a given string. It keeps the range of ranks obtained by the boundary
+ * search and the next rank to be reported, so the results of a prefix
+ * query can be paginated without searching the prefix again. It is small
+ * and serializable, so it can also be handed to a client and restored.
+ * The type and the number of elements of the dictionary are also kept,
+ * so cursors obtained from a different dictionary can be rejected.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+
+#ifndef _PREFIXCURSOR_H
+#define _PREFIXCURSOR_H
+
+#include <fstream>
+using namespace std;
+
+#include <libcdsBasics.h>
+using namespace cds_utils;
+
+#include "Utils.h"
+
+class PrefixCursor
+{
+	public:
+		/** Generic constructor.
+		    @param left: the first rank in the range.
+		    @param right: the rank following the last one in the range.
+		    @param sorted: true if the IDs are the ranks themselves.
+		    @param type: the type of the dictionary.
+		    @param elements: the number of elements in the dictionary.
+		*/
+		PrefixCursor(size_t left, size_t right, bool sorted, uint32_t type, size_t elements)
+		{
+			this->left = left;
+			this->right = (right > left) ? right : left;
+			this->position = this->left;
+			this->sorted = sorted;
+			this->type = type;
+			this->elements = elements;
+		}
+
+		/** Checks if the cursor was obtained from a dictionary with the
+		    given type and number of elements, and its range lies within
+		    the dictionary.
+		    @param type: the type of the dictionary.
+		    @param elements: the number of elements in the dictionary.
+		    @returns if the cursor can be used in the dictionary.
+		*/
+		bool matches(uint32_t type, size_t elements) const
+		{
+			return (this->type == type) && (this->elements == elements) && (right <= elements+1);
+		}
+
+		/** Checks for non-reported elements in the range.
+		    @returns if remains non-reported elements.
+		*/
+		bool hasNext() const
+		{
+			return position < right;
+		}
+
+		/** Retrieves the number of elements prefixed by the string.
+		    @returns the range size.
+		*/
+		size_t count() const
+		{
+			return right-left;
+		}
+
+		/** Retrieves the number of non-reported elements.
+		    @returns the remaining elements.
+		*/
+		size_t remaining() const
+		{
+			return right-position;
+		}
+
+		/** Retrieves the offset (within the range) of the next element
+		    to be reported.
+		    @returns the offset.
+		*/
+		size_t getOffset() const
+		{
+			return position-left;
+		}
+
+		/** Moves the cursor to the given offset within the range.
+		    Offsets beyond the range exhaust the cursor.
+		    @param offset: number of elements skipped from the first one.
+		*/
+		void seek(size_t offset)
+		{
+			position = (offset < count()) ? left+offset : right;
+		}
+
+		/** Consumes (at most) limit elements, returning their ranks.
+		    @param limit: maximum number of elements.
+		    @param first: the first consumed rank.
+		    @returns the number of consumed elements.
+		*/
+		size_t advance(size_t limit, size_t *first)
+		{
+			size_t n = (limit < remaining()) ? limit : remaining();
+
+			*first = position;
+			position += n;
+			return n;
+		}
+
+		/** Checks if the ranks in the range are also the IDs (that is,
+		    the dictionary keeps its elements sorted).
+		    @returns if the ranks are the IDs.
+		*/
+		bool isSorted() const
+		{
+			return sorted;
+		}
+
+		/** Saves the cursor into an ofstream.
+		    @param out: the oftstream.
+		*/
+		void save(ofstream &out) const
+		{
+			saveValue<uint32_t>(out, PREFIXCURSOR);
+			saveValue<uint64_t>(out, left);
+			saveValue<uint64_t>(out, right);
+			saveValue<uint64_t>(out, position);
+			saveValue<uchar>(out, sorted ? 1 : 0);
+			saveValue<uint32_t>(out, type);
+			saveValue<uint64_t>(out, elements);
+		}
+
+		/** Loads a cursor from an ifstream.
+		    @param in: the ifstream.
+		    @returns the loaded cursor (or NULL if the stream does not
+		      contain a cursor).
+		*/
+		static PrefixCursor *load(ifstream &in)
+		{
+			uint32_t mark = loadValue<uint32_t>(in);
+			if (!in.good() || (mark != PREFIXCURSOR)) return NULL;
+
+			size_t left = loadValue<uint64_t>(in);
+			size_t right = loadValue<uint64_t>(in);
+			size_t position = loadValue<uint64_t>(in);
+			bool sorted = (loadValue<uchar>(in) != 0);
+			uint32_t type = loadValue<uint32_t>(in);
+			size_t elements = loadValue<uint64_t>(in);
+			if (!in.good()) return NULL;
+
+			PrefixCursor *cursor = new PrefixCursor(left, right, sorted, type, elements);
+			cursor->seek(position-left);
+			return cursor;
+		}
+
+		/** Generic destructor. */
+		~PrefixCursor() {}
+
+	protected:
+		size_t left;		//! First rank in the range
+		size_t right;		//! Rank following the last one in the range
+		size_t position;	//! Next rank to be reported
+		bool sorted;		//! The ranks are also the IDs
+		uint32_t type;		//! Type of the dictionary
+		size_t elements;	//! Number of elements in the dictionary
+};
+
+#endif  /* _PREFIXCURSOR_H */
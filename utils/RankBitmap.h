@@ -0,0 +1,85 @@
+/* RankBitmap.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Build-time choice of the rank/select bitmaps used by the hash tables,
+ * the DACs and the (plain) FM-Index. By default they are BitSequenceRG;
+ * compiling with -DCACHELINE_RANK replaces them with BitSequenceCL, which
+ * keeps the rank counters in the same cache line as the bits (faster
+ * queries at the cost of a slightly larger bitmap). Loading does not
+ * depend on this choice: any stored bitmap is restored with its own type.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#ifndef _RANKBITMAP_H
+#define _RANKBITMAP_H
+
+#include <BitSequence.h>
+#include <BitSequenceBuilder.h>
+using namespace cds_static;
+
+/** Builds a rank/select bitmap over the first n bits of bitarray.
+    @param bitarray: the bits.
+    @param n: the bitmap length.
+    @param factor: sampling factor (only used by BitSequenceRG).
+    @returns the bitmap.
+*/
+inline BitSequence *
+buildRankBitmap(uint *bitarray, size_t n, uint factor)
+{
+#ifdef CACHELINE_RANK
+	return new BitSequenceCL(bitarray, n);
+#else
+	return new BitSequenceRG(bitarray, n, factor);
+#endif
+}
+
+/** Builds a rank/select bitmap from a BitString.
+    @param bs: the bits.
+    @param factor: sampling factor (only used by BitSequenceRG).
+    @returns the bitmap.
+*/
+inline BitSequence *
+buildRankBitmap(const BitString &bs, uint factor)
+{
+#ifdef CACHELINE_RANK
+	return new BitSequenceCL(bs);
+#else
+	return new BitSequenceRG(bs, factor);
+#endif
+}
+
+/** Creates a builder of rank/select bitmaps (for the sequences).
+    @param factor: sampling factor (only used by BitSequenceRG).
+    @returns the builder.
+*/
+inline BitSequenceBuilder *
+rankBitmapBuilder(uint factor)
+{
+#ifdef CACHELINE_RANK
+	return new BitSequenceBuilderCL();
+#else
+	return new BitSequenceBuilderRG(factor);
+#endif
+}
+
+#endif  /* _RANKBITMAP_H */
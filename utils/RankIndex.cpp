@@ -0,0 +1,185 @@
+/* RankIndex.cpp
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Alphabetical permutation of the IDs of a dictionary which does not keep
+ * its strings sorted (hash-based dictionaries). It stores the ID of each
+ * string in lexicographic order using ceil(log n) bits per string, so rank
+ * operations are direct and prefix operations binary search the ranks 
+ * extracting O(log n) strings.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#include "RankIndex.h"
+#include "../StringDictionary.h"
+
+/** Comparator sorting the IDs by their strings. */
+struct SortByString
+{
+	vector<uchar*> *strings;
+	bool operator()(size_t i, size_t j) const { return strcmp((char*)(*strings)[i], (char*)(*strings)[j]) < 0; }
+};
+
+RankIndex::RankIndex()
+{
+	this->dict = NULL;
+	this->elements = 0;
+	this->ids = NULL;
+}
+
+RankIndex::RankIndex(const StringDictionary *dict)
+{
+	this->dict = dict;
+	this->elements = dict->numElements();
+
+	vector<uchar*> strings(elements+1, (uchar*)NULL);
+	vector<size_t> sorted(elements);
+
+	for (size_t id=1; id<=elements; id++)
+	{
+		uint strLen;
+		strings[id] = dict->extract(id, &strLen);
+		sorted[id-1] = id;
+	}
+
+	SortByString cmp = {&strings};
+	std::sort(sorted.begin(), sorted.end(), cmp);
+
+	for (size_t id=1; id<=elements; id++) delete [] strings[id];
+
+	ids = new LogSequence(&sorted, bits(elements));
+}
+
+size_t
+RankIndex::locateRank(size_t rank) const
+{
+	if ((rank == 0) || (rank > elements)) return NORESULT;
+	return ids->getField(rank-1);
+}
+
+uchar*
+RankIndex::extractRank(size_t rank, uint *strLen) const
+{
+	if ((rank == 0) || (rank > elements)) { *strLen = 0; return NULL; }
+	return dict->extract(ids->getField(rank-1), strLen);
+}
+
+IteratorDictID*
+RankIndex::locatePrefix(uchar *str, uint strLen) const
+{
+	size_t left, right;
+	locateBoundaries(str, strLen, &left, &right);
+
+	return new IteratorDictIDRank(this, left, right-left);
+}
+
+IteratorDictString*
+RankIndex::extractPrefix(uchar *str, uint strLen) const
+{
+	size_t left, right;
+	locateBoundaries(str, strLen, &left, &right);
+
+	return new IteratorDictStringRank(this, left, right-left);
+}
+
+size_t
+RankIndex::getSize() const
+{
+	return ids->getSize()+sizeof(RankIndex);
+}
+
+void
+RankIndex::save(ofstream &out)
+{
+	saveValue<uint32_t>(out, RANKINDEX);
+	saveValue<uint64_t>(out, elements);
+	ids->save(out);
+}
+
+RankIndex*
+RankIndex::load(ifstream &in, const StringDictionary *dict, MemoryMapping *mapping)
+{
+	streampos pos = in.tellg();
+	uint32_t mark = 0;
+
+	in.read((char*)&mark, sizeof(uint32_t));
+
+	if (!in.good() || (mark != RANKINDEX))
+	{
+		// No index is stored after the dictionary
+		in.clear();
+		in.seekg(pos, ios_base::beg);
+		return NULL;
+	}
+
+	RankIndex *index = new RankIndex();
+	index->dict = dict;
+	index->elements = loadValue<uint64_t>(in);
+	index->ids = new LogSequence(in, mapping);
+
+	return index;
+}
+
+RankIndex::~RankIndex()
+{
+	if (ids != NULL) delete ids;
+}
+
+void
+RankIndex::locateBoundaries(uchar *str, uint strLen, size_t *left, size_t *right) const
+{
+	// First rank whose string is not lower than the prefix
+	size_t l = 1, r = elements+1;
+
+	while (l < r)
+	{
+		size_t c = (l+r)/2;
+		if (compare(c, str, strLen) < 0) l = c+1;
+		else r = c;
+	}
+
+	*left = l;
+
+	// First rank whose string is greater than the prefix
+	r = elements+1;
+
+	while (l < r)
+	{
+		size_t c = (l+r)/2;
+		if (compare(c, str, strLen) <= 0) l = c+1;
+		else r = c;
+	}
+
+	*right = l;
+}
+
+int
+RankIndex::compare(size_t rank, uchar *str, uint strLen) const
+{
+	uint len;
+	uchar *current = dict->extract(ids->getField(rank-1), &len);
+	int cmp = strncmp((char*)current, (char*)str, strLen);
+
+	delete [] current;
+	return cmp;
+}
+
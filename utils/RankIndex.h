@@ -0,0 +1,133 @@
+/* RankIndex.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Alphabetical permutation of the IDs of a dictionary which does not keep
+ * its strings sorted (hash-based dictionaries). It stores the ID of each
+ * string in lexicographic order using ceil(log n) bits per string, so rank
+ * operations are direct and prefix operations binary search the ranks 
+ * extracting O(log n) strings.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#ifndef _RANKINDEX_H
+#define _RANKINDEX_H
+
+#include <iostream>
+using namespace std;
+
+#include <libcdsBasics.h>
+using namespace cds_utils;
+
+#include "LogSequence.h"
+#include "MemoryMapping.h"
+
+class StringDictionary;
+class IteratorDictID;
+class IteratorDictString;
+
+class RankIndex
+{
+	public:
+		/** Class Constructor. All strings are extracted and sorted.
+		    @param dict: the indexed dictionary.
+		*/
+		RankIndex(const StringDictionary *dict);
+
+		/** Retrieves the ID with the given alphabetical rank.
+		    @param rank: the alphabetical ranking.
+		    @returns the ID (or NORESULT).
+		*/
+		size_t locateRank(size_t rank) const;
+
+		/** Obtains the string with the given alphabetical rank.
+		    @param rank: the alphabetical ranking.
+		    @param strLen: pointer to the extracted string length.
+		    @returns the requested string (or NULL).
+		*/
+		uchar* extractRank(size_t rank, uint *strLen) const;
+
+		/** Locates all IDs of those elements prefixed by the given 
+		    string (in alphabetical order).
+		    @param str: the prefix to be searched.
+		    @param strLen: the prefix length.
+		    @returns an iterator for direct scanning of all the IDs.
+		*/
+		IteratorDictID* locatePrefix(uchar *str, uint strLen) const;
+
+		/** Extracts all elements prefixed by the given string (in 
+		    alphabetical order).
+		    @param str: the prefix to be searched.
+		    @param strLen: the prefix length.
+		    @returns an iterator for direct scanning of all the strings.
+		*/
+		IteratorDictString* extractPrefix(uchar *str, uint strLen) const;
+
+		/** Computes the size of the structure in bytes. 
+		    @returns the index size in bytes.
+		*/
+		size_t getSize() const;
+
+		/** Stores the index into an ofstream (after the dictionary).
+		    @param out: the oftstream.
+		*/
+		void save(ofstream &out);
+
+		/** Loads the index stored after the dictionary (if any). The
+		    stream is left unchanged when no index is found.
+		    @param in: the ifstream.
+		    @param dict: the indexed dictionary.
+		    @param mapping: the memory mapping of the file (or NULL).
+		    @returns the loaded index (or NULL).
+		*/
+		static RankIndex *load(ifstream &in, const StringDictionary *dict, MemoryMapping *mapping);
+
+		/** Generic destructor. */
+		~RankIndex();
+
+	protected:
+		const StringDictionary *dict;	//! Indexed dictionary
+		uint64_t elements;		//! Number of strings
+		LogSequence *ids;		//! ID of each string (by rank)
+
+		/** Generic Constructor. */
+		RankIndex();
+
+		/** Computes the range of ranks prefixed by the given string.
+		    @param str: the prefix to be searched.
+		    @param strLen: the prefix length.
+		    @param left: pointer to the first rank.
+		    @param right: pointer to the rank following the last one.
+		*/
+		void locateBoundaries(uchar *str, uint strLen, size_t *left, size_t *right) const;
+
+		/** Compares the prefix of the string with the given rank.
+		    @param rank: the alphabetical ranking.
+		    @param str: the prefix to be compared.
+		    @param strLen: the prefix length.
+		    @returns the strncmp value.
+		*/
+		int compare(size_t rank, uchar *str, uint strLen) const;
+};
+
+#endif  /* _RANKINDEX_H */
+
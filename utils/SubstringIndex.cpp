@@ -0,0 +1,293 @@
+/* SubstringIndex.cpp
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Auxiliary q-gram index for substring search in dictionaries which do not
+ * support it natively. The IDs are grouped in blocks of consecutive IDs 
+ * (the buckets of Front-Coding based dictionaries) and each q-gram in the
+ * dictionary stores the list of blocks containing it. A substring query 
+ * intersects the lists of its q-grams and only decodes the candidate 
+ * blocks to verify them.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#include <algorithm>
+
+#include "SubstringIndex.h"
+#include "../StringDictionary.h"
+
+SubstringIndex::SubstringIndex()
+{
+	this->dict = NULL;
+	this->elements = 0;
+	this->blocksize = 0;
+
+	this->grams = NULL;
+	this->offsets = NULL;
+	this->blocks = NULL;
+}
+
+SubstringIndex::SubstringIndex(const StringDictionary *dict, uint blocksize)
+{
+	this->dict = dict;
+	this->elements = dict->numElements();
+	this->blocksize = blocksize;
+
+	// Collecting the pairs (q-gram, block) in the dictionary. The block
+	// is stored in the lower GRAMSHIFT bits.
+	const uint GRAMSHIFT = 40;
+	vector<uint64_t> pairs, current;
+
+	IteratorDictString *it = dict->extractTable();
+	size_t id = 0;
+
+	while (it->hasNext())
+	{
+		uint strLen;
+		uchar *str = it->next(&strLen);
+		uint64_t block = id/blocksize;
+
+		for (uint i=0; i+SUBSTRGRAM<=strLen; i++)
+			current.push_back(((uint64_t)gram(str+i) << GRAMSHIFT) | block);
+
+		delete [] str;
+		id++;
+
+		// The q-grams of the block are deduplicated when it is closed
+		if (((id % blocksize) == 0) || !it->hasNext())
+		{
+			std::sort(current.begin(), current.end());
+			current.erase(std::unique(current.begin(), current.end()), current.end());
+
+			pairs.insert(pairs.end(), current.begin(), current.end());
+			current.clear();
+		}
+	}
+
+	delete it;
+
+	std::sort(pairs.begin(), pairs.end());
+
+	// Building the inverted lists
+	size_t nblocks = (elements+blocksize-1)/blocksize;
+	vector<size_t> vgrams, voffsets, vblocks(pairs.size());
+
+	for (size_t i=0; i<pairs.size(); i++)
+	{
+		size_t g = pairs[i] >> GRAMSHIFT;
+
+		if (vgrams.empty() || (vgrams.back() != g))
+		{
+			vgrams.push_back(g);
+			voffsets.push_back(i);
+		}
+
+		vblocks[i] = pairs[i] & (((uint64_t)1 << GRAMSHIFT)-1);
+	}
+
+	voffsets.push_back(pairs.size());
+
+	grams = new LogSequence(&vgrams, 8*SUBSTRGRAM);
+	offsets = new LogSequence(&voffsets, bits(pairs.size()));
+	blocks = new LogSequence(&vblocks, bits(nblocks));
+}
+
+IteratorDictID*
+SubstringIndex::locate(uchar *str, uint strLen) const
+{
+	vector<size_t> ids;
+	search(str, strLen, &ids, NULL);
+
+	size_t *result = new size_t[ids.size()+1];
+	for (size_t i=0; i<ids.size(); i++) result[i] = ids[i];
+
+	return new IteratorDictIDNoContiguous(result, ids.size());
+}
+
+IteratorDictString*
+SubstringIndex::extract(uchar *str, uint strLen) const
+{
+	vector<size_t> ids;
+	vector<uchar*> strings;
+	search(str, strLen, &ids, &strings);
+
+	return new IteratorDictStringVector(&strings, strings.size());
+}
+
+size_t
+SubstringIndex::getSize() const
+{
+	return grams->getSize()+offsets->getSize()+blocks->getSize()+sizeof(SubstringIndex);
+}
+
+void
+SubstringIndex::save(ofstream &out)
+{
+	saveValue<uint32_t>(out, SUBSTRINDEX);
+	saveValue<uint64_t>(out, elements);
+	saveValue<uint32_t>(out, blocksize);
+
+	grams->save(out);
+	offsets->save(out);
+	blocks->save(out);
+}
+
+SubstringIndex*
+SubstringIndex::load(ifstream &in, const StringDictionary *dict, MemoryMapping *mapping)
+{
+	streampos pos = in.tellg();
+	uint32_t mark = 0;
+
+	in.read((char*)&mark, sizeof(uint32_t));
+
+	if (!in.good() || (mark != SUBSTRINDEX))
+	{
+		// No index is stored after the dictionary
+		in.clear();
+		in.seekg(pos, ios_base::beg);
+		return NULL;
+	}
+
+	SubstringIndex *index = new SubstringIndex();
+	index->dict = dict;
+	index->elements = loadValue<uint64_t>(in);
+	index->blocksize = loadValue<uint32_t>(in);
+
+	index->grams = new LogSequence(in, mapping);
+	index->offsets = new LogSequence(in, mapping);
+	index->blocks = new LogSequence(in, mapping);
+
+	return index;
+}
+
+SubstringIndex::~SubstringIndex()
+{
+	if (grams != NULL) delete grams;
+	if (offsets != NULL) delete offsets;
+	if (blocks != NULL) delete blocks;
+}
+
+void
+SubstringIndex::search(uchar *str, uint strLen, vector<size_t> *ids, vector<uchar*> *strings) const
+{
+	vector<size_t> cands;
+
+	if (strLen >= SUBSTRGRAM) candidates(str, strLen, &cands);
+	else
+	{
+		// Short substrings are not filtered: all blocks are scanned
+		size_t nblocks = (elements+blocksize-1)/blocksize;
+		for (size_t b=0; b<nblocks; b++) cands.push_back(b);
+	}
+
+	for (size_t c=0; c<cands.size(); c++)
+	{
+		size_t left = cands[c]*blocksize+1;
+		size_t right = left+blocksize-1;
+		if (right > elements) right = elements;
+
+		IteratorDictString *it = dict->extractRange(left, right);
+
+		for (size_t id=left; it->hasNext(); id++)
+		{
+			uint len;
+			uchar *current = it->next(&len);
+
+			if (std::search(current, current+len, str, str+strLen) != current+len)
+			{
+				ids->push_back(id);
+
+				if (strings != NULL) { strings->push_back(current); continue; }
+			}
+
+			delete [] current;
+		}
+
+		delete it;
+	}
+}
+
+void
+SubstringIndex::candidates(uchar *str, uint strLen, vector<size_t> *candidates) const
+{
+	// Obtaining the list of each different q-gram in the substring
+	vector<pair<size_t, size_t> > lists;
+
+	for (uint i=0; i+SUBSTRGRAM<=strLen; i++)
+	{
+		size_t pos;
+
+		// Some q-gram does not appear in the dictionary
+		if (!findGram(gram(str+i), &pos)) return;
+
+		size_t begin = offsets->getField(pos);
+		size_t end = offsets->getField(pos+1);
+
+		lists.push_back(pair<size_t, size_t>(end-begin, begin));
+	}
+
+	// The lists are intersected from the shortest one
+	std::sort(lists.begin(), lists.end());
+	lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+	candidates->resize(lists[0].first);
+	if (lists[0].first > 0) blocks->getRange(lists[0].second, lists[0].first, &(*candidates)[0]);
+
+	for (size_t l=1; (l<lists.size()) && !candidates->empty(); l++)
+	{
+		size_t ptr = lists[l].second, end = lists[l].second+lists[l].first;
+		size_t kept = 0;
+
+		for (size_t c=0; (c<candidates->size()) && (ptr<end); c++)
+		{
+			size_t block = (*candidates)[c];
+			while ((ptr < end) && (blocks->getField(ptr) < block)) ptr++;
+
+			if ((ptr < end) && (blocks->getField(ptr) == block))
+			{
+				(*candidates)[kept] = block;
+				kept++;
+			}
+		}
+
+		candidates->resize(kept);
+	}
+}
+
+bool
+SubstringIndex::findGram(size_t gram, size_t *pos) const
+{
+	size_t l = 0, r = grams->getNumberOfElements();
+
+	while (l < r)
+	{
+		size_t c = (l+r)/2;
+		size_t current = grams->getField(c);
+
+		if (current == gram) { *pos = c; return true; }
+		else if (current < gram) l = c+1;
+		else r = c;
+	}
+
+	return false;
+}
+
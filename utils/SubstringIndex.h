@@ -0,0 +1,146 @@
+/* SubstringIndex.h
+ * Copyright (C) 2014, Francisco Claude & Rodrigo Canovas & Miguel A. Martinez-Prieto
+ * all rights reserved.
+ *
+ * Auxiliary q-gram index for substring search in dictionaries which do not
+ * support it natively. The IDs are grouped in blocks of consecutive IDs 
+ * (the buckets of Front-Coding based dictionaries) and each q-gram in the
+ * dictionary stores the list of blocks containing it. A substring query 
+ * intersects the lists of its q-grams and only decodes the candidate 
+ * blocks to verify them.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Contacting the authors:
+ *   Francisco Claude:  	fclaude@recoded.cl
+ *   Rodrigo Canovas:  		rcanovas@student.unimelb.edu.au
+ *   Miguel A. Martinez-Prieto:	migumar2@infor.uva.es
+ */
+
+#ifndef _SUBSTRINGINDEX_H
+#define _SUBSTRINGINDEX_H
+
+#include <iostream>
+#include <vector>
+using namespace std;
+
+#include <libcdsBasics.h>
+using namespace cds_utils;
+
+#include "LogSequence.h"
+#include "MemoryMapping.h"
+#include "Utils.h"
+
+class StringDictionary;
+class IteratorDictID;
+class IteratorDictString;
+
+class SubstringIndex
+{
+	public:
+		/** Class Constructor. All strings are sequentially scanned.
+		    @param dict: the indexed dictionary.
+		    @param blocksize: number of consecutive IDs per block.
+		*/
+		SubstringIndex(const StringDictionary *dict, uint blocksize);
+
+		/** Locates all IDs of those elements containing the given 
+		    substring (in ascending order).
+		    @param str: the substring to be searched.
+		    @param strLen: the substring length.
+		    @returns an iterator for direct scanning of all the IDs.
+		*/
+		IteratorDictID* locate(uchar *str, uint strLen) const;
+
+		/** Extracts all elements containing the given substring.
+		    @param str: the substring to be searched.
+		    @param strLen: the substring length.
+		    @returns an iterator for direct scanning of all the strings.
+		*/
+		IteratorDictString* extract(uchar *str, uint strLen) const;
+
+		/** Computes the size of the structure in bytes. 
+		    @returns the index size in bytes.
+		*/
+		size_t getSize() const;
+
+		/** Stores the index into an ofstream (after the dictionary).
+		    @param out: the oftstream.
+		*/
+		void save(ofstream &out);
+
+		/** Loads the index stored after the dictionary (if any). The
+		    stream is left unchanged when no index is found.
+		    @param in: the ifstream.
+		    @param dict: the indexed dictionary.
+		    @param mapping: the memory mapping of the file (or NULL).
+		    @returns the loaded index (or NULL).
+		*/
+		static SubstringIndex *load(ifstream &in, const StringDictionary *dict, MemoryMapping *mapping);
+
+		/** Generic destructor. */
+		~SubstringIndex();
+
+	protected:
+		const StringDictionary *dict;	//! Indexed dictionary
+		uint64_t elements;		//! Number of strings
+		uint32_t blocksize;		//! Number of IDs per block
+
+		LogSequence *grams;		//! Sorted q-grams
+		LogSequence *offsets;		//! Beginning of the list of each q-gram
+		LogSequence *blocks;		//! Concatenated lists of blocks
+
+		/** Generic Constructor. */
+		SubstringIndex();
+
+		/** Searches the given substring.
+		    @param str: the substring to be searched.
+		    @param strLen: the substring length.
+		    @param ids: vector for the IDs containing the substring.
+		    @param strings: vector for the strings containing the 
+		      substring (or NULL if they are not required).
+		*/
+		void search(uchar *str, uint strLen, vector<size_t> *ids, vector<uchar*> *strings) const;
+
+		/** Obtains the blocks which contain all q-grams in the given 
+		    substring (it must be, at least, SUBSTRGRAM long).
+		    @param str: the substring to be searched.
+		    @param strLen: the substring length.
+		    @param candidates: vector for the candidate blocks.
+		*/
+		void candidates(uchar *str, uint strLen, vector<size_t> *candidates) const;
+
+		/** Binary searches the given q-gram.
+		    @param gram: the q-gram to be searched.
+		    @param pos: pointer to the q-gram position.
+		    @returns if the q-gram appears in the dictionary.
+		*/
+		bool findGram(size_t gram, size_t *pos) const;
+
+		/** Obtains the q-gram starting at the given string.
+		    @param str: the string.
+		    @returns the q-gram.
+		*/
+		static inline size_t gram(const uchar *str)
+		{
+			size_t g = 0;
+			for (uint i=0; i<SUBSTRGRAM; i++) g = (g << 8) | str[i];
+			return g;
+		}
+};
+
+#endif  /* _SUBSTRINGINDEX_H */
+
@@ -34,6 +34,10 @@
 #include <sys/stat.h> 
 #include <sys/types.h> 
 
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+
 #include <libcdsBasics.h>
 using namespace cds_utils;
 
@@ -48,11 +52,31 @@ using namespace cds_utils;
 
 static const size_t NORESULT = 0;
 
+/* Number of queries whose searches are interleaved in batch operations */
+static const size_t BATCHSIZE = 16;
+#define PREFETCH(addr) __builtin_prefetch((const void*)(addr))
+
+/* Size (in bytes) of the buffer used for streaming strings from disk */
+static const size_t READBUFFER = 1048576;
+
+/* Byte-aligned widths of the LogSequences (when requested by their builders) */
+static const uint32_t LOGALIGNOVERHEAD = 15;	// Maximum extra space (in percentage of the packed sequence)
+static const size_t LOGALIGNBYTES = 4096;	// Extra space (in bytes) always allowed
+
+/* Value of the 32-bit bucket counter of the front-coding dictionaries
+   announcing a 64-bit counter (written after the bucket offsets) */
+static const uint32_t WIDEBUCKETS = (uint32_t)-1;
+
+/* Mark of the serialized cursors for paginated prefix queries */
+static const uint32_t PREFIXCURSOR = 0x52435850;
+
 /* Hash-based dictionaries */
 static const uint32_t HASHHF      = 11; 	// Familiy of Hash-Huffman dictionaries
 static const uint32_t HASHUFFDAC  = 114; 	// HashDAC-Huffman dictionary
 static const uint32_t HASHRPF     = 12; 	// Familiy of Hash-RePair dictionaries
 static const uint32_t HASHRPDAC   = 124; 	// HashDAC-RePair dictionary
+static const uint32_t MPHFHF      = 13; 	// Minimal Perfect Hash-Huffman dictionary
+static const uint32_t MPHFRPF     = 14; 	// Minimal Perfect Hash-RePair dictionary
 
 static const uint32_t HASHRP      = 1; 		// Hash-RePair dictionary (used for loading purposes)
 static const uint32_t HASHBRP     = 2; 		// HashB-RePair dictionary (used for loading purposes)
@@ -62,6 +86,23 @@ static const uint32_t HASHUFF     = 1; 		// Hash-Huffman dictionary (used for lo
 static const uint32_t HASHBHUFF   = 2; 		// HashB-Huffman dictionary (used for loading purposes)
 static const uint32_t HASHBBHUFF  = 3; 		// HashBB-Huffman dictionary (used for loading purposes)
 
+static const uint32_t HASHMPHF    = 4; 		// Minimal perfect hash (used for loading purposes)
+
+static const uint32_t HASHLEGACY  = 0; 		// Byte-wise modulo hash (tables without format version)
+static const uint32_t HASHWORD    = 1; 		// 64-bit multiply-based word hash
+
+static const size_t HASHVERSIONED = (size_t)-1;	// Mark written (instead of the table size) by versioned tables
+static const uint32_t HASHFORMAT  = 1; 		// Current format version of the hash tables
+
+static const uint32_t RANKINDEX   = 0x4B4E4152; 	// Mark of the (optional) rank index stored after a hash dictionary
+
+/* Approximate membership filter (Front-Coding and hash-based dictionaries) */
+static const uint32_t MEMBERSHIPFILTER = 0x544C4946;	// Mark of the (optional) filter stored after a dictionary
+static const uint32_t FILTERBITS   = 10;		// Bits per string (about 1% of false positives)
+static const uint32_t FILTERPROBES = 7;			// Bits set per string (9-bit offsets within a block)
+static const uint32_t FILTERBLOCK  = 8;			// 64-bit words per block (a 512-bit cache line)
+static const uint64_t FILTERSEED   = 0x5bd1e9955bd1e995ULL;	// Seed of the filter hash function
+
 
 
 
@@ -72,14 +113,35 @@ static const uint32_t HTFC   = 221; 		// HuTucker Front-Coding dictionary
 static const uint32_t HHTFC  = 222; 		// HuTucker Front-Coding dictionary (with Huffman for suffixes)
 static const uint32_t RPHTFC = 223; 		// HuTucker Front-Coding dictionary (with RePair for suffixes)
 
+static const uint32_t SUBSTRINDEX = 0x52545342;	// Mark of the (optional) substring index stored after a dictionary
+static const uint32_t SUBSTRGRAM  = 3;		// Length of the q-grams indexed for substring search
+static const uint32_t SUBSTRBLOCK = 16;		// IDs per block of the substring index (for dictionaries without buckets)
+
 /* RePair+DAC dictionary */
 static const uint32_t RPDAC = 3;		// RePair+DAC dictionary
 
+/* Symbols kept in the (local) explicit stack of the RePair expanders before growing it */
+static const uint RPSTACK = 64;
+/* Longest rule expansion compared at once (when the grammar is unpacked) */
+static const uint RPSCRATCH = 256;
+
 /* FM-Index based dictionaries */
 static const uint32_t FMINDEX = 4;		// FM-Index dictionary (with plain: RG and compressed: RRR variants)
+static const uint32_t SAQSUFSORT = 0;		// Suffix sorting: Larsson-Sadakane (16 bytes per symbol)
+static const uint32_t SAIS = 1;			// Suffix sorting: SA-IS (4 bytes per symbol)
+static const uint32_t WTREE = 0;		// BWT (and XBW alpha) sequence: Huffman-shaped wavelet tree
+static const uint32_t WMATRIX = 1;		// BWT (and XBW alpha) sequence: wavelet matrix
 
 /* FM-Index based dictionaries */
 static const uint32_t DXBW = 5;			// XBW dictionary (with plain: RG and compressed: RRR variants)
+static const uint32_t XBWMATRIX = 0x5854414D;	// Mark: the XBW alpha sequence is a wavelet matrix
+
+/* Dynamic dictionaries */
+static const uint32_t DYNAMIC = 6;		// Static dictionary extended with a delta layer of insertions
+static const size_t DYNAMICBUFFER = 1048576;	// Number of buffered insertions triggering a background merge
+static const uint32_t DYNAMICBUCKET = 16;	// Bucket size of the (PFC) delta segments
+static const size_t DYNAMICFACTOR = 2;		// Consecutive segments are merged while the older is not larger than FACTOR times the newer
+static const size_t DYNAMICSEGMENTS = 32;	// Maximum number of delta segments (the newest ones are merged beyond it)
 
 
 inline uint
@@ -133,7 +195,7 @@ Reallocate(uchar** array, size_t len)
 	delete [] *array;
 
 	// This initialization is due to Valgrind warnings
-	for (uint i=len; i<llen; i++) xarr[i] = 0;
+	memset(xarr+len, 0, llen-len);
 
 	*array = xarr;
 
@@ -149,15 +211,19 @@ Reallocate(int** array, size_t len)
 	delete [] *array;
 
 	// This initialization is due to valgrind warnings
-	for (uint i=len; i<llen; i++) xarr[i] = 0;
+	memset(xarr+len, 0, (llen-len)*sizeof(int));
 
 	*array = xarr;
 
 	return llen;
 }
 
+/* Compares (at most) the first 'length' bytes of two strings, adding the
+   length of their common prefix to lcp. It returns the difference between
+   the first mismatching bytes (0 if no mismatch is found). This is the
+   scalar version, used for short strings and non-x86 targets. */
 inline int 
-longestCommonPrefix(const uchar* str1, const uchar* str2, uint length, uint *lcp)
+longestCommonPrefixScalar(const uchar* str1, const uchar* str2, uint length, uint *lcp)
 {	
 	uint ptr = 0;
 
@@ -175,6 +241,133 @@ longestCommonPrefix(const uchar* str1, const uchar* str2, uint length, uint *lcp
 	return 0;
 }
 
+#ifdef __SSE2__
+/* Vector loads may read beyond the end of the shortest string (its
+   terminator is the mismatch), so they are only performed if they do not
+   cross a page boundary. */
+static const size_t LCPPAGE = 4096;
+
+inline bool
+samePage(const uchar* str, size_t bytes)
+{
+	return ((size_t)str & (LCPPAGE-1)) <= LCPPAGE-bytes;
+}
+
+/* SSE2 version of longestCommonPrefix: 16 bytes per step. */
+inline int
+longestCommonPrefixSSE2(const uchar* str1, const uchar* str2, uint length, uint *lcp)
+{
+	uint ptr = 0;
+
+	for (; ptr+16<=length; ptr+=16)
+	{
+		if (samePage(str1+ptr, 16) && samePage(str2+ptr, 16))
+		{
+			__m128i a = _mm_loadu_si128((const __m128i*)(str1+ptr));
+			__m128i b = _mm_loadu_si128((const __m128i*)(str2+ptr));
+			uint mask = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^ 0xFFFF;
+
+			if (mask != 0)
+			{
+				ptr += __builtin_ctz(mask);
+				*lcp += ptr;
+				return (str1[ptr] - str2[ptr]);
+			}
+		}
+		else
+		{
+			uint shared = 0;
+			int cmp = longestCommonPrefixScalar(str1+ptr, str2+ptr, 16, &shared);
+			if (cmp != 0) { *lcp += ptr+shared; return cmp; }
+		}
+	}
+
+	*lcp += ptr;
+	return longestCommonPrefixScalar(str1+ptr, str2+ptr, length-ptr, lcp);
+}
+
+/* AVX2 version of longestCommonPrefix: 32 bytes per step. It is only
+   called if the CPU supports AVX2 (the remaining bytes are compared with
+   SSE2). */
+__attribute__((target("avx2"))) inline int
+longestCommonPrefixAVX2(const uchar* str1, const uchar* str2, uint length, uint *lcp)
+{
+	uint ptr = 0;
+
+	for (; ptr+32<=length; ptr+=32)
+	{
+		if (!samePage(str1+ptr, 32) || !samePage(str2+ptr, 32)) break;
+
+		__m256i a = _mm256_loadu_si256((const __m256i*)(str1+ptr));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(str2+ptr));
+		uint mask = ~(uint)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+
+		if (mask != 0)
+		{
+			ptr += __builtin_ctz(mask);
+			*lcp += ptr;
+			return (str1[ptr] - str2[ptr]);
+		}
+	}
+
+	*lcp += ptr;
+	return longestCommonPrefixSSE2(str1+ptr, str2+ptr, length-ptr, lcp);
+}
+#endif
+
+/* Compares (at most) the first 'length' bytes of two strings, adding the
+   length of their common prefix to lcp. It returns the difference between
+   the first mismatching bytes (0 if no mismatch is found). The comparison
+   is vectorized (AVX2 or SSE2, chosen at runtime) for long strings. */
+inline int 
+longestCommonPrefix(const uchar* str1, const uchar* str2, uint length, uint *lcp)
+{	
+#ifdef __SSE2__
+	if ((length >= 32) && __builtin_cpu_supports("avx2")) return longestCommonPrefixAVX2(str1, str2, length, lcp);
+	if (length >= 16) return longestCommonPrefixSSE2(str1, str2, length, lcp);
+#endif
+
+	return longestCommonPrefixScalar(str1, str2, length, lcp);
+}
+
+/* Compares the first 'length' bytes of two strings (as memcmp, returning
+   a negative value, zero or a positive value). The bytes are compared
+   eight at a time as big-endian words, which avoids the call overhead of
+   memcmp for the short (encoded) strings compared in binary searches. */
+inline int
+compareBytes(const uchar* str1, const uchar* str2, uint length)
+{
+	uint ptr = 0;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	if (length >= 8)
+	{
+		uint64_t a, b;
+
+		// The last word may overlap the previous one (its shared bytes
+		// are already known to be equal)
+		for (;; ptr+=8)
+		{
+			if (ptr+8 > length) ptr = length-8;
+
+			memcpy(&a, str1+ptr, 8); memcpy(&b, str2+ptr, 8);
+			if (a != b)
+			{
+				a = __builtin_bswap64(a); b = __builtin_bswap64(b);
+				return (a < b) ? -1 : 1;
+			}
+
+			if (ptr+8 == length) return 0;
+		}
+	}
+#endif
+
+	for (; ptr<length; ptr++)
+		if (str1[ptr] != str2[ptr]) return (str1[ptr] - str2[ptr]);
+
+	return 0;
+}
+
 inline double
 getTime(void)
 {